@@ -23,6 +23,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/grid/reference_cell.h>
 
@@ -30,8 +31,11 @@
 
 // To be able to serialize XDMFEntry
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/version.hpp>
 
+#include <cstdint>
 #include <limits>
+#include <list>
 #include <string>
 #include <tuple>
 #include <typeinfo>
@@ -53,6 +57,10 @@ DEAL_II_NAMESPACE_OPEN
 #ifndef DOXYGEN
 class ParameterHandler;
 class XDMFEntry;
+namespace DataOutBase
+{
+  class Hdf5TimeSeriesWriter;
+}
 #endif
 
 /**
@@ -1169,6 +1177,34 @@ namespace DataOutBase
      */
     bool write_higher_order_cells;
 
+    /**
+     * Flag determining whether the data arrays of VTU files are written in
+     * the <code>appended</code> format, i.e., as raw binary data collected in
+     * an <code>AppendedData</code> section at the end of the file, rather
+     * than base64 encoded inside the respective <code>DataArray</code>
+     * elements. This avoids the 33% size overhead of base64 encoding as well
+     * as the cost of encoding and decoding the data.
+     *
+     * If libz was found during configuration, each data array is compressed
+     * in the same way as for inline output, unless #compression_level is set
+     * to <tt>no_compression</tt>, in which case the arrays are written
+     * uncompressed and the file does not declare a compressor at all.
+     * Uncompressed arrays are written straight to the output stream, whereas
+     * compressed arrays are kept in memory, in compressed form, until the
+     * rest of the file has been written since their offsets within the
+     * appended section are only known after compression.
+     *
+     * Default is <tt>false</tt>.
+     *
+     * @note The appended section can only be written after the rest of the
+     * file, and consequently this flag is only honored by
+     * DataOutBase::write_vtu() and DataOutInterface::write_vtu().
+     * DataOutBase::write_vtu_main() and
+     * DataOutInterface::write_vtu_in_parallel(), which write pieces of a file
+     * that are later concatenated, always write their data inline.
+     */
+    bool write_appended_raw_data;
+
     /**
      * Constructor.
      */
@@ -1177,7 +1213,8 @@ namespace DataOutBase
       const unsigned int cycle = std::numeric_limits<unsigned int>::min(),
       const bool         print_date_and_time              = true,
       const ZlibCompressionLevel compression_level        = best_compression,
-      const bool                 write_higher_order_cells = false);
+      const bool                 write_higher_order_cells = false,
+      const bool                 write_appended_raw_data  = false);
   };
 
 
@@ -1254,6 +1291,105 @@ namespace DataOutBase
     static const unsigned int format_version;
   };
 
+  /**
+   * Flags controlling the details of output in HDF5 format, see
+   * DataOutBase::write_hdf5_parallel().
+   *
+   * By default, all datasets are stored contiguously and uncompressed, and
+   * every process writes its own part of each dataset. For large parallel
+   * runs, the options below allow to store datasets in compressed chunks, to
+   * perform metadata operations collectively, and to let only a subset of
+   * processes access the file.
+   *
+   * @ingroup output
+   */
+  struct Hdf5Flags : public OutputFlagsBase<Hdf5Flags>
+  {
+    /**
+     * The compression filters that can be applied to the datasets.
+     */
+    enum CompressionFilter
+    {
+      /**
+       * Do not compress the datasets.
+       */
+      no_filter,
+      /**
+       * Compress the datasets using the deflate algorithm of zlib. The
+       * datasets are byte-shuffled before compression, which typically
+       * improves the compression ratio of floating point data considerably.
+       */
+      deflate,
+      /**
+       * Compress the datasets using szip. This filter is only available if
+       * the HDF5 library was built with szip (or libaec) support.
+       */
+      szip
+    };
+
+    /**
+     * The number of rows, i.e., nodes or cells, of a dataset that are stored
+     * together in one chunk of the file. If zero, datasets are stored
+     * contiguously, unless a #compression_filter is selected: compressed
+     * datasets always need to be chunked, and a chunk size of 65536 rows is
+     * used in that case.
+     *
+     * Default is <tt>0</tt>.
+     */
+    unsigned int chunk_size;
+
+    /**
+     * The compression filter applied to all datasets.
+     *
+     * @note In parallel, writing compressed datasets requires HDF5 version
+     * 1.10.2 or later.
+     *
+     * Default is <tt>no_filter</tt>.
+     */
+    CompressionFilter compression_filter;
+
+    /**
+     * The compression level between 1 (fastest) and 9 (smallest files) used
+     * by the <tt>deflate</tt> filter.
+     *
+     * Default is <tt>6</tt>, the default of zlib.
+     */
+    unsigned int deflate_level;
+
+    /**
+     * Flag determining whether metadata of the file is read and written
+     * collectively by all processes, rather than by every process on its
+     * own. This avoids a storm of small metadata requests to the file
+     * system when many processes write to the same file. It requires a
+     * parallel HDF5 library of version 1.10 or later, and is ignored
+     * otherwise.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool collective_metadata;
+
+    /**
+     * The number of consecutive MPI processes that are grouped together for
+     * writing. Only the first process of each group opens the file and
+     * writes the data of the entire group, after having received it from the
+     * other processes of the group. This reduces the number of processes
+     * that access the file system to a fraction of the total number.
+     *
+     * Default is <tt>1</tt>, i.e., every process writes its own data.
+     */
+    unsigned int ranks_per_writer;
+
+    /**
+     * Constructor.
+     */
+    Hdf5Flags(const unsigned int      chunk_size          = 0,
+              const CompressionFilter compression_filter  = no_filter,
+              const unsigned int      deflate_level       = 6,
+              const bool              collective_metadata = false,
+              const unsigned int      ranks_per_writer    = 1);
+  };
+
+
   /**
    * Flags controlling the DataOutFilter.
    *
@@ -2318,6 +2454,9 @@ namespace DataOutBase
    * contain only the solution values. If @p write_mesh_file is true and the
    * filenames are the same, the resulting file will contain both mesh data
    * and solution values.
+   *
+   * The layout of the datasets in the file and the way the processes access
+   * the file are controlled by @p flags.
    */
   template <int dim, int spacedim>
   void
@@ -2326,7 +2465,8 @@ namespace DataOutBase
                       const bool                               write_mesh_file,
                       const std::string &                      mesh_filename,
                       const std::string &solution_filename,
-                      const MPI_Comm &   comm);
+                      const MPI_Comm &   comm,
+                      const Hdf5Flags &  flags = Hdf5Flags());
 
   /**
    * DataOutFilter is an intermediate data format that reduces the amount of
@@ -2738,7 +2878,13 @@ public:
    * default value of @p n_groups is 0, meaning that every MPI rank will write one
    * file. A value of 1 will generate one big file containing the solution over
    * the whole domain, while a larger value will create @p n_groups files (but not
-   * more than there are MPI ranks).
+   * more than there are MPI ranks). Finally, the value
+   * numbers::invalid_unsigned_int creates one file per compute node: all MPI
+   * ranks that share memory, as determined by
+   * <code>MPI_Comm_split_type(..., MPI_COMM_TYPE_SHARED, ...)</code>, write
+   * into the same file using MPI I/O. This keeps the number of files
+   * proportional to the size of the machine rather than to the number of
+   * processes, without requiring MPI I/O across nodes.
    *
    * Note that only one processor needs to
    * generate the .pvtu file, where processor zero is chosen to take over this
@@ -2861,6 +3007,10 @@ public:
    * contain only the solution values. If write_mesh_file is true and the
    * filenames are the same, the resulting file will contain both mesh data
    * and solution values.
+   *
+   * Both variants of this function use the DataOutBase::Hdf5Flags set
+   * through set_flags() to determine chunking, compression, and the way the
+   * processes access the file.
    */
   void
   write_hdf5_parallel(const DataOutBase::DataOutFilter &data_filter,
@@ -2869,6 +3019,17 @@ public:
                       const std::string &               solution_filename,
                       const MPI_Comm &                  comm) const;
 
+  /**
+   * Write the data in @p data_filter as the next time step of the time series
+   * managed by @p writer. See DataOutBase::Hdf5TimeSeriesWriter for details,
+   * in particular for the meaning of @p mesh_changed.
+   */
+  void
+  write_hdf5_time_step(DataOutBase::Hdf5TimeSeriesWriter &writer,
+                       const DataOutBase::DataOutFilter & data_filter,
+                       const double                       time,
+                       const bool mesh_changed = false) const;
+
   /**
    * DataOutFilter is an intermediate data format that reduces the amount of
    * data that will be written to files. The object filled by this function
@@ -2892,6 +3053,74 @@ public:
         const DataOutBase::OutputFormat output_format =
           DataOutBase::default_format) const;
 
+  /**
+   * Write data and grid to the file @p filename in the given format, like the
+   * write() function does, but do so on a separate task so that the calling
+   * thread can continue with its computations while the output is being
+   * generated, compressed, and written to disk.
+   *
+   * Before it returns, this function takes a copy of everything the output
+   * functions need: the patches, the names of the data sets, the information
+   * about non-scalar data ranges, and the output flags. Consequently, it is
+   * safe to call build_patches() again, to modify or destroy the vectors
+   * attached to a derived class such as DataOut, or to change the flags of
+   * this object right after this function has returned; none of this will
+   * affect the file being written.
+   *
+   * Since every pending write holds a copy of the patches, the number of
+   * writes that can be in flight at the same time is limited to the value
+   * set by set_max_background_writes(). If that many writes are still
+   * pending when this function is called, it waits for the oldest of them
+   * to finish before it queues the new one. This keeps the memory used for
+   * the snapshots bounded.
+   *
+   * The returned object can be used to wait for the file to be written. If
+   * writing the file failed, calling Threads::Task::join() on it re-throws
+   * the exception that was raised on the background task. Exceptions of
+   * writes whose task object was discarded by the caller are re-thrown by
+   * the next call to this function or to wait_for_background_writes() that
+   * has to wait for them.
+   *
+   * If the deal.II runtime has been configured to use only a single thread
+   * (see MultithreadInfo::set_thread_limit()), the file is written before
+   * this function returns.
+   *
+   * @note Only output formats that are written through a `std::ostream`
+   * (i.e., all formats supported by write()) can be written in the
+   * background. Parallel output via write_vtu_in_parallel() and
+   * write_hdf5_parallel() consists of collective MPI operations and can not
+   * be moved to a separate thread unless MPI is initialized with full thread
+   * support; for these formats, the expensive part that does not need
+   * communication is write_filtered_data(), and the resulting
+   * DataOutBase::DataOutFilter object is already a snapshot that can be
+   * written later. In a parallel program, every process can instead write
+   * its own piece via this function with format DataOutBase::vtu, and one
+   * process writes the (small) record file with write_pvtu_record() as
+   * usual.
+   */
+  Threads::Task<void>
+  write_in_background(const std::string &             filename,
+                      const DataOutBase::OutputFormat output_format =
+                        DataOutBase::default_format) const;
+
+  /**
+   * Wait for all writes started by write_in_background() to finish. If any
+   * of them failed, the exception it raised is re-thrown here.
+   */
+  void
+  wait_for_background_writes() const;
+
+  /**
+   * Set the maximal number of writes started via write_in_background() that
+   * may be pending at the same time. The default is one, i.e., each call to
+   * write_in_background() waits until the previous output has been written.
+   * Larger values allow slow file systems to fall further behind the
+   * computation, at the cost of keeping one copy of the patches in memory
+   * per pending write.
+   */
+  void
+  set_max_background_writes(const unsigned int max_writes);
+
   /**
    * Set the default format. The value set here is used anytime, output for
    * format <tt>default_format</tt> is requested.
@@ -3016,6 +3245,26 @@ protected:
   unsigned int default_subdivisions;
 
 private:
+  /**
+   * A class that stores a copy of the patches, data set names, and output
+   * flags of a DataOutInterface object. It is used by write_in_background()
+   * to write output while the original object may be modified. The class is
+   * defined in the .cc file.
+   */
+  class Snapshot;
+
+  /**
+   * The writes that have been started by write_in_background() and that
+   * have not been waited for yet, in the order in which they were started.
+   */
+  mutable std::list<Threads::Task<void>> background_writes;
+
+  /**
+   * The maximal number of elements in @p background_writes. See
+   * set_max_background_writes().
+   */
+  unsigned int max_background_writes;
+
   /**
    * Standard output format.  Use this format, if output format default_format
    * is requested. It can be changed by the <tt>set_format</tt> function or in
@@ -3082,6 +3331,12 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  /**
+   * Flags to be used upon output of HDF5 data. Can be changed by using the
+   * <tt>set_flags</tt> function.
+   */
+  DataOutBase::Hdf5Flags hdf5_flags;
 };
 
 
@@ -3314,6 +3569,16 @@ public:
   void
   add_attribute(const std::string &attr_name, const unsigned int dimension);
 
+  /**
+   * Set the HDF5 groups of the mesh and the solution file in which the
+   * datasets referenced by this entry are stored, for example
+   * <code>"/mesh_0"</code>. By default, the datasets are expected in the
+   * root group of their files.
+   */
+  void
+  set_hdf5_groups(const std::string &mesh_group,
+                  const std::string &solution_group);
+
   /**
    * Read or write the data of this object for serialization using the
    * [BOOST serialization
@@ -3321,10 +3586,20 @@ public:
    */
   template <class Archive>
   void
-  serialize(Archive &ar, const unsigned int /*version*/)
+  serialize(Archive &ar, const unsigned int version)
   {
     ar &valid &h5_sol_filename &h5_mesh_filename &entry_time &num_nodes
       &num_cells &dimension &space_dimension &attribute_dims;
+
+    // The HDF5 groups were added in version 1 of this class. Entries stored
+    // by earlier versions reference datasets in the root groups of the files
+    if (version >= 1)
+      ar &h5_sol_group &h5_mesh_group;
+    else
+      {
+        h5_sol_group.clear();
+        h5_mesh_group.clear();
+      }
   }
 
   /**
@@ -3362,6 +3637,16 @@ private:
    */
   std::string h5_mesh_filename;
 
+  /**
+   * The HDF5 group of the solution file that contains the solution datasets.
+   */
+  std::string h5_sol_group;
+
+  /**
+   * The HDF5 group of the mesh file that contains the nodes and cells.
+   */
+  std::string h5_mesh_group;
+
   /**
    * The simulation time associated with this entry.
    */
@@ -3396,6 +3681,169 @@ private:
 
 
 
+namespace DataOutBase
+{
+  /**
+   * A class that writes a sequence of time steps into one HDF5 file that
+   * stays open as long as the object exists, together with an XDMF file that
+   * describes the whole time series.
+   *
+   * Calling DataOutInterface::write_hdf5_parallel() once per time step writes
+   * the nodes and cells of the mesh over and over again, even if the mesh has
+   * not changed since the previous time step. This class instead stores the
+   * mesh in a group <code>/mesh_k</code> of the HDF5 file only when it has
+   * changed, and writes the data sets of time step $n$ into a group
+   * <code>/step_n</code>. The XDMF entries of all time steps that share a
+   * mesh then reference the same nodes and cells datasets. Since the mesh
+   * often makes up the larger part of the output, this considerably reduces
+   * the amount of data written in simulations on fixed meshes.
+   *
+   * The mesh is written for the first time step, whenever the caller
+   * indicates that it has changed, and whenever the total number of nodes or
+   * cells differs from the one of the previously written mesh. Note that a
+   * mesh whose vertices moved, but that has the same number of nodes and
+   * cells, can not be detected as changed and needs to be indicated by the
+   * caller.
+   *
+   * After each time step, the HDF5 file is flushed and the XDMF file is
+   * rewritten, so that both can be used for visualization or post-processing
+   * while the simulation is still running. A typical use looks like this:
+   * @code
+   * DataOutBase::Hdf5TimeSeriesWriter writer("solution.h5",
+   *                                          "solution.xdmf",
+   *                                          MPI_COMM_WORLD);
+   * for (unsigned int step = 0; step < n_steps; ++step)
+   *   {
+   *     ... // advance the solution
+   *
+   *     DataOut<dim> data_out;
+   *     data_out.attach_dof_handler(dof_handler);
+   *     data_out.add_data_vector(solution, "u");
+   *     data_out.build_patches();
+   *
+   *     DataOutBase::DataOutFilter data_filter(
+   *       DataOutBase::DataOutFilterFlags(true, true));
+   *     data_out.write_filtered_data(data_filter);
+   *     data_out.write_hdf5_time_step(writer,
+   *                                   data_filter,
+   *                                   time,
+   *                                   mesh_was_refined);
+   *   }
+   * @endcode
+   *
+   * All functions of this class, including the constructor and the
+   * destructor, need to be called on all processes of the communicator.
+   * Chunking and compression of the datasets are controlled by the
+   * Hdf5Flags passed to the constructor; aggregating the data of several
+   * processes through Hdf5Flags::ranks_per_writer is not supported by this
+   * class.
+   */
+  class Hdf5TimeSeriesWriter
+  {
+  public:
+    /**
+     * Constructor. Create (or truncate) the HDF5 file @p h5_filename and
+     * remember the name of the XDMF file that is written after each time
+     * step. The name of the HDF5 file is stored in the XDMF file as given
+     * here, and should therefore usually not contain a directory.
+     */
+    Hdf5TimeSeriesWriter(const std::string &h5_filename,
+                         const std::string &xdmf_filename,
+                         const MPI_Comm &   comm,
+                         const Hdf5Flags &  flags = Hdf5Flags());
+
+    /**
+     * Destructor. Closes the HDF5 file.
+     */
+    ~Hdf5TimeSeriesWriter();
+
+    /**
+     * Write the data in @p data_filter, which has been obtained from
+     * @p patches, as the next time step with time @p time. The mesh is
+     * written in addition if @p mesh_changed is true, if this is the first
+     * time step, or if the number of nodes or cells differs from the one of
+     * the last mesh written.
+     *
+     * Usually, this function is called through
+     * DataOutInterface::write_hdf5_time_step().
+     */
+    template <int dim, int spacedim>
+    void
+    write_time_step(const std::vector<Patch<dim, spacedim>> &patches,
+                    const DataOutFilter &                    data_filter,
+                    const double                             time,
+                    const bool mesh_changed = false);
+
+    /**
+     * Return the XDMF entries of the time steps written so far. The entries
+     * are only valid on process zero of the communicator.
+     */
+    const std::vector<XDMFEntry> &
+    get_xdmf_entries() const;
+
+    /**
+     * Return the number of meshes written so far.
+     */
+    unsigned int
+    n_meshes_written() const;
+
+  private:
+    /**
+     * The name of the HDF5 file.
+     */
+    const std::string h5_filename;
+
+    /**
+     * The name of the XDMF file.
+     */
+    const std::string xdmf_filename;
+
+    /**
+     * The communicator of all processes writing to the file.
+     */
+    const MPI_Comm comm;
+
+    /**
+     * The flags controlling the layout of the datasets.
+     */
+    const Hdf5Flags flags;
+
+    /**
+     * The HDF5 identifier of the open file, stored in a type wide enough to
+     * hold an <code>hid_t</code> so that this header does not need to
+     * include the HDF5 headers.
+     */
+    std::int64_t h5_file_id;
+
+    /**
+     * The number of meshes written so far.
+     */
+    unsigned int n_meshes;
+
+    /**
+     * The number of time steps written so far.
+     */
+    unsigned int n_steps;
+
+    /**
+     * The total number of nodes and cells of the last mesh written.
+     */
+    unsigned int mesh_node_cell_count[2];
+
+    /**
+     * The reference cell of the patches, used when writing the XDMF file.
+     */
+    ReferenceCell reference_cell;
+
+    /**
+     * The XDMF entries of the time steps written so far.
+     */
+    std::vector<XDMFEntry> entries;
+  };
+} // namespace DataOutBase
+
+
+
 /* -------------------- inline functions ------------------- */
 
 namespace DataOutBase
@@ -3435,4 +3883,7 @@ namespace DataOutBase
 
 DEAL_II_NAMESPACE_CLOSE
 
+// Version 1 of XDMFEntry added the HDF5 groups of the mesh and solution data
+BOOST_CLASS_VERSION(dealii::XDMFEntry, 1)
+
 #endif
@@ -23,6 +23,8 @@
 
 #  include <list>
 #  include <map>
+#  include <memory>
+#  include <mutex>
 #  include <shared_mutex>
 #  include <thread>
 #  include <vector>
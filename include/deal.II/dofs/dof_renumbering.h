@@ -30,6 +30,20 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declarations
+#ifndef DOXYGEN
+namespace Utilities
+{
+  namespace MPI
+  {
+    class Partitioner;
+  }
+} // namespace Utilities
+
+template <int dim, typename Number, typename VectorizedArrayType>
+class MatrixFree;
+#endif
+
 /**
  * Implementation of a number of renumbering algorithms for the degrees of
  * freedom on a triangulation. The functions in this namespace compute
@@ -1214,6 +1228,87 @@ namespace DoFRenumbering
    * @}
    */
 
+  /**
+   * @name Numberings based on matrix-free loops
+   * @{
+   */
+
+  /**
+   * Renumber the degrees of freedom in the order in which they are accessed
+   * by the cell loops of the given MatrixFree object, in order to improve
+   * the data locality of operator evaluations with MatrixFree::cell_loop()
+   * and of the vector operations that are usually interleaved with them.
+   *
+   * The degrees of freedom are numbered by the first cell batch that
+   * accesses them, going through the cell batches in the order
+   * MatrixFree::cell_loop() traverses them and through the unknowns of a
+   * batch in the order FEEvaluation reads them, i.e., with the lanes of the
+   * batch as the fastest running index. As a consequence, the vector entries
+   * touched by one batch are mostly contiguous, and an entry is usually
+   * accessed for the last time shortly after it has been accessed for the
+   * first time, i.e., while it is still in cache.
+   *
+   * In parallel, the locally owned degrees of freedom that are ghosts on
+   * other processes (i.e., the ones that need to be sent in
+   * LinearAlgebra::distributed::Vector::update_ghost_values() and received
+   * in LinearAlgebra::distributed::Vector::compress()) are numbered first,
+   * again in the order of first access. This groups the data exchanged with
+   * other processes into a few contiguous ranges. Degrees of freedom that
+   * are not touched by any cell batch (e.g., because the respective cells
+   * are not part of the MatrixFree object) are numbered last, keeping their
+   * relative order.
+   *
+   * The @p dof_handler must be one of the DoFHandler objects the
+   * @p matrix_free object has been set up with. As the numbering changes,
+   * the MatrixFree object (and any vector initialized from it) needs to be
+   * re-initialized after calling this function. The degrees of freedom are
+   * numbered according to the unknowns on the cells, without resolving
+   * constraints, i.e., the MatrixFree object needs to store the plain
+   * indices, which is the default (see
+   * MatrixFree::AdditionalData::store_plain_indices).
+   *
+   * @note This function is only available if
+   * <tt>deal.II/matrix_free/matrix_free.h</tt> is included.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * Compute the renumbering vector needed by the matrix_free_data_locality()
+   * function. Does not perform the renumbering on the @p DoFHandler dofs but
+   * returns the renumbering vector.
+   */
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free);
+
+  /**
+   * @}
+   */
+
+  namespace internal
+  {
+    /**
+     * Compute the renumbering of the locally owned degrees of freedom for
+     * compute_matrix_free_data_locality(), given the local indices (in the
+     * numbering of the @p partitioner) in the order they are accessed by the
+     * cell loop. The result is indexed by the position of a degree of
+     * freedom within the locally owned range, as expected by
+     * DoFHandler::renumber_dofs().
+     */
+    void
+    compute_matrix_free_data_locality(
+      std::vector<types::global_dof_index> &new_dof_indices,
+      const Utilities::MPI::Partitioner &   partitioner,
+      const std::vector<unsigned int> &     dof_indices_in_loop_order);
+  } // namespace internal
+
 
 
   /**
@@ -1243,6 +1338,83 @@ namespace DoFRenumbering
 } // namespace DoFRenumbering
 
 
+
+#ifndef DOXYGEN
+
+/* ------------------------- template functions ------------------------- */
+
+namespace DoFRenumbering
+{
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                   dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    std::vector<types::global_dof_index> new_dof_indices;
+    compute_matrix_free_data_locality(new_dof_indices,
+                                      dof_handler,
+                                      matrix_free);
+    dof_handler.renumber_dofs(new_dof_indices);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &              new_dof_indices,
+    const DoFHandler<dim> &                             dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    Assert(dof_handler.n_dofs() > 0, ExcDoFHandlerNotInitialized());
+
+    unsigned int dof_no = numbers::invalid_unsigned_int;
+    for (unsigned int no = 0; no < matrix_free.n_components(); ++no)
+      if (&matrix_free.get_dof_handler(no) == &dof_handler)
+        {
+          dof_no = no;
+          break;
+        }
+    Assert(dof_no != numbers::invalid_unsigned_int,
+           ExcMessage("The given DoFHandler is not part of the MatrixFree "
+                      "object."));
+
+    const auto &dof_info = matrix_free.get_dof_info(dof_no);
+
+    // collect the local indices in the order they are accessed by
+    // FEEvaluation, i.e., with the lanes of a cell batch running fastest
+    std::vector<unsigned int> dof_indices_in_loop_order;
+    std::vector<unsigned int> dof_indices;
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        dof_info.get_dof_indices_on_cell_batch(dof_indices, cell, false);
+        const unsigned int n_filled =
+          matrix_free.n_active_entries_per_cell_batch(cell);
+        if (n_filled > 1 && dof_indices.size() % n_filled == 0)
+          {
+            const unsigned int dofs_per_cell = dof_indices.size() / n_filled;
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              for (unsigned int v = 0; v < n_filled; ++v)
+                dof_indices_in_loop_order.push_back(
+                  dof_indices[v * dofs_per_cell + i]);
+          }
+        else
+          dof_indices_in_loop_order.insert(dof_indices_in_loop_order.end(),
+                                           dof_indices.begin(),
+                                           dof_indices.end());
+      }
+
+    internal::compute_matrix_free_data_locality(
+      new_dof_indices,
+      *matrix_free.get_vector_partitioner(dof_no),
+      dof_indices_in_loop_order);
+  }
+} // namespace DoFRenumbering
+
+#endif
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
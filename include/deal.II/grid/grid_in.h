@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/smartpointer.h>
 
@@ -35,6 +36,11 @@ template <int dim, int space_dim>
 class Triangulation;
 template <int dim>
 struct CellData;
+namespace TriangulationDescription
+{
+  template <int dim, int spacedim>
+  struct Description;
+}
 #endif
 
 /**
@@ -336,6 +342,8 @@ public:
     assimp,
     /// Use read_exodusii()
     exodusii,
+    /// Use read_binary()
+    binary,
   };
 
   /**
@@ -428,6 +436,71 @@ public:
   void
   read_vtu(std::istream &in);
 
+  /**
+   * Read a triangulation from the binary format written by
+   * GridOut::write_binary(). The stream must have been opened in binary
+   * mode.
+   *
+   * Unlike the text based formats, the file stores vertex locations and
+   * integer ids in their native binary representation, so that reading
+   * amounts to a small number of bulk reads. No reordering or other repair
+   * of the data is attempted: the cells are passed to
+   * Triangulation::create_triangulation() exactly as they were stored, since
+   * they were taken from a valid triangulation in the first place. See the
+   * documentation of GridOut::write_binary() for a description of the file
+   * layout.
+   *
+   * The file has to be written with the same values of `dim` and `spacedim`
+   * and on a machine with the same byte order; otherwise an exception is
+   * thrown.
+   *
+   * All sections of the file are read, and the cells are assigned the
+   * subdomain ids they had when the file was written. To read only the part
+   * of the mesh relevant to one process, use read_binary_description()
+   * instead.
+   */
+  void
+  read_binary(std::istream &in);
+
+  /**
+   * Read the part of a triangulation written by GridOut::write_binary() that
+   * is relevant to one process, and return it as a
+   * TriangulationDescription::Description, which can be passed to
+   * parallel::fullydistributed::Triangulation::create_triangulation().
+   *
+   * The file contains one section per subdomain id of the triangulation that
+   * was written, see the documentation of GridOut::write_binary(). The
+   * process with rank $p$ in @p comm only reads the directory of sections in
+   * the header of the file and then section $p$, which already contains the
+   * cells owned by this process and the layer of ghost cells around them,
+   * their vertices, and their ids in the order used by the description. The
+   * cost of the function therefore only depends on the size of the local
+   * part of the mesh, and no process ever holds the whole mesh. In
+   * particular, the file does not have to be parsed: every array of a
+   * section is read with a single bulk read.
+   *
+   * The result is the same as the one of
+   * TriangulationDescription::Utilities::create_description_from_triangulation()
+   * called with the written triangulation and the default settings, except
+   * that the mesh smoothing is set to Triangulation::none. The active cells
+   * of the written triangulation become the coarse cells, with the
+   * position of a cell in the file as its coarse cell id.
+   *
+   * By default, the file has to contain as many sections as there are
+   * processes in @p comm. If @p my_rank_in is given, section @p my_rank_in
+   * is read instead of the one of the calling process, and the number of
+   * sections may differ from the size of @p comm. This can be used to set up
+   * the description of any process on a single process, e.g., for testing.
+   *
+   * This function does not need a triangulation to be attached to this
+   * object and is therefore static.
+   */
+  static TriangulationDescription::Description<dim, spacedim>
+  read_binary_description(
+    const MPI_Comm &   comm,
+    const std::string &filename,
+    const unsigned int my_rank_in = numbers::invalid_unsigned_int);
+
 
   /**
    * Read grid data from an unv file as generated by the Salome mesh
@@ -580,6 +653,53 @@ public:
   read_msh(const std::string &filename);
 #endif
 
+  /**
+   * Read a mesh stored in the ASCII format 4.1 of Gmsh in parallel, without
+   * any process ever holding more than its share of the mesh.
+   *
+   * The other read_msh() functions read the whole file on every process and
+   * build a complete coarse mesh, which is only then partitioned, e.g., by
+   * TriangulationDescription::Utilities::create_description_from_triangulation().
+   * For large meshes, this limits the size of the meshes that can be used to
+   * the memory available to a single process. This function instead works as
+   * follows:
+   * - Process zero scans the file once and determines the byte offsets at
+   *   which each process's contiguous share of the nodes and elements starts.
+   *   Only these offsets, not the mesh itself, are kept in memory.
+   * - Each process seeks to its ranges and reads its nodes, cells, and
+   *   boundary faces. The cells become the locally owned cells of that
+   *   process, with the position of a cell among all cells of the file as
+   *   its coarse cell id.
+   * - Node coordinates, cells, and boundary faces are sent to a process
+   *   determined from the node tag, which is then queried to find the ghost
+   *   cells adjacent to the locally owned cells, the coordinates of all of
+   *   their vertices, and the boundary ids of their faces.
+   * - The resulting TriangulationDescription::Description is passed to
+   *   Triangulation::create_triangulation() of the triangulation attached to
+   *   this object, using its communicator.
+   *
+   * The function is intended for parallel::fullydistributed::Triangulation
+   * objects, but can also be used with a serial Triangulation, in which case
+   * the whole mesh is read by the one process.
+   *
+   * As in the other read_msh() functions, the physical tags of the entities
+   * are used as material ids of the cells and boundary ids of the faces. In
+   * contrast to them, the cells are used exactly as stored in the file,
+   * since reordering or inverting cells requires knowledge of the whole mesh:
+   * meshes of quadrilaterals or hexahedra need to be oriented consistently,
+   * as is the case for simplex meshes and for meshes written by deal.II. The
+   * partitioning follows the order of the cells in the file, so the file
+   * should store the cells in an order with good locality, as is the case
+   * for files written by Gmsh after renumbering the elements.
+   *
+   * Each line of the \$Nodes and \$Elements sections has to contain exactly
+   * one entry, which is how Gmsh writes these files.
+   *
+   * @ingroup simplex
+   */
+  void
+  read_msh_distributed(const std::string &filename);
+
   /**
    * Read grid data from a file containing tecplot ASCII data. This also works
    * in the absence of any tecplot installation.
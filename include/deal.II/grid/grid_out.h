@@ -1020,7 +1020,9 @@ public:
     /// write() calls write_vtk()
     vtk,
     /// write() calls write_vtu()
-    vtu
+    vtu,
+    /// write() calls write_binary()
+    binary
   };
 
   /**
@@ -1341,6 +1343,75 @@ public:
   void
   write_vtu(const Triangulation<dim, spacedim> &tria, std::ostream &out) const;
 
+  /**
+   * Write the triangulation in a binary format that can be read back with
+   * GridIn::read_binary(). In contrast to the text based formats, the
+   * vertex locations and integer ids are written in their native binary
+   * representation, which makes writing and reading large meshes
+   * considerably faster and, for the vertex locations, exact. The stream
+   * should be opened in binary mode.
+   *
+   * As for the other formats, only the active cells are written; they
+   * become the coarse cells of the triangulation read back in, so the
+   * triangulation must not have hanging nodes. In addition to the material,
+   * manifold, and subdomain ids of the cells, the boundary and manifold ids
+   * of their faces and edges are stored, including the boundary ids of the
+   * vertices in 1d.
+   *
+   * The file is split into sections, one per subdomain id of the active
+   * cells: section $p$ contains the cells with subdomain id $p$ and the
+   * layer of cells sharing a vertex with one of them, i.e., the locally
+   * owned and ghost cells of process $p$ if the subdomain ids describe a
+   * partitioning of the mesh, e.g., by GridTools::partition_triangulation().
+   * Each process can then read its own section with
+   * GridIn::read_binary_description() without looking at the rest of the
+   * file. Cells next to the boundary of a subdomain are stored in several
+   * sections. If the subdomain ids have not been set, all cells are in a
+   * single section.
+   *
+   * The file consists of a sequence of arrays, each of which is padded to
+   * a multiple of eight bytes:
+   * - A header: the eight characters `dealtria`, followed by four 32-bit
+   *   unsigned integers (the format version, the byte order mark
+   *   `0x01020304` to detect files written on machines with a different
+   *   byte order, `dim`, and `spacedim`), and three 64-bit unsigned
+   *   integers: the number of vertices, the number of cells, and the number
+   *   $n$ of sections.
+   * - The directory of sections: $n+1$ 64-bit byte offsets from the start
+   *   of the header, where entry $p$ is the start of section $p$ and the
+   *   last entry is the end of the file.
+   * - For each section, the following arrays:
+   *   - Three 64-bit integers: the number of vertices, cells, and vertex
+   *     indices of the cells of the section.
+   *   - The 64-bit global indices of the vertices of the section, in
+   *     ascending order, followed by their locations as `spacedim` doubles
+   *     per vertex.
+   *   - An offset table of 64-bit integers with one entry more than there
+   *     are cells, and the 32-bit vertex indices of all cells within the
+   *     section, where the ones of cell $i$ are stored at the positions
+   *     `offsets[i]` to `offsets[i+1]`.
+   *   - The 64-bit global indices of the cells, in ascending order, which is
+   *     the order of the cells in the triangulation written, followed by
+   *     their 32-bit subdomain ids, material ids, and manifold ids.
+   *   - The 32-bit boundary ids of the faces of the cells, with
+   *     GeometryInfo::faces_per_cell entries per cell, and, in 3d, the
+   *     boundary ids of their edges with GeometryInfo::lines_per_cell
+   *     entries per cell. Interior faces and edges as well as unused entries
+   *     of simplices have the id numbers::internal_face_boundary_id.
+   *   - In 2d and 3d, the 32-bit manifold ids of the edges of the cells with
+   *     GeometryInfo::lines_per_cell entries per cell, and, in 3d, the ones
+   *     of the faces with GeometryInfo::faces_per_cell entries per cell.
+   *
+   * Since the directory and the sizes of all arrays are stored in the file,
+   * the position of every entry can be computed without reading the
+   * preceding data. A program may therefore map the file into memory or
+   * seek directly to the section it is interested in.
+   */
+  template <int dim, int spacedim>
+  void
+  write_binary(const Triangulation<dim, spacedim> &tria,
+               std::ostream &                      out) const;
+
   /**
    * Write triangulation in VTU format for each processor, and add a .pvtu file
    * for visualization in VisIt or Paraview that describes the collection of VTU
@@ -22,6 +22,7 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parallel.h>
 #include <deal.II/base/smartpointer.h>
 #include <deal.II/base/template_constraints.h>
@@ -32,6 +33,7 @@
 #include <deal.II/lac/diagonal_matrix.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/lac/vector_memory.h>
+#include <deal.II/lac/vector_operations_internal.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -492,6 +494,19 @@ protected:
  *
  * solver.solve (A, x, b, precondition);
  * @endcode
+ *
+ * Matrix-free operators usually do not provide
+ * <tt>precondition_Jacobi()</tt> and <tt>Jacobi_step()</tt>. For
+ * LinearAlgebra::distributed::Vector on the host, this class instead works
+ * with operators that provide a function <tt>get_matrix_diagonal_inverse()</tt>
+ * returning a pointer to a DiagonalMatrix with the inverse diagonal (like
+ * MatrixFreeOperators::Base) together with a vmult() function that runs
+ * operations on ranges of the vectors before and after the matrix-vector
+ * product accesses them (see the documentation of SolverCG for the precise
+ * interface). In step(), the result vector of the product is then zeroed
+ * range by range inside the product, and the Jacobi update of the solution
+ * is performed on each range as soon as the product is done with it, i.e.,
+ * while the entries are still in cache.
  */
 template <typename MatrixType = SparseMatrix<double>>
 class PreconditionJacobi : public PreconditionRelaxation<MatrixType>
@@ -926,6 +941,47 @@ private:
  * if it is applied repeatedly, e.g. in a smoother for a geometric multigrid
  * solver, that can in turn be used to solve several linear systems.
  *
+ * As an alternative to the Lanczos iteration, the largest eigenvalue can be
+ * estimated by a power iteration on the preconditioned matrix, selected via
+ * PreconditionChebyshev::AdditionalData::eigenvalue_algorithm. Each step of
+ * the power iteration needs a single norm computation (i.e., one global
+ * reduction in parallel) and no inner products, but it converges more slowly
+ * than the Lanczos iteration and does not give an estimate of the smallest
+ * eigenvalue, so a smoothing range larger than one must be given. The last
+ * iterate of the power iteration is kept as an approximation of the
+ * eigenvector to the largest eigenvalue and is used as the initial vector
+ * for the next estimate of the same object, typically after the
+ * preconditioner has been re-initialized with a slightly different matrix.
+ * Such a warm-started estimate needs considerably fewer iterations.
+ *
+ * <h4>Reusing eigenvalue estimates</h4>
+ *
+ * In nonlinear problems, the matrix and thus the preconditioner are often
+ * rebuilt in every Newton step while the spectrum changes only slightly. If
+ * PreconditionChebyshev::AdditionalData::reuse_eigenvalue_estimates is set,
+ * a call to initialize() on an object that has already computed eigenvalue
+ * estimates for a matrix of the same size keeps these estimates and the
+ * resulting polynomial, i.e., no eigenvalue computation is done in the next
+ * vmult(). The estimates can be refreshed at any time by calling
+ * estimate_eigenvalues().
+ *
+ * For the smoothers on the levels of a multigrid hierarchy, the static
+ * function estimate_eigenvalues() taking a vector of preconditioners computes
+ * the estimates of all levels in one pass. For the power iteration, the
+ * iterations on all levels proceed in lockstep, such that the norms of all
+ * levels are combined into a single global reduction per iteration for
+ * LinearAlgebra::distributed::Vector, rather than one per level:
+ * @code
+ * std::vector<const SmootherType *> smoothers;
+ * std::vector<const VectorType *>   vectors;
+ * for (unsigned int level = min_level; level <= max_level; ++level)
+ *   {
+ *     smoothers.push_back(&mg_smoother.smoothers[level]);
+ *     vectors.push_back(&level_vectors[level]);
+ *   }
+ * SmootherType::estimate_eigenvalues(smoothers, vectors);
+ * @endcode
+ *
  * <h4>Bypassing the eigenvalue computation</h4>
  *
  * In some contexts, the automatic eigenvalue computation of this class may
@@ -937,6 +993,21 @@ private:
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
 
+ * <h4>Fusing the vector updates into the matrix-vector product</h4>
+ *
+ * For LinearAlgebra::distributed::Vector on the host and a DiagonalMatrix
+ * as the inner preconditioner, the vector updates of each Chebyshev step are
+ * done in a single sweep over the vectors. If the matrix additionally
+ * provides a vmult() function that runs operations on ranges of the vectors
+ * before and after the matrix-vector product accesses them (see the
+ * documentation of SolverCG for the precise interface, which is the one of
+ * MatrixFree::cell_loop() with an @p operation_before_loop and an
+ * @p operation_after_loop), the zeroing of the result vector and the update
+ * of the Chebyshev iterate are moved into the matrix-vector product. They
+ * then work on vector entries that were just accessed by the product and
+ * are still in cache, rather than in separate sweeps through main memory.
+ * This is used in vmult() and step(), but not in Tvmult() and Tstep().
+
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
  * If the range <tt>[max_eigenvalue/smoothing_range, max_eigenvalue]</tt>
@@ -1002,14 +1073,38 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * An enum to define the available algorithms for the estimation of the
+     * eigenvalues.
+     */
+    enum class EigenvalueAlgorithm
+    {
+      /**
+       * Lanczos iteration, run through SolverCG. This algorithm computes
+       * estimates for both the smallest and the largest eigenvalue.
+       */
+      lanczos,
+      /**
+       * Power iteration on the preconditioned matrix. This algorithm only
+       * estimates the largest eigenvalue and needs a smoothing range larger
+       * than one. It can be warm-started from the previous estimate, see
+       * the discussion in the main class.
+       */
+      power_iteration
+    };
+
     /**
      * Constructor.
      */
-    AdditionalData(const unsigned int degree              = 1,
-                   const double       smoothing_range     = 0.,
-                   const unsigned int eig_cg_n_iterations = 8,
-                   const double       eig_cg_residual     = 1e-2,
-                   const double       max_eigenvalue      = 1);
+    AdditionalData(
+      const unsigned int        degree              = 1,
+      const double              smoothing_range     = 0.,
+      const unsigned int        eig_cg_n_iterations = 8,
+      const double              eig_cg_residual     = 1e-2,
+      const double              max_eigenvalue      = 1,
+      const EigenvalueAlgorithm eigenvalue_algorithm =
+        EigenvalueAlgorithm::lanczos,
+      const bool reuse_eigenvalue_estimates = false);
 
     /**
      *  Copy assignment operator.
@@ -1045,7 +1140,9 @@ public:
 
     /**
      * Maximum number of CG iterations performed for finding the maximum
-     * eigenvalue. If set to zero, no computations are performed. Instead, the
+     * eigenvalue, or number of steps of the power iteration in case
+     * @p eigenvalue_algorithm is set to EigenvalueAlgorithm::power_iteration.
+     * If set to zero, no computations are performed. Instead, the
      * user must supply a largest eigenvalue via the variable
      * PreconditionChebyshev::AdditionalData::max_eigenvalue.
      */
@@ -1064,6 +1161,22 @@ public:
      */
     double max_eigenvalue;
 
+    /**
+     * The algorithm used for the estimation of the eigenvalues.
+     * Together with @p eig_cg_n_iterations, this variable controls the
+     * balance between the cost and the accuracy of the estimate.
+     */
+    EigenvalueAlgorithm eigenvalue_algorithm;
+
+    /**
+     * If set to true, a call to initialize() on an object that already holds
+     * eigenvalue estimates for a matrix of the same size keeps these
+     * estimates instead of recomputing them on the next application of the
+     * preconditioner. If @p degree is set to numbers::invalid_unsigned_int,
+     * the degree determined from the previous estimate is kept as well.
+     */
+    bool reuse_eigenvalue_estimates;
+
     /**
      * Constraints to be used for the operator given. This variable is used to
      * zero out the correct entries when creating an initial guess.
@@ -1158,7 +1271,8 @@ public:
      */
     double max_eigenvalue_estimate;
     /**
-     * Number of CG iterations performed or 0.
+     * Number of CG iterations (or steps of the power iteration) performed or
+     * 0.
      */
     unsigned int cg_iterations;
     /**
@@ -1188,11 +1302,50 @@ public:
    * computation. If the user set provided values for the largest eigenvalue
    * in AdditionalData, no computation is performed and the information given
    * by the user is used.
+   *
+   * This function can also be called explicitly after the eigenvalues have
+   * been computed, e.g. to refresh estimates that have been kept by
+   * initialize() according to AdditionalData::reuse_eigenvalue_estimates.
    */
   EigenvalueInformation
   estimate_eigenvalues(const VectorType &src) const;
 
+  /**
+   * Compute the eigenvalue estimates of several preconditioners in one pass,
+   * e.g. of the smoothers on all levels of a multigrid hierarchy. The vector
+   * <tt>src[i]</tt> gives the layout of the vectors for
+   * <tt>preconditioners[i]</tt>, as in the function above.
+   *
+   * The estimates with the Lanczos iteration are computed one after the
+   * other. The power iterations of all preconditioners, in contrast, proceed
+   * in lockstep, with the norms of all preconditioners computed together. For
+   * LinearAlgebra::distributed::Vector, this results in a single global
+   * reduction per iteration, provided that all vectors share the same MPI
+   * communicator.
+   */
+  static std::vector<EigenvalueInformation>
+  estimate_eigenvalues(
+    const std::vector<const PreconditionChebyshev *> &preconditioners,
+    const std::vector<const VectorType *> &           src);
+
 private:
+  /**
+   * Run the Lanczos iteration for the eigenvalue estimate, or use the
+   * eigenvalue given in the AdditionalData if no iterations are requested.
+   * Expects solution_old and temp_vector1 to be set up.
+   */
+  EigenvalueInformation
+  estimate_eigenvalues_lanczos() const;
+
+  /**
+   * Compute the factors theta and delta, as well as the degree if requested,
+   * from the eigenvalue estimates in @p info, and set up the temporary vectors
+   * for the layout given by @p src.
+   */
+  void
+  set_chebyshev_parameters(EigenvalueInformation &info,
+                           const VectorType &     src) const;
+
   /**
    * A pointer to the underlying matrix.
    */
@@ -1216,6 +1369,12 @@ private:
    */
   mutable VectorType temp_vector2;
 
+  /**
+   * The approximation of the eigenvector to the largest eigenvalue computed
+   * by the last power iteration, used as the initial vector of the next one.
+   */
+  mutable VectorType eigenvector_estimate;
+
   /**
    * Stores the additional data passed to the initialize function, obtained
    * through a copy operation.
@@ -1454,6 +1613,137 @@ PreconditionRelaxation<MatrixType>::n() const
 
 //---------------------------------------------------------------------------
 
+namespace internal
+{
+  namespace PreconditionRelaxationImplementation
+  {
+    // A helper type-trait that leverage SFINAE to figure out if type T has
+    // T::get_matrix_diagonal_inverse()
+    template <typename T>
+    struct has_get_matrix_diagonal_inverse
+    {
+    private:
+      static bool
+      detect(...);
+
+      template <typename U>
+      static decltype(std::declval<const U &>().get_matrix_diagonal_inverse())
+      detect(const U &);
+
+    public:
+      static const bool value =
+        !std::is_same<bool, decltype(detect(std::declval<T>()))>::value;
+    };
+
+    // Determine whether PreconditionJacobi should use the inverse diagonal
+    // of the matrix and the vmult() function with operations before and
+    // after the product, rather than the functions precondition_Jacobi()
+    // and Jacobi_step() of the matrix
+    template <typename MatrixType, typename VectorType>
+    struct use_matrix_free_jacobi : std::false_type
+    {};
+
+    template <typename MatrixType, typename Number>
+    struct use_matrix_free_jacobi<
+      MatrixType,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+      : std::integral_constant<
+          bool,
+          has_get_matrix_diagonal_inverse<MatrixType>::value &&
+            ::dealii::internal::has_vmult_with_std_functions<
+              MatrixType,
+              LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>::
+              value>
+    {};
+
+    template <typename MatrixType, typename VectorType>
+    inline void
+    jacobi_vmult(const MatrixType &A,
+                 VectorType &      dst,
+                 const VectorType &src,
+                 const double      relaxation,
+                 std::false_type)
+    {
+      A.precondition_Jacobi(dst, src, relaxation);
+    }
+
+    template <typename MatrixType, typename Number>
+    inline void
+    jacobi_vmult(
+      const MatrixType &                                                   A,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      dst,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &src,
+      const double relaxation,
+      std::true_type)
+    {
+      const auto &diagonal = A.get_matrix_diagonal_inverse()->get_vector();
+      AssertDimension(diagonal.locally_owned_size(), src.locally_owned_size());
+
+      const Number        omega        = relaxation;
+      const Number *const diagonal_ptr = diagonal.begin();
+      const Number *const src_ptr      = src.begin();
+      Number *const       dst_ptr      = dst.begin();
+      const unsigned int  n_owned_dofs = src.locally_owned_size();
+      DEAL_II_OPENMP_SIMD_PRAGMA
+      for (unsigned int i = 0; i < n_owned_dofs; ++i)
+        dst_ptr[i] = omega * diagonal_ptr[i] * src_ptr[i];
+    }
+
+    template <typename MatrixType, typename VectorType>
+    inline void
+    jacobi_step(const MatrixType &A,
+                VectorType &      dst,
+                const VectorType &src,
+                const double      relaxation,
+                std::false_type)
+    {
+      A.Jacobi_step(dst, src, relaxation);
+    }
+
+    // Jacobi step x = x + omega D^{-1} (b - A x) with the residual computed
+    // range by range inside the matrix-vector product
+    template <typename MatrixType, typename Number>
+    inline void
+    jacobi_step(
+      const MatrixType &                                                   A,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &      dst,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &src,
+      const double relaxation,
+      std::true_type)
+    {
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      const auto &diagonal = A.get_matrix_diagonal_inverse()->get_vector();
+      AssertDimension(diagonal.locally_owned_size(), src.locally_owned_size());
+
+      GrowingVectorMemory<VectorType>            memory;
+      typename VectorMemory<VectorType>::Pointer product_pointer(memory);
+      VectorType &                               product = *product_pointer;
+      product.reinit(dst, true);
+
+      const Number        omega        = relaxation;
+      const Number *const diagonal_ptr = diagonal.begin();
+      const Number *const rhs_ptr      = src.begin();
+      Number *const       solution_ptr = dst.begin();
+      Number *const       product_ptr  = product.begin();
+
+      A.vmult(
+        product,
+        dst,
+        [product_ptr](const unsigned int begin, const unsigned int end) {
+          std::fill(product_ptr + begin, product_ptr + end, Number());
+        },
+        [&](const unsigned int begin, const unsigned int end) {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (unsigned int i = begin; i < end; ++i)
+            solution_ptr[i] +=
+              omega * diagonal_ptr[i] * (rhs_ptr[i] - product_ptr[i]);
+        });
+    }
+  } // namespace PreconditionRelaxationImplementation
+} // namespace internal
+
 template <typename MatrixType>
 template <class VectorType>
 inline void
@@ -1466,7 +1756,15 @@ PreconditionJacobi<MatrixType>::vmult(VectorType &      dst,
     "PreconditionJacobi and VectorType must have the same size_type.");
 
   Assert(this->A != nullptr, ExcNotInitialized());
-  this->A->precondition_Jacobi(dst, src, this->relaxation);
+  internal::PreconditionRelaxationImplementation::jacobi_vmult(
+    *this->A,
+    dst,
+    src,
+    this->relaxation,
+    std::integral_constant<bool,
+                           internal::PreconditionRelaxationImplementation::
+                             use_matrix_free_jacobi<MatrixType,
+                                                    VectorType>::value>());
 }
 
 
@@ -1483,7 +1781,15 @@ PreconditionJacobi<MatrixType>::Tvmult(VectorType &      dst,
     "PreconditionJacobi and VectorType must have the same size_type.");
 
   Assert(this->A != nullptr, ExcNotInitialized());
-  this->A->precondition_Jacobi(dst, src, this->relaxation);
+  internal::PreconditionRelaxationImplementation::jacobi_vmult(
+    *this->A,
+    dst,
+    src,
+    this->relaxation,
+    std::integral_constant<bool,
+                           internal::PreconditionRelaxationImplementation::
+                             use_matrix_free_jacobi<MatrixType,
+                                                    VectorType>::value>());
 }
 
 
@@ -1500,7 +1806,15 @@ PreconditionJacobi<MatrixType>::step(VectorType &      dst,
     "PreconditionJacobi and VectorType must have the same size_type.");
 
   Assert(this->A != nullptr, ExcNotInitialized());
-  this->A->Jacobi_step(dst, src, this->relaxation);
+  internal::PreconditionRelaxationImplementation::jacobi_step(
+    *this->A,
+    dst,
+    src,
+    this->relaxation,
+    std::integral_constant<bool,
+                           internal::PreconditionRelaxationImplementation::
+                             use_matrix_free_jacobi<MatrixType,
+                                                    VectorType>::value>());
 }
 
 
@@ -2026,6 +2340,96 @@ namespace internal
         solution.swap(solution_old);
     }
 
+    // apply the matrix to the current iterate and perform the subsequent
+    // vector updates. This general variant performs a separate
+    // matrix-vector product and calls vector_updates()
+    template <typename MatrixType,
+              typename VectorType,
+              typename PreconditionerType>
+    inline void
+    vmult_and_update(const MatrixType &        matrix,
+                     const VectorType &        rhs,
+                     const PreconditionerType &preconditioner,
+                     const unsigned int        iteration_index,
+                     const double              factor1,
+                     const double              factor2,
+                     VectorType &              solution_old,
+                     VectorType &              temp_vector1,
+                     VectorType &              temp_vector2,
+                     VectorType &              solution)
+    {
+      matrix.vmult(temp_vector1, solution);
+      vector_updates(rhs,
+                     preconditioner,
+                     iteration_index,
+                     factor1,
+                     factor2,
+                     solution_old,
+                     temp_vector1,
+                     temp_vector2,
+                     solution);
+    }
+
+    // selection for diagonal matrix around parallel deal.II vector and a
+    // matrix that can run operations before and after the matrix-vector
+    // product on ranges of the vectors: the result vector is zeroed just
+    // before the product writes into it, and the vector updates are run on
+    // each range as soon as the product is done with it
+    template <typename MatrixType,
+              typename Number,
+              typename std::enable_if<
+                ::dealii::internal::has_vmult_with_std_functions<
+                  MatrixType,
+                  LinearAlgebra::distributed::
+                    Vector<Number, MemorySpace::Host>>::value,
+                int>::type = 0>
+    inline void
+    vmult_and_update(
+      const MatrixType &matrix,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &rhs,
+      const DiagonalMatrix<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>> &jacobi,
+      const unsigned int iteration_index,
+      const double       factor1,
+      const double       factor2,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &solution_old,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>
+        &temp_vector1,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &solution)
+    {
+      Assert(iteration_index > 0, ExcInternalError());
+
+      VectorUpdater<Number> upd(rhs.begin(),
+                                jacobi.get_vector().begin(),
+                                iteration_index,
+                                factor1,
+                                factor2,
+                                solution_old.begin(),
+                                temp_vector1.begin(),
+                                solution.begin());
+      Number *const product = temp_vector1.begin();
+      matrix.vmult(
+        temp_vector1,
+        solution,
+        [product](const unsigned int begin, const unsigned int end) {
+          std::fill(product + begin, product + end, Number());
+        },
+        [&upd](const unsigned int begin, const unsigned int end) {
+          upd.apply_to_subrange(begin, end);
+        });
+
+      // swap vectors x^{n+1}->x^{n}, given the updates in the function above
+      if (iteration_index == 1)
+        {
+          solution.swap(temp_vector1);
+          solution_old.swap(temp_vector1);
+        }
+      else
+        solution.swap(solution_old);
+    }
+
     template <typename MatrixType, typename PreconditionerType>
     inline void
     initialize_preconditioner(
@@ -2171,6 +2575,60 @@ namespace internal
 
       std::vector<double> values;
     };
+
+    // Compute the squares of the l2 norms of the given vectors
+    template <typename VectorType>
+    std::vector<double>
+    norms_sqr(const std::vector<VectorType *> &vectors)
+    {
+      std::vector<double> result(vectors.size());
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        result[i] = vectors[i]->norm_sqr();
+      return result;
+    }
+
+    // Same as above, but sum the local contributions of all vectors over the
+    // MPI processes in a single reduction if they share a communicator
+    template <typename Number>
+    std::vector<double>
+    norms_sqr(const std::vector<
+              LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> *>
+                &vectors)
+    {
+      std::vector<double> result(vectors.size());
+      if (vectors.empty())
+        return result;
+
+      const MPI_Comm &communicator = vectors[0]->get_mpi_communicator();
+      for (const auto vector : vectors)
+        if (vector->get_mpi_communicator() != communicator)
+          {
+            for (unsigned int i = 0; i < vectors.size(); ++i)
+              result[i] = vectors[i]->norm_sqr();
+            return result;
+          }
+
+      using RealType = typename numbers::NumberTraits<Number>::real_type;
+      const auto thread_loop_partitioner =
+        std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        {
+          RealType norm_sqr = 0;
+          ::dealii::internal::VectorOperations::Norm2<Number, RealType> norm2(
+            vectors[i]->begin());
+          ::dealii::internal::VectorOperations::parallel_reduce(
+            norm2,
+            0,
+            vectors[i]->locally_owned_size(),
+            norm_sqr,
+            thread_loop_partitioner);
+          result[i] = norm_sqr;
+        }
+      Utilities::MPI::sum(ArrayView<const double>(result),
+                          communicator,
+                          ArrayView<double>(result));
+      return result;
+    }
   } // namespace PreconditionChebyshevImplementation
 } // namespace internal
 
@@ -2178,16 +2636,21 @@ namespace internal
 
 template <typename MatrixType, class VectorType, typename PreconditionerType>
 inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
-  AdditionalData::AdditionalData(const unsigned int degree,
-                                 const double       smoothing_range,
-                                 const unsigned int eig_cg_n_iterations,
-                                 const double       eig_cg_residual,
-                                 const double       max_eigenvalue)
+  AdditionalData::AdditionalData(
+    const unsigned int        degree,
+    const double              smoothing_range,
+    const unsigned int        eig_cg_n_iterations,
+    const double              eig_cg_residual,
+    const double              max_eigenvalue,
+    const EigenvalueAlgorithm eigenvalue_algorithm,
+    const bool                reuse_eigenvalue_estimates)
   : degree(degree)
   , smoothing_range(smoothing_range)
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , eigenvalue_algorithm(eigenvalue_algorithm)
+  , reuse_eigenvalue_estimates(reuse_eigenvalue_estimates)
 {}
 
 
@@ -2199,12 +2662,14 @@ inline typename PreconditionChebyshev<MatrixType,
                   PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   AdditionalData::operator=(const AdditionalData &other_data)
 {
-  degree              = other_data.degree;
-  smoothing_range     = other_data.smoothing_range;
-  eig_cg_n_iterations = other_data.eig_cg_n_iterations;
-  eig_cg_residual     = other_data.eig_cg_residual;
-  max_eigenvalue      = other_data.max_eigenvalue;
-  preconditioner      = other_data.preconditioner;
+  degree                     = other_data.degree;
+  smoothing_range            = other_data.smoothing_range;
+  eig_cg_n_iterations        = other_data.eig_cg_n_iterations;
+  eig_cg_residual            = other_data.eig_cg_residual;
+  max_eigenvalue             = other_data.max_eigenvalue;
+  eigenvalue_algorithm       = other_data.eigenvalue_algorithm;
+  reuse_eigenvalue_estimates = other_data.reuse_eigenvalue_estimates;
+  preconditioner             = other_data.preconditioner;
   constraints.copy_from(other_data.constraints);
 
   return *this;
@@ -2232,13 +2697,27 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   const MatrixType &    matrix,
   const AdditionalData &additional_data)
 {
+  // the estimates of the previous matrix can only be kept if they have been
+  // computed for vectors of the right size
+  const bool keep_estimates = additional_data.reuse_eigenvalue_estimates &&
+                              eigenvalues_are_initialized &&
+                              solution_old.size() == matrix.m();
+  const unsigned int previous_degree = data.degree;
+
   matrix_ptr = &matrix;
   data       = additional_data;
   Assert(data.degree > 0,
          ExcMessage("The degree of the Chebyshev method must be positive."));
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner);
-  eigenvalues_are_initialized = false;
+
+  if (keep_estimates)
+    {
+      if (data.degree == numbers::invalid_unsigned_int)
+        data.degree = previous_degree;
+    }
+  else
+    eigenvalues_are_initialized = false;
 }
 
 
@@ -2255,6 +2734,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
     solution_old.reinit(empty_vector);
     temp_vector1.reinit(empty_vector);
     temp_vector2.reinit(empty_vector);
+    eigenvector_estimate.reinit(empty_vector);
   }
   data.preconditioner.reset();
 }
@@ -2268,15 +2748,170 @@ inline typename PreconditionChebyshev<MatrixType,
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   estimate_eigenvalues(const VectorType &src) const
 {
-  Assert(eigenvalues_are_initialized == false, ExcInternalError());
-  Assert(data.preconditioner.get() != nullptr, ExcNotInitialized());
+  return estimate_eigenvalues(
+           std::vector<const PreconditionChebyshev *>(1, this),
+           std::vector<const VectorType *>(1, &src))
+    .front();
+}
+
 
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline std::vector<
+  typename PreconditionChebyshev<MatrixType,
+                                 VectorType,
+                                 PreconditionerType>::EigenvalueInformation>
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  estimate_eigenvalues(
+    const std::vector<const PreconditionChebyshev *> &preconditioners,
+    const std::vector<const VectorType *> &           src)
+{
+  AssertDimension(preconditioners.size(), src.size());
+
+  std::vector<EigenvalueInformation> info(preconditioners.size());
+
+  // compute the estimates with the Lanczos iteration (or the ones given by
+  // the user) right away and collect the preconditioners that use the power
+  // iteration
+  std::vector<unsigned int> power_iteration_indices;
+  for (unsigned int i = 0; i < preconditioners.size(); ++i)
+    {
+      const PreconditionChebyshev &preconditioner = *preconditioners[i];
+      Assert(preconditioner.data.preconditioner.get() != nullptr,
+             ExcNotInitialized());
+
+      preconditioner.solution_old.reinit(*src[i]);
+      preconditioner.temp_vector1.reinit(*src[i], true);
+
+      if (preconditioner.data.eig_cg_n_iterations > 0 &&
+          preconditioner.data.eigenvalue_algorithm ==
+            AdditionalData::EigenvalueAlgorithm::power_iteration)
+        power_iteration_indices.push_back(i);
+      else
+        info[i] = preconditioner.estimate_eigenvalues_lanczos();
+    }
+
+  // run the power iterations of all remaining preconditioners in lockstep,
+  // such that the norms can be computed together. The iterate x is stored in
+  // temp_vector1 and the product A x in solution_old.
+  if (power_iteration_indices.empty() == false)
+    {
+      std::vector<VectorType *> iterates;
+      unsigned int              max_n_iterations = 0;
+      for (const unsigned int i : power_iteration_indices)
+        {
+          const PreconditionChebyshev &preconditioner = *preconditioners[i];
+          Assert(preconditioner.data.smoothing_range > 1.,
+                 ExcMessage("The power iteration only estimates the largest "
+                            "eigenvalue and needs a smoothing range larger "
+                            "than one."));
+          VectorType &x = preconditioner.temp_vector1;
+
+          // start from the eigenvector approximation of the previous power
+          // iteration if available, or from the initial guess also used for
+          // the Lanczos iteration otherwise
+          if (preconditioner.eigenvector_estimate.size() == x.size() &&
+              preconditioner.eigenvector_estimate.locally_owned_elements() ==
+                x.locally_owned_elements())
+            x.equ(1., preconditioner.eigenvector_estimate);
+          else
+            internal::PreconditionChebyshevImplementation::set_initial_guess(
+              x);
+          preconditioner.data.constraints.set_zero(x);
+
+          iterates.push_back(&x);
+          info[i].min_eigenvalue_estimate = info[i].max_eigenvalue_estimate =
+            1.;
+          max_n_iterations = std::max(max_n_iterations,
+                                      preconditioner.data.eig_cg_n_iterations);
+        }
+
+      std::vector<double> norms =
+        internal::PreconditionChebyshevImplementation::norms_sqr(iterates);
+      for (double &norm : norms)
+        norm = std::sqrt(norm);
+
+      for (unsigned int it = 0; it < max_n_iterations; ++it)
+        {
+          // preconditioners that have done all their iterations or have run
+          // into a zero vector are inactive
+          std::vector<unsigned int> active;
+          std::vector<VectorType *> active_iterates;
+          for (unsigned int j = 0; j < power_iteration_indices.size(); ++j)
+            {
+              const PreconditionChebyshev &preconditioner =
+                *preconditioners[power_iteration_indices[j]];
+              if (it < preconditioner.data.eig_cg_n_iterations &&
+                  norms[j] > 0.)
+                {
+                  preconditioner.matrix_ptr->vmult(preconditioner.solution_old,
+                                                   preconditioner.temp_vector1);
+                  preconditioner.data.preconditioner->vmult(
+                    preconditioner.temp_vector1, preconditioner.solution_old);
+                  active.push_back(j);
+                  active_iterates.push_back(&preconditioner.temp_vector1);
+                }
+            }
+          if (active.empty())
+            break;
+
+          const std::vector<double> new_norms =
+            internal::PreconditionChebyshevImplementation::norms_sqr(
+              active_iterates);
+          for (unsigned int k = 0; k < active.size(); ++k)
+            {
+              const unsigned int     j        = active[k];
+              const double           new_norm = std::sqrt(new_norms[k]);
+              EigenvalueInformation &result = info[power_iteration_indices[j]];
+              ++result.cg_iterations;
+              if (new_norm > 0.)
+                {
+                  result.max_eigenvalue_estimate = new_norm / norms[j];
+                  *active_iterates[k] *= 1. / new_norm;
+                  norms[j] = 1.;
+                }
+              else
+                norms[j] = 0.;
+            }
+        }
+
+      for (unsigned int j = 0; j < power_iteration_indices.size(); ++j)
+        {
+          const unsigned int           i = power_iteration_indices[j];
+          const PreconditionChebyshev &preconditioner = *preconditioners[i];
+
+          // keep the final iterate for warm-starting the next estimate
+          preconditioner.eigenvector_estimate.reinit(
+            preconditioner.temp_vector1, true);
+          preconditioner.eigenvector_estimate.equ(1.,
+                                                  preconditioner.temp_vector1);
+
+          // include the same safety factor as for the Lanczos iteration since
+          // the power iteration will in general not be converged
+          info[i].max_eigenvalue_estimate *= 1.2;
+          info[i].min_eigenvalue_estimate = info[i].max_eigenvalue_estimate /
+                                            preconditioner.data.smoothing_range;
+        }
+    }
+
+  for (unsigned int i = 0; i < preconditioners.size(); ++i)
+    preconditioners[i]->set_chebyshev_parameters(info[i], *src[i]);
+
+  return info;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline typename PreconditionChebyshev<MatrixType,
+                                      VectorType,
+                                      PreconditionerType>::EigenvalueInformation
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  estimate_eigenvalues_lanczos() const
+{
   PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
     EigenvalueInformation info{};
 
-  solution_old.reinit(src);
-  temp_vector1.reinit(src, true);
-
   if (data.eig_cg_n_iterations > 0)
     {
       Assert(data.eig_cg_n_iterations > 2,
@@ -2337,6 +2972,18 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
       info.min_eigenvalue_estimate = data.max_eigenvalue / data.smoothing_range;
     }
 
+
+  return info;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  set_chebyshev_parameters(EigenvalueInformation &info,
+                           const VectorType &     src) const
+{
   const double alpha = (data.smoothing_range > 1. ?
                           info.max_eigenvalue_estimate / data.smoothing_range :
                           std::min(0.9 * info.max_eigenvalue_estimate,
@@ -2395,8 +3042,6 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   const_cast<
     PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
     ->eigenvalues_are_initialized = true;
-
-  return info;
 }
 
 
@@ -2430,11 +3075,11 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         rhs,
         *data.preconditioner,
         k + 1,
@@ -2505,8 +3150,8 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  matrix_ptr->vmult(temp_vector1, solution);
-  internal::PreconditionChebyshevImplementation::vector_updates(
+  internal::PreconditionChebyshevImplementation::vmult_and_update(
+    *matrix_ptr,
     rhs,
     *data.preconditioner,
     1,
@@ -2523,11 +3168,11 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   double rhok = delta / theta, sigma = theta / delta;
   for (unsigned int k = 0; k < data.degree - 1; ++k)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
       const double rhokp   = 1. / (2. * sigma - rhok);
       const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
       rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
+      internal::PreconditionChebyshevImplementation::vmult_and_update(
+        *matrix_ptr,
         rhs,
         *data.preconditioner,
         k + 2,
@@ -0,0 +1,473 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_block_cg_h
+#define dealii_solver_block_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/numbers.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+template <typename number>
+class SparseMatrix;
+#endif
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the block Conjugate Gradients method, which solves
+ * a linear system with a symmetric positive definite matrix for several
+ * right hand sides at once. Here, "block" refers to the block of right hand
+ * sides that is iterated on simultaneously, not to block vectors or block
+ * matrices. The method builds a single Krylov space from the residuals of
+ * all right hand sides. It therefore typically needs fewer iterations than
+ * solving the systems one after the other with SolverCG, and it applies the
+ * matrix to all search directions at once: if the matrix class provides a
+ * function <tt>vmult(std::vector<VectorType> &, const std::vector<VectorType>
+ * &)</tt> like SparseMatrix::vmult(), the matrix entries only need to be
+ * loaded from memory once per iteration rather than once per right hand
+ * side. For all other matrix classes, and for the preconditioner, the
+ * vmult() functions are called for each vector in turn.
+ *
+ * The implementation follows the breakdown-free block CG method of H. Ji and
+ * Y. Li, "A breakdown-free block conjugate gradient method", BIT Numerical
+ * Mathematics 57 (2017), pp. 379-403. The search directions are
+ * orthonormalized in every iteration, and directions that have become
+ * linearly dependent (for example because the solution for one right hand
+ * side has converged, or because two right hand sides are equal) are
+ * removed. The threshold for this is given by
+ * AdditionalData::deflation_tolerance.
+ *
+ * The residual passed to the SolverControl object is the largest of the
+ * residual norms of the individual systems, i.e., the iteration stops once
+ * all systems are solved to the given tolerance. The vector passed to any
+ * additional slots connected via SolverBase::connect() is the current
+ * approximation of the first solution vector.
+ *
+ * The matrix and the preconditioner must be symmetric positive definite.
+ * The method is only implemented for real-valued vectors.
+ *
+ *
+ * <h3>Usage</h3>
+ *
+ * @code
+ * std::vector<Vector<double>> solutions(n_rhs, Vector<double>(n));
+ * std::vector<Vector<double>> right_hand_sides(n_rhs, Vector<double>(n));
+ * // ... fill right_hand_sides
+ *
+ * SolverControl                 control(1000, 1e-10);
+ * SolverBlockCG<Vector<double>> solver(control);
+ * solver.solve(system_matrix, solutions, right_hand_sides, preconditioner);
+ * @endcode
+ */
+template <typename VectorType = Vector<double>>
+class SolverBlockCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, search directions whose norm after
+     * orthogonalization against the other directions falls below
+     * $10^{-6}$ times the largest norm of a direction are removed.
+     */
+    explicit AdditionalData(const double deflation_tolerance = 1e-6);
+
+    /**
+     * Relative tolerance below which a search direction is considered
+     * linearly dependent on the others and is removed. Since the
+     * orthonormalization works on the matrix of inner products between the
+     * directions, values close to or below the square root of the machine
+     * precision keep directions that consist of roundoff only, which slows
+     * down convergence considerably.
+     */
+    double deflation_tolerance;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverBlockCG(SolverControl &           cn,
+                VectorMemory<VectorType> &mem,
+                const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverBlockCG(SolverControl &       cn,
+                const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverBlockCG() override = default;
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for all $x_i$ in @p x. The vectors
+   * in @p x are used as starting values and must have the same layout as
+   * the vectors in @p b.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &             A,
+        std::vector<VectorType> &      x,
+        const std::vector<VectorType> &b,
+        const PreconditionerType &     preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverBlockImplementation
+  {
+    /**
+     * Apply the matrix @p A to all vectors in @p src, one at a time.
+     */
+    template <typename MatrixType, typename VectorType>
+    void
+    vmult(const MatrixType &             A,
+          std::vector<VectorType> &      dst,
+          const std::vector<VectorType> &src)
+    {
+      for (unsigned int i = 0; i < src.size(); ++i)
+        A.vmult(dst[i], src[i]);
+    }
+
+
+
+    /**
+     * Apply a SparseMatrix to all vectors in @p src at once.
+     */
+    template <typename number, typename VectorType>
+    void
+    vmult(const SparseMatrix<number> &   A,
+          std::vector<VectorType> &      dst,
+          const std::vector<VectorType> &src)
+    {
+      A.vmult(dst, src);
+    }
+
+
+
+    /**
+     * Set <tt>dst[j] += factor * sum_i coefficients(i,j) * vectors[i]</tt>
+     * for all vectors in @p dst.
+     */
+    template <typename VectorType, typename number>
+    void
+    add_linear_combinations(std::vector<VectorType> &      dst,
+                            const FullMatrix<number> &     coefficients,
+                            const std::vector<VectorType> &vectors,
+                            const number                   factor)
+    {
+      AssertDimension(coefficients.m(), vectors.size());
+      AssertDimension(coefficients.n(), dst.size());
+      for (unsigned int j = 0; j < dst.size(); ++j)
+        {
+          unsigned int i = 0;
+          for (; i + 1 < vectors.size(); i += 2)
+            dst[j].add(factor * coefficients(i, j),
+                       vectors[i],
+                       factor * coefficients(i + 1, j),
+                       vectors[i + 1]);
+          if (i < vectors.size())
+            dst[j].add(factor * coefficients(i, j), vectors[i]);
+        }
+    }
+
+
+
+    /**
+     * Compute the matrix of inner products <tt>result(i,j) = left[i] *
+     * right[j]</tt>.
+     */
+    template <typename VectorType, typename number>
+    void
+    inner_products(const std::vector<VectorType> &left,
+                   const std::vector<VectorType> &right,
+                   FullMatrix<number> &           result)
+    {
+      result.reinit(left.size(), right.size());
+      for (unsigned int i = 0; i < left.size(); ++i)
+        for (unsigned int j = 0; j < right.size(); ++j)
+          result(i, j) = left[i] * right[j];
+    }
+
+
+
+    /**
+     * Fill @p dst with an orthonormal basis of the space spanned by the
+     * vectors in @p src, leaving out directions whose norm after
+     * orthogonalization against the previous ones is smaller than
+     * @p tolerance times the largest norm of the vectors in @p src. The
+     * basis is computed by a Cholesky factorization of the Gram matrix with
+     * diagonal pivoting, which selects the remaining vector with the largest
+     * component orthogonal to the basis so far in each step.
+     */
+    template <typename VectorType>
+    void
+    orthonormalize(const std::vector<VectorType> &src,
+                   std::vector<VectorType> &      dst,
+                   const double                   tolerance)
+    {
+      using number         = typename VectorType::value_type;
+      const unsigned int k = src.size();
+
+      FullMatrix<number> gram;
+      inner_products(src, src, gram);
+
+      // the diagonal of the remaining Schur complement and the rows of the
+      // Cholesky factor, with columns in the original order of the vectors
+      std::vector<number> remaining_norms_sqr(k);
+      for (unsigned int j = 0; j < k; ++j)
+        remaining_norms_sqr[j] = gram(j, j);
+      const number max_norm_sqr =
+        (k > 0 ? *std::max_element(remaining_norms_sqr.begin(),
+                                   remaining_norms_sqr.end()) :
+                 number());
+
+      FullMatrix<number>        factor(k, k);
+      std::vector<unsigned int> pivots;
+      std::vector<bool>         is_pivot(k, false);
+      while (pivots.size() < k)
+        {
+          unsigned int pivot = numbers::invalid_unsigned_int;
+          for (unsigned int j = 0; j < k; ++j)
+            if (!is_pivot[j] &&
+                (pivot == numbers::invalid_unsigned_int ||
+                 remaining_norms_sqr[j] > remaining_norms_sqr[pivot]))
+              pivot = j;
+          if (!(remaining_norms_sqr[pivot] >
+                tolerance * tolerance * max_norm_sqr))
+            break;
+
+          const unsigned int s = pivots.size();
+          factor(s, pivot)     = std::sqrt(remaining_norms_sqr[pivot]);
+          for (unsigned int j = 0; j < k; ++j)
+            if (!is_pivot[j] && j != pivot)
+              {
+                number entry = gram(pivot, j);
+                for (unsigned int t = 0; t < s; ++t)
+                  entry -= factor(t, pivot) * factor(t, j);
+                factor(s, j) = entry / factor(s, pivot);
+                remaining_norms_sqr[j] -= factor(s, j) * factor(s, j);
+              }
+          pivots.push_back(pivot);
+          is_pivot[pivot] = true;
+        }
+
+      // dst[s] = (src[pivots[s]] - sum_{t<s} factor(t,pivots[s]) dst[t]) /
+      //          factor(s,pivots[s])
+      const unsigned int old_size = dst.size();
+      dst.resize(pivots.size());
+      for (unsigned int s = old_size; s < dst.size(); ++s)
+        dst[s].reinit(src[0], true);
+      for (unsigned int s = 0; s < pivots.size(); ++s)
+        {
+          dst[s] = src[pivots[s]];
+          for (unsigned int t = 0; t < s; ++t)
+            dst[s].add(-factor(t, pivots[s]), dst[t]);
+          dst[s] /= factor(s, pivots[s]);
+        }
+    }
+  } // namespace SolverBlockImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverBlockCG<VectorType>::AdditionalData::AdditionalData(
+  const double deflation_tolerance)
+  : deflation_tolerance(deflation_tolerance)
+{}
+
+
+
+template <typename VectorType>
+SolverBlockCG<VectorType>::SolverBlockCG(SolverControl &           cn,
+                                         VectorMemory<VectorType> &mem,
+                                         const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverBlockCG<VectorType>::SolverBlockCG(SolverControl &       cn,
+                                         const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverBlockCG<VectorType>::solve(const MatrixType &             A,
+                                 std::vector<VectorType> &      x,
+                                 const std::vector<VectorType> &b,
+                                 const PreconditionerType &     preconditioner)
+{
+  using number = typename VectorType::value_type;
+  static_assert(numbers::NumberTraits<number>::is_complex == false,
+                "SolverBlockCG is only implemented for real-valued vectors.");
+
+  namespace Implementation = internal::SolverBlockImplementation;
+
+  AssertDimension(x.size(), b.size());
+  const unsigned int n_rhs = b.size();
+  if (n_rhs == 0)
+    return;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("block_cg");
+
+  // the residuals r, the preconditioned residuals z, the search directions
+  // p, and q=Ap. the latter two have as many vectors as there are linearly
+  // independent search directions. all of them are stored as vectors of
+  // vectors to allow the matrix to work on all of them at once
+  std::vector<VectorType> r(n_rhs), z(n_rhs), p, q;
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    {
+      r[j].reinit(x[j], true);
+      z[j].reinit(x[j], true);
+    }
+
+  const auto compute_residual_norm = [&r]() {
+    double max_norm = 0;
+    for (const VectorType &r_j : r)
+      max_norm = std::max<double>(max_norm, r_j.l2_norm());
+    return max_norm;
+  };
+
+  // compute residuals
+  Implementation::vmult(A, r, x);
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    r[j].sadd(-1., 1., b[j]);
+
+  double res = compute_residual_norm();
+  int    it  = 0;
+  conv       = this->iteration_status(0, res, x[0]);
+  if (conv != SolverControl::iterate)
+    {
+      AssertThrow(conv == SolverControl::success,
+                  SolverControl::NoConvergence(it, res));
+      return;
+    }
+
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    preconditioner.vmult(z[j], r[j]);
+  Implementation::orthonormalize(z, p, additional_data.deflation_tolerance);
+
+  FullMatrix<number> p_dot_q, p_dot_q_inverse, p_dot_r, q_dot_z;
+  FullMatrix<number> alpha, beta;
+
+  while (conv == SolverControl::iterate)
+    {
+      // if no linearly independent search directions are left although the
+      // residuals are not small enough, we cannot make any progress
+      if (p.size() == 0)
+        {
+          conv = SolverControl::failure;
+          break;
+        }
+
+      ++it;
+
+      q.resize(p.size());
+      for (unsigned int i = 0; i < p.size(); ++i)
+        if (q[i].size() != p[i].size())
+          q[i].reinit(p[i], true);
+      Implementation::vmult(A, q, p);
+
+      // alpha = (P^T A P)^{-1} P^T R
+      Implementation::inner_products(p, q, p_dot_q);
+      p_dot_q_inverse = p_dot_q;
+      p_dot_q_inverse.gauss_jordan();
+      Implementation::inner_products(p, r, p_dot_r);
+      alpha.reinit(p.size(), n_rhs);
+      p_dot_q_inverse.mmult(alpha, p_dot_r);
+
+      Implementation::add_linear_combinations(x, alpha, p, number(1.));
+      Implementation::add_linear_combinations(r, alpha, q, number(-1.));
+
+      res  = compute_residual_norm();
+      conv = this->iteration_status(it, res, x[0]);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // beta = -(P^T A P)^{-1} Q^T Z, and the new search directions are
+      // the orthonormalized columns of Z + P beta
+      for (unsigned int j = 0; j < n_rhs; ++j)
+        preconditioner.vmult(z[j], r[j]);
+      Implementation::inner_products(q, z, q_dot_z);
+      beta.reinit(p.size(), n_rhs);
+      p_dot_q_inverse.mmult(beta, q_dot_z);
+
+      Implementation::add_linear_combinations(z, beta, p, number(-1.));
+      Implementation::orthonormalize(z, p, additional_data.deflation_tolerance);
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
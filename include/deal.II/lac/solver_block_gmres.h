@@ -0,0 +1,411 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_block_gmres_h
+#define dealii_solver_block_gmres_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/numbers.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/householder.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_block_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the restarted block GMRES method, which solves a
+ * linear system with a general (not necessarily symmetric) matrix for
+ * several right hand sides at once. As for SolverBlockCG, "block" refers to
+ * the block of right hand sides that is iterated on simultaneously. The
+ * method builds a single Krylov space from the residuals of all right hand
+ * sides and applies the matrix to a whole block of basis vectors in each
+ * iteration, using a function <tt>vmult(std::vector<VectorType> &, const
+ * std::vector<VectorType> &)</tt> like SparseMatrix::vmult() if the matrix
+ * class provides one.
+ *
+ * The preconditioner is applied from the right, such that the residuals
+ * minimized by the method are the residuals of the original systems. In
+ * each iteration, the new block of basis vectors is orthogonalized against
+ * the previous ones by two passes of block Gram-Schmidt, and
+ * orthonormalized within itself. Directions that have become linearly
+ * dependent, for example because two right hand sides are equal or because
+ * the Krylov space contains the solution for one of the systems, are
+ * removed, using the threshold AdditionalData::deflation_tolerance. The
+ * method is restarted once the basis would exceed
+ * AdditionalData::max_basis_size vectors. At least one block of basis
+ * vectors is added per restart cycle, regardless of this size.
+ *
+ * The residual passed to the SolverControl object is the largest of the
+ * residual norms of the individual systems. Within a restart cycle, these
+ * norms are the ones of the small least-squares problems the method solves,
+ * whereas the residuals are computed explicitly at the end of each cycle.
+ * The vector passed to any additional slots connected via
+ * SolverBase::connect() is the approximation of the first solution vector
+ * at the start of the current restart cycle.
+ *
+ * The method is only implemented for real-valued vectors.
+ *
+ *
+ * <h3>Usage</h3>
+ *
+ * @code
+ * std::vector<Vector<double>> solutions(n_rhs, Vector<double>(n));
+ * std::vector<Vector<double>> right_hand_sides(n_rhs, Vector<double>(n));
+ * // ... fill right_hand_sides
+ *
+ * SolverControl                    control(1000, 1e-10);
+ * SolverBlockGMRES<Vector<double>> solver(control);
+ * solver.solve(system_matrix, solutions, right_hand_sides, preconditioner);
+ * @endcode
+ */
+template <typename VectorType = Vector<double>>
+class SolverBlockGMRES : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, the method is restarted once the basis
+     * would exceed 30 vectors, and basis vectors whose norm after
+     * orthogonalization falls below $10^{-6}$ times their norm before
+     * orthogonalization are removed.
+     */
+    explicit AdditionalData(const unsigned int max_basis_size      = 30,
+                            const double       deflation_tolerance = 1e-6);
+
+    /**
+     * Maximal number of basis vectors of the Krylov space, summed over all
+     * blocks, before the method is restarted.
+     */
+    unsigned int max_basis_size;
+
+    /**
+     * Relative tolerance below which a new basis vector is considered
+     * linearly dependent on the others and is removed.
+     */
+    double deflation_tolerance;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverBlockGMRES(SolverControl &           cn,
+                   VectorMemory<VectorType> &mem,
+                   const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverBlockGMRES(SolverControl &       cn,
+                   const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverBlockGMRES() override = default;
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for all $x_i$ in @p x. The vectors
+   * in @p x are used as starting values and must have the same layout as
+   * the vectors in @p b.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &             A,
+        std::vector<VectorType> &      x,
+        const std::vector<VectorType> &b,
+        const PreconditionerType &     preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename VectorType>
+SolverBlockGMRES<VectorType>::AdditionalData::AdditionalData(
+  const unsigned int max_basis_size,
+  const double       deflation_tolerance)
+  : max_basis_size(max_basis_size)
+  , deflation_tolerance(deflation_tolerance)
+{}
+
+
+
+template <typename VectorType>
+SolverBlockGMRES<VectorType>::SolverBlockGMRES(SolverControl &           cn,
+                                               VectorMemory<VectorType> &mem,
+                                               const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverBlockGMRES<VectorType>::SolverBlockGMRES(SolverControl &       cn,
+                                               const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverBlockGMRES<VectorType>::solve(
+  const MatrixType &             A,
+  std::vector<VectorType> &      x,
+  const std::vector<VectorType> &b,
+  const PreconditionerType &     preconditioner)
+{
+  using number = typename VectorType::value_type;
+  static_assert(
+    numbers::NumberTraits<number>::is_complex == false,
+    "SolverBlockGMRES is only implemented for real-valued vectors.");
+
+  namespace Implementation = internal::SolverBlockImplementation;
+
+  AssertDimension(x.size(), b.size());
+  const unsigned int n_rhs = b.size();
+  if (n_rhs == 0)
+    return;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("block_gmres");
+
+  // the residuals r, the blocks of basis vectors of the Krylov space, and
+  // temporary vectors z (preconditioned basis vectors or the update of the
+  // solution) and w (the new basis vectors before orthonormalization)
+  std::vector<VectorType> r(n_rhs), z, w;
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    r[j].reinit(x[j], true);
+  std::vector<std::vector<VectorType>> basis;
+
+  const auto resize_like = [&x](std::vector<VectorType> &vectors,
+                                const unsigned int       size) {
+    const unsigned int old_size = vectors.size();
+    vectors.resize(size);
+    for (unsigned int i = old_size; i < size; ++i)
+      vectors[i].reinit(x[0], true);
+  };
+
+  const auto compute_residual = [&]() {
+    Implementation::vmult(A, r, x);
+    double max_norm = 0;
+    for (unsigned int j = 0; j < n_rhs; ++j)
+      {
+        r[j].sadd(-1., 1., b[j]);
+        max_norm = std::max<double>(max_norm, r[j].l2_norm());
+      }
+    return max_norm;
+  };
+
+  double res = compute_residual();
+  int    it  = 0;
+  conv       = this->iteration_status(0, res, x[0]);
+  if (conv != SolverControl::iterate)
+    {
+      AssertThrow(conv == SolverControl::success,
+                  SolverControl::NoConvergence(it, res));
+      return;
+    }
+
+  // the block Hessenberg matrix, whose size is bounded by the number of
+  // basis vectors of one restart cycle. the basis must have room for at
+  // least two blocks
+  const unsigned int max_basis_size =
+    std::max(additional_data.max_basis_size, 2 * n_rhs);
+  FullMatrix<number> hessenberg(max_basis_size, max_basis_size);
+
+  FullMatrix<number> coefficients, rhs_coefficients, y;
+  Vector<number>     ls_rhs, ls_solution;
+
+  while (conv == SolverControl::iterate)
+    {
+      // start a new cycle with the orthonormalized residuals. the columns of
+      // rhs_coefficients contain the residuals in this basis
+      basis.resize(1);
+      Implementation::orthonormalize(r,
+                                     basis[0],
+                                     additional_data.deflation_tolerance);
+      if (basis[0].size() == 0)
+        {
+          conv = SolverControl::failure;
+          break;
+        }
+      Implementation::inner_products(basis[0], r, rhs_coefficients);
+
+      hessenberg = number();
+
+      // index of the first vector of each block within the whole basis
+      std::vector<unsigned int> block_start = {
+        0, static_cast<unsigned int>(basis[0].size())};
+
+      while (true)
+        {
+          ++it;
+
+          // w = A P^{-1} V_m
+          const unsigned int m = basis.size() - 1;
+          resize_like(z, basis[m].size());
+          resize_like(w, basis[m].size());
+          for (unsigned int i = 0; i < basis[m].size(); ++i)
+            preconditioner.vmult(z[i], basis[m][i]);
+          Implementation::vmult(A, w, z);
+
+          double norm_before = 0;
+          for (const VectorType &w_i : w)
+            norm_before = std::max<double>(norm_before, w_i.l2_norm());
+
+          // block Gram-Schmidt against the previous blocks, applied twice to
+          // keep the basis orthogonal up to roundoff
+          for (unsigned int pass = 0; pass < 2; ++pass)
+            for (unsigned int l = 0; l <= m; ++l)
+              {
+                Implementation::inner_products(basis[l], w, coefficients);
+                Implementation::add_linear_combinations(w,
+                                                        coefficients,
+                                                        basis[l],
+                                                        number(-1.));
+                for (unsigned int i = 0; i < coefficients.m(); ++i)
+                  for (unsigned int j = 0; j < coefficients.n(); ++j)
+                    hessenberg(block_start[l] + i, block_start[m] + j) +=
+                      coefficients(i, j);
+              }
+
+          // orthonormalize the new block within itself. the deflation
+          // tolerance refers to the norm before orthogonalization, such that
+          // a block consisting of roundoff is removed entirely
+          double norm_after = 0;
+          for (const VectorType &w_i : w)
+            norm_after = std::max<double>(norm_after, w_i.l2_norm());
+          basis.emplace_back();
+          if (norm_after > additional_data.deflation_tolerance * norm_before)
+            Implementation::orthonormalize(
+              w,
+              basis.back(),
+              additional_data.deflation_tolerance * norm_before / norm_after);
+          Implementation::inner_products(basis.back(), w, coefficients);
+          for (unsigned int i = 0; i < coefficients.m(); ++i)
+            for (unsigned int j = 0; j < coefficients.n(); ++j)
+              hessenberg(block_start[m + 1] + i, block_start[m] + j) =
+                coefficients(i, j);
+          block_start.push_back(block_start[m + 1] + basis.back().size());
+
+          // solve the least-squares problems min |E_1 S - H y| for all right
+          // hand sides with a QR decomposition of the Hessenberg matrix
+          const unsigned int n_cols = block_start[m + 1];
+          const unsigned int n_rows = block_start[m + 2];
+          coefficients.reinit(n_rows, n_cols);
+          coefficients.fill(hessenberg);
+          Householder<number> qr(coefficients);
+
+          y.reinit(n_cols, n_rhs);
+          ls_rhs.reinit(n_rows);
+          ls_solution.reinit(n_cols);
+          res = 0;
+          for (unsigned int j = 0; j < n_rhs; ++j)
+            {
+              ls_rhs = number();
+              for (unsigned int i = 0; i < rhs_coefficients.m(); ++i)
+                ls_rhs(i) = rhs_coefficients(i, j);
+              res = std::max(res, qr.least_squares(ls_solution, ls_rhs));
+              for (unsigned int i = 0; i < n_cols; ++i)
+                y(i, j) = ls_solution(i);
+            }
+
+          conv = this->iteration_status(it, res, x[0]);
+          if (conv != SolverControl::iterate || basis.back().size() == 0 ||
+              n_rows + basis.back().size() > max_basis_size)
+            break;
+        }
+
+      // x += P^{-1} V y, where the preconditioner is applied once per right
+      // hand side to the combination of the basis vectors
+      resize_like(w, n_rhs);
+      resize_like(z, n_rhs);
+      for (unsigned int j = 0; j < n_rhs; ++j)
+        w[j] = number();
+      for (unsigned int l = 0; l + 1 < basis.size(); ++l)
+        {
+          coefficients.reinit(basis[l].size(), n_rhs);
+          for (unsigned int i = 0; i < basis[l].size(); ++i)
+            for (unsigned int j = 0; j < n_rhs; ++j)
+              coefficients(i, j) = y(block_start[l] + i, j);
+          Implementation::add_linear_combinations(w,
+                                                  coefficients,
+                                                  basis[l],
+                                                  number(1.));
+        }
+      for (unsigned int j = 0; j < n_rhs; ++j)
+        {
+          preconditioner.vmult(z[j], w[j]);
+          x[j] += z[j];
+        }
+
+      // with right preconditioning, the residuals of the least-squares
+      // problems are the residuals of the updated solution, so convergence
+      // has already been checked in the last step. the next cycle starts
+      // from the explicitly computed residuals to avoid accumulating
+      // roundoff
+      if (conv == SolverControl::iterate)
+        compute_residual();
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -21,12 +21,18 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
+#include <deal.II/lac/vector_operations_internal.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -34,6 +40,16 @@ DEAL_II_NAMESPACE_OPEN
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+template <typename VectorType>
+class DiagonalMatrix;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
 #endif
 
 
@@ -90,6 +106,39 @@ class PreconditionIdentity;
  * The solve() function of this class uses the mechanism described in the
  * Solver base class to determine convergence. This mechanism can also be used
  * to observe the progress of the iteration.
+ *
+ * <h3>Fusing the vector updates into the matrix-vector product</h3>
+ *
+ * Each iteration of CG applies the preconditioner and the matrix once, and
+ * performs a handful of vector updates and inner products, each of which
+ * reads the vectors from main memory again. For matrix-free operators, the
+ * vector operations therefore often take as much time as the operator
+ * evaluation itself. If the matrix provides a function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int,
+ *                                     const unsigned int)> &operation_before,
+ *            const std::function<void(const unsigned int,
+ *                                     const unsigned int)> &operation_after)
+ *   const;
+ * @endcode
+ * the vector type is LinearAlgebra::distributed::Vector on the host, and the
+ * preconditioner is either a PreconditionIdentity or a DiagonalMatrix, the
+ * solver instead updates the search direction inside the matrix-vector
+ * product and performs the remaining updates and inner products in a single
+ * additional sweep over the vectors. Such a matrix must call
+ * @p operation_before on ranges <tt>[begin, end)</tt> of the locally owned
+ * entries (in the MPI-local numbering of the vectors) before it reads the
+ * respective entries of @p src or writes into @p dst, and @p operation_after
+ * on ranges it will neither read from @p src nor write into @p dst anymore,
+ * i.e., where @p dst holds its final values. The ranges passed to each of
+ * the two functions must cover all locally owned entries exactly once. The
+ * product must not zero @p dst, this is done by @p operation_before. This is
+ * the interface of MatrixFree::cell_loop() with the arguments
+ * @p operation_before_loop and @p operation_after_loop, i.e., a matrix-free
+ * operator only needs to forward the two functions to the cell loop. The
+ * iterates are the same as the ones of the general algorithm up to roundoff.
  */
 template <typename VectorType = Vector<double>>
 class SolverCG : public SolverBase<VectorType>
@@ -231,12 +280,483 @@ protected:
     all_eigenvalues_signal;
 };
 
+
+
+/**
+ * This class implements the pipelined variant of the preconditioned
+ * Conjugate Gradients method by P. Ghysels and W. Vanroose, "Hiding global
+ * synchronization latency in the preconditioned Conjugate Gradient
+ * algorithm", Parallel Computing 40 (2014), pp. 224-238. In exact
+ * arithmetic, it computes the same iterates as SolverCG.
+ *
+ * The method rearranges the recurrences of the CG method such that the
+ * three inner products of one iteration, $(r,u)$, $(w,u)$, and $(r,r)$,
+ * are independent of the application of the preconditioner and the matrix
+ * in the same iteration. This has two advantages over SolverCG:
+ * <ol>
+ * <li> For LinearAlgebra::distributed::Vector, the inner products are
+ * combined into a single non-blocking reduction (<tt>MPI_Iallreduce</tt>),
+ * which is in flight while the preconditioner and the matrix are applied.
+ * SolverCG instead performs two blocking reductions per iteration plus one
+ * for the residual norm. This hides the latency of the global
+ * communication, which often limits the scalability of CG on large numbers
+ * of processes.
+ * <li> For dealii::Vector and LinearAlgebra::distributed::Vector on the
+ * host, all vector updates of one iteration and the inner products for the
+ * next one are fused into a single sweep over the vectors, see
+ * internal::VectorOperations::PipelinedCGUpdate. For other vector types,
+ * the updates are performed with the usual vector operations and the inner
+ * products are computed with blocking reductions.
+ * </ol>
+ *
+ * The price is that the method needs nine auxiliary vectors instead of
+ * three, the residual norm used for the convergence test is computed by a
+ * recurrence rather than the definition (which can make the attainable
+ * accuracy somewhat worse than for SolverCG), and the preconditioner and
+ * the matrix are applied one more time than the number of iterations.
+ * Therefore, this solver only pays off when the global reductions are
+ * expensive compared to the application of the matrix and the
+ * preconditioner, i.e., for large numbers of MPI processes with few
+ * unknowns per process.
+ *
+ * Like SolverCG, this class requires a symmetric positive definite matrix
+ * and a symmetric preconditioner. The signals for the CG coefficients, the
+ * eigenvalue estimates, and the condition number estimates of the base class
+ * are supported as well.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  using AdditionalData = typename SolverCG<VectorType>::AdditionalData;
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+};
+
 /*@}*/
 
 /*------------------------- Implementation ----------------------------*/
 
 #ifndef DOXYGEN
 
+namespace internal
+{
+  /**
+   * A type trait that determines whether the matrix type @p MatrixType
+   * provides a function
+   * <tt>vmult(VectorType &, const VectorType &, const std::function<void(
+   * const unsigned int, const unsigned int)> &, const std::function<void(
+   * const unsigned int, const unsigned int)> &)</tt> that calls the two
+   * functions on ranges of the vectors before and after the matrix-vector
+   * product accesses them, see the documentation of SolverCG. This is used
+   * by SolverCG, PreconditionChebyshev, and PreconditionJacobi to fuse
+   * their vector updates into the matrix-vector product.
+   */
+  template <typename MatrixType, typename VectorType>
+  struct has_vmult_with_std_functions
+  {
+  private:
+    static bool
+    detect(...);
+
+    template <typename U>
+    static decltype(std::declval<const U &>().vmult(
+      std::declval<VectorType &>(),
+      std::declval<const VectorType &>(),
+      std::declval<
+        const std::function<void(const unsigned int, const unsigned int)> &>(),
+      std::declval<
+        const std::function<void(const unsigned int, const unsigned int)> &>()))
+    detect(const U &);
+
+  public:
+    static const bool value =
+      !std::is_same<bool, decltype(detect(std::declval<MatrixType>()))>::value;
+  };
+
+
+
+  namespace SolverCGImplementation
+  {
+    /**
+     * The application of the preconditioner and the matrix as well as the
+     * vector updates of one iteration of SolverCG. This general version
+     * calls the functions of the preconditioner, the matrix, and the vector
+     * class one after the other.
+     */
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType,
+              typename = void>
+    class CGWorker
+    {
+    public:
+      using number = typename VectorType::value_type;
+
+      CGWorker(const MatrixType &A, const PreconditionerType &preconditioner)
+        : A(A)
+        , preconditioner(preconditioner)
+      {}
+
+      /**
+       * Return the norm of the initial residual @p g.
+       */
+      double
+      initial_residual_norm(const VectorType &g)
+      {
+        return g.l2_norm();
+      }
+
+      /**
+       * Apply the preconditioner to the residual, $h = P g$, and return the
+       * inner product $(g, P g)$.
+       */
+      number
+      apply_preconditioner(const VectorType &g,
+                           VectorType &      h,
+                           const double      residual_norm)
+      {
+        if (is_identity)
+          return residual_norm * residual_norm;
+
+        preconditioner.vmult(h, g);
+        return g * h;
+      }
+
+      /**
+       * Update the search direction, $d = -P g + \beta d$, with $P g$ as
+       * computed by apply_preconditioner(), compute $h = A d$, and return
+       * the inner product $(d, A d)$. In the first iteration, @p d is not
+       * initialized and only set to $-P g$.
+       */
+      number
+      update_direction_and_vmult(const bool        first_iteration,
+                                 const number      beta,
+                                 const VectorType &g,
+                                 VectorType &      d,
+                                 VectorType &      h)
+      {
+        const VectorType &preconditioned_residual = is_identity ? g : h;
+        if (first_iteration)
+          d.equ(-1., preconditioned_residual);
+        else
+          d.sadd(beta, -1., preconditioned_residual);
+
+        A.vmult(h, d);
+        return d * h;
+      }
+
+      /**
+       * Update the solution, $x = x + \alpha d$, and the residual,
+       * $g = g + \alpha h$, and return the norm of the new residual.
+       */
+      double
+      update_solution(const number      alpha,
+                      VectorType &      x,
+                      VectorType &      g,
+                      const VectorType &d,
+                      const VectorType &h)
+      {
+        x.add(alpha, d);
+        return std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      }
+
+    private:
+      static constexpr bool is_identity =
+        std::is_same<PreconditionerType, PreconditionIdentity>::value;
+
+      const MatrixType &        A;
+      const PreconditionerType &preconditioner;
+    };
+
+
+
+    /**
+     * Return a pointer to the entries of the diagonal of a DiagonalMatrix
+     * used as a preconditioner, or a null pointer for PreconditionIdentity.
+     */
+    template <typename Number, typename VectorType>
+    const Number *
+    get_diagonal_entries(const DiagonalMatrix<VectorType> &preconditioner)
+    {
+      return preconditioner.get_vector().begin();
+    }
+
+    template <typename Number>
+    const Number *
+    get_diagonal_entries(const PreconditionIdentity &)
+    {
+      return nullptr;
+    }
+
+
+
+    /**
+     * Specialization of CGWorker for LinearAlgebra::distributed::Vector on
+     * the host, a matrix that provides the vmult() function with the
+     * additional operations before and after the product (see the
+     * documentation of SolverCG), and a diagonal or identity preconditioner.
+     * The update of the search direction and the inner product $(d, A d)$
+     * are computed inside the matrix-vector product on ranges of the vectors
+     * that are in cache, and the remaining updates and inner products of an
+     * iteration are fused into a single sweep.
+     */
+    template <typename Number, typename MatrixType, typename PreconditionerType>
+    class CGWorker<
+      LinearAlgebra::distributed::Vector<Number, ::dealii::MemorySpace::Host>,
+      MatrixType,
+      PreconditionerType,
+      typename std::enable_if<
+        has_vmult_with_std_functions<
+          MatrixType,
+          LinearAlgebra::distributed::
+            Vector<Number, ::dealii::MemorySpace::Host>>::value &&
+        (std::is_same<PreconditionerType, PreconditionIdentity>::value ||
+         std::is_same<PreconditionerType,
+                      DiagonalMatrix<LinearAlgebra::distributed::Vector<
+                        Number,
+                        ::dealii::MemorySpace::Host>>>::value)>::type>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number,
+                                           ::dealii::MemorySpace::Host>;
+
+      CGWorker(const MatrixType &A, const PreconditionerType &preconditioner)
+        : A(A)
+        , diagonal(get_diagonal_entries<Number>(preconditioner))
+        , g_dot_pg(Number())
+        , n_range_sums(0)
+        , thread_loop_partitioner(
+            std::make_shared<::dealii::parallel::internal::TBBPartitioner>())
+      {}
+
+      double
+      initial_residual_norm(const VectorType &g)
+      {
+        return compute_residual_norm(g);
+      }
+
+      Number
+      apply_preconditioner(const VectorType &, VectorType &, const double)
+      {
+        // the inner product (g, P g) has been computed together with the
+        // norm of the residual, and P g is computed on the fly in
+        // update_direction_and_vmult()
+        return g_dot_pg;
+      }
+
+      Number
+      update_direction_and_vmult(const bool        first_iteration,
+                                 const Number      beta,
+                                 const VectorType &g,
+                                 VectorType &      d,
+                                 VectorType &      h)
+      {
+        const Number *const g_ptr    = g.begin();
+        Number *const       d_ptr    = d.begin();
+        Number *const       h_ptr    = h.begin();
+        const Number *const diagonal = this->diagonal;
+
+        n_range_sums = 0;
+
+        A.vmult(
+          h,
+          d,
+          [&](const unsigned int begin, const unsigned int end) {
+            if (first_iteration)
+              {
+                if (diagonal != nullptr)
+                  {
+                    DEAL_II_OPENMP_SIMD_PRAGMA
+                    for (unsigned int i = begin; i < end; ++i)
+                      d_ptr[i] = -diagonal[i] * g_ptr[i];
+                  }
+                else
+                  {
+                    DEAL_II_OPENMP_SIMD_PRAGMA
+                    for (unsigned int i = begin; i < end; ++i)
+                      d_ptr[i] = -g_ptr[i];
+                  }
+              }
+            else
+              {
+                if (diagonal != nullptr)
+                  {
+                    DEAL_II_OPENMP_SIMD_PRAGMA
+                    for (unsigned int i = begin; i < end; ++i)
+                      d_ptr[i] = beta * d_ptr[i] - diagonal[i] * g_ptr[i];
+                  }
+                else
+                  {
+                    DEAL_II_OPENMP_SIMD_PRAGMA
+                    for (unsigned int i = begin; i < end; ++i)
+                      d_ptr[i] = beta * d_ptr[i] - g_ptr[i];
+                  }
+              }
+            std::fill(h_ptr + begin, h_ptr + end, Number());
+          },
+          [&](const unsigned int begin, const unsigned int end) {
+            // the ranges are processed concurrently if the matrix-vector
+            // product is thread-parallel, so each range stores its sum in a
+            // slot of its own
+            const unsigned int slot = n_range_sums++;
+            if (slot < range_sums.size())
+              {
+                range_sums[slot].first  = begin;
+                range_sums[slot].second = Number();
+                dealii::internal::VectorOperations::accumulate_recursive(
+                  dealii::internal::VectorOperations::Dot<Number, Number>(
+                    d_ptr, h_ptr),
+                  begin,
+                  end,
+                  range_sums[slot].second);
+              }
+          });
+
+        Number d_dot_h = Number();
+        if (n_range_sums <= range_sums.size())
+          {
+            // add the sums in the order of the ranges to get the same result
+            // regardless of the order in which the ranges were processed
+            std::sort(range_sums.begin(),
+                      range_sums.begin() + n_range_sums,
+                      [](const std::pair<unsigned int, Number> &a,
+                         const std::pair<unsigned int, Number> &b) {
+                        return a.first < b.first;
+                      });
+            for (unsigned int i = 0; i < n_range_sums; ++i)
+              d_dot_h += range_sums[i].second;
+          }
+        else
+          {
+            // there were more ranges than slots, as in the first iteration.
+            // compute the inner product in a separate sweep and provide
+            // enough slots for the next iterations
+            range_sums.resize(n_range_sums);
+            dealii::internal::VectorOperations::Dot<Number, Number> d_dot_h_op(
+              d_ptr, h_ptr);
+            dealii::internal::VectorOperations::parallel_reduce(
+              d_dot_h_op,
+              0,
+              d.locally_owned_size(),
+              d_dot_h,
+              thread_loop_partitioner);
+          }
+
+        return Utilities::MPI::sum(d_dot_h, d.get_mpi_communicator());
+      }
+
+      double
+      update_solution(const Number      alpha,
+                      VectorType &      x,
+                      VectorType &      g,
+                      const VectorType &d,
+                      const VectorType &h)
+      {
+        dealii::internal::VectorOperations::CGUpdateSolution<Number> update(
+          x.begin(), g.begin(), d.begin(), h.begin(), diagonal, alpha);
+        dealii::internal::VectorOperations::MultipleSums<Number, 2> local_sums;
+        dealii::internal::VectorOperations::parallel_reduce(
+          update,
+          0,
+          x.locally_owned_size(),
+          local_sums,
+          thread_loop_partitioner);
+        return reduce_residual_sums(local_sums, g);
+      }
+
+    private:
+      /**
+       * Compute the norm of the residual and the inner product $(g, P g)$ in
+       * one sweep over the residual.
+       */
+      double
+      compute_residual_norm(const VectorType &g)
+      {
+        dealii::internal::VectorOperations::CGResidualSums<Number> sums(
+          g.begin(), diagonal);
+        dealii::internal::VectorOperations::MultipleSums<Number, 2> local_sums;
+        dealii::internal::VectorOperations::parallel_reduce(
+          sums, 0, g.locally_owned_size(), local_sums, thread_loop_partitioner);
+        return reduce_residual_sums(local_sums, g);
+      }
+
+      /**
+       * Sum the local results of CGResidualSums over all processes, store
+       * the inner product $(g, P g)$, and return the norm of the residual.
+       */
+      double
+      reduce_residual_sums(
+        const dealii::internal::VectorOperations::MultipleSums<Number, 2>
+          &               local_sums,
+        const VectorType &g)
+      {
+        Number sums[2];
+        Utilities::MPI::sum(local_sums.values, g.get_mpi_communicator(), sums);
+        g_dot_pg = (diagonal != nullptr) ? sums[1] : sums[0];
+        return std::sqrt(std::abs(sums[0]));
+      }
+
+      const MatrixType &  A;
+      const Number *const diagonal;
+
+      /**
+       * The inner product $(g, P g)$ of the current residual.
+       */
+      Number g_dot_pg;
+
+      /**
+       * The first index and the local inner product $(d, A d)$ of each range
+       * passed to the operation after the matrix-vector product, and the
+       * number of ranges of the current product.
+       */
+      std::vector<std::pair<unsigned int, Number>> range_sums;
+      std::atomic<unsigned int>                    n_range_sums;
+
+      /**
+       * The partitioner of the thread-parallel loops, reused in all
+       * iterations to keep the affinity of the vector entries to the
+       * threads.
+       */
+      std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+        thread_loop_partitioner;
+    };
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
+
 template <typename VectorType>
 SolverCG<VectorType>::SolverCG(SolverControl &           cn,
                                VectorMemory<VectorType> &mem,
@@ -353,6 +873,10 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
   d.reinit(x, true);
   h.reinit(x, true);
 
+  internal::SolverCGImplementation::
+    CGWorker<VectorType, MatrixType, PreconditionerType>
+      worker(A, preconditioner);
+
   int    it        = 0;
   number gh        = number();
   number beta      = number();
@@ -369,7 +893,7 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
   else
     g.equ(-1., b);
 
-  double res = g.l2_norm();
+  double res = worker.initial_residual_norm(g);
   conv       = this->iteration_status(0, res, x);
   if (conv != SolverControl::iterate)
     return;
@@ -379,50 +903,22 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
       it++;
       old_alpha = alpha;
 
+      // apply the preconditioner (unless it is fused into the matrix-vector
+      // product by the worker) and compute the new search direction d as well
+      // as h = A d
+      const number new_gh = worker.apply_preconditioner(g, h, res);
       if (it > 1)
         {
-          if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
-              false)
-            {
-              preconditioner.vmult(h, g);
-              beta = gh;
-              Assert(std::abs(beta) != 0., ExcDivideByZero());
-              gh   = g * h;
-              beta = gh / beta;
-              d.sadd(beta, -1., h);
-            }
-          else
-            {
-              beta = gh;
-              gh   = res * res;
-              beta = gh / beta;
-              d.sadd(beta, -1., g);
-            }
-        }
-      else
-        {
-          if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
-              false)
-            {
-              preconditioner.vmult(h, g);
-              d.equ(-1., h);
-              gh = g * h;
-            }
-          else
-            {
-              d.equ(-1., g);
-              gh = res * res;
-            }
+          Assert(std::abs(gh) != 0., ExcDivideByZero());
+          beta = new_gh / gh;
         }
+      gh = new_gh;
 
-      A.vmult(h, d);
-
-      alpha = d * h;
+      alpha = worker.update_direction_and_vmult(it == 1, beta, g, d, h);
       Assert(std::abs(alpha) != 0., ExcDivideByZero());
       alpha = gh / alpha;
 
-      x.add(alpha, d);
-      res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      res = worker.update_solution(alpha, x, g, d, h);
 
       print_vectors(it, x, g, d);
 
@@ -506,6 +1002,517 @@ SolverCG<VectorType>::connect_eigenvalues_slot(
 
 
 
+namespace internal
+{
+  namespace SolverCGImplementation
+  {
+    /**
+     * The vector updates and inner products of SolverPipelinedCG. This
+     * general version performs each update with the functions of the vector
+     * class, and computes the inner products with blocking reductions
+     * already in start_reductions() and update_and_start_reductions().
+     */
+    template <typename VectorType>
+    class PipelinedCGWorker
+    {
+    public:
+      using number = typename VectorType::value_type;
+
+      /**
+       * Compute the inner products $(r,u)$, $(w,u)$, and $(r,r)$.
+       */
+      void
+      start_reductions(const VectorType &r,
+                       const VectorType &u,
+                       const VectorType &w)
+      {
+        r_dot_u       = r * u;
+        w_dot_u       = w * u;
+        residual_norm = r.l2_norm();
+      }
+
+      /**
+       * Perform the vector updates of one iteration with the coefficients
+       * @p alpha and @p beta, see
+       * internal::VectorOperations::PipelinedCGUpdate, and compute the inner
+       * products for the next iteration.
+       */
+      void
+      update_and_start_reductions(const number      alpha,
+                                  const number      beta,
+                                  VectorType &      x,
+                                  VectorType &      r,
+                                  VectorType &      u,
+                                  VectorType &      w,
+                                  VectorType &      p,
+                                  VectorType &      s,
+                                  VectorType &      q,
+                                  VectorType &      z,
+                                  const VectorType &m,
+                                  const VectorType &n)
+      {
+        z.sadd(beta, 1., n);
+        q.sadd(beta, 1., m);
+        s.sadd(beta, 1., w);
+        p.sadd(beta, 1., u);
+        x.add(alpha, p);
+        r.add(-alpha, s);
+        u.add(-alpha, q);
+        w.add(-alpha, z);
+        start_reductions(r, u, w);
+      }
+
+      /**
+       * Return the inner products computed by the last call to one of the
+       * functions above.
+       */
+      void
+      finish_reductions(number &r_dot_u_out,
+                        number &w_dot_u_out,
+                        double &residual_norm_out)
+      {
+        r_dot_u_out       = r_dot_u;
+        w_dot_u_out       = w_dot_u;
+        residual_norm_out = residual_norm;
+      }
+
+    private:
+      number r_dot_u;
+      number w_dot_u;
+      double residual_norm;
+    };
+
+
+
+    /**
+     * The part of PipelinedCGWorker that works on the locally owned
+     * elements of vectors stored in contiguous arrays. The updates and the
+     * inner products are fused into a single sweep over the vectors, and
+     * the inner products are only accumulated locally.
+     */
+    template <typename Number>
+    class PipelinedCGLocalWorker
+    {
+    public:
+      using size_type = types::global_dof_index;
+
+      PipelinedCGLocalWorker()
+        : thread_loop_partitioner(
+            std::make_shared<::dealii::parallel::internal::TBBPartitioner>())
+      {}
+
+    protected:
+      void
+      compute_local_sums(const size_type     size,
+                         const Number *const r,
+                         const Number *const u,
+                         const Number *const w)
+      {
+        dealii::internal::VectorOperations::Dot<Number, Number> r_dot_u(r, u);
+        dealii::internal::VectorOperations::Dot<Number, Number> w_dot_u(w, u);
+        dealii::internal::VectorOperations::Dot<Number, Number> r_dot_r(r, r);
+        dealii::internal::VectorOperations::parallel_reduce(
+          r_dot_u, 0, size, local_sums.values[0], thread_loop_partitioner);
+        dealii::internal::VectorOperations::parallel_reduce(
+          w_dot_u, 0, size, local_sums.values[1], thread_loop_partitioner);
+        dealii::internal::VectorOperations::parallel_reduce(
+          r_dot_r, 0, size, local_sums.values[2], thread_loop_partitioner);
+      }
+
+      void
+      update_and_compute_local_sums(const size_type     size,
+                                    const Number        alpha,
+                                    const Number        beta,
+                                    Number *const       x,
+                                    Number *const       r,
+                                    Number *const       u,
+                                    Number *const       w,
+                                    Number *const       p,
+                                    Number *const       s,
+                                    Number *const       q,
+                                    Number *const       z,
+                                    const Number *const m,
+                                    const Number *const n)
+      {
+        dealii::internal::VectorOperations::PipelinedCGUpdate<Number> update(
+          x, r, u, w, p, s, q, z, m, n, alpha, beta);
+        dealii::internal::VectorOperations::parallel_reduce(
+          update, 0, size, local_sums, thread_loop_partitioner);
+      }
+
+      void
+      extract_sums(Number &r_dot_u, Number &w_dot_u, double &residual_norm)
+      {
+        r_dot_u       = local_sums.values[0];
+        w_dot_u       = local_sums.values[1];
+        residual_norm = std::sqrt(std::abs(local_sums.values[2]));
+      }
+
+      /**
+       * The local inner products $(r,u)$, $(w,u)$, and $(r,r)$.
+       */
+      dealii::internal::VectorOperations::MultipleSums<Number, 3> local_sums;
+
+      /**
+       * The partitioner of the thread-parallel loops, reused in all
+       * iterations to keep the affinity of the vector entries to the
+       * threads.
+       */
+      std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+        thread_loop_partitioner;
+    };
+
+
+
+    /**
+     * Specialization of PipelinedCGWorker for dealii::Vector.
+     */
+    template <typename Number>
+    class PipelinedCGWorker<::dealii::Vector<Number>>
+      : public PipelinedCGLocalWorker<Number>
+    {
+    public:
+      using VectorType = ::dealii::Vector<Number>;
+
+      void
+      start_reductions(const VectorType &r,
+                       const VectorType &u,
+                       const VectorType &w)
+      {
+        this->compute_local_sums(r.size(), r.begin(), u.begin(), w.begin());
+      }
+
+      void
+      update_and_start_reductions(const Number      alpha,
+                                  const Number      beta,
+                                  VectorType &      x,
+                                  VectorType &      r,
+                                  VectorType &      u,
+                                  VectorType &      w,
+                                  VectorType &      p,
+                                  VectorType &      s,
+                                  VectorType &      q,
+                                  VectorType &      z,
+                                  const VectorType &m,
+                                  const VectorType &n)
+      {
+        this->update_and_compute_local_sums(x.size(),
+                                            alpha,
+                                            beta,
+                                            x.begin(),
+                                            r.begin(),
+                                            u.begin(),
+                                            w.begin(),
+                                            p.begin(),
+                                            s.begin(),
+                                            q.begin(),
+                                            z.begin(),
+                                            m.begin(),
+                                            n.begin());
+      }
+
+      void
+      finish_reductions(Number &r_dot_u, Number &w_dot_u, double &residual_norm)
+      {
+        this->extract_sums(r_dot_u, w_dot_u, residual_norm);
+      }
+    };
+
+
+
+    /**
+     * Specialization of PipelinedCGWorker for
+     * LinearAlgebra::distributed::Vector on the host. The local sums are
+     * combined with a non-blocking reduction that is started in
+     * start_reductions() and update_and_start_reductions() and only waited
+     * for in finish_reductions().
+     */
+    template <typename Number>
+    class PipelinedCGWorker<
+      LinearAlgebra::distributed::Vector<Number, ::dealii::MemorySpace::Host>>
+      : public PipelinedCGLocalWorker<Number>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number,
+                                           ::dealii::MemorySpace::Host>;
+
+      PipelinedCGWorker()
+#ifdef DEAL_II_WITH_MPI
+        : request(MPI_REQUEST_NULL)
+#endif
+      {}
+
+      ~PipelinedCGWorker()
+      {
+#ifdef DEAL_II_WITH_MPI
+        // do not leave a reduction in flight if the solver was left by an
+        // exception
+        if (request != MPI_REQUEST_NULL)
+          MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+      }
+
+      void
+      start_reductions(const VectorType &r,
+                       const VectorType &u,
+                       const VectorType &w)
+      {
+        this->compute_local_sums(r.locally_owned_size(),
+                                 r.begin(),
+                                 u.begin(),
+                                 w.begin());
+        start_global_sum(r);
+      }
+
+      void
+      update_and_start_reductions(const Number      alpha,
+                                  const Number      beta,
+                                  VectorType &      x,
+                                  VectorType &      r,
+                                  VectorType &      u,
+                                  VectorType &      w,
+                                  VectorType &      p,
+                                  VectorType &      s,
+                                  VectorType &      q,
+                                  VectorType &      z,
+                                  const VectorType &m,
+                                  const VectorType &n)
+      {
+        this->update_and_compute_local_sums(x.locally_owned_size(),
+                                            alpha,
+                                            beta,
+                                            x.begin(),
+                                            r.begin(),
+                                            u.begin(),
+                                            w.begin(),
+                                            p.begin(),
+                                            s.begin(),
+                                            q.begin(),
+                                            z.begin(),
+                                            m.begin(),
+                                            n.begin());
+        start_global_sum(r);
+      }
+
+      void
+      finish_reductions(Number &r_dot_u, Number &w_dot_u, double &residual_norm)
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (request != MPI_REQUEST_NULL)
+          {
+            const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+#endif
+        this->extract_sums(r_dot_u, w_dot_u, residual_norm);
+      }
+
+    private:
+      void
+      start_global_sum(const VectorType &r)
+      {
+#ifdef DEAL_II_WITH_MPI
+        if (r.get_partitioner()->n_mpi_processes() > 1)
+          {
+            const int ierr = MPI_Iallreduce(
+              MPI_IN_PLACE,
+              this->local_sums.values,
+              3,
+              Utilities::MPI::internal::mpi_type_id(this->local_sums.values),
+              MPI_SUM,
+              r.get_mpi_communicator(),
+              &request);
+            AssertThrowMPI(ierr);
+          }
+#else
+        (void)r;
+#endif
+      }
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The request of the reduction in flight.
+       */
+      MPI_Request request;
+#endif
+    };
+  } // namespace SolverCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &           cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, mem, data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &       cn,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  // Memory allocation. in the notation of Ghysels and Vanroose, r is the
+  // residual, u=Pr the preconditioned residual, w=Au, m=Pw, n=Am, and p, s=Ap,
+  // q=Ps, z=Aq the search direction and its images
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // define some aliases for simpler access
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues = !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<number> diagonal;
+  std::vector<number> offdiagonal;
+
+  number eigen_beta_alpha = 0;
+
+  // the search direction and its images are multiplied by beta=0 in the
+  // first iteration, so they need to be zero rather than uninitialized
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x);
+  s.reinit(x);
+  q.reinit(x);
+  z.reinit(x);
+
+  int    it          = 0;
+  number r_dot_u     = number();
+  number w_dot_u     = number();
+  number old_r_dot_u = number();
+  number beta        = number();
+  number alpha       = number();
+  number old_alpha   = number();
+  double res         = 0;
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverCGImplementation::PipelinedCGWorker<VectorType> worker;
+  worker.start_reductions(r, u, w);
+
+  while (true)
+    {
+      // apply the preconditioner and the matrix while the reductions of the
+      // inner products are in flight
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+
+      worker.finish_reductions(r_dot_u, w_dot_u, res);
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      ++it;
+      old_alpha = alpha;
+
+      if (it > 1)
+        {
+          Assert(std::abs(old_r_dot_u) != 0., ExcDivideByZero());
+          beta  = r_dot_u / old_r_dot_u;
+          alpha = w_dot_u - beta * r_dot_u / old_alpha;
+        }
+      else
+        {
+          beta  = 0.;
+          alpha = w_dot_u;
+        }
+      Assert(std::abs(alpha) != 0., ExcDivideByZero());
+      alpha       = r_dot_u / alpha;
+      old_r_dot_u = r_dot_u;
+
+      worker.update_and_start_reductions(
+        alpha, beta, x, r, u, w, p, s, q, z, m, n);
+
+      this->print_vectors(it, x, r, p);
+
+      if (it > 1)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+        }
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -21,6 +21,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/full_matrix.h>
@@ -29,6 +32,7 @@
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_operations_internal.h>
 
 #include <algorithm>
 #include <cmath>
@@ -37,6 +41,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -104,6 +120,300 @@ namespace internal
        */
       std::vector<typename VectorMemory<VectorType>::Pointer> data;
     };
+
+
+
+    /**
+     * The two operations the classical Gram-Schmidt algorithm is made of:
+     * the inner products of vectors with the vectors of the Arnoldi basis,
+     * and the addition of a linear combination of the basis vectors to a
+     * vector. This general implementation uses the functions of the vector
+     * class and thus needs one global reduction per inner product. The
+     * specializations for dealii::Vector and
+     * LinearAlgebra::distributed::Vector below compute all inner products in
+     * one sweep over the vectors and a single reduction, and add all basis
+     * vectors in one sweep.
+     */
+    template <typename VectorType>
+    class GramSchmidtKernels
+    {
+    public:
+      /**
+       * Set <tt>result(i, j - first_vector) = orthogonal_vectors[j] *
+       * orthogonal_vectors[i]</tt> for all <tt>i <= j</tt> and
+       * <tt>first_vector <= j <= last_vector</tt>, i.e., compute the inner
+       * products of the vectors with indices between @p first_vector and
+       * @p last_vector with all vectors before them and with themselves.
+       */
+      void
+      inner_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                     const unsigned int            first_vector,
+                     const unsigned int            last_vector,
+                     FullMatrix<double> &          result)
+      {
+        result.reinit(last_vector + 1, last_vector - first_vector + 1);
+        for (unsigned int j = first_vector; j <= last_vector; ++j)
+          for (unsigned int i = 0; i <= j; ++i)
+            result(i, j - first_vector) =
+              orthogonal_vectors[j] * orthogonal_vectors[i];
+      }
+
+      /**
+       * Add <tt>coefficients(i) * orthogonal_vectors[i]</tt> for all <tt>i <
+       * n_vectors</tt> to @p vv.
+       */
+      void
+      add_linear_combination(const TmpVectors<VectorType> &orthogonal_vectors,
+                             const unsigned int            n_vectors,
+                             const Vector<double> &        coefficients,
+                             VectorType &                  vv)
+      {
+        unsigned int i = 0;
+        for (; i + 1 < n_vectors; i += 2)
+          vv.add(coefficients(i),
+                 orthogonal_vectors[i],
+                 coefficients(i + 1),
+                 orthogonal_vectors[i + 1]);
+        if (i < n_vectors)
+          vv.add(coefficients(i), orthogonal_vectors[i]);
+      }
+    };
+
+
+
+    /**
+     * The number of basis vectors processed in one sweep over a vector by
+     * ContiguousGramSchmidtKernels.
+     */
+    constexpr unsigned int gram_schmidt_group_size = 8;
+
+
+
+    /**
+     * Base class for the specializations of GramSchmidtKernels for vectors
+     * that store their locally owned entries contiguously. The inner products
+     * and the linear combinations work on groups of several basis vectors at
+     * a time, so that the entries of the vector that is orthogonalized are
+     * read only once per group rather than once per basis vector.
+     */
+    template <typename Number>
+    class ContiguousGramSchmidtKernels
+    {
+    protected:
+      ContiguousGramSchmidtKernels()
+        : thread_loop_partitioner(
+            std::make_shared<::dealii::parallel::internal::TBBPartitioner>())
+      {}
+
+      /**
+       * Compute the inner products described in
+       * GramSchmidtKernels::inner_products() on the first @p local_size
+       * entries of the vectors and store them in local_sums, in the order in
+       * which they appear in the columns of the result.
+       */
+      template <typename VectorType>
+      void
+      compute_local_inner_products(
+        const TmpVectors<VectorType> &orthogonal_vectors,
+        const unsigned int            first_vector,
+        const unsigned int            last_vector,
+        const std::size_t             local_size)
+      {
+        collect_vector_pointers(orthogonal_vectors, last_vector + 1);
+        local_sums.clear();
+        for (unsigned int j = first_vector; j <= last_vector; ++j)
+          for (unsigned int start = 0; start <= j;
+               start += gram_schmidt_group_size)
+            {
+              const unsigned int n_vectors =
+                std::min(gram_schmidt_group_size, j + 1 - start);
+              dealii::internal::VectorOperations::
+                MultipleDot<Number, gram_schmidt_group_size>
+                  dot(vector_pointers.data() + start,
+                      n_vectors,
+                      vector_pointers[j]);
+              dealii::internal::VectorOperations::
+                MultipleSums<Number, gram_schmidt_group_size>
+                  sums;
+              dealii::internal::VectorOperations::parallel_reduce(
+                dot, 0, local_size, sums, thread_loop_partitioner);
+              local_sums.insert(local_sums.end(),
+                                sums.values,
+                                sums.values + n_vectors);
+            }
+      }
+
+      /**
+       * Copy the sums computed by compute_local_inner_products() into
+       * @p result.
+       */
+      void
+      extract_inner_products(const unsigned int  first_vector,
+                             const unsigned int  last_vector,
+                             FullMatrix<double> &result) const
+      {
+        result.reinit(last_vector + 1, last_vector - first_vector + 1);
+        auto sum = local_sums.begin();
+        for (unsigned int j = first_vector; j <= last_vector; ++j)
+          for (unsigned int i = 0; i <= j; ++i, ++sum)
+            result(i, j - first_vector) = *sum;
+      }
+
+      /**
+       * Add <tt>coefficients(i) * orthogonal_vectors[i]</tt> for all <tt>i <
+       * n_vectors</tt> to the first @p local_size entries of @p vv.
+       */
+      template <typename VectorType>
+      void
+      add_local_linear_combination(
+        const TmpVectors<VectorType> &orthogonal_vectors,
+        const unsigned int            n_vectors,
+        const Vector<double> &        coefficients,
+        const std::size_t             local_size,
+        Number *const                 vv)
+      {
+        collect_vector_pointers(orthogonal_vectors, n_vectors);
+        factors.resize(n_vectors);
+        for (unsigned int i = 0; i < n_vectors; ++i)
+          factors[i] = coefficients(i);
+        for (unsigned int start = 0; start < n_vectors;
+             start += gram_schmidt_group_size)
+          {
+            dealii::internal::VectorOperations::
+              Vectorization_add_linear_combination<Number,
+                                                   gram_schmidt_group_size>
+                update(vv,
+                       vector_pointers.data() + start,
+                       factors.data() + start,
+                       std::min(gram_schmidt_group_size, n_vectors - start));
+            dealii::internal::VectorOperations::parallel_for(
+              update, 0, local_size, thread_loop_partitioner);
+          }
+      }
+
+      /**
+       * The local inner products computed by compute_local_inner_products().
+       */
+      std::vector<Number> local_sums;
+
+    private:
+      /**
+       * Fill vector_pointers with the data of the first @p n_vectors vectors
+       * in @p orthogonal_vectors.
+       */
+      template <typename VectorType>
+      void
+      collect_vector_pointers(const TmpVectors<VectorType> &orthogonal_vectors,
+                              const unsigned int            n_vectors)
+      {
+        vector_pointers.resize(n_vectors);
+        for (unsigned int i = 0; i < n_vectors; ++i)
+          vector_pointers[i] = orthogonal_vectors[i].begin();
+      }
+
+      /**
+       * Pointers to the data of the basis vectors.
+       */
+      std::vector<const Number *> vector_pointers;
+
+      /**
+       * The coefficients of the linear combination, converted to the number
+       * type of the vectors.
+       */
+      std::vector<Number> factors;
+
+      /**
+       * The partitioner of the thread-parallel loops, reused in all
+       * iterations.
+       */
+      std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+        thread_loop_partitioner;
+    };
+
+
+
+    /**
+     * Specialization of GramSchmidtKernels for dealii::Vector.
+     */
+    template <typename Number>
+    class GramSchmidtKernels<::dealii::Vector<Number>>
+      : public ContiguousGramSchmidtKernels<Number>
+    {
+    public:
+      using VectorType = ::dealii::Vector<Number>;
+
+      void
+      inner_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                     const unsigned int            first_vector,
+                     const unsigned int            last_vector,
+                     FullMatrix<double> &          result)
+      {
+        this->compute_local_inner_products(orthogonal_vectors,
+                                           first_vector,
+                                           last_vector,
+                                           orthogonal_vectors[0].size());
+        this->extract_inner_products(first_vector, last_vector, result);
+      }
+
+      void
+      add_linear_combination(const TmpVectors<VectorType> &orthogonal_vectors,
+                             const unsigned int            n_vectors,
+                             const Vector<double> &        coefficients,
+                             VectorType &                  vv)
+      {
+        this->add_local_linear_combination(
+          orthogonal_vectors, n_vectors, coefficients, vv.size(), vv.begin());
+      }
+    };
+
+
+
+    /**
+     * Specialization of GramSchmidtKernels for
+     * LinearAlgebra::distributed::Vector, which sums the local inner products
+     * over all processes in a single call to Utilities::MPI::sum().
+     */
+    template <typename Number>
+    class GramSchmidtKernels<
+      LinearAlgebra::distributed::Vector<Number, ::dealii::MemorySpace::Host>>
+      : public ContiguousGramSchmidtKernels<Number>
+    {
+    public:
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number,
+                                           ::dealii::MemorySpace::Host>;
+
+      void
+      inner_products(const TmpVectors<VectorType> &orthogonal_vectors,
+                     const unsigned int            first_vector,
+                     const unsigned int            last_vector,
+                     FullMatrix<double> &          result)
+      {
+        const VectorType &vector = orthogonal_vectors[0];
+        this->compute_local_inner_products(orthogonal_vectors,
+                                           first_vector,
+                                           last_vector,
+                                           vector.locally_owned_size());
+        if (vector.get_partitioner()->n_mpi_processes() > 1)
+          Utilities::MPI::sum(ArrayView<const Number>(this->local_sums),
+                              vector.get_mpi_communicator(),
+                              ArrayView<Number>(this->local_sums));
+        this->extract_inner_products(first_vector, last_vector, result);
+      }
+
+      void
+      add_linear_combination(const TmpVectors<VectorType> &orthogonal_vectors,
+                             const unsigned int            n_vectors,
+                             const Vector<double> &        coefficients,
+                             VectorType &                  vv)
+      {
+        this->add_local_linear_combination(orthogonal_vectors,
+                                           n_vectors,
+                                           coefficients,
+                                           vv.locally_owned_size(),
+                                           vv.begin());
+      }
+    };
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -153,6 +463,22 @@ namespace internal
  * class, see the documentation of the Solver base class.
  *
  *
+ * <h3>Orthogonalization</h3>
+ *
+ * By default, each new vector is orthogonalized against the Arnoldi basis
+ * with the modified Gram-Schmidt algorithm, which computes one inner product
+ * after the other. For parallel vectors, each of them is a global reduction,
+ * so the cost of an iteration with a long basis is dominated by the latency
+ * of these reductions. AdditionalData::orthogonalization_strategy selects
+ * one of the variants of the classical Gram-Schmidt algorithm instead, which
+ * compute all inner products of an iteration at once: either the algorithm
+ * applied twice in each iteration, with two reductions, or the variant with
+ * delayed re-orthogonalization, which needs only a single reduction per
+ * iteration. For dealii::Vector and LinearAlgebra::distributed::Vector, the
+ * inner products are also computed in one sweep over the vectors, and the
+ * basis vectors are subtracted in one sweep as well.
+ *
+ *
  * <h3>Observing the progress of linear solver iterations</h3>
  *
  * The solve() function of this class uses the mechanism described in the
@@ -180,16 +506,53 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * The algorithms available to orthogonalize a new vector against the
+     * Arnoldi basis.
+     */
+    enum class OrthogonalizationStrategy
+    {
+      /**
+       * The modified Gram-Schmidt algorithm, which computes the inner
+       * product with one basis vector at a time and thus needs as many
+       * global reductions per iteration as there are basis vectors.
+       */
+      modified_gram_schmidt,
+
+      /**
+       * The classical Gram-Schmidt algorithm, which computes the inner
+       * products with all basis vectors at once. It is always applied twice
+       * to retain orthogonality, so each iteration needs two global
+       * reductions.
+       */
+      classical_gram_schmidt,
+
+      /**
+       * The classical Gram-Schmidt algorithm with delayed
+       * re-orthogonalization: The second application of the algorithm to a
+       * vector is done in the next iteration, together with the first
+       * application to the next vector, so each iteration needs only a
+       * single global reduction. As a consequence, the residual is only
+       * known one iteration later, and one additional reduction is needed
+       * before each restart.
+       */
+      delayed_classical_gram_schmidt
+    };
+
     /**
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and the modified Gram-Schmidt
+     * algorithm for orthogonalization.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int              max_n_tmp_vectors          = 30,
+      const bool                      right_preconditioning      = false,
+      const bool                      use_default_residual       = true,
+      const bool                      force_re_orthogonalization = false,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -220,6 +583,13 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * The algorithm used to orthogonalize new vectors against the Arnoldi
+     * basis. See the section on orthogonalization in the documentation of
+     * this class.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -573,6 +943,210 @@ namespace internal
 
 
 
+    /**
+     * Orthogonalize the vector <tt>orthogonal_vectors[dim]</tt> against the
+     * @p dim (orthogonal) vectors before it with the classical Gram-Schmidt
+     * algorithm, which is applied twice. The factors used for
+     * orthogonalization are stored in @p h, and the norm of the
+     * orthogonalized vector is returned.
+     */
+    template <typename VectorType>
+    inline double
+    classical_gram_schmidt(const TmpVectors<VectorType> &  orthogonal_vectors,
+                           const unsigned int              dim,
+                           Vector<double> &                h,
+                           GramSchmidtKernels<VectorType> &kernels)
+    {
+      Assert(dim > 0, ExcInternalError());
+      VectorType &vv = orthogonal_vectors[dim];
+
+      FullMatrix<double> inner_products;
+      Vector<double>     coefficients(dim);
+      double             norm_vv_sqr = 0;
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) = 0;
+
+      // since the other vectors are orthonormal, the norm of the
+      // orthogonalized vector follows from its initial norm and the factors.
+      // this is accurate in the second pass, where the factors are small
+      for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+          kernels.inner_products(orthogonal_vectors, dim, dim, inner_products);
+          norm_vv_sqr = inner_products(dim, 0);
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              h(i) += inner_products(i, 0);
+              coefficients(i) = -inner_products(i, 0);
+              norm_vv_sqr -= inner_products(i, 0) * inner_products(i, 0);
+            }
+          kernels.add_linear_combination(orthogonal_vectors,
+                                         dim,
+                                         coefficients,
+                                         vv);
+        }
+
+      return std::sqrt(std::max(norm_vv_sqr, 0.));
+    }
+
+
+
+    /**
+     * Complete column @p column of the Hessenberg matrix @p hessenberg,
+     * whose last entry was computed with an estimate of the norm of the basis
+     * vector <tt>column+1</tt>. The first column of @p inner_products holds
+     * the inner products of that vector with all vectors up to and including
+     * itself. The factors for orthogonalizing the vector a second time are
+     * stored in @p coefficients, and its norm after that is returned.
+     */
+    inline double
+    complete_hessenberg_column(const FullMatrix<double> &inner_products,
+                               const unsigned int        column,
+                               FullMatrix<double> &      hessenberg,
+                               Vector<double> &          coefficients)
+    {
+      const unsigned int n        = column + 1;
+      double             norm_sqr = inner_products(n, 0);
+      for (unsigned int i = 0; i < n; ++i)
+        {
+          coefficients(i) = inner_products(i, 0);
+          norm_sqr -= coefficients(i) * coefficients(i);
+        }
+      const double norm = std::sqrt(std::max(norm_sqr, 0.));
+
+      const double factor = hessenberg(n, column);
+      for (unsigned int i = 0; i < n; ++i)
+        hessenberg(i, column) += factor * coefficients(i);
+      hessenberg(n, column) = factor * norm;
+
+      return norm;
+    }
+
+
+
+    /**
+     * One step of the classical Gram-Schmidt algorithm with delayed
+     * re-orthogonalization, following K. Swirydowicz, J. Langou, S.
+     * Ananthan, U. Yang, and S. Thomas, "Low synchronization Gram-Schmidt
+     * and generalized minimal residual algorithms", Numer. Linear Algebra
+     * Appl. 28 (2021), e2343.
+     *
+     * On entry, <tt>orthogonal_vectors[dim-1]</tt> has only been
+     * orthogonalized once against the vectors before it and normalized with
+     * an estimate of its norm (unless <tt>dim==1</tt>), and
+     * <tt>orthogonal_vectors[dim]</tt> is the operator applied to it. This
+     * function orthogonalizes the former a second time, normalizes it, and
+     * completes column <tt>dim-2</tt> of the Hessenberg matrix @p hessenberg
+     * accordingly. Since the operator is linear, the inner products of the
+     * operator applied to the final vector follow from the ones of
+     * <tt>orthogonal_vectors[dim]</tt>, so the latter can then be
+     * orthogonalized once against the first @p dim vectors, with the
+     * preliminary factors stored in column <tt>dim-1</tt> of @p hessenberg.
+     * All inner products are computed in a single call to @p kernels.
+     */
+    template <typename VectorType>
+    inline void
+    delayed_classical_gram_schmidt(
+      const TmpVectors<VectorType> &  orthogonal_vectors,
+      const unsigned int              dim,
+      FullMatrix<double> &            hessenberg,
+      GramSchmidtKernels<VectorType> &kernels)
+    {
+      Assert(dim > 0, ExcInternalError());
+      VectorType &vv = orthogonal_vectors[dim];
+
+      FullMatrix<double> inner_products;
+      kernels.inner_products(orthogonal_vectors,
+                             dim > 1 ? dim - 1 : dim,
+                             dim,
+                             inner_products);
+      const unsigned int vv_column = inner_products.n() - 1;
+
+      // the inner products of vv with the basis vectors, and the factors for
+      // orthogonalizing the previous vector a second time
+      Vector<double> projections(dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        projections(i) = inner_products(i, vv_column);
+      Vector<double> coefficients(dim - 1);
+      double         norm_previous = 1.;
+
+      if (dim > 1)
+        {
+          norm_previous = complete_hessenberg_column(inner_products,
+                                                     dim - 2,
+                                                     hessenberg,
+                                                     coefficients);
+
+          // an exact breakdown, which makes the previous column the last one
+          if (norm_previous == 0.)
+            return;
+
+          coefficients *= -1.;
+          VectorType &previous = orthogonal_vectors[dim - 1];
+          kernels.add_linear_combination(orthogonal_vectors,
+                                         dim - 1,
+                                         coefficients,
+                                         previous);
+          previous *= 1. / norm_previous;
+
+          double projection_previous = projections(dim - 1);
+          for (unsigned int i = 0; i < dim - 1; ++i)
+            projection_previous += coefficients(i) * projections(i);
+          projections(dim - 1) = projection_previous / norm_previous;
+        }
+
+      // the operator applied to the final vector is
+      // (vv - sum_j coefficients(j) A v_j) / norm_previous, which gives the
+      // factors of the orthogonalization
+      for (unsigned int i = 0; i < dim; ++i)
+        {
+          double entry = projections(i);
+          for (unsigned int j = 0; j < dim - 1; ++j)
+            entry += hessenberg(i, j) * coefficients(j);
+          hessenberg(i, dim - 1) = entry / norm_previous;
+        }
+
+      // this is the same as subtracting the factors times the basis vectors
+      // from the operator applied to the final vector
+      double norm_vv_sqr = inner_products(dim, vv_column);
+      for (unsigned int i = 0; i < dim; ++i)
+        norm_vv_sqr -= projections(i) * projections(i);
+      projections *= -1.;
+      kernels.add_linear_combination(orthogonal_vectors, dim, projections, vv);
+
+      // the norm is only an estimate that is corrected in the next step
+      const double scaling =
+        (norm_vv_sqr > 0. ? 1. / std::sqrt(norm_vv_sqr) : 1.);
+      vv *= scaling;
+      hessenberg(dim, dim - 1) = 1. / (scaling * norm_previous);
+    }
+
+
+
+    /**
+     * Complete column <tt>dim-1</tt> of the Hessenberg matrix @p hessenberg
+     * after the last call to delayed_classical_gram_schmidt() before a
+     * restart, by computing the inner products of
+     * <tt>orthogonal_vectors[dim]</tt> with the vectors before it.
+     */
+    template <typename VectorType>
+    inline void
+    complete_delayed_classical_gram_schmidt(
+      const TmpVectors<VectorType> &  orthogonal_vectors,
+      const unsigned int              dim,
+      FullMatrix<double> &            hessenberg,
+      GramSchmidtKernels<VectorType> &kernels)
+    {
+      FullMatrix<double> inner_products;
+      kernels.inner_products(orthogonal_vectors, dim, dim, inner_products);
+      Vector<double> coefficients(dim);
+      complete_hessenberg_column(inner_products,
+                                 dim - 1,
+                                 hessenberg,
+                                 coefficients);
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -588,14 +1162,16 @@ namespace internal
 
 template <class VectorType>
 inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
-  const unsigned int max_n_tmp_vectors,
-  const bool         right_preconditioning,
-  const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const unsigned int              max_n_tmp_vectors,
+  const bool                      right_preconditioning,
+  const bool                      use_default_residual,
+  const bool                      force_re_orthogonalization,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -808,10 +1384,17 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
     !condition_number_signal.empty() || !all_condition_numbers_signal.empty() ||
     !eigenvalues_signal.empty() || !all_eigenvalues_signal.empty() ||
     !hessenberg_signal.empty() || !all_hessenberg_signal.empty();
-  // for eigenvalue computation, need to collect the Hessenberg matrix (before
-  // applying Givens rotations)
+  // the classical Gram-Schmidt algorithm with delayed re-orthogonalization
+  // completes each column of the Hessenberg matrix one iteration later
+  const bool delayed_orthogonalization =
+    (additional_data.orthogonalization_strategy ==
+     AdditionalData::OrthogonalizationStrategy::
+       delayed_classical_gram_schmidt);
+
+  // for eigenvalue computation and the delayed orthogonalization, need to
+  // collect the Hessenberg matrix (before applying Givens rotations)
   FullMatrix<double> H_orig;
-  if (do_eigenvalues)
+  if (do_eigenvalues || delayed_orthogonalization)
     H_orig.reinit(n_tmp_vectors, n_tmp_vectors - 1);
 
   // matrix used for the orthogonalization process later
@@ -857,6 +1440,9 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
   bool re_orthogonalize = additional_data.force_re_orthogonalization;
 
+  internal::SolverGMRESImplementation::GramSchmidtKernels<VectorType>
+    gram_schmidt_kernels;
+
   ///////////////////////////////////////////////////////////////////////////
   // outer iteration: loop until we either reach convergence or the maximum
   // number of iterations is exceeded. each cycle of this loop amounts to one
@@ -917,12 +1503,94 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
       v *= 1. / rho;
 
+      // Apply the Givens rotations to the column of the Hessenberg matrix
+      // with the given number, which is stored in h, and check for
+      // convergence. The column was computed in the given iteration, which
+      // for the delayed orthogonalization is the previous one.
+      const auto process_column = [&](const unsigned int column,
+                                      const unsigned int iteration) {
+        dim = column + 1;
+
+        // for eigenvalues, get the resulting coefficients from the
+        // orthogonalization process. for the delayed orthogonalization, they
+        // are already there and we get h from them instead
+        if (delayed_orthogonalization)
+          for (unsigned int i = 0; i < dim + 1; ++i)
+            h(i) = H_orig(i, column);
+        else if (do_eigenvalues)
+          for (unsigned int i = 0; i < dim + 1; ++i)
+            H_orig(i, column) = h(i);
+
+        //  Transformation into tridiagonal structure
+        givens_rotation(h, gamma, ci, si, column);
+
+        //  append vector on matrix
+        for (unsigned int i = 0; i < dim; ++i)
+          H(i, column) = h(i);
+
+        //  default residual
+        rho = std::fabs(gamma(dim));
+
+        if (use_default_residual)
+          {
+            last_res        = rho;
+            iteration_state = this->iteration_status(iteration, rho, x);
+          }
+        else
+          {
+            deallog << "default_res=" << rho << std::endl;
+
+            dealii::Vector<double> h_(dim);
+            *x_     = x;
+            *gamma_ = gamma;
+            H1.reinit(dim + 1, dim);
+
+            for (unsigned int i = 0; i < dim + 1; ++i)
+              for (unsigned int j = 0; j < dim; ++j)
+                H1(i, j) = H(i, j);
+
+            H1.backward(h_, *gamma_);
+
+            if (left_precondition)
+              for (unsigned int i = 0; i < dim; ++i)
+                x_->add(h_(i), tmp_vectors[i]);
+            else
+              {
+                p = 0.;
+                for (unsigned int i = 0; i < dim; ++i)
+                  p.add(h_(i), tmp_vectors[i]);
+                preconditioner.vmult(*r, p);
+                x_->add(1., *r);
+              };
+            A.vmult(*r, *x_);
+            r->sadd(-1., 1., b);
+            // Now *r contains the unpreconditioned residual!!
+            if (left_precondition)
+              {
+                const double res = r->l2_norm();
+                last_res         = res;
+
+                iteration_state = this->iteration_status(iteration, res, x);
+              }
+            else
+              {
+                preconditioner.vmult(*x_, *r);
+                const double preconditioned_res = x_->l2_norm();
+                last_res                        = preconditioned_res;
+
+                iteration_state =
+                  this->iteration_status(iteration, preconditioned_res, x);
+              }
+          }
+      };
+
       // inner iteration doing at most as many steps as there are temporary
       // vectors. the number of steps actually been done is propagated outside
       // through the @p dim variable
-      for (unsigned int inner_iteration = 0;
-           ((inner_iteration < n_tmp_vectors - 2) &&
-            (iteration_state == SolverControl::iterate));
+      dim                          = 0;
+      unsigned int inner_iteration = 0;
+      for (; ((inner_iteration < n_tmp_vectors - 2) &&
+              (iteration_state == SolverControl::iterate));
            ++inner_iteration)
         {
           ++accumulated_iterations;
@@ -940,15 +1608,34 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
               A.vmult(vv, p);
             }
 
-          dim = inner_iteration + 1;
+          if (delayed_orthogonalization)
+            {
+              // this completes the previous column of the Hessenberg matrix,
+              // so check for convergence with it
+              internal::SolverGMRESImplementation::
+                delayed_classical_gram_schmidt(tmp_vectors,
+                                               inner_iteration + 1,
+                                               H_orig,
+                                               gram_schmidt_kernels);
+              if (inner_iteration > 0)
+                process_column(inner_iteration - 1,
+                               accumulated_iterations - 1);
+              continue;
+            }
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+                 AdditionalData::OrthogonalizationStrategy::
+                   modified_gram_schmidt ?
+               modified_gram_schmidt(tmp_vectors,
+                                     inner_iteration + 1,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal) :
+               internal::SolverGMRESImplementation::classical_gram_schmidt(
+                 tmp_vectors, inner_iteration + 1, h, gram_schmidt_kernels));
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -956,78 +1643,21 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
           if (s != 0)
             vv *= 1. / s;
 
-          // for eigenvalues, get the resulting coefficients from the
-          // orthogonalization process
-          if (do_eigenvalues)
-            for (unsigned int i = 0; i < dim + 1; ++i)
-              H_orig(i, inner_iteration) = h(i);
-
-          //  Transformation into tridiagonal structure
-          givens_rotation(h, gamma, ci, si, inner_iteration);
-
-          //  append vector on matrix
-          for (unsigned int i = 0; i < dim; ++i)
-            H(i, inner_iteration) = h(i);
-
-          //  default residual
-          rho = std::fabs(gamma(dim));
-
-          if (use_default_residual)
-            {
-              last_res = rho;
-              iteration_state =
-                this->iteration_status(accumulated_iterations, rho, x);
-            }
-          else
-            {
-              deallog << "default_res=" << rho << std::endl;
-
-              dealii::Vector<double> h_(dim);
-              *x_     = x;
-              *gamma_ = gamma;
-              H1.reinit(dim + 1, dim);
-
-              for (unsigned int i = 0; i < dim + 1; ++i)
-                for (unsigned int j = 0; j < dim; ++j)
-                  H1(i, j) = H(i, j);
-
-              H1.backward(h_, *gamma_);
-
-              if (left_precondition)
-                for (unsigned int i = 0; i < dim; ++i)
-                  x_->add(h_(i), tmp_vectors[i]);
-              else
-                {
-                  p = 0.;
-                  for (unsigned int i = 0; i < dim; ++i)
-                    p.add(h_(i), tmp_vectors[i]);
-                  preconditioner.vmult(*r, p);
-                  x_->add(1., *r);
-                };
-              A.vmult(*r, *x_);
-              r->sadd(-1., 1., b);
-              // Now *r contains the unpreconditioned residual!!
-              if (left_precondition)
-                {
-                  const double res = r->l2_norm();
-                  last_res         = res;
-
-                  iteration_state =
-                    this->iteration_status(accumulated_iterations, res, x);
-                }
-              else
-                {
-                  preconditioner.vmult(*x_, *r);
-                  const double preconditioned_res = x_->l2_norm();
-                  last_res                        = preconditioned_res;
-
-                  iteration_state =
-                    this->iteration_status(accumulated_iterations,
-                                           preconditioned_res,
-                                           x);
-                }
-            }
+          process_column(inner_iteration, accumulated_iterations);
         };
+
+      // with the delayed orthogonalization, the last column of the
+      // Hessenberg matrix is not complete yet if we ran out of basis vectors
+      if (delayed_orthogonalization && dim < inner_iteration &&
+          iteration_state == SolverControl::iterate)
+        {
+          internal::SolverGMRESImplementation::
+            complete_delayed_classical_gram_schmidt(tmp_vectors,
+                                                    inner_iteration,
+                                                    H_orig,
+                                                    gram_schmidt_kernels);
+          process_column(inner_iteration - 1, accumulated_iterations);
+        }
       // end of inner iteration. now calculate the solution from the temporary
       // vectors
       h.reinit(dim);
@@ -18,6 +18,9 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -318,11 +321,59 @@ protected:
   std::vector<const size_type *> prebuilt_lower_bound;
 
   /**
-   * Fills the #prebuilt_lower_bound array.
+   * Fills the #prebuilt_lower_bound array and the level sets stored in
+   * #lower_level_rows and #upper_level_rows.
    */
   void
   prebuild_lower_bound();
 
+  /**
+   * The rows of the matrix, sorted into level sets with respect to the
+   * strictly lower triangular part of the sparsity pattern: a row in level
+   * <i>l</i> has entries left of the diagonal only in columns whose rows are
+   * in levels smaller than <i>l</i>. The rows of one level therefore do not
+   * depend on each other in a forward substitution and can be processed
+   * concurrently. The rows of level <i>l</i> are stored in the range
+   * <tt>[lower_level_starts[l], lower_level_starts[l+1])</tt> of this array.
+   * Becomes available after invocation of prebuild_lower_bound().
+   */
+  std::vector<size_type> lower_level_rows;
+
+  /**
+   * Start of each level within #lower_level_rows, with one more element
+   * than there are levels.
+   */
+  std::vector<size_type> lower_level_starts;
+
+  /**
+   * Same as #lower_level_rows, but with respect to the strictly upper
+   * triangular part of the sparsity pattern, i.e., for backward
+   * substitutions.
+   */
+  std::vector<size_type> upper_level_rows;
+
+  /**
+   * Start of each level within #upper_level_rows.
+   */
+  std::vector<size_type> upper_level_starts;
+
+  /**
+   * Call @p f for every row of the matrix, in an order that respects the
+   * dependencies of a forward substitution if @p forward is true, and those
+   * of a backward substitution otherwise. If more than one thread is
+   * available and the levels of the respective level set (see
+   * #lower_level_rows) are large enough, the rows of each level are
+   * processed in parallel. Otherwise, this function simply runs over all
+   * rows in ascending (forward) or descending (backward) order.
+   *
+   * Since each call of @p f only depends on the calls for rows of earlier
+   * levels, the result of the substitution does not depend on the number
+   * of threads.
+   */
+  template <typename Function>
+  void
+  apply_in_level_order(const bool forward, const Function &f) const;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -352,6 +403,61 @@ SparseLUDecomposition<number>::get_strengthen_diagonal(
 
 
 
+template <typename number>
+template <typename Function>
+inline void
+SparseLUDecomposition<number>::apply_in_level_order(const bool      forward,
+                                                    const Function &f) const
+{
+  // the number of rows a task should at least work on. levels with fewer
+  // than twice as many rows are run sequentially
+  const size_type grain_size = 64;
+
+  const std::vector<size_type> &level_rows =
+    (forward ? lower_level_rows : upper_level_rows);
+  const std::vector<size_type> &level_starts =
+    (forward ? lower_level_starts : upper_level_starts);
+
+  const size_type N        = level_rows.size();
+  const size_type n_levels = (level_starts.size() > 0 ?
+                                level_starts.size() - 1 :
+                                0);
+
+  // if there is nothing to gain from the level sets, stay with the natural
+  // ordering of the rows, which accesses memory more regularly
+  if (MultithreadInfo::n_threads() == 1 || N < 2 * grain_size * n_levels)
+    {
+      if (forward)
+        for (size_type row = 0; row < N; ++row)
+          f(row);
+      else
+        for (size_type row = N; row > 0; --row)
+          f(row - 1);
+      return;
+    }
+
+  for (size_type level = 0; level < n_levels; ++level)
+    {
+      const size_type begin = level_starts[level];
+      const size_type end   = level_starts[level + 1];
+      if (end - begin < 2 * grain_size)
+        for (size_type i = begin; i < end; ++i)
+          f(level_rows[i]);
+      else
+        parallel::apply_to_subranges(
+          begin,
+          end,
+          [&level_rows, &f](const size_type range_begin,
+                            const size_type range_end) {
+            for (size_type i = range_begin; i < range_end; ++i)
+              f(level_rows[i]);
+          },
+          grain_size);
+    }
+}
+
+
+
 template <typename number>
 inline bool
 SparseLUDecomposition<number>::empty() const
@@ -28,9 +28,45 @@
 
 #include <algorithm>
 #include <cstring>
+#include <numeric>
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace SparseLUDecompositionImplementation
+  {
+    using size_type = types::global_dof_index;
+
+    /**
+     * Given the @p level of every row, collect the rows of each level in
+     * @p rows by a counting sort, and store in @p starts where each level
+     * begins in @p rows.
+     */
+    inline void
+    sort_into_levels(const std::vector<size_type> &level,
+                     std::vector<size_type> &      rows,
+                     std::vector<size_type> &      starts)
+    {
+      const size_type N = level.size();
+      const size_type n_levels =
+        (N > 0 ? *std::max_element(level.begin(), level.end()) + 1 : 0);
+
+      starts.assign(n_levels + 1, 0);
+      for (size_type row = 0; row < N; ++row)
+        ++starts[level[row] + 1];
+      std::partial_sum(starts.begin(), starts.end(), starts.begin());
+
+      std::vector<size_type> next_position(starts.begin(), starts.end() - 1);
+      rows.resize(N);
+      for (size_type row = 0; row < N; ++row)
+        rows[next_position[level[row]]++] = row;
+    }
+  } // namespace SparseLUDecompositionImplementation
+} // namespace internal
+
+
+
 template <typename number>
 SparseLUDecomposition<number>::SparseLUDecomposition()
   : SparseMatrix<number>()
@@ -57,6 +93,11 @@ SparseLUDecomposition<number>::clear()
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
 
+  std::vector<size_type>().swap(lower_level_rows);
+  std::vector<size_type>().swap(lower_level_starts);
+  std::vector<size_type>().swap(upper_level_rows);
+  std::vector<size_type>().swap(upper_level_starts);
+
   SparseMatrix<number>::clear();
 
   if (own_sparsity)
@@ -121,6 +162,12 @@ SparseLUDecomposition<number>::initialize(
                                            2 * data.extra_off_diagonals,
                                          data.extra_off_diagonals);
       own_sparsity->compress();
+
+      // the user has no access to this pattern, so store the column
+      // offsets if they requested them for the pattern of the matrix
+      if (matrix_sparsity.has_column_offsets())
+        own_sparsity->store_column_offsets();
+
       sparsity_pattern_to_use = own_sparsity;
     }
 
@@ -157,6 +204,33 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
                                &column_numbers[rowstart_indices[row + 1]],
                                row);
     }
+
+  // now sort the rows into level sets. the level of a row is one more than
+  // the largest level of the rows it depends on in a forward substitution
+  // (the columns left of the diagonal) or a backward substitution (the
+  // columns right of the diagonal), respectively
+  std::vector<size_type> level(N);
+  for (size_type row = 0; row < N; ++row)
+    {
+      level[row] = 0;
+      for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+           col != prebuilt_lower_bound[row];
+           ++col)
+        level[row] = std::max(level[row], level[*col] + 1);
+    }
+  internal::SparseLUDecompositionImplementation::sort_into_levels(
+    level, lower_level_rows, lower_level_starts);
+
+  for (size_type row = N; row > 0; --row)
+    {
+      level[row - 1] = 0;
+      for (const size_type *col = prebuilt_lower_bound[row - 1];
+           col != &column_numbers[rowstart_indices[row]];
+           ++col)
+        level[row - 1] = std::max(level[row - 1], level[*col] + 1);
+    }
+  internal::SparseLUDecompositionImplementation::sort_into_levels(
+    level, upper_level_rows, upper_level_starts);
 }
 
 template <typename number>
@@ -239,7 +313,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(lower_level_rows) +
+          MemoryConsumption::memory_consumption(lower_level_starts) +
+          MemoryConsumption::memory_consumption(upper_level_rows) +
+          MemoryConsumption::memory_consumption(upper_level_starts));
 }
 
 
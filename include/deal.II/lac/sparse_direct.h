@@ -127,12 +127,14 @@ public:
 
   /**
    * Factorize the matrix. This function may be called multiple times for
-   * different matrices, after the object of this class has been initialized
-   * for a certain sparsity pattern. You may therefore save some computing
-   * time if you want to invert several matrices with the same sparsity
-   * pattern. However, note that the bulk of the computing time is actually
-   * spent in the factorization, so this functionality may not always be of
-   * large benefit.
+   * different matrices. If the sparsity pattern of the matrix is the same as
+   * the one of the matrix passed to the previous call of this function or of
+   * analyze(), the symbolic factorization, i.e., the column ordering and the
+   * analysis of the structure of the factors, is kept and only the numerical
+   * factorization is recomputed, as in numeric_factorize(). This saves a
+   * considerable part of the computing time in applications like Newton's
+   * method or implicit time stepping, where matrices with the same sparsity
+   * pattern are factorized over and over again.
    *
    * In contrast to the other direct solver classes, the initialization method
    * does nothing. Therefore initialize is not automatically called by this
@@ -146,6 +148,32 @@ public:
   void
   factorize(const Matrix &matrix);
 
+  /**
+   * Compute the symbolic factorization of the given matrix, i.e., the column
+   * ordering and the analysis of the structure of the factors, and store it
+   * for subsequent calls to numeric_factorize() with matrices that have the
+   * same sparsity pattern. Any previously computed factorization is
+   * discarded.
+   *
+   * The symbolic factorization depends mostly on the sparsity pattern of the
+   * matrix, but UMFPACK also takes the values of the given matrix into
+   * account in the choice of its strategy, so the matrix should be
+   * representative of the ones to be factorized later on.
+   */
+  template <class Matrix>
+  void
+  analyze(const Matrix &matrix);
+
+  /**
+   * Compute the numerical factorization of the given matrix with the
+   * symbolic factorization computed by the last call to analyze() or
+   * factorize(). The matrix must have the same sparsity pattern as the matrix
+   * given to that call, otherwise an exception is thrown.
+   */
+  template <class Matrix>
+  void
+  numeric_factorize(const Matrix &matrix);
+
   /**
    * Initialize memory and call SparseDirectUMFPACK::factorize.
    */
@@ -373,6 +401,8 @@ private:
    * The UMFPACK routines allocate objects in which they store information
    * about symbolic and numeric values of the decomposition. The actual data
    * type of these objects is opaque, and only passed around as void pointers.
+   * The symbolic decomposition is kept after the numerical factorization, so
+   * that it can be reused for matrices with the same sparsity pattern.
    */
   void *symbolic_decomposition;
   void *numeric_decomposition;
@@ -383,6 +413,31 @@ private:
   void
   clear();
 
+  /**
+   * Copy the given matrix into the arrays Ap, Ai, Ax, and Az, and set the
+   * sizes of the matrix. Return whether the sparsity pattern, as well as the
+   * choice between real and complex values, is the same as the one of the
+   * matrix stored in these arrays before.
+   */
+  template <class Matrix>
+  bool
+  copy_matrix(const Matrix &matrix);
+
+  /**
+   * Compute the symbolic factorization of the matrix stored in the arrays Ap,
+   * Ai, Ax, and Az, replacing the one stored before.
+   */
+  void
+  compute_symbolic_factorization();
+
+  /**
+   * Compute the numerical factorization of the matrix stored in the arrays
+   * Ap, Ai, Ax, and Az with the stored symbolic factorization, replacing the
+   * numerical factorization stored before.
+   */
+  void
+  compute_numeric_factorization();
+
   /**
    * Make sure that the arrays Ai and Ap are sorted in each row. UMFPACK wants
    * it this way. We need to have three versions of this function, one for the
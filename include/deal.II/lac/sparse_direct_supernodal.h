@@ -0,0 +1,430 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_direct_supernodal_h
+#define dealii_sparse_direct_supernodal_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A sparse direct solver that is implemented in deal.II itself and does not
+ * need any external library. It computes either an $LDL^T$ factorization of
+ * a symmetric matrix or an $LU$ factorization of a general matrix with a
+ * supernodal multifrontal method, and is meant for small to medium-sized
+ * problems on a single node, e.g. as a coarse grid solver in multigrid via
+ * MGCoarseGridApplyPreconditioner.
+ *
+ * The factorization proceeds in the usual three phases:
+ * <ol>
+ * <li> The unknowns are reordered to reduce the fill-in of the factors. The
+ * default is a nested dissection ordering of the graph of $A+A^T$, which
+ * recursively splits the graph by separators taken from the middle level of
+ * a breadth-first level structure rooted at a pseudo-peripheral vertex, see
+ * A. George and J. W. H. Liu, "Computer Solution of Large Sparse Positive
+ * Definite Systems", Prentice-Hall, 1981.
+ * <li> The symbolic factorization computes the elimination tree of the
+ * reordered matrix and groups consecutive columns with the same structure
+ * into supernodes. Small supernodes are merged with their parent even if
+ * this introduces a few explicit zeros, in order to make the dense
+ * operations more efficient.
+ * <li> The numerical factorization assembles a dense frontal matrix for each
+ * supernode from the entries of the matrix and the update matrices of its
+ * children, eliminates the columns of the supernode, and passes the Schur
+ * complement on to the parent. Supernodes at the same height in the
+ * elimination tree are independent of each other and are factorized in
+ * parallel with parallel::apply_to_subranges(). The dense updates of large
+ * frontal matrices near the root of the tree are parallelized as well.
+ * </ol>
+ *
+ * The $LDL^T$ factorization does not pivot and is therefore only suitable
+ * for symmetric matrices whose leading principal minors do not vanish, in
+ * particular symmetric positive definite matrices. Only the upper triangle
+ * of the matrix is read in this case. The $LU$ factorization uses partial
+ * pivoting restricted to the diagonal block of each supernode, which
+ * preserves the symbolic structure. If no nonzero pivot can be found within
+ * these limits, an ExcZeroPivot exception is thrown.
+ *
+ * Several right hand sides can be solved for at once by passing them as the
+ * columns of a FullMatrix to solve(), which is more efficient than solving
+ * for them one after the other.
+ *
+ * This class implements the usual interface of preconditioners with an
+ * initialize() function and vmult() that applies the inverse of the matrix,
+ * as well as the interface of SparseDirectUMFPACK with factorize() and
+ * solve().
+ *
+ * <h4>Instantiations</h4>
+ *
+ * There are instantiations of this class for SparseMatrix<double>,
+ * SparseMatrix<float>, SparseMatrixEZ<float>, SparseMatrixEZ<double>,
+ * BlockSparseMatrix<double>, and BlockSparseMatrix<float>.
+ *
+ * @ingroup Solvers Preconditioners
+ */
+class SparseDirectSupernodal : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Parameters of the factorization.
+   */
+  class AdditionalData
+  {
+  public:
+    /**
+     * The type of factorization.
+     */
+    enum class Factorization
+    {
+      /**
+       * $LDL^T$ factorization without pivoting for symmetric matrices.
+       */
+      ldlt,
+      /**
+       * $LU$ factorization with partial pivoting within supernodes for
+       * general matrices.
+       */
+      lu
+    };
+
+    /**
+     * The ordering of the unknowns applied before the factorization.
+     */
+    enum class Ordering
+    {
+      /**
+       * Nested dissection ordering as described in the documentation of the
+       * class.
+       */
+      nested_dissection,
+      /**
+       * Keep the numbering of the matrix, apart from a postordering of the
+       * elimination tree that does not change the fill-in.
+       */
+      none
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const Factorization factorization = Factorization::lu,
+      const Ordering      ordering      = Ordering::nested_dissection);
+
+    /**
+     * The type of factorization.
+     */
+    Factorization factorization;
+
+    /**
+     * The ordering of the unknowns.
+     */
+    Ordering ordering;
+  };
+
+  /**
+   * Constructor.
+   */
+  SparseDirectSupernodal();
+
+  /**
+   * @name Setting up a sparse factorization
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Store the parameters in @p additional_data and compute the factorization
+   * of the given matrix, calling factorize().
+   */
+  template <class Matrix>
+  void
+  initialize(const Matrix &        matrix,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Compute the ordering, the symbolic factorization, and the numerical
+   * factorization of the given matrix with the parameters given to the last
+   * call of initialize(), or the default parameters.
+   */
+  template <class Matrix>
+  void
+  factorize(const Matrix &matrix);
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that represent the inverse of a matrix
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Preconditioner interface function. Given the source vector, return the
+   * solution of the linear system with the factorized matrix.
+   */
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  vmult(BlockVector<double> &dst, const BlockVector<double> &src) const;
+
+  /**
+   * Same as before, but uses the transpose of the matrix, i.e. this function
+   * multiplies with $A^{-T}$.
+   */
+  void
+  Tvmult(Vector<double> &dst, const Vector<double> &src) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  Tvmult(BlockVector<double> &dst, const BlockVector<double> &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * @}
+   */
+
+  /**
+   * @name Functions that solve linear systems
+   */
+  /**
+   * @{
+   */
+
+  /**
+   * Solve for a certain right hand side vector, overwriting it with the
+   * solution. If @p transpose is set to true, the linear system with the
+   * transpose of the matrix is solved.
+   */
+  void
+  solve(Vector<double> &rhs_and_solution, const bool transpose = false) const;
+
+  /**
+   * Same as before, but for block vectors.
+   */
+  void
+  solve(BlockVector<double> &rhs_and_solution,
+        const bool           transpose = false) const;
+
+  /**
+   * Solve for several right hand sides at once. Each column of
+   * @p rhs_and_solution, which must have m() rows, is a right hand side and
+   * is overwritten by the corresponding solution.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution,
+        const bool          transpose = false) const;
+
+  /**
+   * @}
+   */
+
+  /**
+   * Return the number of entries stored in the factors, including the
+   * explicit zeros in the dense blocks of the supernodes.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of supernodes of the factorization.
+   */
+  unsigned int
+  n_supernodes() const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * The factorization ran into a zero pivot.
+   */
+  DeclException1(
+    ExcZeroPivot,
+    size_type,
+    << "The factorization encountered a zero pivot when eliminating row "
+    << arg1
+    << " of the matrix. Either the matrix is singular, or the pivoting "
+    << "strategy of the chosen factorization is not sufficient for it. In "
+    << "the latter case, try the LU factorization if you used the LDL^T "
+    << "factorization, or use SparseDirectUMFPACK.");
+
+private:
+  /**
+   * Free all memory.
+   */
+  void
+  clear();
+
+  /**
+   * Compute the ordering and the symbolic factorization for the sparsity
+   * pattern given in compressed row storage.
+   */
+  void
+  analyze(const std::vector<std::size_t> &row_start,
+          const std::vector<size_type> &  column_indices);
+
+  /**
+   * Compute the numerical factorization for the matrix given in compressed
+   * row storage, after analyze() has been called for its sparsity pattern.
+   */
+  void
+  factorize_numerically(const std::vector<std::size_t> &row_start,
+                        const std::vector<size_type> &  column_indices,
+                        const std::vector<double> &     values);
+
+  /**
+   * Assemble the frontal matrix of the given supernode, eliminate its
+   * columns and store the factors and the update matrix for the parent.
+   * Return the index of the row with a zero pivot, or
+   * numbers::invalid_size_type on success.
+   */
+  size_type
+  factorize_supernode(const unsigned int                 supernode,
+                      const std::vector<std::size_t> &   upper_start,
+                      const std::vector<size_type> &     upper_indices,
+                      const std::vector<double> &        upper_values,
+                      const std::vector<std::size_t> &   lower_start,
+                      const std::vector<size_type> &     lower_indices,
+                      const std::vector<double> &        lower_values,
+                      std::vector<std::vector<double>> &update_matrices);
+
+  /**
+   * Solve with the factors for the right hand sides stored row by row in
+   * @p values, with @p n_rhs entries per row, in the permuted numbering.
+   */
+  void
+  solve_permuted(double *           values,
+                 const unsigned int n_rhs,
+                 const bool         transpose) const;
+
+  /**
+   * The parameters of the factorization.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The size of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * The ordering of the unknowns: entry @p i is the index in the original
+   * numbering of the unknown that is eliminated in position @p i.
+   */
+  std::vector<size_type> permutation;
+
+  /**
+   * The first column of each supernode, with an additional entry holding
+   * the total number of columns.
+   */
+  std::vector<size_type> supernode_start;
+
+  /**
+   * The parent of each supernode in the elimination tree, or
+   * numbers::invalid_unsigned_int for roots.
+   */
+  std::vector<unsigned int> supernode_parent;
+
+  /**
+   * The children of the supernodes in compressed storage, i.e., the
+   * children of supernode @p s are
+   * <tt>children[children_start[s]]</tt> to
+   * <tt>children[children_start[s+1]-1]</tt>.
+   */
+  std::vector<unsigned int> children_start;
+  std::vector<unsigned int> children;
+
+  /**
+   * The rows below the diagonal block of each supernode, i.e., the indices
+   * that the Schur complement of the supernode couples to, sorted
+   * ascendingly. Stored in compressed form with offsets in
+   * structure_start.
+   */
+  std::vector<std::size_t> structure_start;
+  std::vector<size_type>   structure;
+
+  /**
+   * The supernodes grouped by their height in the elimination tree: the
+   * supernodes of one group only depend on those of the previous groups.
+   */
+  std::vector<unsigned int> level_start;
+  std::vector<unsigned int> level_supernodes;
+
+  /**
+   * The offset of the factors of each supernode into factor_values. For a
+   * supernode with @p k columns and @p r rows below its diagonal block, the
+   * factors consist of the first @p k columns of the frontal matrix, stored
+   * row by row as a dense $(k+r)\times k$ matrix, followed by the last
+   * @p r columns of its first @p k rows, stored as a dense $k \times r$
+   * matrix, in case of the $LU$ factorization.
+   */
+  std::vector<std::size_t> factor_start;
+
+  /**
+   * The values of the factors.
+   */
+  std::vector<double> factor_values;
+
+  /**
+   * The row interchanges of the $LU$ factorization, as local indices within
+   * the diagonal block of each supernode.
+   */
+  std::vector<unsigned int> pivots;
+};
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // dealii_sparse_direct_supernodal_h
@@ -20,6 +20,8 @@
 
 #  include <deal.II/base/config.h>
 
+#  include <deal.II/base/thread_local_storage.h>
+
 #  include <deal.II/lac/sparse_ilu.h>
 #  include <deal.II/lac/vector.h>
 
@@ -61,74 +63,82 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
   number *luval = this->SparseMatrix<number>::val.get();
 
-  const size_type N    = this->m();
-  size_type       jrow = 0;
+  const size_type N = this->m();
 
-  std::vector<size_type> iw(N, numbers::invalid_size_type);
+  // row k only reads rows jrow<k that are in its own sparsity pattern, i.e.,
+  // rows of earlier levels of the forward substitution. the rows of one level
+  // can therefore be factorized concurrently, with one copy of the
+  // scratch array iw per thread
+  Threads::ThreadLocalStorage<std::vector<size_type>> iw_storage(
+    std::vector<size_type>(N, numbers::invalid_size_type));
 
-  for (size_type k = 0; k < N; ++k)
-    {
-      const size_type j1 = ia[k], j2 = ia[k + 1] - 1;
+  const auto factorize_row = [&](const size_type k) {
+    std::vector<size_type> &iw = iw_storage.get();
 
-      for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = j;
+    const size_type j1 = ia[k], j2 = ia[k + 1] - 1;
+    size_type       jrow = 0;
 
-      // the algorithm in the book works on the elements of row k left of the
-      // diagonal. however, since we store the diagonal element at the first
-      // position, start at the element after the diagonal and run as long as
-      // we don't walk into the right half
-      size_type j = j1 + 1;
+    for (size_type j = j1; j <= j2; ++j)
+      iw[ja[j]] = j;
 
-      // pathological case: the current row of the matrix has only the
-      // diagonal entry. then we have nothing to do.
-      if (j > j2)
-        goto label_200;
+    // the algorithm in the book works on the elements of row k left of the
+    // diagonal. however, since we store the diagonal element at the first
+    // position, start at the element after the diagonal and run as long as
+    // we don't walk into the right half
+    size_type j = j1 + 1;
 
-    label_150:
+    // pathological case: the current row of the matrix has only the
+    // diagonal entry. then we have nothing to do.
+    if (j > j2)
+      goto label_200;
 
-      jrow = ja[j];
-      if (jrow >= k)
-        goto label_200;
+  label_150:
 
-      // actual computations:
-      {
-        number t1 = luval[j] * luval[ia[jrow]];
-        luval[j]  = t1;
-
-        // jj runs from just right of the diagonal to the end of the row
-        size_type jj = ia[jrow] + 1;
-        while (ja[jj] < jrow)
-          ++jj;
-        for (; jj < ia[jrow + 1]; ++jj)
-          {
-            const size_type jw = iw[ja[jj]];
-            if (jw != numbers::invalid_size_type)
-              luval[jw] -= t1 * luval[jj];
-          }
-
-        ++j;
-        if (j <= j2)
-          goto label_150;
-      }
+    jrow = ja[j];
+    if (jrow >= k)
+      goto label_200;
+
+    // actual computations:
+    {
+      number t1 = luval[j] * luval[ia[jrow]];
+      luval[j]  = t1;
+
+      // jj runs from just right of the diagonal to the end of the row
+      size_type jj = ia[jrow] + 1;
+      while (ja[jj] < jrow)
+        ++jj;
+      for (; jj < ia[jrow + 1]; ++jj)
+        {
+          const size_type jw = iw[ja[jj]];
+          if (jw != numbers::invalid_size_type)
+            luval[jw] -= t1 * luval[jj];
+        }
+
+      ++j;
+      if (j <= j2)
+        goto label_150;
+    }
 
-    label_200:
+  label_200:
 
-      // in the book there is an assertion that we have hit the diagonal
-      // element, i.e. that jrow==k. however, we store the diagonal element at
-      // the front, so jrow must actually be larger than k or j is already in
-      // the next row
-      Assert((jrow > k) || (j == ia[k + 1]), ExcInternalError());
+    // in the book there is an assertion that we have hit the diagonal
+    // element, i.e. that jrow==k. however, we store the diagonal element at
+    // the front, so jrow must actually be larger than k or j is already in
+    // the next row
+    Assert((jrow > k) || (j == ia[k + 1]), ExcInternalError());
 
-      // now we have to deal with the diagonal element. in the book it is
-      // located at position 'j', but here we use the convention of storing
-      // the diagonal element first, so instead of j we use uptr[k]=ia[k]
-      Assert(luval[ia[k]] != 0, ExcZeroPivot(k));
+    // now we have to deal with the diagonal element. in the book it is
+    // located at position 'j', but here we use the convention of storing
+    // the diagonal element first, so instead of j we use uptr[k]=ia[k]
+    Assert(luval[ia[k]] != 0, ExcZeroPivot(k));
 
-      luval[ia[k]] = 1. / luval[ia[k]];
+    luval[ia[k]] = 1. / luval[ia[k]];
 
-      for (size_type j = j1; j <= j2; ++j)
-        iw[ja[j]] = numbers::invalid_size_type;
-    }
+    for (size_type j = j1; j <= j2; ++j)
+      iw[ja[j]] = numbers::invalid_size_type;
+  };
+
+  this->apply_in_level_order(true, factorize_row);
 }
 
 
@@ -143,75 +153,75 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
-
-  // solve LUx=b in two steps:
-  // first Ly = b, then
-  //       Ux = y
-  //
-  // first a forward solve. since
-  // the diagonal values of L are
-  // one, there holds
-  // y_i = b_i
-  //       - sum_{j=0}^{i-1} L_{ij}y_j
-  // we split the y_i = b_i off and
-  // perform it at the outset of the
-  // loop
-  dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
+  const SparsityPattern &  sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const size_type *const   column_numbers   = sparsity.colnums.get();
+
+  const number *const luval = this->SparseMatrix<number>::val.get();
+
+  const auto substitute = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
+
+    // solve LUx=b in two steps:
+    // first Ly = b, then
+    //       Ux = y
+    //
+    // first a forward solve. since
+    // the diagonal values of L are
+    // one, there holds
+    // y_i = b_i
+    //       - sum_{j=0}^{i-1} L_{ij}y_j
+    // we split the y_i = b_i off and
+    // perform it at the outset of the
+    // loop
+    //
+    // the rows are processed level by
+    // level, see apply_in_level_order()
+    dst = src;
+    this->apply_in_level_order(true, [&](const size_type row) {
       // get start of this row. skip the
       // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
+      const std::size_t rowstart = rowstart_indices[row] + 1;
       // find the position where the part
       // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      somenumber    dst_row = dst(row);
-      const number *luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
-      dst(row) = dst_row;
-    }
+      const std::size_t first_after_diagonal =
+        this->prebuilt_lower_bound[row] - column_numbers;
 
-  // now the backward solve. same
-  // procedure, but we need not set
-  // dst before, since this is already
-  // done.
-  //
-  // note that we need to scale now,
-  // since the diagonal is not equal to
-  // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
+      somenumber dst_row = dst(row);
+      for (std::size_t j = rowstart; j < first_after_diagonal; ++j)
+        dst_row -= luval[j] * dst(get_column_index(column_indices[j], row));
+      dst(row) = dst_row;
+    });
+
+    // now the backward solve. same
+    // procedure, but we need not set
+    // dst before, since this is already
+    // done.
+    //
+    // note that we need to scale now,
+    // since the diagonal is not equal to
+    // one now
+    this->apply_in_level_order(false, [&](const size_type row) {
       // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
+      const std::size_t rowend = rowstart_indices[row + 1];
       // find the position where the part
       // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
+      const std::size_t first_after_diagonal =
+        this->prebuilt_lower_bound[row] - column_numbers;
 
-      somenumber    dst_row = dst(row);
-      const number *luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        dst_row -= *luval * dst(*col);
+      somenumber dst_row = dst(row);
+      for (std::size_t j = first_after_diagonal; j < rowend; ++j)
+        dst_row -= luval[j] * dst(get_column_index(column_indices[j], row));
 
       // scale by the diagonal element.
       // note that the diagonal element
       // was stored inverted
       dst(row) = dst_row * this->diag_element(row);
-    }
+    });
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(sparsity,
+                                                           substitute);
 }
 
 
@@ -225,76 +235,76 @@ SparseILU<number>::Tvmult(Vector<somenumber> &      dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
-  const std::size_t *const rowstart_indices =
-    this->get_sparsity_pattern().rowstart.get();
-  const size_type *const column_numbers =
-    this->get_sparsity_pattern().colnums.get();
-
-  // solve (LU)'x=b in two steps:
-  // first U'y = b, then
-  //       L'x = y
-  //
-  // first a forward solve. Due to the
-  // fact that the transpose of U'
-  // is not easily accessible, a
-  // temporary vector is required.
-  Vector<somenumber> tmp(N);
-
-  dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
-      dst(row) -= tmp(row);
-      // scale by the diagonal element.
-      // note that the diagonal element
-      // was stored inverted
-      dst(row) *= this->diag_element(row);
+  const size_type          N                = dst.size();
+  const SparsityPattern &  sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+  const size_type *const   column_numbers   = sparsity.colnums.get();
 
-      // get end of this row
-      const size_type *const rowend =
-        &column_numbers[rowstart_indices[row + 1]];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      const somenumber dst_row = dst(row);
-      const number *   luval   = this->SparseMatrix<number>::val.get() +
-                            (first_after_diagonal - column_numbers);
-      for (const size_type *col = first_after_diagonal; col != rowend;
-           ++col, ++luval)
-        tmp(*col) += *luval * dst_row;
-    }
+  const number *const luval = this->SparseMatrix<number>::val.get();
 
-  // now the backward solve. same
-  // procedure, but we need not set
-  // dst before, since this is already
-  // done.
-  //
-  // note that we no scaling is required
-  // now, since the diagonal is one
-  // now
-  tmp = 0;
-  for (int row = N - 1; row >= 0; --row)
-    {
-      dst(row) -= tmp(row);
+  const auto substitute = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
 
-      // get start of this row. skip the
-      // diagonal element
-      const size_type *const rowstart =
-        &column_numbers[rowstart_indices[row] + 1];
-      // find the position where the part
-      // right of the diagonal starts
-      const size_type *const first_after_diagonal =
-        this->prebuilt_lower_bound[row];
-
-      const somenumber dst_row = dst(row);
-      const number *   luval =
-        this->SparseMatrix<number>::val.get() + (rowstart - column_numbers);
-      for (const size_type *col = rowstart; col != first_after_diagonal;
-           ++col, ++luval)
-        tmp(*col) += *luval * dst_row;
-    }
+    // solve (LU)'x=b in two steps:
+    // first U'y = b, then
+    //       L'x = y
+    //
+    // first a forward solve. Due to the
+    // fact that the transpose of U'
+    // is not easily accessible, a
+    // temporary vector is required.
+    Vector<somenumber> tmp(N);
+
+    dst = src;
+    for (size_type row = 0; row < N; ++row)
+      {
+        dst(row) -= tmp(row);
+        // scale by the diagonal element.
+        // note that the diagonal element
+        // was stored inverted
+        dst(row) *= this->diag_element(row);
+
+        // get end of this row
+        const std::size_t rowend = rowstart_indices[row + 1];
+        // find the position where the part
+        // right of the diagonal starts
+        const std::size_t first_after_diagonal =
+          this->prebuilt_lower_bound[row] - column_numbers;
+
+        const somenumber dst_row = dst(row);
+        for (std::size_t j = first_after_diagonal; j < rowend; ++j)
+          tmp(get_column_index(column_indices[j], row)) += luval[j] * dst_row;
+      }
+
+    // now the backward solve. same
+    // procedure, but we need not set
+    // dst before, since this is already
+    // done.
+    //
+    // note that we no scaling is required
+    // now, since the diagonal is one
+    // now
+    tmp = 0;
+    for (int row = N - 1; row >= 0; --row)
+      {
+        dst(row) -= tmp(row);
+
+        // get start of this row. skip the
+        // diagonal element
+        const std::size_t rowstart = rowstart_indices[row] + 1;
+        // find the position where the part
+        // right of the diagonal starts
+        const std::size_t first_after_diagonal =
+          this->prebuilt_lower_bound[row] - column_numbers;
+
+        const somenumber dst_row = dst(row);
+        for (std::size_t j = rowstart; j < first_after_diagonal; ++j)
+          tmp(get_column_index(column_indices[j], row)) += luval[j] * dst_row;
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(sparsity,
+                                                           substitute);
 }
 
 
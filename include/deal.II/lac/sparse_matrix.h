@@ -45,6 +45,8 @@ template <typename Matrix>
 class BlockMatrixBase;
 template <typename number>
 class SparseILU;
+template <typename number>
+class SparseMIC;
 #    ifdef DEAL_II_WITH_MPI
 namespace Utilities
 {
@@ -483,6 +485,25 @@ namespace SparseMatrixIterators
  * SparseMatrix::end) you will find that the elements are not sorted by column
  * index within each row whenever the matrix is square.
  *
+ * <h3>Mixed precision</h3>
+ *
+ * Matrix-vector products with sparse matrices are limited by the memory
+ * bandwidth, and the matrix entries make up a large part of the data that
+ * needs to be loaded. A SparseMatrix<float> can be applied to vectors of
+ * doubles (Vector<double> and, in serial,
+ * LinearAlgebra::distributed::Vector<double>), in which case the products
+ * are summed up in double precision and only the matrix entries are
+ * rounded to single precision. This is typically used for preconditioners:
+ * a SparseMatrix<float> is filled from the system matrix with copy_from(),
+ * and PreconditionSSOR, PreconditionChebyshev or SparseILU<float> set up
+ * from it are passed to a solver like SolverCG or SolverGMRES that works on
+ * the double-precision system matrix. The solver then still converges to
+ * the full accuracy of the double-precision system, since the
+ * preconditioner only needs to approximate the inverse. If deal.II uses
+ * 64-bit indices, calling SparsityPattern::store_column_offsets() for the
+ * pattern of the float matrix also reduces the index data these
+ * preconditioners load per entry to 32 bits.
+ *
  * @note Instantiations for this template are provided for <tt>@<float@> and
  * @<double@></tt>; others can be generated in application programs (see the
  * section on
@@ -1100,6 +1121,25 @@ public:
   void
   vmult(OutVector &dst, const InVector &src) const;
 
+  /**
+   * Matrix-vector multiplication with several vectors at once: let
+   * <i>dst[i] = M*src[i]</i> for all vectors in @p src. For vectors that
+   * store their elements contiguously (dealii::Vector and serial
+   * LinearAlgebra::distributed::Vector objects), the matrix entries and
+   * column indices are only read once for all vectors rather than once per
+   * vector, which makes this function considerably faster than calling
+   * vmult() for each vector in turn. This is the operation needed by block
+   * Krylov methods such as SolverBlockCG. For other vector types, this
+   * function simply calls vmult() for each vector.
+   *
+   * Source and destination vectors must not be the same.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  template <typename VectorType>
+  void
+  vmult(std::vector<VectorType> &dst, const std::vector<VectorType> &src) const;
+
   /**
    * Matrix-vector multiplication: let <i>dst = M<sup>T</sup>*src</i> with
    * <i>M</i> being this matrix. This function does the same as vmult() but
@@ -1733,6 +1773,8 @@ private:
   friend class SparseLUDecomposition;
   template <typename>
   friend class SparseILU;
+  template <typename>
+  friend class SparseMIC;
 
   // To allow it calling private prepare_add() and prepare_set().
   template <typename>
@@ -25,6 +25,7 @@
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/lac/vector.h>
@@ -483,49 +484,222 @@ namespace internal
   namespace SparseMatrixImplementation
   {
     /**
-     * Perform a vmult using the SparseMatrix data structures, but only using
-     * a subinterval for the row indices.
+     * Return a pointer to the elements of @p src if they are stored
+     * contiguously and in the order of the global indices, which allows
+     * the inner loop of vmult_on_subrange() to read them without going
+     * through the access operator of the vector class. Return a null
+     * pointer otherwise.
+     */
+    template <typename VectorType>
+    const typename VectorType::value_type *
+    get_contiguous_data(const VectorType &)
+    {
+      return nullptr;
+    }
+
+
+
+    template <typename Number>
+    const Number *
+    get_contiguous_data(const Vector<Number> &src)
+    {
+      return src.begin();
+    }
+
+
+
+    template <typename Number>
+    const Number *
+    get_contiguous_data(
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &src)
+    {
+      // only if all elements are locally owned do local and global indices
+      // coincide
+      if (src.locally_owned_size() == src.size())
+        return src.begin();
+      else
+        return nullptr;
+    }
+
+
+
+    /**
+     * Perform a vmult on the rows [begin_row, end_row), reading the
+     * elements of the source vector through @p src_accessor. The products
+     * are summed up in the number type of the destination vector, i.e., in
+     * double precision when applying a SparseMatrix<float> to a
+     * Vector<double>.
      *
-     * In the sequential case, this function is called on all rows, in the
-     * parallel case it may be called on a subrange, at the discretion of the
-     * task scheduler.
+     * @p colnums is either the array of column numbers or the array of
+     * column offsets of the sparsity pattern.
      */
-    template <typename number, typename InVector, typename OutVector>
+    template <typename number,
+              typename IndexType,
+              typename Accessor,
+              typename OutVector>
     void
-    vmult_on_subrange(const size_type    begin_row,
-                      const size_type    end_row,
-                      const number *     values,
-                      const std::size_t *rowstart,
-                      const size_type *  colnums,
-                      const InVector &   src,
-                      OutVector &        dst,
-                      const bool         add)
+    vmult_on_subrange_impl(const size_type    begin_row,
+                           const size_type    end_row,
+                           const number *     values,
+                           const std::size_t *rowstart,
+                           const IndexType *  colnums,
+                           const Accessor &   src_accessor,
+                           OutVector &        dst,
+                           const bool         add)
     {
+      using OutNumber = typename OutVector::value_type;
+      using internals::SparsityPatternTools::get_column_index;
+
       const number *               val_ptr    = &values[rowstart[begin_row]];
-      const size_type *            colnum_ptr = &colnums[rowstart[begin_row]];
+      const IndexType *            colnum_ptr = &colnums[rowstart[begin_row]];
       typename OutVector::iterator dst_ptr    = dst.begin() + begin_row;
 
       if (add == false)
         for (size_type row = begin_row; row < end_row; ++row)
           {
-            typename OutVector::value_type s   = 0.;
+            OutNumber           s              = 0.;
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+              s +=
+                OutNumber(*val_ptr++) *
+                OutNumber(src_accessor(get_column_index(*colnum_ptr++, row)));
             *dst_ptr++ = s;
           }
       else
         for (size_type row = begin_row; row < end_row; ++row)
           {
-            typename OutVector::value_type s   = *dst_ptr;
+            OutNumber           s              = *dst_ptr;
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
-              s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+              s +=
+                OutNumber(*val_ptr++) *
+                OutNumber(src_accessor(get_column_index(*colnum_ptr++, row)));
             *dst_ptr++ = s;
           }
     }
+
+
+
+    /**
+     * Perform a vmult using the SparseMatrix data structures, but only using
+     * a subinterval for the row indices.
+     *
+     * In the sequential case, this function is called on all rows, in the
+     * parallel case it may be called on a subrange, at the discretion of the
+     * task scheduler.
+     */
+    template <typename number,
+              typename IndexType,
+              typename InVector,
+              typename OutVector>
+    void
+    vmult_on_subrange(const size_type    begin_row,
+                      const size_type    end_row,
+                      const number *     values,
+                      const std::size_t *rowstart,
+                      const IndexType *  colnums,
+                      const InVector &   src,
+                      OutVector &        dst,
+                      const bool         add)
+    {
+      if (const auto src_ptr = get_contiguous_data(src))
+        vmult_on_subrange_impl(
+          begin_row,
+          end_row,
+          values,
+          rowstart,
+          colnums,
+          [src_ptr](const size_type i) { return src_ptr[i]; },
+          dst,
+          add);
+      else
+        vmult_on_subrange_impl(
+          begin_row,
+          end_row,
+          values,
+          rowstart,
+          colnums,
+          [&src](const size_type i) { return src(i); },
+          dst,
+          add);
+    }
+
+
+
+    /**
+     * Add the product of the transpose of the matrix given by @p values,
+     * @p rowstart, and @p colnums with @p src to @p dst. @p colnums is
+     * either the array of column numbers or the array of column offsets of
+     * the sparsity pattern.
+     */
+    template <typename number,
+              typename IndexType,
+              typename InVector,
+              typename OutVector>
+    void
+    Tvmult_add_impl(const size_type    n_rows,
+                    const number *     values,
+                    const std::size_t *rowstart,
+                    const IndexType *  colnums,
+                    const InVector &   src,
+                    OutVector &        dst)
+    {
+      using internals::SparsityPatternTools::get_column_index;
+
+      for (size_type i = 0; i < n_rows; ++i)
+        for (std::size_t j = rowstart[i]; j < rowstart[i + 1]; ++j)
+          {
+            const size_type p = get_column_index(colnums[j], i);
+            dst(p) += typename OutVector::value_type(values[j]) *
+                      typename OutVector::value_type(src(i));
+          }
+    }
+
+
+
+    /**
+     * The maximal number of vectors processed together by
+     * vmult_multiple_on_subrange(). Larger groups of vectors are split into
+     * groups of this size in order to keep the partial sums in registers.
+     */
+    constexpr unsigned int vmult_multiple_group_size = 8;
+
+
+
+    /**
+     * Perform a vmult on the rows [begin_row, end_row) for up to
+     * vmult_multiple_group_size vectors at once, given by pointers to their
+     * elements. Each matrix entry and column index is read once for all
+     * vectors.
+     */
+    template <typename number, typename IndexType, typename OutNumber>
+    void
+    vmult_multiple_on_subrange(const size_type         begin_row,
+                               const size_type         end_row,
+                               const number *          values,
+                               const std::size_t *     rowstart,
+                               const IndexType *       colnums,
+                               const unsigned int      n_vectors,
+                               const OutNumber *const *src,
+                               OutNumber *const *      dst)
+    {
+      using internals::SparsityPatternTools::get_column_index;
+      AssertIndexRange(n_vectors, vmult_multiple_group_size + 1);
+
+      for (size_type row = begin_row; row < end_row; ++row)
+        {
+          OutNumber s[vmult_multiple_group_size] = {};
+          for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+            {
+              const OutNumber value  = values[j];
+              const size_type column = get_column_index(colnums[j], row);
+              for (unsigned int v = 0; v < n_vectors; ++v)
+                s[v] += value * src[v][column];
+            }
+          for (unsigned int v = 0; v < n_vectors; ++v)
+            dst[v][row] = s[v];
+        }
+    }
   } // namespace SparseMatrixImplementation
 } // namespace internal
 
@@ -779,15 +953,91 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
     0U,
     m(),
     [this, &src, &dst](const size_type begin_row, const size_type end_row) {
-      internal::SparseMatrixImplementation::vmult_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        src,
-        dst,
-        false);
+      internals::SparsityPatternTools::dispatch_column_indices(
+        *cols, [&](const auto *const column_indices) {
+          internal::SparseMatrixImplementation::vmult_on_subrange(
+            begin_row,
+            end_row,
+            val.get(),
+            cols->rowstart.get(),
+            column_indices,
+            src,
+            dst,
+            false);
+        });
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+void
+SparseMatrix<number>::vmult(std::vector<VectorType> &      dst,
+                            const std::vector<VectorType> &src) const
+{
+  using OutNumber = typename VectorType::value_type;
+
+  Assert(cols != nullptr, ExcNotInitialized());
+  Assert(val != nullptr, ExcNotInitialized());
+  AssertDimension(dst.size(), src.size());
+
+  // collect pointers to the elements of the vectors. if one of them does
+  // not store its elements contiguously, fall back to one vmult per vector.
+  // get_contiguous_data() only provides read access, but casting away the
+  // constness is safe for the destination vectors we own here
+  std::vector<const OutNumber *> src_ptrs(src.size());
+  std::vector<OutNumber *>       dst_ptrs(dst.size());
+  bool                           all_contiguous = true;
+  for (unsigned int v = 0; v < src.size(); ++v)
+    {
+      Assert(m() == dst[v].size(), ExcDimensionMismatch(m(), dst[v].size()));
+      Assert(n() == src[v].size(), ExcDimensionMismatch(n(), src[v].size()));
+      Assert(!PointerComparison::equal(&src[v], &dst[v]),
+             ExcSourceEqualsDestination());
+
+      src_ptrs[v] =
+        internal::SparseMatrixImplementation::get_contiguous_data(src[v]);
+      dst_ptrs[v] = const_cast<OutNumber *>(
+        internal::SparseMatrixImplementation::get_contiguous_data(
+          static_cast<const VectorType &>(dst[v])));
+      if (src_ptrs[v] == nullptr || dst_ptrs[v] == nullptr)
+        all_contiguous = false;
+    }
+
+  if (all_contiguous == false)
+    {
+      for (unsigned int v = 0; v < src.size(); ++v)
+        vmult(dst[v], src[v]);
+      return;
+    }
+
+  parallel::apply_to_subranges(
+    0U,
+    m(),
+    [this, &src_ptrs, &dst_ptrs](const size_type begin_row,
+                                 const size_type end_row) {
+      const unsigned int group_size =
+        internal::SparseMatrixImplementation::vmult_multiple_group_size;
+      for (unsigned int first = 0; first < src_ptrs.size();
+           first += group_size)
+        {
+          const unsigned int n_vectors =
+            std::min<unsigned int>(group_size, src_ptrs.size() - first);
+          internals::SparsityPatternTools::dispatch_column_indices(
+            *cols, [&](const auto *const column_indices) {
+              internal::SparseMatrixImplementation::vmult_multiple_on_subrange(
+                begin_row,
+                end_row,
+                val.get(),
+                cols->rowstart.get(),
+                column_indices,
+                n_vectors,
+                src_ptrs.data() + first,
+                dst_ptrs.data() + first);
+            });
+        }
     },
     internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 }
@@ -808,15 +1058,16 @@ SparseMatrix<number>::Tvmult(OutVector &dst, const InVector &src) const
 
   dst = 0;
 
-  for (size_type i = 0; i < m(); ++i)
-    {
-      for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-        {
-          const size_type p = cols->colnums[j];
-          dst(p) += typename OutVector::value_type(val[j]) *
-                    typename OutVector::value_type(src(i));
-        }
-    }
+  internals::SparsityPatternTools::dispatch_column_indices(
+    *cols, [&](const auto *const column_indices) {
+      internal::SparseMatrixImplementation::Tvmult_add_impl(
+        m(),
+        val.get(),
+        cols->rowstart.get(),
+        column_indices,
+        src,
+        dst);
+    });
 }
 
 
@@ -837,15 +1088,18 @@ SparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
     0U,
     m(),
     [this, &src, &dst](const size_type begin_row, const size_type end_row) {
-      internal::SparseMatrixImplementation::vmult_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        src,
-        dst,
-        true);
+      internals::SparsityPatternTools::dispatch_column_indices(
+        *cols, [&](const auto *const column_indices) {
+          internal::SparseMatrixImplementation::vmult_on_subrange(
+            begin_row,
+            end_row,
+            val.get(),
+            cols->rowstart.get(),
+            column_indices,
+            src,
+            dst,
+            true);
+        });
     },
     internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 }
@@ -864,13 +1118,16 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
-  for (size_type i = 0; i < m(); ++i)
-    for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-      {
-        const size_type p = cols->colnums[j];
-        dst(p) += typename OutVector::value_type(val[j]) *
-                  typename OutVector::value_type(src(i));
-      }
+  internals::SparsityPatternTools::dispatch_column_indices(
+    *cols, [&](const auto *const column_indices) {
+      internal::SparseMatrixImplementation::Tvmult_add_impl(
+        m(),
+        val.get(),
+        cols->rowstart.get(),
+        column_indices,
+        src,
+        dst);
+    });
 }
 
 
@@ -886,22 +1143,25 @@ namespace internal
      * parallel case it may be called on a subrange, at the discretion of the
      * task scheduler.
      */
-    template <typename number, typename InVector>
+    template <typename number, typename IndexType, typename InVector>
     typename InVector::value_type
     matrix_norm_sqr_on_subrange(const size_type    begin_row,
                                 const size_type    end_row,
                                 const number *     values,
                                 const std::size_t *rowstart,
-                                const size_type *  colnums,
+                                const IndexType *  colnums,
                                 const InVector &   v)
     {
+      using internals::SparsityPatternTools::get_column_index;
+
       typename InVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename InVector::value_type s = 0;
           for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s += typename InVector::value_type(values[j]) * v(colnums[j]);
+            s += typename InVector::value_type(values[j]) *
+                 v(get_column_index(colnums[j], i));
           norm_sqr +=
             v(i) *
             numbers::NumberTraits<typename InVector::value_type>::conjugate(s);
@@ -925,13 +1185,16 @@ SparseMatrix<number>::matrix_norm_square(const Vector<somenumber> &v) const
 
   return parallel::accumulate_from_subranges<somenumber>(
     [this, &v](const size_type begin_row, const size_type end_row) {
-      return internal::SparseMatrixImplementation::matrix_norm_sqr_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        v);
+      return internals::SparsityPatternTools::dispatch_column_indices(
+        *cols, [&](const auto *const column_indices) {
+          return internal::SparseMatrixImplementation::
+            matrix_norm_sqr_on_subrange(begin_row,
+                                        end_row,
+                                        val.get(),
+                                        cols->rowstart.get(),
+                                        column_indices,
+                                        v);
+        });
     },
     0,
     m(),
@@ -952,23 +1215,26 @@ namespace internal
      * parallel case it may be called on a subrange, at the discretion of the
      * task scheduler.
      */
-    template <typename number, typename InVector>
+    template <typename number, typename IndexType, typename InVector>
     typename InVector::value_type
     matrix_scalar_product_on_subrange(const size_type    begin_row,
                                       const size_type    end_row,
                                       const number *     values,
                                       const std::size_t *rowstart,
-                                      const size_type *  colnums,
+                                      const IndexType *  colnums,
                                       const InVector &   u,
                                       const InVector &   v)
     {
+      using internals::SparsityPatternTools::get_column_index;
+
       typename InVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename InVector::value_type s = 0;
           for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s += typename InVector::value_type(values[j]) * v(colnums[j]);
+            s += typename InVector::value_type(values[j]) *
+                 v(get_column_index(colnums[j], i));
           norm_sqr +=
             u(i) *
             numbers::NumberTraits<typename InVector::value_type>::conjugate(s);
@@ -993,14 +1259,17 @@ SparseMatrix<number>::matrix_scalar_product(const Vector<somenumber> &u,
 
   return parallel::accumulate_from_subranges<somenumber>(
     [this, &u, &v](const size_type begin_row, const size_type end_row) {
-      return internal::SparseMatrixImplementation::
-        matrix_scalar_product_on_subrange(begin_row,
-                                          end_row,
-                                          val.get(),
-                                          cols->rowstart.get(),
-                                          cols->colnums.get(),
-                                          u,
-                                          v);
+      return internals::SparsityPatternTools::dispatch_column_indices(
+        *cols, [&](const auto *const column_indices) {
+          return internal::SparseMatrixImplementation::
+            matrix_scalar_product_on_subrange(begin_row,
+                                              end_row,
+                                              val.get(),
+                                              cols->rowstart.get(),
+                                              column_indices,
+                                              u,
+                                              v);
+        });
     },
     0,
     m(),
@@ -1296,24 +1565,30 @@ namespace internal
      * parallel case it may be called on a subrange, at the discretion of the
      * task scheduler.
      */
-    template <typename number, typename InVector, typename OutVector>
+    template <typename number,
+              typename IndexType,
+              typename InVector,
+              typename OutVector>
     typename OutVector::value_type
     residual_sqr_on_subrange(const size_type    begin_row,
                              const size_type    end_row,
                              const number *     values,
                              const std::size_t *rowstart,
-                             const size_type *  colnums,
+                             const IndexType *  colnums,
                              const InVector &   u,
                              const InVector &   b,
                              OutVector &        dst)
     {
+      using internals::SparsityPatternTools::get_column_index;
+
       typename OutVector::value_type norm_sqr = 0.;
 
       for (size_type i = begin_row; i < end_row; ++i)
         {
           typename OutVector::value_type s = b(i);
           for (size_type j = rowstart[i]; j < rowstart[i + 1]; ++j)
-            s -= typename OutVector::value_type(values[j]) * u(colnums[j]);
+            s -= typename OutVector::value_type(values[j]) *
+                 u(get_column_index(colnums[j], i));
           dst(i) = s;
           norm_sqr +=
             s *
@@ -1342,15 +1617,18 @@ SparseMatrix<number>::residual(Vector<somenumber> &      dst,
 
   return std::sqrt(parallel::accumulate_from_subranges<somenumber>(
     [this, &u, &b, &dst](const size_type begin_row, const size_type end_row) {
-      return internal::SparseMatrixImplementation::residual_sqr_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        u,
-        b,
-        dst);
+      return internals::SparsityPatternTools::dispatch_column_indices(
+        *cols, [&](const auto *const column_indices) {
+          return internal::SparseMatrixImplementation::residual_sqr_on_subrange(
+            begin_row,
+            end_row,
+            val.get(),
+            cols->rowstart.get(),
+            column_indices,
+            u,
+            b,
+            dst);
+        });
     },
     0,
     m(),
@@ -1455,115 +1733,129 @@ SparseMatrix<number>::precondition_SSOR(
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  const size_type    n            = src.size();
-  const std::size_t *rowstart_ptr = cols->rowstart.get();
-  somenumber *       dst_ptr      = &dst(0);
+  const size_type n = src.size();
 
-  // case when we have stored the position
-  // just right of the diagonal (then we
-  // don't have to search for it).
-  if (pos_right_of_diagonal.size() != 0)
-    {
-      Assert(pos_right_of_diagonal.size() == dst.size(),
-             ExcDimensionMismatch(pos_right_of_diagonal.size(), dst.size()));
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
 
-      // forward sweep
-      for (size_type row = 0; row < n; ++row, ++dst_ptr, ++rowstart_ptr)
-        {
-          *dst_ptr = src(row);
-          const std::size_t first_right_of_diagonal_index =
-            pos_right_of_diagonal[row];
-          Assert(first_right_of_diagonal_index <= *(rowstart_ptr + 1),
-                 ExcInternalError());
-          number s = 0;
-          for (size_type j = (*rowstart_ptr) + 1;
-               j < first_right_of_diagonal_index;
-               ++j)
-            s += val[j] * number(dst(cols->colnums[j]));
-
-          // divide by diagonal element
-          *dst_ptr -= s * om;
-          *dst_ptr /= val[*rowstart_ptr];
-        }
+    const std::size_t *rowstart_ptr = cols->rowstart.get();
+    somenumber *       dst_ptr      = &dst(0);
 
-      rowstart_ptr = cols->rowstart.get();
-      dst_ptr      = &dst(0);
-      for (; rowstart_ptr != &cols->rowstart[n]; ++rowstart_ptr, ++dst_ptr)
-        *dst_ptr *=
-          somenumber(om * (number(2.) - om)) * somenumber(val[*rowstart_ptr]);
+    // case when we have stored the position
+    // just right of the diagonal (then we
+    // don't have to search for it).
+    if (pos_right_of_diagonal.size() != 0)
+      {
+        Assert(pos_right_of_diagonal.size() == dst.size(),
+               ExcDimensionMismatch(pos_right_of_diagonal.size(), dst.size()));
 
-      // backward sweep
-      rowstart_ptr = &cols->rowstart[n - 1];
-      dst_ptr      = &dst(n - 1);
-      for (int row = n - 1; row >= 0; --row, --rowstart_ptr, --dst_ptr)
-        {
-          const size_type end_row = *(rowstart_ptr + 1);
-          const size_type first_right_of_diagonal_index =
-            pos_right_of_diagonal[row];
-          number s = 0;
-          for (size_type j = first_right_of_diagonal_index; j < end_row; ++j)
-            s += val[j] * number(dst(cols->colnums[j]));
-
-          *dst_ptr -= s * om;
-          *dst_ptr /= val[*rowstart_ptr];
-        };
-      return;
-    }
+        // forward sweep
+        for (size_type row = 0; row < n; ++row, ++dst_ptr, ++rowstart_ptr)
+          {
+            *dst_ptr = src(row);
+            const std::size_t first_right_of_diagonal_index =
+              pos_right_of_diagonal[row];
+            Assert(first_right_of_diagonal_index <= *(rowstart_ptr + 1),
+                   ExcInternalError());
+            number s = 0;
+            for (size_type j = (*rowstart_ptr) + 1;
+                 j < first_right_of_diagonal_index;
+                 ++j)
+              s += val[j] *
+                   number(dst(get_column_index(column_indices[j], row)));
+
+            // divide by diagonal element
+            *dst_ptr -= s * om;
+            *dst_ptr /= val[*rowstart_ptr];
+          }
 
-  // case when we need to get the position
-  // of the first element right of the
-  // diagonal manually for each sweep.
-  // forward sweep
-  for (size_type row = 0; row < n; ++row, ++dst_ptr, ++rowstart_ptr)
-    {
-      *dst_ptr = src(row);
-      // find the first element in this line
-      // which is on the right of the diagonal.
-      // we need to precondition with the
-      // elements on the left only.
-      // note: the first entry in each
-      // line denotes the diagonal element,
-      // which we need not check.
-      const size_type first_right_of_diagonal_index =
-        (Utilities::lower_bound(cols->colnums.get() + *rowstart_ptr + 1,
-                                cols->colnums.get() + *(rowstart_ptr + 1),
-                                row) -
-         cols->colnums.get());
-
-      number s = 0;
-      for (size_type j = (*rowstart_ptr) + 1; j < first_right_of_diagonal_index;
-           ++j)
-        s += val[j] * number(dst(cols->colnums[j]));
-
-      // divide by diagonal element
-      *dst_ptr -= s * om;
-      Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
-      *dst_ptr /= val[*rowstart_ptr];
-    };
+        rowstart_ptr = cols->rowstart.get();
+        dst_ptr      = &dst(0);
+        for (; rowstart_ptr != &cols->rowstart[n]; ++rowstart_ptr, ++dst_ptr)
+          *dst_ptr *=
+            somenumber(om * (number(2.) - om)) * somenumber(val[*rowstart_ptr]);
 
-  rowstart_ptr = cols->rowstart.get();
-  dst_ptr      = &dst(0);
-  for (size_type row = 0; row < n; ++row, ++rowstart_ptr, ++dst_ptr)
-    *dst_ptr *= somenumber((number(2.) - om)) * somenumber(val[*rowstart_ptr]);
+        // backward sweep
+        rowstart_ptr = &cols->rowstart[n - 1];
+        dst_ptr      = &dst(n - 1);
+        for (int row = n - 1; row >= 0; --row, --rowstart_ptr, --dst_ptr)
+          {
+            const size_type end_row = *(rowstart_ptr + 1);
+            const size_type first_right_of_diagonal_index =
+              pos_right_of_diagonal[row];
+            number s = 0;
+            for (size_type j = first_right_of_diagonal_index; j < end_row; ++j)
+              s += val[j] *
+                   number(dst(get_column_index(column_indices[j], row)));
+
+            *dst_ptr -= s * om;
+            *dst_ptr /= val[*rowstart_ptr];
+          };
+        return;
+      }
 
-  // backward sweep
-  rowstart_ptr = &cols->rowstart[n - 1];
-  dst_ptr      = &dst(n - 1);
-  for (int row = n - 1; row >= 0; --row, --rowstart_ptr, --dst_ptr)
-    {
-      const size_type end_row = *(rowstart_ptr + 1);
-      const size_type first_right_of_diagonal_index =
-        (Utilities::lower_bound(&cols->colnums[*rowstart_ptr + 1],
-                                &cols->colnums[end_row],
-                                static_cast<size_type>(row)) -
-         cols->colnums.get());
-      number s = 0;
-      for (size_type j = first_right_of_diagonal_index; j < end_row; ++j)
-        s += val[j] * number(dst(cols->colnums[j]));
-      *dst_ptr -= s * om;
-      Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
-      *dst_ptr /= val[*rowstart_ptr];
+    // find the first element in a line which is on the right of the
+    // diagonal. note: the first entry in each line denotes the diagonal
+    // element, which we need not check.
+    const auto first_right_of_diagonal = [&](const size_type row) {
+      return Utilities::lower_bound(
+               column_indices + cols->rowstart[row] + 1,
+               column_indices + cols->rowstart[row + 1],
+               row,
+               [row](const auto column, const size_type value) {
+                 return get_column_index(column, row) < value;
+               }) -
+             column_indices;
     };
+
+    // case when we need to get the position
+    // of the first element right of the
+    // diagonal manually for each sweep.
+    // forward sweep
+    for (size_type row = 0; row < n; ++row, ++dst_ptr, ++rowstart_ptr)
+      {
+        *dst_ptr = src(row);
+        // we need to precondition with the
+        // elements on the left only.
+        const size_type first_right_of_diagonal_index =
+          first_right_of_diagonal(row);
+
+        number s = 0;
+        for (size_type j = (*rowstart_ptr) + 1;
+             j < first_right_of_diagonal_index;
+             ++j)
+          s += val[j] * number(dst(get_column_index(column_indices[j], row)));
+
+        // divide by diagonal element
+        *dst_ptr -= s * om;
+        Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
+        *dst_ptr /= val[*rowstart_ptr];
+      };
+
+    rowstart_ptr = cols->rowstart.get();
+    dst_ptr      = &dst(0);
+    for (size_type row = 0; row < n; ++row, ++rowstart_ptr, ++dst_ptr)
+      *dst_ptr *=
+        somenumber((number(2.) - om)) * somenumber(val[*rowstart_ptr]);
+
+    // backward sweep
+    rowstart_ptr = &cols->rowstart[n - 1];
+    dst_ptr      = &dst(n - 1);
+    for (int row = n - 1; row >= 0; --row, --rowstart_ptr, --dst_ptr)
+      {
+        const size_type end_row = *(rowstart_ptr + 1);
+        const size_type first_right_of_diagonal_index =
+          first_right_of_diagonal(row);
+        number s = 0;
+        for (size_type j = first_right_of_diagonal_index; j < end_row; ++j)
+          s += val[j] * number(dst(get_column_index(column_indices[j], row)));
+        *dst_ptr -= s * om;
+        Assert(val[*rowstart_ptr] != number(), ExcDivideByZero());
+        *dst_ptr /= val[*rowstart_ptr];
+      };
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1609,18 +1901,25 @@ SparseMatrix<number>::SOR(Vector<somenumber> &dst, const number om) const
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (size_type row = 0; row < m(); ++row)
-    {
-      somenumber s = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          const size_type col = cols->colnums[j];
-          if (col < row)
-            s -= somenumber(val[j]) * dst(col);
-        }
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
 
-      dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+    for (size_type row = 0; row < m(); ++row)
+      {
+        somenumber s = dst(row);
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            const size_type col = get_column_index(column_indices[j], row);
+            if (col < row)
+              s -= somenumber(val[j]) * dst(col);
+          }
+
+        dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1636,21 +1935,31 @@ SparseMatrix<number>::TSOR(Vector<somenumber> &dst, const number om) const
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  size_type row = m() - 1;
-  while (true)
-    {
-      somenumber s = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        if (cols->colnums[j] > row)
-          s -= somenumber(val[j]) * dst(cols->colnums[j]);
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
+
+    size_type row = m() - 1;
+    while (true)
+      {
+        somenumber s = dst(row);
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            const size_type col = get_column_index(column_indices[j], row);
+            if (col > row)
+              s -= somenumber(val[j]) * dst(col);
+          }
 
-      dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+        dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
 
-      if (row == 0)
-        break;
+        if (row == 0)
+          break;
 
-      --row;
-    }
+        --row;
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1674,22 +1983,29 @@ SparseMatrix<number>::PSOR(Vector<somenumber> &          dst,
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (size_type urow = 0; urow < m(); ++urow)
-    {
-      const size_type row = permutation[urow];
-      somenumber      s   = dst(row);
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
 
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          const size_type col = cols->colnums[j];
-          if (inverse_permutation[col] < urow)
-            {
-              s -= somenumber(val[j]) * dst(col);
-            }
-        }
+    for (size_type urow = 0; urow < m(); ++urow)
+      {
+        const size_type row = permutation[urow];
+        somenumber      s   = dst(row);
 
-      dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            const size_type col = get_column_index(column_indices[j], row);
+            if (inverse_permutation[col] < urow)
+              {
+                s -= somenumber(val[j]) * dst(col);
+              }
+          }
+
+        dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1713,20 +2029,27 @@ SparseMatrix<number>::TPSOR(Vector<somenumber> &          dst,
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (size_type urow = m(); urow != 0;)
-    {
-      --urow;
-      const size_type row = permutation[urow];
-      somenumber      s   = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          const size_type col = cols->colnums[j];
-          if (inverse_permutation[col] > urow)
-            s -= somenumber(val[j]) * dst(col);
-        }
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
 
-      dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+    for (size_type urow = m(); urow != 0;)
+      {
+        --urow;
+        const size_type row = permutation[urow];
+        somenumber      s   = dst(row);
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            const size_type col = get_column_index(column_indices[j], row);
+            if (inverse_permutation[col] > urow)
+              s -= somenumber(val[j]) * dst(col);
+          }
+
+        dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1777,15 +2100,23 @@ SparseMatrix<number>::SOR_step(Vector<somenumber> &      v,
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (size_type row = 0; row < m(); ++row)
-    {
-      somenumber s = b(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          s -= somenumber(val[j]) * v(cols->colnums[j]);
-        }
-      v(row) += s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
+
+    for (size_type row = 0; row < m(); ++row)
+      {
+        somenumber s = b(row);
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            s -=
+              somenumber(val[j]) * v(get_column_index(column_indices[j], row));
+          }
+        v(row) += s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -1805,15 +2136,23 @@ SparseMatrix<number>::TSOR_step(Vector<somenumber> &      v,
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (int row = m() - 1; row >= 0; --row)
-    {
-      somenumber s = b(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          s -= somenumber(val[j]) * v(cols->colnums[j]);
-        }
-      v(row) += s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+  const auto sweep = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
+
+    for (int row = m() - 1; row >= 0; --row)
+      {
+        somenumber s = b(row);
+        for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1];
+             ++j)
+          {
+            s -=
+              somenumber(val[j]) * v(get_column_index(column_indices[j], row));
+          }
+        v(row) += s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
+      }
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(*cols, sweep);
 }
 
 
@@ -0,0 +1,450 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_h
+#define dealii_sparse_matrix_sell_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+
+#include <type_traits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declarations
+#ifndef DOXYGEN
+template <typename number>
+class SparseMatrix;
+class SparsityPattern;
+#endif
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A sparse matrix stored in the sliced ELLPACK format with sorting scope
+ * $\sigma$, known as SELL-C-$\sigma$, which allows matrix-vector products
+ * to be computed with SIMD instructions.
+ *
+ * The CSR format used by SparseMatrix stores the entries of each row one
+ * after the other. A matrix-vector product then consists of one short loop
+ * per row, whose length differs from row to row, and which can hardly be
+ * vectorized. In the SELL-C-$\sigma$ format, the rows are instead grouped
+ * into chunks of $C$ consecutive rows, where $C$ equals the number of lanes
+ * of VectorizedArray<number>, i.e., the width of the SIMD registers of the
+ * target architecture. Within a chunk, the entries are stored column by
+ * column: first the first entry of each of the $C$ rows, then the second
+ * entry of each row, and so on. Rows with fewer entries than the longest
+ * row of their chunk are padded with zeros. A matrix-vector product then
+ * processes all $C$ rows of a chunk at once, loading $C$ matrix entries
+ * with a single aligned load and the corresponding entries of the source
+ * vector with a gather instruction.
+ *
+ * To limit the number of padding entries, rows are sorted by their length
+ * within windows of $\sigma$ rows before being grouped into chunks, so that
+ * rows of similar lengths end up in the same chunk. Larger values of
+ * $\sigma$ reduce the padding, but destroy the locality of the accesses to
+ * the destination vector; values of a few hundred rows are typically a good
+ * choice. With $\sigma=C$, rows are only reordered within their own chunk.
+ *
+ * The class is meant as a faster replacement of a SparseMatrix in iterative
+ * solvers, e.g., for the system matrix passed to SolverCG together with
+ * the preconditioner provided by precondition_Jacobi(). It is set up from
+ * an assembled SparseMatrix with reinit(), and its values can be updated
+ * from a SparseMatrix with the same sparsity pattern with copy_from(),
+ * which does not need to recompute the layout. Individual entries cannot
+ * be accessed or modified.
+ *
+ * Matrix-vector products are provided for vectors whose elements are stored
+ * contiguously in memory and have the same number type as the matrix, such
+ * as Vector<number> and LinearAlgebra::distributed::Vector<number> when
+ * used in serial.
+ */
+template <typename number>
+class SparseMatrixSELL : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of the matrix entries.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows $C$ that are processed together, given by the number
+   * of lanes of VectorizedArray<number>.
+   */
+  static constexpr unsigned int chunk_size = VectorizedArray<number>::size();
+
+  /**
+   * Constructor. Create an empty matrix.
+   */
+  SparseMatrixSELL() = default;
+
+  /**
+   * Constructor. Convert the given matrix, see reinit().
+   */
+  explicit SparseMatrixSELL(const SparseMatrix<number> &matrix,
+                            const unsigned int          sorting_scope = 256);
+
+  /**
+   * Set up the layout from the sparsity pattern of the given matrix and
+   * copy its entries. The rows are sorted by length within windows of
+   * @p sorting_scope rows, which is rounded up to a multiple of
+   * chunk_size.
+   */
+  void
+  reinit(const SparseMatrix<number> &matrix,
+         const unsigned int          sorting_scope = 256);
+
+  /**
+   * Copy the entries of the given matrix, which must have the same sparsity
+   * pattern as the matrix this object was set up with in the last call to
+   * reinit(). This is considerably cheaper than calling reinit() again.
+   */
+  SparseMatrixSELL<number> &
+  copy_from(const SparseMatrix<number> &matrix);
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the object is empty.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Return the number of rows of the matrix.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of columns of the matrix.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of nonzero entries of the matrix this object was
+   * created from, not counting the padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the number of entries actually stored, including the padding.
+   * The ratio of this number to n_nonzero_elements() measures the overhead
+   * of the format over the CSR format.
+   */
+  std::size_t
+  n_stored_elements() const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix. In contrast to vmult(), the contributions of a chunk are added
+   * to the destination vector one lane at a time.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M*src$ to $dst$.
+   */
+  template <typename VectorType>
+  void
+  vmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Adding matrix-vector multiplication: add $M^T*src$ to $dst$.
+   */
+  template <typename VectorType>
+  void
+  Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * @p src vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor @p omega. The matrix
+   * must be square, and all diagonal entries must be nonzero.
+   */
+  template <typename VectorType>
+  void
+  precondition_Jacobi(VectorType &      dst,
+                      const VectorType &src,
+                      const number      omega = 1.) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * @addtogroup Exceptions
+   * @{
+   */
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsity,
+                   "The matrix passed to copy_from() does not have the same "
+                   "sparsity pattern as the one this object was set up "
+                   "with.");
+  //@}
+
+private:
+  /**
+   * Compute $dst = M*src$ if @p add is false, otherwise add to @p dst.
+   */
+  void
+  do_vmult(number *dst, const number *src, const bool add) const;
+
+  /**
+   * Add $M^T*src$ to @p dst.
+   */
+  void
+  do_Tvmult_add(number *dst, const number *src) const;
+
+  /**
+   * Number of rows.
+   */
+  size_type n_rows = 0;
+
+  /**
+   * Number of columns.
+   */
+  size_type n_cols = 0;
+
+  /**
+   * Number of nonzero entries, not counting the padding.
+   */
+  std::size_t n_nonzeros = 0;
+
+  /**
+   * For each chunk, the index of its first column of entries in the values
+   * and column_indices arrays; the last element is the total number of
+   * columns of entries.
+   */
+  std::vector<std::size_t> chunk_starts;
+
+  /**
+   * For each row of each chunk, the index of the row in the original
+   * matrix. Rows added to fill up the last chunk are marked by
+   * numbers::invalid_unsigned_int.
+   */
+  std::vector<unsigned int> chunk_rows;
+
+  /**
+   * The entries of the matrix, one VectorizedArray holding one entry of
+   * each of the rows of a chunk.
+   */
+  AlignedVector<VectorizedArray<number>> values;
+
+  /**
+   * The column indices of the entries in @p values, chunk_size indices per
+   * element of @p values. Padding entries point to a valid column of their
+   * row, so that gathering from the source vector never reads outside of
+   * it.
+   */
+  std::vector<unsigned int> column_indices;
+
+  /**
+   * For each entry of the CSR matrix, in the order in which SparseMatrix
+   * stores them, its position in @p values, given as the index of the
+   * VectorizedArray times chunk_size plus the lane. This allows copy_from()
+   * to update the values without recomputing the layout.
+   */
+  std::vector<std::size_t> csr_to_sell;
+
+  /**
+   * The inverse of the diagonal, in the original numbering of the rows.
+   */
+  AlignedVector<number> inverse_diagonal;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline bool
+SparseMatrixSELL<number>::empty() const
+{
+  return n_rows == 0 && n_cols == 0;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SparseMatrixSELL<number>::size_type
+SparseMatrixSELL<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_nonzero_elements() const
+{
+  return n_nonzeros;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SparseMatrixSELL<number>::n_stored_elements() const
+{
+  return values.size() * chunk_size;
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<number>::vmult(VectorType &dst, const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vectors must have the same number type as the matrix.");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+
+  do_vmult(dst.begin(), src.begin(), false);
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<number>::vmult_add(VectorType &      dst,
+                                    const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vectors must have the same number type as the matrix.");
+  AssertDimension(dst.size(), m());
+  AssertDimension(src.size(), n());
+
+  do_vmult(dst.begin(), src.begin(), true);
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<number>::Tvmult(VectorType &dst, const VectorType &src) const
+{
+  dst = number();
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<number>::Tvmult_add(VectorType &      dst,
+                                     const VectorType &src) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vectors must have the same number type as the matrix.");
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), m());
+
+  do_Tvmult_add(dst.begin(), src.begin());
+}
+
+
+
+template <typename number>
+template <typename VectorType>
+inline void
+SparseMatrixSELL<number>::precondition_Jacobi(VectorType &      dst,
+                                              const VectorType &src,
+                                              const number      omega) const
+{
+  static_assert(std::is_same<typename VectorType::value_type, number>::value,
+                "The vectors must have the same number type as the matrix.");
+  Assert(m() == n(), ExcNotQuadratic());
+  AssertDimension(dst.size(), n());
+  AssertDimension(src.size(), n());
+
+  const number *src_ptr  = src.begin();
+  number *      dst_ptr  = dst.begin();
+  const number *diag_ptr = inverse_diagonal.data();
+
+  const VectorizedArray<number> factor = omega;
+  const size_type n_vectorized = n_rows - n_rows % chunk_size;
+  for (size_type i = 0; i < n_vectorized; i += chunk_size)
+    {
+      VectorizedArray<number> s, d;
+      s.load(src_ptr + i);
+      d.load(diag_ptr + i);
+      (factor * s * d).store(dst_ptr + i);
+    }
+  for (size_type i = n_vectorized; i < n_rows; ++i)
+    dst_ptr[i] = omega * src_ptr[i] * diag_ptr[i];
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,288 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sparse_matrix_sell_templates_h
+#define dealii_sparse_matrix_sell_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+
+#include <algorithm>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <typename number>
+SparseMatrixSELL<number>::SparseMatrixSELL(const SparseMatrix<number> &matrix,
+                                           const unsigned int sorting_scope)
+{
+  reinit(matrix, sorting_scope);
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::reinit(const SparseMatrix<number> &matrix,
+                                 const unsigned int          sorting_scope)
+{
+  clear();
+
+  const SparsityPattern &sparsity = matrix.get_sparsity_pattern();
+  n_rows                          = matrix.m();
+  n_cols                          = matrix.n();
+  n_nonzeros                      = matrix.n_nonzero_elements();
+
+  // the column indices are used as offsets for the gather operations,
+  // which take 32-bit integers
+  AssertThrow(n_rows < numbers::invalid_unsigned_int &&
+                n_cols < numbers::invalid_unsigned_int,
+              ExcMessage("The SELL-C-sigma format only supports matrices "
+                         "with less than 2^32-1 rows and columns."));
+
+  std::vector<unsigned int> row_lengths(n_rows);
+  for (size_type row = 0; row < n_rows; ++row)
+    row_lengths[row] = sparsity.row_length(row);
+
+  // sort the rows by decreasing length within windows of 'sigma' rows and
+  // fill up the last chunk with invalid rows
+  const size_type sigma =
+    std::max<size_type>((sorting_scope + chunk_size - 1) / chunk_size, 1) *
+    chunk_size;
+  const size_type n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+  chunk_rows.resize(n_chunks * chunk_size, numbers::invalid_unsigned_int);
+  std::iota(chunk_rows.begin(), chunk_rows.begin() + n_rows, 0U);
+  for (size_type window = 0; window < n_rows; window += sigma)
+    std::stable_sort(chunk_rows.begin() + window,
+                     chunk_rows.begin() + std::min(window + sigma, n_rows),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return row_lengths[a] > row_lengths[b];
+                     });
+
+  // each chunk is as long as its longest row
+  chunk_starts.resize(n_chunks + 1);
+  chunk_starts[0] = 0;
+  for (size_type chunk = 0; chunk < n_chunks; ++chunk)
+    {
+      unsigned int chunk_length = 0;
+      for (unsigned int lane = 0; lane < chunk_size; ++lane)
+        {
+          const unsigned int row = chunk_rows[chunk * chunk_size + lane];
+          if (row != numbers::invalid_unsigned_int)
+            chunk_length = std::max(chunk_length, row_lengths[row]);
+        }
+      chunk_starts[chunk + 1] = chunk_starts[chunk] + chunk_length;
+    }
+
+  // now set up the column indices and the map from the CSR storage to the
+  // positions in the SELL layout. padding entries use the last column of
+  // their row, or the first column of the matrix for empty rows
+  std::vector<std::size_t> row_starts(n_rows + 1, 0);
+  for (size_type row = 0; row < n_rows; ++row)
+    row_starts[row + 1] = row_starts[row] + row_lengths[row];
+
+  values.resize(chunk_starts.back());
+  column_indices.resize(chunk_starts.back() * chunk_size, 0);
+  csr_to_sell.resize(n_nonzeros);
+  for (size_type chunk = 0; chunk < n_chunks; ++chunk)
+    for (unsigned int lane = 0; lane < chunk_size; ++lane)
+      {
+        const unsigned int row = chunk_rows[chunk * chunk_size + lane];
+        if (row == numbers::invalid_unsigned_int)
+          continue;
+
+        std::size_t  position    = chunk_starts[chunk];
+        unsigned int last_column = 0;
+        std::size_t  csr_index   = row_starts[row];
+        for (auto entry = sparsity.begin(row); entry != sparsity.end(row);
+             ++entry, ++position, ++csr_index)
+          {
+            last_column = entry->column();
+            column_indices[position * chunk_size + lane] = last_column;
+            csr_to_sell[csr_index] = position * chunk_size + lane;
+          }
+        for (; position < chunk_starts[chunk + 1]; ++position)
+          column_indices[position * chunk_size + lane] = last_column;
+      }
+
+  copy_from(matrix);
+}
+
+
+
+template <typename number>
+SparseMatrixSELL<number> &
+SparseMatrixSELL<number>::copy_from(const SparseMatrix<number> &matrix)
+{
+  Assert(matrix.m() == n_rows && matrix.n() == n_cols &&
+           matrix.n_nonzero_elements() == n_nonzeros,
+         ExcDifferentSparsity());
+
+  // padding entries stay at zero
+  values.fill(VectorizedArray<number>());
+
+  std::size_t csr_index = 0;
+  for (auto entry = matrix.begin(); entry != matrix.end();
+       ++entry, ++csr_index)
+    {
+      const std::size_t position = csr_to_sell[csr_index];
+#ifdef DEBUG
+      // the entry must sit in the same row and column as the entry at this
+      // position of the pattern the layout was set up with
+      const std::size_t chunk =
+        std::upper_bound(chunk_starts.begin(),
+                         chunk_starts.end(),
+                         position / chunk_size) -
+        chunk_starts.begin() - 1;
+      Assert(chunk_rows[chunk * chunk_size + position % chunk_size] ==
+                 entry->row() &&
+               column_indices[position] == entry->column(),
+             ExcDifferentSparsity());
+#endif
+      values[position / chunk_size][position % chunk_size] = entry->value();
+    }
+  AssertDimension(csr_index, n_nonzeros);
+
+  if (n_rows == n_cols)
+    {
+      inverse_diagonal.resize(n_rows);
+      for (size_type row = 0; row < n_rows; ++row)
+        {
+          const number diagonal = matrix.diag_element(row);
+          inverse_diagonal[row] =
+            (diagonal != number()) ? number(1.) / diagonal : number();
+        }
+    }
+
+  return *this;
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::clear()
+{
+  n_rows     = 0;
+  n_cols     = 0;
+  n_nonzeros = 0;
+  chunk_starts.clear();
+  chunk_rows.clear();
+  values.clear();
+  column_indices.clear();
+  csr_to_sell.clear();
+  inverse_diagonal.clear();
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::do_vmult(number *      dst,
+                                   const number *src,
+                                   const bool    add) const
+{
+  // every chunk writes to a distinct set of rows, so chunks can be
+  // processed in parallel
+  const auto vmult_on_subrange = [&](const size_type begin_chunk,
+                                     const size_type end_chunk) {
+    for (size_type chunk = begin_chunk; chunk < end_chunk; ++chunk)
+      {
+        VectorizedArray<number> sum     = number();
+        const unsigned int *    columns = column_indices.data() +
+                                     chunk_starts[chunk] * chunk_size;
+        for (std::size_t j = chunk_starts[chunk]; j < chunk_starts[chunk + 1];
+             ++j, columns += chunk_size)
+          {
+            VectorizedArray<number> x;
+            x.gather(src, columns);
+            sum += values[j] * x;
+          }
+
+        const unsigned int *rows = chunk_rows.data() + chunk * chunk_size;
+        for (unsigned int lane = 0; lane < chunk_size; ++lane)
+          if (rows[lane] != numbers::invalid_unsigned_int)
+            {
+              if (add)
+                dst[rows[lane]] += sum[lane];
+              else
+                dst[rows[lane]] = sum[lane];
+            }
+      }
+  };
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    static_cast<size_type>(chunk_starts.empty() ? 0 :
+                                                  chunk_starts.size() - 1),
+    vmult_on_subrange,
+    std::max(internal::SparseMatrixImplementation::minimum_parallel_grain_size /
+               chunk_size,
+             1U));
+}
+
+
+
+template <typename number>
+void
+SparseMatrixSELL<number>::do_Tvmult_add(number *dst, const number *src) const
+{
+  // different chunks may write to the same columns, so this operation runs
+  // in serial
+  for (size_type chunk = 0; chunk + 1 < chunk_starts.size(); ++chunk)
+    {
+      VectorizedArray<number> x       = number();
+      const unsigned int *    rows    = chunk_rows.data() + chunk * chunk_size;
+      const unsigned int *    columns = column_indices.data() +
+                                   chunk_starts[chunk] * chunk_size;
+      for (unsigned int lane = 0; lane < chunk_size; ++lane)
+        if (rows[lane] != numbers::invalid_unsigned_int)
+          x[lane] = src[rows[lane]];
+
+      for (std::size_t j = chunk_starts[chunk]; j < chunk_starts[chunk + 1];
+           ++j, columns += chunk_size)
+        {
+          const VectorizedArray<number> product = values[j] * x;
+          for (unsigned int lane = 0; lane < chunk_size; ++lane)
+            dst[columns[lane]] += product[lane];
+        }
+    }
+}
+
+
+
+template <typename number>
+std::size_t
+SparseMatrixSELL<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(chunk_starts) +
+         MemoryConsumption::memory_consumption(chunk_rows) +
+         values.memory_consumption() +
+         MemoryConsumption::memory_consumption(column_indices) +
+         MemoryConsumption::memory_consumption(csr_to_sell) +
+         inverse_diagonal.memory_consumption();
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -158,40 +158,58 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
   // We assume the underlying matrix A is: A = X - L - U, where -L and -U are
   // strictly lower- and upper- diagonal parts of the system.
   //
-  // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
-  dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
+  // Solve (X-L)X{-1}(X-U) x = b in 3 steps. The rows of the two
+  // substitutions are processed level by level, see
+  // SparseLUDecomposition::apply_in_level_order().
+  const SparsityPattern &  sparsity         = this->get_sparsity_pattern();
+  const std::size_t *const rowstart_indices = sparsity.rowstart.get();
+
+  const number *const values = this->SparseMatrix<number>::val.get();
+
+  const auto substitute = [&](const auto *const column_indices) {
+    using internals::SparsityPatternTools::get_column_index;
+
+    dst = src;
+    this->apply_in_level_order(true, [&](const size_type row) {
       // Now: (X-L)u = b
 
       // get start of this row. skip
       // the diagonal element
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           (p != this->end(row)) && (p->column() < row);
-           ++p)
-        dst(row) -= p->value() * dst(p->column());
+      for (std::size_t j = rowstart_indices[row] + 1;
+           j < rowstart_indices[row + 1];
+           ++j)
+        {
+          const size_type column = get_column_index(column_indices[j], row);
+          if (column >= row)
+            break;
+          dst(row) -= values[j] * dst(column);
+        }
 
       dst(row) *= inv_diag[row];
-    }
+    });
 
-  // Now: v = Xu
-  for (size_type row = 0; row < N; ++row)
-    dst(row) *= diag[row];
+    // Now: v = Xu
+    for (size_type row = 0; row < N; ++row)
+      dst(row) *= diag[row];
 
-  // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
+    // x = (X-U)v
+    this->apply_in_level_order(false, [&](const size_type row) {
       // get end of this row
-      for (typename SparseMatrix<number>::const_iterator p =
-             this->begin(row) + 1;
-           p != this->end(row);
-           ++p)
-        if (p->column() > static_cast<size_type>(row))
-          dst(row) -= p->value() * dst(p->column());
+      for (std::size_t j = rowstart_indices[row] + 1;
+           j < rowstart_indices[row + 1];
+           ++j)
+        {
+          const size_type column = get_column_index(column_indices[j], row);
+          if (column > row)
+            dst(row) -= values[j] * dst(column);
+        }
 
       dst(row) *= inv_diag[row];
-    }
+    });
+  };
+
+  internals::SparsityPatternTools::dispatch_column_indices(sparsity,
+                                                           substitute);
 }
 
 
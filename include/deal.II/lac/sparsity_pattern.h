@@ -35,6 +35,7 @@
 #include <boost/serialization/split_member.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -55,6 +56,8 @@ template <typename number>
 class SparseLUDecomposition;
 template <typename number>
 class SparseILU;
+template <typename number>
+class SparseMIC;
 
 namespace ChunkSparsityPatternIterators
 {
@@ -101,6 +104,40 @@ namespace internals
     size_type
     get_column_index_from_iterator(const std::pair<const size_type, value> &i);
 
+    /**
+     * Helper function to get the column index of an entry in row @p row
+     * from the value stored for it in the column number array of a
+     * SparsityPattern. This allows to write loops that work on either the
+     * column numbers or the column offsets of a sparsity pattern.
+     */
+    inline size_type
+    get_column_index(const size_type column, const size_type)
+    {
+      return column;
+    }
+
+    /**
+     * Same as above, but for the value stored in the array of column offsets
+     * relative to the row, see SparsityPattern::store_column_offsets().
+     */
+    inline size_type
+    get_column_index(const std::int32_t offset, const size_type row)
+    {
+      return row + offset;
+    }
+
+    /**
+     * Call @p kernel with a pointer to the column offsets of @p sparsity if
+     * SparsityPattern::store_column_offsets() was called for it, and with a
+     * pointer to its column numbers otherwise, and return the result of the
+     * call. The kernel, typically a generic lambda, has to translate the
+     * values it reads with get_column_index().
+     */
+    template <typename Kernel>
+    decltype(auto)
+    dispatch_column_indices(const SparsityPatternBase &sparsity,
+                            const Kernel &             kernel);
+
   } // namespace SparsityPatternTools
 } // namespace internals
 
@@ -806,6 +843,16 @@ protected:
    */
   std::unique_ptr<size_type[]> colnums;
 
+  /**
+   * Array of the column numbers of all entries relative to their row, i.e.,
+   * #colnums[<i>p</i>] - <i>r</i> for an entry at position <i>p</i> in row
+   * <i>r</i>, as 32-bit signed integers. This is a second copy of the
+   * information in #colnums, which stays allocated. The array is only
+   * allocated if SparsityPattern::store_column_offsets() was called, and is
+   * a null pointer otherwise.
+   */
+  std::unique_ptr<std::int32_t[]> column_offsets;
+
   /**
    * Store whether the compress() function was called for this object.
    */
@@ -819,6 +866,8 @@ protected:
   template <typename number>
   friend class SparseILU;
   template <typename number>
+  friend class SparseMIC;
+  template <typename number>
   friend class ChunkSparseMatrix;
 
   friend class ChunkSparsityPattern;
@@ -828,6 +877,12 @@ protected:
   friend class SparsityPatternIterators::Iterator;
   friend class SparsityPatternIterators::Accessor;
   friend class ChunkSparsityPatternIterators::Accessor;
+
+  template <typename Kernel>
+  friend decltype(auto)
+  internals::SparsityPatternTools::dispatch_column_indices(
+    const SparsityPatternBase &sparsity,
+    const Kernel &             kernel);
 };
 
 /**
@@ -1034,6 +1089,47 @@ public:
   void
   compress();
 
+  /**
+   * In addition to the column numbers, store the difference between the
+   * column number of each entry and the index of its row as a 32-bit signed
+   * integer. If these offsets are available, the matrix-vector products,
+   * residual computations and relaxation sweeps (SOR, SSOR and their
+   * variants) of SparseMatrix as well as the forward and backward
+   * substitutions of SparseILU and SparseMIC read them in place of the
+   * column numbers.
+   *
+   * This is not a compressed representation of the pattern: the offsets are
+   * a second copy of the column numbers, and the memory used by the pattern
+   * grows by four bytes per entry. The column numbers are kept because all
+   * other functions of this class, its iterators, and the element access of
+   * SparseMatrix work on them. The reason to store the copy is that the
+   * operations listed above are limited by memory bandwidth and only read
+   * the offsets: if deal.II was configured with
+   * <tt>DEAL_II_WITH_64BIT_INDICES</tt>, they load four instead of eight
+   * bytes of index data per entry. With 32-bit indices, there is no benefit
+   * in calling this function.
+   *
+   * These operations are written once for both arrays and select one of
+   * them through internals::SparsityPatternTools::dispatch_column_indices().
+   *
+   * The offsets can only be stored if the bandwidth() of the pattern is
+   * smaller than $2^{31}$. The function returns whether this is the case and
+   * the offsets have been stored. They are discarded when the pattern is
+   * re-initialized, i.e., they have to be created again after each call to
+   * reinit() or one of the copy_from() functions.
+   *
+   * This function may only be called for compressed sparsity patterns.
+   */
+  bool
+  store_column_offsets();
+
+  /**
+   * Return whether store_column_offsets() has been called successfully since
+   * the sparsity pattern was last re-initialized.
+   */
+  bool
+  has_column_offsets() const;
+
 
   /**
    * This function can be used as a replacement for reinit(), subsequent calls
@@ -1329,6 +1425,8 @@ private:
   template <typename number>
   friend class SparseILU;
   template <typename number>
+  friend class SparseMIC;
+  template <typename number>
   friend class ChunkSparseMatrix;
 
   friend class ChunkSparsityPattern;
@@ -1544,6 +1642,14 @@ SparsityPattern::stores_only_added_elements() const
 
 
 
+inline bool
+SparsityPattern::has_column_offsets() const
+{
+  return (column_offsets != nullptr);
+}
+
+
+
 inline unsigned int
 SparsityPatternBase::row_length(const size_type row) const
 {
@@ -1605,6 +1711,7 @@ SparsityPatternBase::load(Archive &ar, const unsigned int)
 
   rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
   colnums  = std::make_unique<size_type[]>(max_vec_len);
+  column_offsets.reset();
 
   ar &boost::serialization::make_array(rowstart.get(), max_dim + 1);
   ar &boost::serialization::make_array(colnums.get(), max_vec_len);
@@ -1666,6 +1773,26 @@ SparsityPattern::operator==(const SparsityPattern &sp2) const
 
 
 
+namespace internals
+{
+  namespace SparsityPatternTools
+  {
+    template <typename Kernel>
+    inline decltype(auto)
+    dispatch_column_indices(const SparsityPatternBase &sparsity,
+                            const Kernel &             kernel)
+    {
+      if (sparsity.column_offsets != nullptr)
+        return kernel(
+          static_cast<const std::int32_t *>(sparsity.column_offsets.get()));
+      else
+        return kernel(static_cast<const size_type *>(sparsity.colnums.get()));
+    }
+  } // namespace SparsityPatternTools
+} // namespace internals
+
+
+
 namespace internal
 {
   namespace SparsityPatternTools
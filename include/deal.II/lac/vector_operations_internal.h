@@ -332,6 +332,44 @@ namespace internal
       const Number        factor;
     };
 
+    /**
+     * Add a linear combination of up to @p max_vectors vectors to a vector,
+     * i.e., <tt>val[i] += sum_j factors[j] * v_vals[j][i]</tt>, reading and
+     * writing each entry of @p val only once.
+     */
+    template <typename Number, unsigned int max_vectors>
+    struct Vectorization_add_linear_combination
+    {
+      Vectorization_add_linear_combination(Number *const              val,
+                                           const Number *const *const v_vals,
+                                           const Number *const        factors,
+                                           const unsigned int         n_vectors)
+        : val(val)
+        , v_vals(v_vals)
+        , factors(factors)
+        , n_vectors(n_vectors)
+      {
+        AssertIndexRange(n_vectors, max_vectors + 1);
+      }
+
+      void
+      operator()(const size_type begin, const size_type end) const
+      {
+        for (size_type i = begin; i < end; ++i)
+          {
+            Number sum = val[i];
+            for (unsigned int j = 0; j < n_vectors; ++j)
+              sum += factors[j] * v_vals[j][i];
+            val[i] = sum;
+          }
+      }
+
+      Number *const              val;
+      const Number *const *const v_vals;
+      const Number *const        factors;
+      const unsigned int         n_vectors;
+    };
+
     template <typename Number>
     struct Vectorization_sadd_xav
     {
@@ -941,6 +979,240 @@ namespace internal
       const Number        a;
     };
 
+    /**
+     * A fixed number of sums that are accumulated together in a single
+     * call to parallel_reduce(), for operations that compute several
+     * inner products in one sweep over the vectors.
+     */
+    template <typename Number, unsigned int n_sums>
+    struct MultipleSums
+    {
+      MultipleSums()
+      {
+        for (unsigned int i = 0; i < n_sums; ++i)
+          values[i] = Number();
+      }
+
+      MultipleSums &
+      operator+=(const MultipleSums &other)
+      {
+        for (unsigned int i = 0; i < n_sums; ++i)
+          values[i] += other.values[i];
+        return *this;
+      }
+
+      MultipleSums
+      operator+(const MultipleSums &other) const
+      {
+        MultipleSums result(*this);
+        result += other;
+        return result;
+      }
+
+      Number values[n_sums];
+    };
+
+    /**
+     * The vector updates of one step of the pipelined conjugate gradient
+     * method by Ghysels and Vanroose, fused with the three inner products
+     * needed by the next step. With the coefficients @p a (alpha) and @p b
+     * (beta), this operation computes
+     * @code
+     * Z = N + b Z,   Q = M + b Q,   S = W + b S,   P = U + b P,
+     * X = X + a P,   R = R - a S,   U = U - a Q,   W = W - a Z
+     * @endcode
+     * and returns the sums of <tt>R*U</tt>, <tt>W*U</tt>, and <tt>R*R</tt>,
+     * reading and writing each vector entry only once.
+     */
+    template <typename Number>
+    struct PipelinedCGUpdate
+    {
+      static const bool vectorizes = false;
+
+      PipelinedCGUpdate(Number *const       X,
+                        Number *const       R,
+                        Number *const       U,
+                        Number *const       W,
+                        Number *const       P,
+                        Number *const       S,
+                        Number *const       Q,
+                        Number *const       Z,
+                        const Number *const M,
+                        const Number *const N,
+                        const Number        a,
+                        const Number        b)
+        : X(X)
+        , R(R)
+        , U(U)
+        , W(W)
+        , P(P)
+        , S(S)
+        , Q(Q)
+        , Z(Z)
+        , M(M)
+        , N(N)
+        , a(a)
+        , b(b)
+      {}
+
+      MultipleSums<Number, 3>
+      operator()(const size_type i) const
+      {
+        const Number z = N[i] + b * Z[i];
+        const Number q = M[i] + b * Q[i];
+        const Number s = W[i] + b * S[i];
+        const Number p = U[i] + b * P[i];
+        Z[i]           = z;
+        Q[i]           = q;
+        S[i]           = s;
+        P[i]           = p;
+        X[i] += a * p;
+
+        const Number r = R[i] - a * s;
+        const Number u = U[i] - a * q;
+        const Number w = W[i] - a * z;
+        R[i]           = r;
+        U[i]           = u;
+        W[i]           = w;
+
+        const Number u_conj = numbers::NumberTraits<Number>::conjugate(u);
+        MultipleSums<Number, 3> result;
+        result.values[0] = r * u_conj;
+        result.values[1] = w * u_conj;
+        result.values[2] = r * numbers::NumberTraits<Number>::conjugate(r);
+        return result;
+      }
+
+      Number *const       X;
+      Number *const       R;
+      Number *const       U;
+      Number *const       W;
+      Number *const       P;
+      Number *const       S;
+      Number *const       Q;
+      Number *const       Z;
+      const Number *const M;
+      const Number *const N;
+      const Number        a;
+      const Number        b;
+    };
+
+    /**
+     * The inner products of the residual of the conjugate gradient method
+     * needed in each step: returns the sums of <tt>R*R</tt> and, if @p P is
+     * not a null pointer, of <tt>R*P*R</tt> with the diagonal preconditioner
+     * @p P.
+     */
+    template <typename Number>
+    struct CGResidualSums
+    {
+      static const bool vectorizes = false;
+
+      CGResidualSums(const Number *const R, const Number *const P)
+        : R(R)
+        , P(P)
+      {}
+
+      MultipleSums<Number, 2>
+      operator()(const size_type i) const
+      {
+        return sums(R[i], i);
+      }
+
+      MultipleSums<Number, 2>
+      sums(const Number r, const size_type i) const
+      {
+        const Number r_conj = numbers::NumberTraits<Number>::conjugate(r);
+
+        MultipleSums<Number, 2> result;
+        result.values[0] = r * r_conj;
+        if (P != nullptr)
+          result.values[1] = P[i] * r * r_conj;
+        return result;
+      }
+
+      const Number *const R;
+      const Number *const P;
+    };
+
+    /**
+     * The update of the solution and the residual of the conjugate gradient
+     * method with the step length @p a, <tt>X = X + a D</tt> and <tt>R = R +
+     * a H</tt>, fused with the inner products of the new residual computed by
+     * CGResidualSums.
+     */
+    template <typename Number>
+    struct CGUpdateSolution
+    {
+      static const bool vectorizes = false;
+
+      CGUpdateSolution(Number *const       X,
+                       Number *const       R,
+                       const Number *const D,
+                       const Number *const H,
+                       const Number *const P,
+                       const Number        a)
+        : X(X)
+        , R(R)
+        , D(D)
+        , H(H)
+        , a(a)
+        , residual_sums(R, P)
+      {}
+
+      MultipleSums<Number, 2>
+      operator()(const size_type i) const
+      {
+        X[i] += a * D[i];
+        const Number r = R[i] + a * H[i];
+        R[i]           = r;
+        return residual_sums.sums(r, i);
+      }
+
+      Number *const                X;
+      Number *const                R;
+      const Number *const          D;
+      const Number *const          H;
+      const Number                 a;
+      const CGResidualSums<Number> residual_sums;
+    };
+
+    /**
+     * The inner products of a vector @p w with up to @p max_vectors vectors
+     * @p v, computed in one sweep over the vectors. Entry @p j of the result
+     * is the sum of <tt>w[i] * conj(v[j][i])</tt>.
+     */
+    template <typename Number, unsigned int max_vectors>
+    struct MultipleDot
+    {
+      static const bool vectorizes = false;
+
+      MultipleDot(const Number *const *const v,
+                  const unsigned int         n_vectors,
+                  const Number *const        w)
+        : v(v)
+        , n_vectors(n_vectors)
+        , w(w)
+      {
+        AssertIndexRange(n_vectors, max_vectors + 1);
+      }
+
+      MultipleSums<Number, max_vectors>
+      operator()(const size_type i) const
+      {
+        MultipleSums<Number, max_vectors> result;
+        const Number                      w_i = w[i];
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          result.values[j] =
+            w_i * numbers::NumberTraits<Number>::conjugate(v[j][i]);
+        return result;
+      }
+
+      const Number *const *const v;
+      const unsigned int         n_vectors;
+      const Number *const        w;
+    };
+
 
 
     // this is the main working loop for all vector sums using the templated
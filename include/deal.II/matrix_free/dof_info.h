@@ -30,6 +30,7 @@
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
 #include <deal.II/matrix_free/face_info.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/mapping_info.h>
 #include <deal.II/matrix_free/shape_info.h>
 #include <deal.II/matrix_free/task_info.h>
@@ -168,11 +169,21 @@ namespace internal
        * processor, get a temporary number by this function, and will later be
        * assigned the correct index after all the ghost indices have been
        * collected by the call to @p assign_ghosts.
+       *
+       * The indices in @p local_indices_resolved are the ones the constraints
+       * are resolved for. They differ from the indices of the cell given in
+       * @p local_indices if the hanging-node constraints of the cell are
+       * treated on the fly, as indicated by @p cell_has_hanging_nodes, in
+       * which case the indices on constrained faces and edges are replaced by
+       * the ones of the coarser neighbors. The indices in @p local_indices
+       * are stored as plain indices.
        */
       template <typename number>
       void
       read_dof_indices(
+        const std::vector<types::global_dof_index> &local_indices_resolved,
         const std::vector<types::global_dof_index> &local_indices,
+        const bool                                  cell_has_hanging_nodes,
         const std::vector<unsigned int> &           lexicographic_inv,
         const dealii::AffineConstraints<number> &   constraints,
         const unsigned int                          cell_number,
@@ -596,6 +607,15 @@ namespace internal
        */
       std::vector<unsigned int> plain_dof_indices;
 
+      /**
+       * Stores the masks of the hanging-node constraints that are resolved on
+       * the fly by FEEvaluation rather than through the @p dof_indices and
+       * @p constraint_indicator fields, with one entry per cell (i.e., per
+       * lane of a cell batch after reorder_cells() has been called). This
+       * field is empty if no cell has such constraints.
+       */
+      std::vector<ConstraintKinds> hanging_node_constraint_masks;
+
       /**
        * Stores the offset in terms of the number of base elements over all
        * DoFInfo objects.
@@ -126,6 +126,7 @@ namespace internal
       start_components.clear();
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
+      hanging_node_constraint_masks.clear();
       dof_indices_interleaved.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
@@ -174,9 +175,12 @@ namespace internal
 
           // figure out constraints by comparing constraint_indicator row
           // shift for this cell within the block as compared to the next
-          // one
+          // one, or by the mask of hanging-node constraints
           const bool has_constraints =
-            row_starts[ib].second != row_starts[ib + n_fe_components].second;
+            row_starts[ib].second != row_starts[ib + n_fe_components].second ||
+            (hanging_node_constraint_masks.size() > 0 &&
+             hanging_node_constraint_masks[cell * n_vectorization + v] !=
+               ConstraintKinds::unconstrained);
 
           auto do_copy = [&](const unsigned int *begin,
                              const unsigned int *end) {
@@ -212,7 +216,9 @@ namespace internal
     template <typename number>
     void
     DoFInfo::read_dof_indices(
+      const std::vector<types::global_dof_index> &local_indices_resolved,
       const std::vector<types::global_dof_index> &local_indices,
+      const bool                                  cell_has_hanging_nodes,
       const std::vector<unsigned int> &           lexicographic_inv,
       const dealii::AffineConstraints<number> &   constraints,
       const unsigned int                          cell_number,
@@ -246,7 +252,7 @@ namespace internal
                i++)
             {
               types::global_dof_index current_dof =
-                local_indices[lexicographic_inv[i]];
+                local_indices_resolved[lexicographic_inv[i]];
               const auto *entries_ptr =
                 constraints.get_constraint_entries(current_dof);
 
@@ -355,6 +361,7 @@ namespace internal
               (row_starts.size() - 1) / n_components + 1);
           row_starts_plain_indices[cell_number] = plain_dof_indices.size();
           const bool cell_has_constraints =
+            cell_has_hanging_nodes ||
             (row_starts[(cell_number + 1) * n_components].second >
              row_starts[cell_number * n_components].second);
           if (cell_has_constraints == true)
@@ -466,7 +473,11 @@ namespace internal
               if (store_plain_indices == true)
                 {
                   if (row_starts[boundary_cells[i] * n_components].second !=
-                      row_starts[(boundary_cells[i] + 1) * n_components].second)
+                        row_starts[(boundary_cells[i] + 1) * n_components]
+                          .second ||
+                      (hanging_node_constraint_masks.size() > 0 &&
+                       hanging_node_constraint_masks[boundary_cells[i]] !=
+                         ConstraintKinds::unconstrained))
                     {
                       unsigned int *data_ptr =
                         plain_dof_indices.data() +
@@ -563,7 +574,8 @@ namespace internal
       std::vector<std::pair<unsigned short, unsigned short>>
                                 new_constraint_indicator;
       std::vector<unsigned int> new_plain_indices, new_rowstart_plain;
-      unsigned int              position_cell = 0;
+      std::vector<ConstraintKinds> new_hanging_node_constraint_masks;
+      unsigned int                 position_cell = 0;
       new_dof_indices.reserve(dof_indices.size());
       new_constraint_indicator.reserve(constraint_indicator.size());
       if (store_plain_indices == true)
@@ -574,6 +586,10 @@ namespace internal
                                     numbers::invalid_unsigned_int);
           new_plain_indices.reserve(plain_dof_indices.size());
         }
+      if (hanging_node_constraint_masks.size() > 0)
+        new_hanging_node_constraint_masks.resize(
+          vectorization_length * task_info.cell_partition_data.back(),
+          ConstraintKinds::unconstrained);
 
       // copy the indices and the constraint indicators to the new data field,
       // where we will go through the cells in the renumbered way. in case the
@@ -613,9 +629,18 @@ namespace internal
                     new_constraint_indicator.push_back(
                       constraint_indicator[index]);
                 }
+              const bool cell_has_hanging_nodes =
+                hanging_node_constraint_masks.size() > 0 &&
+                hanging_node_constraint_masks[cell_no / n_components] !=
+                  ConstraintKinds::unconstrained;
+              if (cell_has_hanging_nodes)
+                new_hanging_node_constraint_masks[i * vectorization_length +
+                                                  j] =
+                  hanging_node_constraint_masks[cell_no / n_components];
               if (store_plain_indices &&
-                  row_starts[cell_no].second !=
-                    row_starts[cell_no + n_components].second)
+                  (row_starts[cell_no].second !=
+                     row_starts[cell_no + n_components].second ||
+                   cell_has_hanging_nodes))
                 {
                   new_rowstart_plain[i * vectorization_length + j] =
                     new_plain_indices.size();
@@ -658,6 +683,7 @@ namespace internal
       new_constraint_indicator.swap(constraint_indicator);
       new_plain_indices.swap(plain_dof_indices);
       new_rowstart_plain.swap(row_starts_plain_indices);
+      new_hanging_node_constraint_masks.swap(hanging_node_constraint_masks);
 
 #ifdef DEBUG
       // sanity check 1: all indices should be smaller than the number of dofs
@@ -759,12 +785,17 @@ namespace internal
             n_vectorization_lanes_filled[dof_access_cell][i];
 
           // check 1: Check if there are constraints -> no compression possible
+          // (this includes cells with hanging-node constraints resolved on
+          // the fly, which need the plain indices in some cases)
           bool has_constraints = false;
           for (unsigned int j = 0; j < n_comp; ++j)
             {
               const unsigned int cell_no = i * vectorization_length + j;
               if (row_starts[cell_no * n_components].second !=
-                  row_starts[(cell_no + 1) * n_components].second)
+                    row_starts[(cell_no + 1) * n_components].second ||
+                  (hanging_node_constraint_masks.size() > 0 &&
+                   hanging_node_constraint_masks[cell_no] !=
+                     ConstraintKinds::unconstrained))
                 {
                   has_constraints = true;
                   break;
@@ -2040,6 +2071,8 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
+      memory += hanging_node_constraint_masks.capacity() *
+                sizeof(ConstraintKinds);
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
     }
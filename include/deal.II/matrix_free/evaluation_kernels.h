@@ -137,9 +137,311 @@ namespace internal
 
 
 
+  /**
+   * Evaluation and integration with dense shape matrices for elements without
+   * tensor-product structure, i.e., MatrixFreeFunctions::tensor_none as used
+   * for FE_SimplexP, FE_WedgeP, and FE_PyramidP on cells and faces. The shape
+   * values and the shape gradients in each direction are given as row-major
+   * matrices of size <tt>n_dofs x n_q_points</tt>, with @p gradient_stride
+   * entries between the matrices of two directions.
+   *
+   * Rather than performing one matrix-vector product for the values and one
+   * for each direction of the gradient, the values and all gradient
+   * components are computed in a single pass: evaluate() works on blocks of
+   * quadrature points and integrate() on blocks of unknowns, keeping the
+   * partial sums of a block in registers. Thus, each entry of the input is
+   * loaded once per block rather than once per output entry, and the rows of
+   * the shape matrices are streamed contiguously. The vectorization is over
+   * the cells of a batch, i.e., the lanes of @p Number.
+   */
+  template <int dim, typename Number>
+  struct FEEvaluationImplDense
+  {
+    /**
+     * The number of quadrature points (in evaluate()) or unknowns (in
+     * integrate()) that are processed at once. The <tt>(dim+1) *
+     * block_size</tt> partial sums fit into the registers of common SIMD
+     * architectures.
+     */
+    static constexpr unsigned int block_size = 4;
+
+    static void
+    evaluate(const unsigned int n_components,
+             const unsigned int n_dofs,
+             const unsigned int n_q_points,
+             const Number *     shape_values,
+             const Number *     shape_gradients,
+             const unsigned int gradient_stride,
+             const Number *     values_dofs,
+             Number *           values_quad,
+             Number *           gradients_quad,
+             const bool         evaluate_values,
+             const bool         evaluate_gradients)
+    {
+      if (evaluate_values && evaluate_gradients)
+        do_evaluate<true, true>(n_components,
+                                n_dofs,
+                                n_q_points,
+                                shape_values,
+                                shape_gradients,
+                                gradient_stride,
+                                values_dofs,
+                                values_quad,
+                                gradients_quad);
+      else if (evaluate_values)
+        do_evaluate<true, false>(n_components,
+                                 n_dofs,
+                                 n_q_points,
+                                 shape_values,
+                                 shape_gradients,
+                                 gradient_stride,
+                                 values_dofs,
+                                 values_quad,
+                                 gradients_quad);
+      else if (evaluate_gradients)
+        do_evaluate<false, true>(n_components,
+                                 n_dofs,
+                                 n_q_points,
+                                 shape_values,
+                                 shape_gradients,
+                                 gradient_stride,
+                                 values_dofs,
+                                 values_quad,
+                                 gradients_quad);
+    }
+
+    static void
+    integrate(const unsigned int n_components,
+              const unsigned int n_dofs,
+              const unsigned int n_q_points,
+              const Number *     shape_values,
+              const Number *     shape_gradients,
+              const unsigned int gradient_stride,
+              Number *           values_dofs,
+              const Number *     values_quad,
+              const Number *     gradients_quad,
+              const bool         integrate_values,
+              const bool         integrate_gradients,
+              const bool         add_into_values_array)
+    {
+      if (integrate_values && integrate_gradients)
+        do_integrate<true, true>(n_components,
+                                 n_dofs,
+                                 n_q_points,
+                                 shape_values,
+                                 shape_gradients,
+                                 gradient_stride,
+                                 values_dofs,
+                                 values_quad,
+                                 gradients_quad,
+                                 add_into_values_array);
+      else if (integrate_values)
+        do_integrate<true, false>(n_components,
+                                  n_dofs,
+                                  n_q_points,
+                                  shape_values,
+                                  shape_gradients,
+                                  gradient_stride,
+                                  values_dofs,
+                                  values_quad,
+                                  gradients_quad,
+                                  add_into_values_array);
+      else if (integrate_gradients)
+        do_integrate<false, true>(n_components,
+                                  n_dofs,
+                                  n_q_points,
+                                  shape_values,
+                                  shape_gradients,
+                                  gradient_stride,
+                                  values_dofs,
+                                  values_quad,
+                                  gradients_quad,
+                                  add_into_values_array);
+    }
+
+  private:
+    template <bool do_values, bool do_gradients>
+    static void
+    do_evaluate(const unsigned int n_components,
+                const unsigned int n_dofs,
+                const unsigned int n_q_points,
+                const Number *     shape_values,
+                const Number *     shape_gradients,
+                const unsigned int gradient_stride,
+                const Number *     values_dofs,
+                Number *           values_quad,
+                Number *           gradients_quad)
+    {
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          const Number *dofs      = values_dofs + c * n_dofs;
+          Number *      values    = values_quad + c * n_q_points;
+          Number *      gradients = gradients_quad + c * dim * n_q_points;
+
+          unsigned int q = 0;
+          for (; q + block_size <= n_q_points; q += block_size)
+            evaluate_block<block_size, do_values, do_gradients>(
+              n_dofs,
+              n_q_points,
+              q,
+              shape_values,
+              shape_gradients,
+              gradient_stride,
+              dofs,
+              values,
+              gradients);
+          for (; q < n_q_points; ++q)
+            evaluate_block<1, do_values, do_gradients>(n_dofs,
+                                                       n_q_points,
+                                                       q,
+                                                       shape_values,
+                                                       shape_gradients,
+                                                       gradient_stride,
+                                                       dofs,
+                                                       values,
+                                                       gradients);
+        }
+    }
+
+    template <unsigned int n_block, bool do_values, bool do_gradients>
+    static inline DEAL_II_ALWAYS_INLINE void
+    evaluate_block(const unsigned int n_dofs,
+                   const unsigned int n_q_points,
+                   const unsigned int first_q,
+                   const Number *     shape_values,
+                   const Number *     shape_gradients,
+                   const unsigned int gradient_stride,
+                   const Number *     dofs,
+                   Number *           values,
+                   Number *           gradients)
+    {
+      Number value_sums[n_block];
+      Number gradient_sums[dim][n_block];
+      for (unsigned int b = 0; b < n_block; ++b)
+        {
+          value_sums[b] = Number();
+          for (unsigned int d = 0; d < dim; ++d)
+            gradient_sums[d][b] = Number();
+        }
+
+      for (unsigned int i = 0; i < n_dofs; ++i)
+        {
+          const Number       dof_value = dofs[i];
+          const unsigned int offset    = i * n_q_points + first_q;
+          if (do_values)
+            for (unsigned int b = 0; b < n_block; ++b)
+              value_sums[b] += shape_values[offset + b] * dof_value;
+          if (do_gradients)
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int b = 0; b < n_block; ++b)
+                gradient_sums[d][b] +=
+                  shape_gradients[d * gradient_stride + offset + b] *
+                  dof_value;
+        }
+
+      for (unsigned int b = 0; b < n_block; ++b)
+        {
+          if (do_values)
+            values[first_q + b] = value_sums[b];
+          if (do_gradients)
+            for (unsigned int d = 0; d < dim; ++d)
+              gradients[d * n_q_points + first_q + b] = gradient_sums[d][b];
+        }
+    }
+
+    template <bool do_values, bool do_gradients>
+    static void
+    do_integrate(const unsigned int n_components,
+                 const unsigned int n_dofs,
+                 const unsigned int n_q_points,
+                 const Number *     shape_values,
+                 const Number *     shape_gradients,
+                 const unsigned int gradient_stride,
+                 Number *           values_dofs,
+                 const Number *     values_quad,
+                 const Number *     gradients_quad,
+                 const bool         add_into_values_array)
+    {
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          Number *      dofs      = values_dofs + c * n_dofs;
+          const Number *values    = values_quad + c * n_q_points;
+          const Number *gradients = gradients_quad + c * dim * n_q_points;
+
+          unsigned int i = 0;
+          for (; i + block_size <= n_dofs; i += block_size)
+            integrate_block<block_size, do_values, do_gradients>(
+              n_q_points,
+              i,
+              shape_values,
+              shape_gradients,
+              gradient_stride,
+              values,
+              gradients,
+              dofs,
+              add_into_values_array);
+          for (; i < n_dofs; ++i)
+            integrate_block<1, do_values, do_gradients>(n_q_points,
+                                                        i,
+                                                        shape_values,
+                                                        shape_gradients,
+                                                        gradient_stride,
+                                                        values,
+                                                        gradients,
+                                                        dofs,
+                                                        add_into_values_array);
+        }
+    }
+
+    template <unsigned int n_block, bool do_values, bool do_gradients>
+    static inline DEAL_II_ALWAYS_INLINE void
+    integrate_block(const unsigned int n_q_points,
+                    const unsigned int first_dof,
+                    const Number *     shape_values,
+                    const Number *     shape_gradients,
+                    const unsigned int gradient_stride,
+                    const Number *     values,
+                    const Number *     gradients,
+                    Number *           dofs,
+                    const bool         add_into_values_array)
+    {
+      Number sums[n_block];
+      for (unsigned int b = 0; b < n_block; ++b)
+        sums[b] = add_into_values_array ? dofs[first_dof + b] : Number();
+
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          Number value;
+          Number gradient[dim];
+          if (do_values)
+            value = values[q];
+          if (do_gradients)
+            for (unsigned int d = 0; d < dim; ++d)
+              gradient[d] = gradients[d * n_q_points + q];
+
+          for (unsigned int b = 0; b < n_block; ++b)
+            {
+              const unsigned int index = (first_dof + b) * n_q_points + q;
+              if (do_values)
+                sums[b] += shape_values[index] * value;
+              if (do_gradients)
+                for (unsigned int d = 0; d < dim; ++d)
+                  sums[b] += shape_gradients[d * gradient_stride + index] *
+                             gradient[d];
+            }
+        }
+
+      for (unsigned int b = 0; b < n_block; ++b)
+        dofs[first_dof + b] = sums[b];
+    }
+  };
+
+
+
   /**
    * Specialization for MatrixFreeFunctions::tensor_none, which cannot use the
-   * sum-factorization kernels.
+   * sum-factorization kernels and uses the dense kernels of
+   * FEEvaluationImplDense instead.
    */
   template <int dim, int fe_degree, int n_q_points_1d, typename Number>
   struct FEEvaluationImpl<MatrixFreeFunctions::tensor_none,
@@ -696,51 +998,18 @@ namespace internal
     const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
     const unsigned int n_q_points = shape_info.n_q_points;
 
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
-
-    if (evaluation_flag & EvaluationFlags::values)
-      {
-        const auto shape_values = shape_info.data.front().shape_values.data();
-        auto       values_quad_ptr        = values_quad;
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            eval.template values<0, true, false>(values_dofs_actual_ptr,
-                                                 values_quad_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
-
-    if (evaluation_flag & EvaluationFlags::gradients)
-      {
-        const auto shape_gradients =
-          shape_info.data.front().shape_gradients.data();
-        auto gradients_quad_ptr     = gradients_quad;
-        auto values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            for (unsigned int d = 0; d < dim; ++d)
-              {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                eval.template gradients<0, true, false>(values_dofs_actual_ptr,
-                                                        gradients_quad_ptr);
-
-                gradients_quad_ptr += n_q_points;
-              }
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
+    FEEvaluationImplDense<dim, Number>::evaluate(
+      n_components,
+      n_dofs,
+      n_q_points,
+      shape_info.data.front().shape_values.data(),
+      shape_info.data.front().shape_gradients.data(),
+      n_dofs * n_q_points,
+      values_dofs_actual,
+      values_quad,
+      gradients_quad,
+      evaluation_flag & EvaluationFlags::values,
+      evaluation_flag & EvaluationFlags::gradients);
 
     if (evaluation_flag & EvaluationFlags::hessians)
       {
@@ -772,61 +1041,19 @@ namespace internal
     const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
     const unsigned int n_q_points = shape_info.n_q_points;
 
-    using Eval =
-      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
-
-    if (integration_flag & EvaluationFlags::values)
-      {
-        const auto shape_values = shape_info.data.front().shape_values.data();
-        auto       values_quad_ptr        = values_quad;
-        auto       values_dofs_actual_ptr = values_dofs_actual;
-
-        Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            if (add_into_values_array == false)
-              eval.template values<0, false, false>(values_quad_ptr,
-                                                    values_dofs_actual_ptr);
-            else
-              eval.template values<0, false, true>(values_quad_ptr,
-                                                   values_dofs_actual_ptr);
-
-            values_quad_ptr += n_q_points;
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
-
-    if (integration_flag & EvaluationFlags::gradients)
-      {
-        const auto shape_gradients =
-          shape_info.data.front().shape_gradients.data();
-        auto gradients_quad_ptr     = gradients_quad;
-        auto values_dofs_actual_ptr = values_dofs_actual;
-
-        for (unsigned int c = 0; c < n_components; ++c)
-          {
-            for (unsigned int d = 0; d < dim; ++d)
-              {
-                Eval eval(nullptr,
-                          shape_gradients + n_q_points * n_dofs * d,
-                          nullptr,
-                          n_dofs,
-                          n_q_points);
-
-                if ((add_into_values_array == false &&
-                     (integration_flag & EvaluationFlags::values) == false) &&
-                    d == 0)
-                  eval.template gradients<0, false, false>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-                else
-                  eval.template gradients<0, false, true>(
-                    gradients_quad_ptr, values_dofs_actual_ptr);
-
-                gradients_quad_ptr += n_q_points;
-              }
-            values_dofs_actual_ptr += n_dofs;
-          }
-      }
+    FEEvaluationImplDense<dim, Number>::integrate(
+      n_components,
+      n_dofs,
+      n_q_points,
+      shape_info.data.front().shape_values.data(),
+      shape_info.data.front().shape_gradients.data(),
+      n_dofs * n_q_points,
+      values_dofs_actual,
+      values_quad,
+      gradients_quad,
+      integration_flag & EvaluationFlags::values,
+      integration_flag & EvaluationFlags::gradients,
+      add_into_values_array);
   }
 
 
@@ -2550,63 +2777,20 @@ namespace internal
         {
           const unsigned int n_dofs     = data.dofs_per_component_on_cell;
           const unsigned int n_q_points = data.n_q_points_faces[face_no];
-          const auto         shape_info = data.data.front();
-
-          using Eval = EvaluatorTensorProduct<evaluate_general,
-                                              1,
-                                              0,
-                                              0,
-                                              VectorizedArrayType,
-                                              VectorizedArrayType>;
-
-          if (evaluate_values)
-            {
-              const auto shape_values =
-                &shape_info.shape_values_face(face_no, face_orientation, 0);
-
-              auto values_quad_ptr        = values_quad;
-              auto values_dofs_actual_ptr = values_array;
-
-              Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-              for (unsigned int c = 0; c < n_components; ++c)
-                {
-                  eval.template values<0, true, false>(values_dofs_actual_ptr,
-                                                       values_quad_ptr);
-
-                  values_quad_ptr += n_q_points;
-                  values_dofs_actual_ptr += n_dofs;
-                }
-            }
-
-          if (evaluate_gradients)
-            {
-              auto gradients_quad_ptr     = gradients_quad;
-              auto values_dofs_actual_ptr = values_array;
-
-              std::array<const VectorizedArrayType *, dim> shape_gradients;
-              for (unsigned int d = 0; d < dim; ++d)
-                shape_gradients[d] = &shape_info.shape_gradients_face(
-                  face_no, face_orientation, d, 0);
-
-              for (unsigned int c = 0; c < n_components; ++c)
-                {
-                  for (unsigned int d = 0; d < dim; ++d)
-                    {
-                      Eval eval(nullptr,
-                                shape_gradients[d],
-                                nullptr,
-                                n_dofs,
-                                n_q_points);
-
-                      eval.template gradients<0, true, false>(
-                        values_dofs_actual_ptr, gradients_quad_ptr);
-
-                      gradients_quad_ptr += n_q_points;
-                    }
-                  values_dofs_actual_ptr += n_dofs;
-                }
-            }
+          const auto &       shape_info = data.data.front();
 
+          FEEvaluationImplDense<dim, VectorizedArrayType>::evaluate(
+            n_components,
+            n_dofs,
+            n_q_points,
+            &shape_info.shape_values_face(face_no, face_orientation, 0),
+            &shape_info.shape_gradients_face(face_no, face_orientation, 0, 0),
+            shape_info.shape_gradients_face.size(3),
+            values_array,
+            values_quad,
+            gradients_quad,
+            evaluate_values,
+            evaluate_gradients);
 
           return true;
         }
@@ -2705,67 +2889,21 @@ namespace internal
         {
           const unsigned int n_dofs     = data.dofs_per_component_on_cell;
           const unsigned int n_q_points = data.n_q_points_faces[face_no];
-          const auto         shape_info = data.data.front();
-
-          using Eval = EvaluatorTensorProduct<evaluate_general,
-                                              1,
-                                              0,
-                                              0,
-                                              VectorizedArrayType,
-                                              VectorizedArrayType>;
-
-          if (integrate_values)
-            {
-              const auto shape_values =
-                &shape_info.shape_values_face(face_no, face_orientation, 0);
-
-              auto values_quad_ptr        = values_quad;
-              auto values_dofs_actual_ptr = values_array;
-
-              Eval eval(shape_values, nullptr, nullptr, n_dofs, n_q_points);
-              for (unsigned int c = 0; c < n_components; ++c)
-                {
-                  eval.template values<0, false, false>(values_quad_ptr,
-                                                        values_dofs_actual_ptr);
-
-                  values_quad_ptr += n_q_points;
-                  values_dofs_actual_ptr += n_dofs;
-                }
-            }
-
-          if (integrate_gradients)
-            {
-              auto gradients_quad_ptr     = gradients_quad;
-              auto values_dofs_actual_ptr = values_array;
-
-              std::array<const VectorizedArrayType *, dim> shape_gradients;
-              for (unsigned int d = 0; d < dim; ++d)
-                shape_gradients[d] = &shape_info.shape_gradients_face(
-                  face_no, face_orientation, d, 0);
-
-              for (unsigned int c = 0; c < n_components; ++c)
-                {
-                  for (unsigned int d = 0; d < dim; ++d)
-                    {
-                      Eval eval(nullptr,
-                                shape_gradients[d],
-                                nullptr,
-                                n_dofs,
-                                n_q_points);
-
-                      if ((integrate_values == false) && d == 0)
-                        eval.template gradients<0, false, false>(
-                          gradients_quad_ptr, values_dofs_actual_ptr);
-                      else
-                        eval.template gradients<0, false, true>(
-                          gradients_quad_ptr, values_dofs_actual_ptr);
-
-                      gradients_quad_ptr += n_q_points;
-                    }
-                  values_dofs_actual_ptr += n_dofs;
-                }
-            }
+          const auto &       shape_info = data.data.front();
 
+          FEEvaluationImplDense<dim, VectorizedArrayType>::integrate(
+            n_components,
+            n_dofs,
+            n_q_points,
+            &shape_info.shape_values_face(face_no, face_orientation, 0),
+            &shape_info.shape_gradients_face(face_no, face_orientation, 0, 0),
+            shape_info.shape_gradients_face.size(3),
+            values_array,
+            values_quad,
+            gradients_quad,
+            integrate_values,
+            integrate_gradients,
+            false);
 
           return true;
         }
@@ -4131,6 +4269,129 @@ namespace internal
 
 
 
+  /**
+   * This struct applies the hanging-node constraints of a cell batch on the
+   * fly, given the masks computed by MatrixFreeFunctions::HangingNodes. On
+   * the faces and edges of a cell that are constrained, the values of the
+   * degrees of freedom read from the coarser neighbor are interpolated to
+   * the position of the cell by one-dimensional interpolations along the
+   * lines in each coordinate direction (sum factorization). The transposed
+   * operation is used when integrating, in order to distribute the values
+   * of the constrained degrees of freedom back to the coarser neighbor.
+   */
+  template <int dim, typename Number>
+  struct FEEvaluationImplHangingNodes
+  {
+    static void
+    run(const unsigned int                            n_components,
+        const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+        const bool                                    transpose,
+        const std::array<MatrixFreeFunctions::ConstraintKinds, Number::size()>
+          &     constraint_mask,
+        Number *values)
+    {
+      using namespace MatrixFreeFunctions;
+
+      const auto &       univariate_shape_data = shape_info.data.front();
+      const unsigned int fe_degree = univariate_shape_data.fe_degree;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      const unsigned int dofs_per_component =
+        Utilities::fixed_power<dim>(n_dofs_1d);
+      const Number *weights =
+        univariate_shape_data.subface_interpolation_matrix.data();
+      AssertDimension(univariate_shape_data.subface_interpolation_matrix.size(),
+                      n_dofs_1d * n_dofs_1d);
+      AssertIndexRange(fe_degree, max_n_dofs_1d_hanging_nodes);
+
+      const ConstraintKinds type[3] = {ConstraintKinds::type_x,
+                                       ConstraintKinds::type_y,
+                                       ConstraintKinds::type_z};
+      const ConstraintKinds face[3] = {ConstraintKinds::face_x,
+                                       ConstraintKinds::face_y,
+                                       ConstraintKinds::face_z};
+      const ConstraintKinds edge[3] = {ConstraintKinds::edge_yz,
+                                       ConstraintKinds::edge_zx,
+                                       ConstraintKinds::edge_xy};
+
+      typename Number::value_type line_in[max_n_dofs_1d_hanging_nodes];
+      typename Number::value_type line_out[max_n_dofs_1d_hanging_nodes];
+
+      for (unsigned int v = 0; v < Number::size(); ++v)
+        {
+          const ConstraintKinds mask = constraint_mask[v];
+          if (mask == ConstraintKinds::unconstrained)
+            continue;
+
+          for (unsigned int direction = 0; direction < dim; ++direction)
+            {
+              // the lines along 'direction' to interpolate lie on the
+              // constrained faces normal to the other two directions 'a' and
+              // 'b', or along a constrained edge in 3D. The weights are the
+              // ones of the first child (lower position along the line) or,
+              // mirrored, of the second child
+              const unsigned int a = (direction + 1) % dim;
+              const unsigned int b = (direction + 2) % dim;
+              const bool         face_a = is_set(mask, face[a]);
+              const bool         face_b = dim == 3 && is_set(mask, face[b]);
+              const bool edge_d = dim == 3 && is_set(mask, edge[direction]);
+              if (!face_a && !face_b && !edge_d)
+                continue;
+
+              const unsigned int pos_a = is_set(mask, type[a]) ? 0 : fe_degree;
+              const unsigned int pos_b = is_set(mask, type[b]) ? 0 : fe_degree;
+              const bool first_child   = is_set(mask, type[direction]);
+              const unsigned int stride = Utilities::pow(n_dofs_1d, direction);
+              const unsigned int stride_a = Utilities::pow(n_dofs_1d, a);
+              const unsigned int stride_b = Utilities::pow(n_dofs_1d, b);
+
+              for (unsigned int ib = 0; ib < (dim == 3 ? n_dofs_1d : 1); ++ib)
+                for (unsigned int ia = 0; ia < n_dofs_1d; ++ia)
+                  {
+                    if (!((face_a && ia == pos_a) ||
+                          (face_b && ib == pos_b) ||
+                          (edge_d && ia == pos_a && ib == pos_b)))
+                      continue;
+
+                    const unsigned int offset =
+                      ia * stride_a + (dim == 3 ? ib * stride_b : 0);
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      {
+                        Number *line_values =
+                          values + c * dofs_per_component + offset;
+                        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                          line_in[i] = line_values[i * stride][v];
+
+                        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                          {
+                            typename Number::value_type sum = 0;
+                            for (unsigned int k = 0; k < n_dofs_1d; ++k)
+                              {
+                                // weight of the coarse function k in the
+                                // fine point i, taking the mirrored matrix
+                                // for the second child
+                                const unsigned int fine =
+                                  first_child ? (transpose ? k : i) :
+                                                fe_degree - (transpose ? k : i);
+                                const unsigned int coarse =
+                                  first_child ? (transpose ? i : k) :
+                                                fe_degree - (transpose ? i : k);
+                                sum += weights[fine * n_dofs_1d + coarse][0] *
+                                       line_in[k];
+                              }
+                            line_out[i] = sum;
+                          }
+
+                        for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                          line_values[i * stride][v] = line_out[i];
+                      }
+                  }
+            }
+        }
+    }
+  };
+
+
+
   /**
    * This struct implements the action of the inverse mass matrix operation
    * using an FEEvaluationBaseData argument.
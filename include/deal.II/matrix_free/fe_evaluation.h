@@ -655,6 +655,12 @@ public:
    * MatrixFree object and lead to a structure that does not effectively use
    * vectorization in the evaluate routines based on these values (instead,
    * VectorizedArray::size() same copies are worked on).
+   *
+   * @note On cells with hanging-node constraints that are resolved on the
+   * fly (see MatrixFree::AdditionalData::use_fast_hanging_node_algorithm),
+   * the transposed interpolation to the coarser neighbors is applied to a
+   * copy of the values stored in this class before summing them into the
+   * vector. The local values are not changed by this call.
    */
   template <typename VectorType>
   void
@@ -701,6 +707,11 @@ public:
    * MatrixFree object and lead to a structure that does not effectively use
    * vectorization in the evaluate routines based on these values (instead,
    * VectorizedArray::size() same copies are worked on).
+   *
+   * @note On cells with hanging-node constraints that are resolved on the
+   * fly (see MatrixFree::AdditionalData::use_fast_hanging_node_algorithm),
+   * the values are written through the unconstrained indices of the cell,
+   * i.e., the constrained degrees of freedom on the cell are set as well.
    */
   template <typename VectorType>
   void
@@ -1212,12 +1223,15 @@ protected:
    * A unified function to read from and write into vectors based on the given
    * template operation. It can perform the operation for @p read_dof_values,
    * @p distribute_local_to_global, and @p set_dof_values. It performs the
-   * operation for several vectors at a time.
+   * operation for several vectors at a time. The local values are read from
+   * or written to the arrays pointed to by @p values_dofs, one per
+   * component, which usually are the arrays of this object.
    */
   template <typename VectorType, typename VectorOperation>
   void
   read_write_operation(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &vectors,
     const std::array<
       const std::vector<ArrayView<const typename VectorType::value_type>> *,
@@ -1236,6 +1250,7 @@ protected:
   void
   read_write_operation_contiguous(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &vectors,
     const std::array<
       const std::vector<ArrayView<const typename VectorType::value_type>> *,
@@ -1253,8 +1268,30 @@ protected:
   void
   read_write_operation_global(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &vectors) const;
 
+  /**
+   * Return whether any of the cells in the current batch has hanging-node
+   * constraints that are resolved on the fly, see
+   * MatrixFree::AdditionalData::use_fast_hanging_node_algorithm.
+   */
+  bool
+  has_hanging_node_constraints() const;
+
+  /**
+   * Apply the hanging-node constraints of the cells in the current batch on
+   * the fly to the values in the arrays pointed to by @p values_dofs, one per
+   * component. If @p transpose is false,
+   * the values read from the degrees of freedom of the coarser neighbors are
+   * interpolated to the constrained degrees of freedom of the cell, as
+   * needed after reading from a vector. If @p transpose is true, the
+   * transposed operation is applied before summing into a vector.
+   */
+  void
+  apply_hanging_node_constraints(VectorizedArrayType *const *values_dofs,
+                                 const bool                  transpose) const;
+
   /**
    * This field stores the values for local degrees of freedom (e.g. after
    * reading out from a vector but before applying unit cell transformations
@@ -2948,6 +2985,35 @@ private:
   void
   check_template_arguments(const unsigned int fe_no,
                            const unsigned int first_selected_component);
+
+  /**
+   * Compute the inverse Jacobians and the JxW values of the present cell
+   * batch from the support points of the mapping, starting at index @p
+   * offset in MappingInfoStorage::mapping_support_points, and let the
+   * pointers of the base class point to the result. Used on cells where
+   * MatrixFree::AdditionalData::store_mapping_support_points has been set.
+   */
+  void
+  compute_jacobians_from_support_points(const unsigned int offset);
+
+  /**
+   * Scratch storage for compute_jacobians_from_support_points(), holding the
+   * support points, their values and gradients at the quadrature points, and
+   * the temporary data of the evaluator.
+   */
+  AlignedVector<VectorizedArrayType> geometry_scratch;
+
+  /**
+   * The inverse and transposed Jacobians computed by
+   * compute_jacobians_from_support_points().
+   */
+  AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians_on_the_fly;
+
+  /**
+   * The Jacobian determinants times the quadrature weights computed by
+   * compute_jacobians_from_support_points().
+   */
+  AlignedVector<VectorizedArrayType> JxW_on_the_fly;
 };
 
 
@@ -4376,6 +4442,7 @@ inline void
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   read_write_operation(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &src,
     const std::array<
       const std::vector<ArrayView<const typename VectorType::value_type>> *,
@@ -4388,7 +4455,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // separate function
   if (this->matrix_info == nullptr)
     {
-      read_write_operation_global(operation, src);
+      read_write_operation_global(operation, values_dofs, src);
       return;
     }
 
@@ -4423,7 +4490,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
         [this->cell] >=
       internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::contiguous)
     {
-      read_write_operation_contiguous(operation, src, src_sm, mask);
+      read_write_operation_contiguous(
+        operation, values_dofs, src, src_sm, mask);
       return;
     }
 
@@ -4472,9 +4540,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       return;
     }
 
-  const unsigned int *  dof_indices[n_lanes];
-  VectorizedArrayType **values_dofs =
-    const_cast<VectorizedArrayType **>(&this->values_dofs[0]);
+  const unsigned int *dof_indices[n_lanes];
 
   // Assign the appropriate cell ids for face/cell case and get the pointers
   // to the dof indices of the cells on all lanes
@@ -4485,6 +4551,23 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       ->n_vectorization_lanes_filled[this->dof_access_index][this->cell];
   bool               has_constraints   = false;
   const unsigned int n_components_read = n_fe_components > 1 ? n_components : 1;
+
+  // cells with hanging-node constraints resolved on the fly store the
+  // indices of the coarser neighbors, so we need to switch to the
+  // unconstrained indices when no constraints should be applied and when
+  // setting values
+  const bool use_plain_indices_on_hanging_nodes =
+    (apply_constraints == false ||
+     std::is_same<VectorOperation,
+                  internal::VectorSetter<Number, VectorizedArrayType>>::
+       value) &&
+    has_hanging_node_constraints();
+  const auto lane_has_hanging_nodes = [&](const unsigned int cell_index) {
+    return use_plain_indices_on_hanging_nodes &&
+           this->dof_info->hanging_node_constraint_masks[cell_index] !=
+             internal::MatrixFreeFunctions::ConstraintKinds::unconstrained;
+  };
+
   if (is_face)
     {
       if (this->dof_access_index ==
@@ -4530,7 +4613,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                ->row_starts[(this->cell * n_lanes + v) * n_fe_components +
                             first_selected_component];
           if (my_index_start[n_components_read].second !=
-              my_index_start[0].second)
+                my_index_start[0].second ||
+              lane_has_hanging_nodes(this->cell * n_lanes + v))
             has_constraints = true;
           Assert(my_index_start[n_components_read].first ==
                      my_index_start[0].first ||
@@ -4599,10 +4683,11 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
       // For read_dof_values_plain, redirect the dof_indices field to the
       // unconstrained indices
-      if (apply_constraints == false &&
-          this->dof_info->row_starts[cell_dof_index].second !=
-            this->dof_info->row_starts[cell_dof_index + n_components_read]
-              .second)
+      if ((apply_constraints == false &&
+           this->dof_info->row_starts[cell_dof_index].second !=
+             this->dof_info->row_starts[cell_dof_index + n_components_read]
+               .second) ||
+          (!is_face && lane_has_hanging_nodes(cell_index)))
         {
           Assert(this->dof_info->row_starts_plain_indices[cell_index] !=
                    numbers::invalid_unsigned_int,
@@ -4745,6 +4830,7 @@ inline void
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   read_write_operation_global(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &src) const
 {
   Assert(!local_dof_indices.empty(), ExcNotInitialized());
@@ -4777,6 +4863,7 @@ inline void
 FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   read_write_operation_contiguous(
     const VectorOperation &                        operation,
+    VectorizedArrayType *const *                   values_dofs,
     const std::array<VectorType *, n_components_> &src,
     const std::array<
       const std::vector<ArrayView<const typename VectorType::value_type>> *,
@@ -5260,11 +5347,14 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   internal::VectorReader<Number, VectorizedArrayType> reader;
   read_write_operation(reader,
+                       this->values_dofs,
                        src_data.first,
                        src_data.second,
                        std::bitset<VectorizedArrayType::size()>().flip(),
                        true);
 
+  apply_hanging_node_constraints(this->values_dofs, false);
+
 #  ifdef DEBUG
   dof_values_initialized = true;
 #  endif
@@ -5292,6 +5382,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   internal::VectorReader<Number, VectorizedArrayType> reader;
   read_write_operation(reader,
+                       this->values_dofs,
                        src_data.first,
                        src_data.second,
                        std::bitset<VectorizedArrayType::size()>().flip(),
@@ -5332,7 +5423,101 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
     distributor;
-  read_write_operation(distributor, dst_data.first, dst_data.second, mask);
+
+  if (has_hanging_node_constraints())
+    {
+      // apply the transposed interpolation to a copy of the local values
+      // and sum that copy into the vector, such that the values held by
+      // this object remain unchanged. the copy lives in scratch memory of
+      // the MatrixFree object that is handed back also if an exception
+      // passes through here
+      const auto release_buffer =
+        [this](AlignedVector<VectorizedArrayType> *buffer) {
+          this->matrix_info->release_scratch_data(buffer);
+        };
+      const std::unique_ptr<AlignedVector<VectorizedArrayType>,
+                            decltype(release_buffer)>
+        buffer(this->matrix_info->acquire_scratch_data(), release_buffer);
+
+      const unsigned int dofs_per_component =
+        this->data->dofs_per_component_on_cell;
+      buffer->resize_fast(n_components * dofs_per_component);
+      VectorizedArrayType *values_dofs_copy[n_components];
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        {
+          values_dofs_copy[comp] = buffer->data() + comp * dofs_per_component;
+          std::copy(this->values_dofs[comp],
+                    this->values_dofs[comp] + dofs_per_component,
+                    values_dofs_copy[comp]);
+        }
+
+      apply_hanging_node_constraints(values_dofs_copy, true);
+      read_write_operation(distributor,
+                           values_dofs_copy,
+                           dst_data.first,
+                           dst_data.second,
+                           mask);
+    }
+  else
+    read_write_operation(distributor,
+                         this->values_dofs,
+                         dst_data.first,
+                         dst_data.second,
+                         mask);
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline bool
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  has_hanging_node_constraints() const
+{
+  if (is_face || this->matrix_info == nullptr ||
+      this->dof_info->hanging_node_constraint_masks.empty() ||
+      this->dof_access_index !=
+        internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
+    return false;
+
+  constexpr unsigned int n_lanes = VectorizedArrayType::size();
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    if (this->dof_info->hanging_node_constraint_masks[this->cell * n_lanes +
+                                                      v] !=
+        internal::MatrixFreeFunctions::ConstraintKinds::unconstrained)
+      return true;
+
+  return false;
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_hanging_node_constraints(VectorizedArrayType *const *values_dofs,
+                                 const bool                  transpose) const
+{
+  if (has_hanging_node_constraints() == false)
+    return;
+
+  constexpr unsigned int n_lanes = VectorizedArrayType::size();
+  std::array<internal::MatrixFreeFunctions::ConstraintKinds, n_lanes>
+    constraint_mask;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    constraint_mask[v] =
+      this->dof_info->hanging_node_constraint_masks[this->cell * n_lanes + v];
+
+  for (unsigned int comp = 0; comp < n_components; ++comp)
+    internal::FEEvaluationImplHangingNodes<dim, VectorizedArrayType>::run(
+      1, *this->data, transpose, constraint_mask, values_dofs[comp]);
 }
 
 
@@ -5363,7 +5548,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     this->dof_info);
 
   internal::VectorSetter<Number, VectorizedArrayType> setter;
-  read_write_operation(setter, dst_data.first, dst_data.second, mask);
+  read_write_operation(
+    setter, this->values_dofs, dst_data.first, dst_data.second, mask);
 }
 
 
@@ -5395,7 +5581,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     this->dof_info);
 
   internal::VectorSetter<Number, VectorizedArrayType> setter;
-  read_write_operation(setter, dst_data.first, dst_data.second, mask, false);
+  read_write_operation(
+    setter, this->values_dofs, dst_data.first, dst_data.second, mask, false);
 }
 
 
@@ -7725,6 +7912,73 @@ FEEvaluation<dim,
 
 
 
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components_,
+          typename Number,
+          typename VectorizedArrayType>
+inline void
+FEEvaluation<dim,
+             fe_degree,
+             n_q_points_1d,
+             n_components_,
+             Number,
+             VectorizedArrayType>::
+  compute_jacobians_from_support_points(const unsigned int offset)
+{
+  const internal::MatrixFreeFunctions::ShapeInfo<VectorizedArrayType>
+    &                shape_info       = this->mapping_data->mapping_shape_info;
+  const unsigned int n_mapping_points = shape_info.dofs_per_component_on_cell;
+  AssertDimension(shape_info.n_q_points, n_q_points);
+  AssertIndexRange(offset + dim * n_mapping_points - 1,
+                   this->mapping_data->mapping_support_points.size());
+
+  // layout of the scratch array: support points, values and gradients at
+  // the quadrature points, and the temporary data of the evaluator with the
+  // same size as in the setup of MappingInfo
+  const unsigned int scratch_size =
+    dim * (2 * n_q_points + 3 * n_mapping_points);
+  geometry_scratch.resize_fast(dim * n_mapping_points + dim * n_q_points +
+                               dim * dim * n_q_points + scratch_size);
+  VectorizedArrayType *support_points = geometry_scratch.data();
+  VectorizedArrayType *values         = support_points + dim * n_mapping_points;
+  VectorizedArrayType *gradients      = values + dim * n_q_points;
+  VectorizedArrayType *scratch        = gradients + dim * dim * n_q_points;
+
+  const VectorizedArrayType *stored_points =
+    this->mapping_data->mapping_support_points.data() + offset;
+  for (unsigned int i = 0; i < dim * n_mapping_points; ++i)
+    support_points[i] = stored_points[i];
+
+  internal::FEEvaluationFactory<dim, Number, VectorizedArrayType>::evaluate(
+    dim,
+    EvaluationFlags::gradients,
+    shape_info,
+    support_points,
+    values,
+    gradients,
+    nullptr,
+    scratch);
+
+  jacobians_on_the_fly.resize_fast(n_q_points);
+  JxW_on_the_fly.resize_fast(n_q_points);
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      Tensor<2, dim, VectorizedArrayType> jac;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          jac[d][e] = gradients[q + (d * dim + e) * n_q_points];
+      JxW_on_the_fly[q] = determinant(jac) * this->quadrature_weights[q];
+      jacobians_on_the_fly[q] = transpose(invert(jac));
+    }
+
+  this->jacobian = jacobians_on_the_fly.data();
+  this->J_value  = JxW_on_the_fly.data();
+}
+
+
+
 template <int dim,
           int fe_degree,
           int n_q_points_1d,
@@ -7753,8 +8007,14 @@ FEEvaluation<dim,
 
   const unsigned int offsets =
     this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (this->cell_type == internal::MatrixFreeFunctions::general &&
+      this->mapping_data->mapping_support_points.empty() == false)
+    compute_jacobians_from_support_points(offsets);
+  else
+    {
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
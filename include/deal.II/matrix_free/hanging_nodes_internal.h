@@ -0,0 +1,684 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 - 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_hanging_nodes_internal_h
+#define dealii_matrix_free_hanging_nodes_internal_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * Here is the system for how we store constraint types in a binary mask.
+     * This is not a complete contradiction-free system, i.e., there are
+     * invalid states that we just assume that we never get.
+     *
+     * If the mask is zero, there are no constraints. Then, there are three
+     * different fields with one bit per dimension. The first field determines
+     * the type, or the position of an element along each direction. The
+     * second field determines if there is a constrained face with that
+     * direction as normal. The last field determines if there is a
+     * constrained edge of a given pair of coordinate planes, but where
+     * neither of the corresponding faces are constrained (only valid in 3D).
+     *
+     * The layout of the bits is the same as the one used by the hanging node
+     * support of CUDAWrappers::MatrixFree.
+     */
+    enum class ConstraintKinds : std::uint16_t
+    {
+      /**
+       * No constraints on the cell.
+       */
+      unconstrained = 0,
+
+      /**
+       * The element is placed in the 'first position' along the x, y, or z
+       * axis, i.e., it is the lower child of its parent in that direction.
+       * These also determine which face is constrained. For example, in 2D,
+       * if face_x and type_x are set, then the face at x = 0 is constrained.
+       */
+      type_x = 1 << 0,
+      type_y = 1 << 1,
+      type_z = 1 << 2,
+
+      /**
+       * The element has a constrained face at x = 0 or x = fe_degree (and
+       * the same for y and z).
+       */
+      face_x = 1 << 3,
+      face_y = 1 << 4,
+      face_z = 1 << 5,
+
+      /**
+       * The element has a constrained edge between the given pair of
+       * coordinate planes, without either of the two faces being
+       * constrained.
+       */
+      edge_xy = 1 << 6,
+      edge_yz = 1 << 7,
+      edge_zx = 1 << 8
+    };
+
+
+
+    /**
+     * Bitwise or of two constraint masks.
+     */
+    inline ConstraintKinds
+    operator|(const ConstraintKinds a, const ConstraintKinds b)
+    {
+      return static_cast<ConstraintKinds>(static_cast<std::uint16_t>(a) |
+                                          static_cast<std::uint16_t>(b));
+    }
+
+
+
+    /**
+     * Bitwise or of two constraint masks, storing the result in @p a.
+     */
+    inline ConstraintKinds &
+    operator|=(ConstraintKinds &a, const ConstraintKinds b)
+    {
+      a = a | b;
+      return a;
+    }
+
+
+
+    /**
+     * Bitwise and of two constraint masks.
+     */
+    inline ConstraintKinds
+    operator&(const ConstraintKinds a, const ConstraintKinds b)
+    {
+      return static_cast<ConstraintKinds>(static_cast<std::uint16_t>(a) &
+                                          static_cast<std::uint16_t>(b));
+    }
+
+
+
+    /**
+     * Return whether any of the bits in @p bits are set in @p mask.
+     */
+    inline bool
+    is_set(const ConstraintKinds mask, const ConstraintKinds bits)
+    {
+      return (mask & bits) != ConstraintKinds::unconstrained;
+    }
+
+
+
+    /**
+     * The largest number of degrees of freedom per coordinate direction for
+     * which the hanging-node constraints are applied on the fly by
+     * FEEvaluation, given by the size of the temporary array used in the
+     * interpolation kernel.
+     */
+    constexpr unsigned int max_n_dofs_1d_hanging_nodes = 40;
+
+
+
+    /**
+     * This class detects the hanging-node constraints of the cells of a
+     * triangulation that are refined once more than their neighbors, and
+     * creates the masks used to resolve these constraints on the fly within
+     * FEEvaluation on the CPU, the same way as CUDAWrappers::MatrixFree does
+     * on the GPU. Instead of expanding the constrained degrees of freedom of
+     * a cell into the degrees of freedom they depend on, the degrees of
+     * freedom on the constrained faces and edges are replaced by the ones of
+     * the coarser neighbor, and the values on the cell are then obtained by
+     * a one-dimensional interpolation along each coordinate direction.
+     *
+     * The implementation of this class is explained in <em>Section 3 of
+     * Matrix-Free Finite-Element Computations On Graphics Processors With
+     * Adaptively Refined Unstructured Meshes</em> by Karl Ljungkvist,
+     * SpringSim-HPC, 2017 April 23-26.
+     *
+     * Only scalar FE_Q elements on meshes where the faces between cells of
+     * different refinement levels are in standard orientation are supported;
+     * setup_constraints() reports all other cases to the caller, which is
+     * expected to fall back to the general treatment of constraints.
+     */
+    template <int dim>
+    class HangingNodes
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      HangingNodes(const Triangulation<dim> &triangulation);
+
+      /**
+       * Compute the constraint mask for the given active cell of a
+       * DoFHandler and replace the constrained entries of @p dof_indices,
+       * given in lexicographic ordering, by the indices of the degrees of
+       * freedom of the coarser neighbors. The argument
+       * @p lexicographic_numbering describes the lexicographic ordering of
+       * the degrees of freedom on the cell as in
+       * ShapeInfo::lexicographic_numbering.
+       *
+       * Return false if the constraints on the cell cannot be represented by
+       * a mask, in which case @p dof_indices should not be used.
+       */
+      template <typename CellIterator>
+      bool
+      setup_constraints(
+        const CellIterator &                  cell,
+        const std::vector<unsigned int> &     lexicographic_numbering,
+        std::vector<types::global_dof_index> &dof_indices,
+        ConstraintKinds &                     mask) const;
+
+    private:
+      /**
+       * Set up line-to-cell mapping for edge constraints in 3D.
+       */
+      void
+      setup_line_to_cell(const Triangulation<dim> &triangulation);
+
+      /**
+       * Add the constraints of edges whose faces are not constrained, which
+       * can only happen in 3D.
+       */
+      template <typename CellIterator>
+      bool
+      setup_edge_constraints(
+        const CellIterator &                  cell,
+        const std::vector<unsigned int> &     lexicographic_numbering,
+        std::vector<types::global_dof_index> &dof_indices,
+        ConstraintKinds &                     mask) const;
+
+      /**
+       * Return the lexicographic index of the @p dof-th degree of freedom
+       * along the given line of a hexahedron.
+       */
+      static unsigned int
+      line_dof_idx(const unsigned int local_line,
+                   const unsigned int dof,
+                   const unsigned int fe_degree);
+
+      /**
+       * For each line of the triangulation in 3D, the active cells that
+       * contain the line or its parent, together with the local number of
+       * the line within these cells.
+       */
+      std::vector<std::vector<
+        std::pair<typename Triangulation<dim>::cell_iterator, unsigned int>>>
+        line_to_cells;
+    };
+
+
+
+    template <int dim>
+    inline HangingNodes<dim>::HangingNodes(
+      const Triangulation<dim> &triangulation)
+    {
+      // Set up line-to-cell mapping for edge constraints (only if dim = 3)
+      setup_line_to_cell(triangulation);
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::setup_line_to_cell(const Triangulation<dim> &)
+    {}
+
+
+
+    template <>
+    inline void
+    HangingNodes<3>::setup_line_to_cell(const Triangulation<3> &triangulation)
+    {
+      // In 3D, we can have DoFs on only an edge being constrained (e.g. in a
+      // cartesian 2x2x2 grid, where only the upper left 2 cells are refined).
+      // This sets up a helper data structure in the form of a mapping from
+      // edges (i.e. lines) to neighboring cells.
+
+      // Mapping from an edge to which children that share that edge.
+      const unsigned int line_to_children[12][2] = {{0, 2},
+                                                    {1, 3},
+                                                    {0, 1},
+                                                    {2, 3},
+                                                    {4, 6},
+                                                    {5, 7},
+                                                    {4, 5},
+                                                    {6, 7},
+                                                    {0, 4},
+                                                    {1, 5},
+                                                    {2, 6},
+                                                    {3, 7}};
+
+      const unsigned int n_raw_lines = triangulation.n_raw_lines();
+      line_to_cells.resize(n_raw_lines);
+
+      std::vector<std::vector<
+        std::pair<typename Triangulation<3>::cell_iterator, unsigned int>>>
+        line_to_inactive_cells(n_raw_lines);
+
+      // First add active and inactive cells to their lines:
+      for (const auto &cell : triangulation.cell_iterators())
+        for (unsigned int line = 0; line < GeometryInfo<3>::lines_per_cell;
+             ++line)
+          {
+            const unsigned int line_idx = cell->line(line)->index();
+            if (cell->is_active())
+              line_to_cells[line_idx].push_back(std::make_pair(cell, line));
+            else
+              line_to_inactive_cells[line_idx].push_back(
+                std::make_pair(cell, line));
+          }
+
+      // Now, we can access edge-neighboring active cells on same level to also
+      // access of an edge to the edges "children". These are found from looking
+      // at the corresponding edge of children of inactive edge neighbors.
+      for (unsigned int line_idx = 0; line_idx < n_raw_lines; ++line_idx)
+        if ((line_to_cells[line_idx].size() > 0) &&
+            line_to_inactive_cells[line_idx].size() > 0)
+          {
+            // We now have cells to add (active ones) and edges to which they
+            // should be added (inactive cells).
+            const auto &inactive_cell =
+              line_to_inactive_cells[line_idx][0].first;
+            const unsigned int neighbor_line =
+              line_to_inactive_cells[line_idx][0].second;
+
+            for (unsigned int c = 0; c < 2; ++c)
+              {
+                const auto &child =
+                  inactive_cell->child(line_to_children[neighbor_line][c]);
+                const unsigned int child_line_idx =
+                  child->line(neighbor_line)->index();
+
+                // Now add all active cells
+                for (const auto &cl : line_to_cells[line_idx])
+                  line_to_cells[child_line_idx].push_back(cl);
+              }
+          }
+    }
+
+
+
+    template <int dim>
+    template <typename CellIterator>
+    inline bool
+    HangingNodes<dim>::setup_constraints(
+      const CellIterator &                  cell,
+      const std::vector<unsigned int> &     lexicographic_numbering,
+      std::vector<types::global_dof_index> &dof_indices,
+      ConstraintKinds &                     mask) const
+    {
+      mask = ConstraintKinds::unconstrained;
+
+      const unsigned int fe_degree = cell->get_fe().degree;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      const unsigned int dofs_per_face =
+        Utilities::fixed_power<dim - 1>(n_dofs_1d);
+      AssertDimension(dof_indices.size(),
+                      Utilities::fixed_power<dim>(n_dofs_1d));
+
+      std::vector<types::global_dof_index> neighbor_dofs(dofs_per_face);
+      std::vector<unsigned int>            lex_face_mapping;
+
+      for (const unsigned int face : GeometryInfo<dim>::face_indices())
+        {
+          if (cell->at_boundary(face) ||
+              cell->neighbor(face)->has_children() == true ||
+              cell->neighbor_is_coarser(face) == false)
+            continue;
+
+          // Neighbor is coarser than us, i.e., face is constrained
+          const auto neighbor = cell->neighbor(face);
+          if (neighbor->is_artificial())
+            return false;
+
+          const std::pair<unsigned int, unsigned int> neighbor_face_no =
+            cell->neighbor_of_coarser_neighbor(face);
+          const unsigned int neighbor_face = neighbor_face_no.first;
+          const unsigned int subface       = neighbor_face_no.second;
+
+          // the face-local coordinate systems of the two cells need to
+          // coincide for the subface index to directly translate into the
+          // position of the cell along the face
+          if (dim == 3 && (cell->face_orientation(face) == false ||
+                           cell->face_flip(face) || cell->face_rotation(face) ||
+                           neighbor->face_orientation(neighbor_face) == false ||
+                           neighbor->face_flip(neighbor_face) ||
+                           neighbor->face_rotation(neighbor_face)))
+            return false;
+
+          // Get indices to read
+          neighbor->face(neighbor_face)->get_dof_indices(neighbor_dofs);
+          if (lex_face_mapping.empty())
+            lex_face_mapping =
+              FETools::lexicographic_to_hierarchic_numbering<(dim > 1 ?
+                                                                dim - 1 :
+                                                                1)>(fe_degree);
+
+          // Offset if upper/right/back face
+          const unsigned int offset = (face % 2 == 1) ? fe_degree : 0;
+
+          if (dim == 2)
+            {
+              if (face < 2)
+                {
+                  mask |= ConstraintKinds::face_x;
+                  if (face == 0)
+                    mask |= ConstraintKinds::type_x;
+                  if (subface == 0)
+                    mask |= ConstraintKinds::type_y;
+                }
+              else
+                {
+                  mask |= ConstraintKinds::face_y;
+                  if (face == 2)
+                    mask |= ConstraintKinds::type_y;
+                  if (subface == 0)
+                    mask |= ConstraintKinds::type_x;
+                }
+
+              // Reorder neighbor_dofs and copy into the face of dof_indices
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                {
+                  // If X-line, i.e., if y = 0 or y = fe_degree, else Y-line,
+                  // i.e., if x = 0 or x = fe_degree
+                  const unsigned int idx = (face > 1) ?
+                                             n_dofs_1d * offset + i :
+                                             n_dofs_1d * i + offset;
+                  dof_indices[idx] = neighbor_dofs[lex_face_mapping[i]];
+                }
+            }
+          else if (dim == 3)
+            {
+              // YZ-plane
+              if (face < 2)
+                {
+                  mask |= ConstraintKinds::face_x;
+                  if (face == 0)
+                    mask |= ConstraintKinds::type_x;
+                  if (subface % 2 == 0)
+                    mask |= ConstraintKinds::type_y;
+                  if (subface / 2 == 0)
+                    mask |= ConstraintKinds::type_z;
+                }
+              // XZ-plane
+              else if (face < 4)
+                {
+                  mask |= ConstraintKinds::face_y;
+                  if (face == 2)
+                    mask |= ConstraintKinds::type_y;
+                  if (subface % 2 == 0)
+                    mask |= ConstraintKinds::type_z;
+                  if (subface / 2 == 0)
+                    mask |= ConstraintKinds::type_x;
+                }
+              // XY-plane
+              else
+                {
+                  mask |= ConstraintKinds::face_z;
+                  if (face == 4)
+                    mask |= ConstraintKinds::type_z;
+                  if (subface % 2 == 0)
+                    mask |= ConstraintKinds::type_x;
+                  if (subface / 2 == 0)
+                    mask |= ConstraintKinds::type_y;
+                }
+
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                  {
+                    unsigned int idx = 0;
+                    // If YZ-plane, i.e., if x = 0 or x = fe_degree
+                    if (face < 2)
+                      idx = n_dofs_1d * n_dofs_1d * i + n_dofs_1d * j + offset;
+                    // If XZ-plane, i.e., if y = 0 or y = fe_degree
+                    else if (face < 4)
+                      idx = n_dofs_1d * n_dofs_1d * j + n_dofs_1d * offset + i;
+                    // If XY-plane, i.e., if z = 0 or z = fe_degree
+                    else
+                      idx = n_dofs_1d * n_dofs_1d * offset + n_dofs_1d * i + j;
+
+                    dof_indices[idx] =
+                      neighbor_dofs[lex_face_mapping[n_dofs_1d * i + j]];
+                  }
+            }
+          else
+            return false;
+        }
+
+      // In 3D we can have a situation where only DoFs on an edge are
+      // constrained. Append these here.
+      return setup_edge_constraints(cell,
+                                    lexicographic_numbering,
+                                    dof_indices,
+                                    mask);
+    }
+
+
+
+    template <int dim>
+    template <typename CellIterator>
+    inline bool
+    HangingNodes<dim>::setup_edge_constraints(
+      const CellIterator &,
+      const std::vector<unsigned int> &,
+      std::vector<types::global_dof_index> &,
+      ConstraintKinds &) const
+    {
+      return true;
+    }
+
+
+
+    template <>
+    template <typename CellIterator>
+    inline bool
+    HangingNodes<3>::setup_edge_constraints(
+      const CellIterator &                  cell,
+      const std::vector<unsigned int> &     lexicographic_numbering,
+      std::vector<types::global_dof_index> &dof_indices,
+      ConstraintKinds &                     mask) const
+    {
+      const unsigned int fe_degree = cell->get_fe().degree;
+
+      // For each line on cell, which faces does it belong to, what is the
+      // edge mask, what is the types of the faces it belong to, and what is
+      // the type along the edge.
+      const ConstraintKinds line_to_edge[12][4] = {
+        {ConstraintKinds::face_x | ConstraintKinds::face_z,
+         ConstraintKinds::edge_zx,
+         ConstraintKinds::type_x | ConstraintKinds::type_z,
+         ConstraintKinds::type_y},
+        {ConstraintKinds::face_x | ConstraintKinds::face_z,
+         ConstraintKinds::edge_zx,
+         ConstraintKinds::type_z,
+         ConstraintKinds::type_y},
+        {ConstraintKinds::face_y | ConstraintKinds::face_z,
+         ConstraintKinds::edge_yz,
+         ConstraintKinds::type_y | ConstraintKinds::type_z,
+         ConstraintKinds::type_x},
+        {ConstraintKinds::face_y | ConstraintKinds::face_z,
+         ConstraintKinds::edge_yz,
+         ConstraintKinds::type_z,
+         ConstraintKinds::type_x},
+        {ConstraintKinds::face_x | ConstraintKinds::face_z,
+         ConstraintKinds::edge_zx,
+         ConstraintKinds::type_x,
+         ConstraintKinds::type_y},
+        {ConstraintKinds::face_x | ConstraintKinds::face_z,
+         ConstraintKinds::edge_zx,
+         ConstraintKinds::unconstrained,
+         ConstraintKinds::type_y},
+        {ConstraintKinds::face_y | ConstraintKinds::face_z,
+         ConstraintKinds::edge_yz,
+         ConstraintKinds::type_y,
+         ConstraintKinds::type_x},
+        {ConstraintKinds::face_y | ConstraintKinds::face_z,
+         ConstraintKinds::edge_yz,
+         ConstraintKinds::unconstrained,
+         ConstraintKinds::type_x},
+        {ConstraintKinds::face_x | ConstraintKinds::face_y,
+         ConstraintKinds::edge_xy,
+         ConstraintKinds::type_x | ConstraintKinds::type_y,
+         ConstraintKinds::type_z},
+        {ConstraintKinds::face_x | ConstraintKinds::face_y,
+         ConstraintKinds::edge_xy,
+         ConstraintKinds::type_y,
+         ConstraintKinds::type_z},
+        {ConstraintKinds::face_x | ConstraintKinds::face_y,
+         ConstraintKinds::edge_xy,
+         ConstraintKinds::type_x,
+         ConstraintKinds::type_z},
+        {ConstraintKinds::face_x | ConstraintKinds::face_y,
+         ConstraintKinds::edge_xy,
+         ConstraintKinds::unconstrained,
+         ConstraintKinds::type_z}};
+
+      std::vector<types::global_dof_index> neighbor_dofs;
+
+      for (unsigned int local_line = 0;
+           local_line < GeometryInfo<3>::lines_per_cell;
+           ++local_line)
+        {
+          // If we don't already have a constraint for as part of a face
+          if (is_set(mask, line_to_edge[local_line][0]))
+            continue;
+
+          // For each cell which share that edge
+          const unsigned int line = cell->line(local_line)->index();
+          for (const auto &edge_neighbor : line_to_cells[line])
+            {
+              // If one of them is coarser than us
+              const auto &neighbor_cell = edge_neighbor.first;
+              if (neighbor_cell->level() >= cell->level())
+                continue;
+
+              if (neighbor_cell->is_artificial())
+                return false;
+
+              const unsigned int local_line_neighbor = edge_neighbor.second;
+              mask |= line_to_edge[local_line][1] | line_to_edge[local_line][2];
+
+              bool flipped = false;
+              if (cell->line(local_line)->vertex_index(0) ==
+                  neighbor_cell->line(local_line_neighbor)->vertex_index(0))
+                {
+                  // Assuming line directions match axes directions, we have
+                  // an unflipped edge of first type
+                  mask |= line_to_edge[local_line][3];
+                }
+              else if (cell->line(local_line)->vertex_index(1) ==
+                       neighbor_cell->line(local_line_neighbor)
+                         ->vertex_index(1))
+                {
+                  // We have an unflipped edge of second type
+                }
+              else if (cell->line(local_line)->vertex_index(1) ==
+                       neighbor_cell->line(local_line_neighbor)
+                         ->vertex_index(0))
+                {
+                  // We have a flipped edge of second type
+                  flipped = true;
+                }
+              else if (cell->line(local_line)->vertex_index(0) ==
+                       neighbor_cell->line(local_line_neighbor)
+                         ->vertex_index(1))
+                {
+                  // We have a flipped edge of first type
+                  mask |= line_to_edge[local_line][3];
+                  flipped = true;
+                }
+              else
+                return false;
+
+              // Copy the unconstrained values
+              const typename DoFHandler<3>::cell_iterator neighbor_dof_cell(
+                &neighbor_cell->get_triangulation(),
+                neighbor_cell->level(),
+                neighbor_cell->index(),
+                &cell->get_dof_handler());
+              neighbor_dofs.resize(dof_indices.size());
+              neighbor_dof_cell->get_dof_indices(neighbor_dofs);
+
+              for (unsigned int i = 0; i <= fe_degree; ++i)
+                dof_indices[line_dof_idx(local_line, i, fe_degree)] =
+                  neighbor_dofs[lexicographic_numbering[line_dof_idx(
+                    local_line_neighbor,
+                    flipped ? fe_degree - i : i,
+                    fe_degree)]];
+
+              // Stop looping over edge neighbors
+              break;
+            }
+        }
+
+      return true;
+    }
+
+
+
+    template <int dim>
+    inline unsigned int
+    HangingNodes<dim>::line_dof_idx(const unsigned int local_line,
+                                    const unsigned int dof,
+                                    const unsigned int fe_degree)
+    {
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      unsigned int       x, y, z;
+
+      if (local_line < 8)
+        {
+          x = (local_line % 4 == 0) ? 0 :
+                                      (local_line % 4 == 1) ? fe_degree : dof;
+          y = (local_line % 4 == 2) ? 0 :
+                                      (local_line % 4 == 3) ? fe_degree : dof;
+          z = (local_line / 4) * fe_degree;
+        }
+      else
+        {
+          x = ((local_line - 8) % 2) * fe_degree;
+          y = ((local_line - 8) / 2) * fe_degree;
+          z = dof;
+        }
+
+      return n_dofs_1d * n_dofs_1d * z + n_dofs_1d * y + x;
+    }
+  } // namespace MatrixFreeFunctions
+} // namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
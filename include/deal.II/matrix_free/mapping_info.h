@@ -34,6 +34,7 @@
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/helper_functions.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
 
@@ -209,6 +210,9 @@ namespace internal
        * @p normal_vectors and the second derivatives. Note that affine cells
        * have shorter fields of length 1, where the others have lengths equal
        * to the number of quadrature points of the given cell.
+       *
+       * For cells of type @p general whose geometry is represented by
+       * @p mapping_support_points, the index points into that array instead.
        */
       AlignedVector<unsigned int> data_index_offsets;
 
@@ -291,6 +295,29 @@ namespace internal
        */
       AlignedVector<Point<spacedim, VectorizedArrayType>> quadrature_points;
 
+      /**
+       * A compressed representation of the geometry of cells of type @p
+       * general, used instead of @p JxW_values and @p jacobians if
+       * MatrixFree::AdditionalData::store_mapping_support_points is set.
+       * For each cell batch, the support points of the MappingQ are stored
+       * relative to the first support point of each cell (to reduce
+       * cancellation when computing derivatives in reduced precision),
+       * component by component, i.e., with <tt>dim * n_mapping_points</tt>
+       * entries per batch. FEEvaluation computes the Jacobians and JxW values
+       * from these points on the fly with @p mapping_shape_info. Empty if no
+       * such cells are present.
+       *
+       * Indexed by @p data_index_offsets.
+       */
+      AlignedVector<VectorizedArrayType> mapping_support_points;
+
+      /**
+       * The interpolation matrices from the support points of the mapping to
+       * the quadrature points of this quadrature formula, for use with @p
+       * mapping_support_points.
+       */
+      ShapeInfo<VectorizedArrayType> mapping_shape_info;
+
       /**
        * Clears all data fields except the descriptor vector.
        */
@@ -352,7 +379,8 @@ namespace internal
         const UpdateFlags update_flags_cells,
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags update_flags_faces_by_cells,
+        const bool        store_mapping_support_points = false);
 
       /**
        * Update the information in the given cells and faces that is the
@@ -418,6 +446,13 @@ namespace internal
        */
       UpdateFlags update_flags_faces_by_cells;
 
+      /**
+       * Whether the geometry of general cells is kept in terms of the support
+       * points of the mapping, see
+       * MatrixFree::AdditionalData::store_mapping_support_points.
+       */
+      bool store_mapping_support_points;
+
       /**
        * Stores whether a cell is Cartesian (cell type 0), has constant
        * transform data (Jacobians) (cell type 1), or is general (cell type
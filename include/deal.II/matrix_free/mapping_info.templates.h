@@ -175,6 +175,7 @@ namespace internal
         }
       quadrature_point_offsets.clear();
       quadrature_points.clear();
+      mapping_support_points.clear();
     }
 
 
@@ -198,7 +199,9 @@ namespace internal
              MemoryConsumption::memory_consumption(normals_times_jacobians[0]) +
              MemoryConsumption::memory_consumption(normals_times_jacobians[1]) +
              MemoryConsumption::memory_consumption(quadrature_point_offsets) +
-             MemoryConsumption::memory_consumption(quadrature_points);
+             MemoryConsumption::memory_consumption(quadrature_points) +
+             MemoryConsumption::memory_consumption(mapping_support_points) +
+             mapping_shape_info.memory_consumption();
     }
 
 
@@ -258,6 +261,18 @@ namespace internal
             MemoryConsumption::memory_consumption(quadrature_point_offsets) +
               MemoryConsumption::memory_consumption(quadrature_points));
         }
+
+      const std::size_t support_point_size =
+        Utilities::MPI::sum(mapping_support_points.size(),
+                            task_info.communicator);
+      if (support_point_size > 0)
+        {
+          out << "      Memory mapping support points: ";
+          task_info.print_memory_statistics(
+            out,
+            MemoryConsumption::memory_consumption(mapping_support_points) +
+              mapping_shape_info.memory_consumption());
+        }
     }
 
 
@@ -273,8 +288,9 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
-      mapping_collection = nullptr;
-      mapping            = nullptr;
+      mapping_collection           = nullptr;
+      mapping                      = nullptr;
+      store_mapping_support_points = false;
     }
 
 
@@ -338,7 +354,8 @@ namespace internal
       const UpdateFlags update_flags_cells,
       const UpdateFlags update_flags_boundary_faces,
       const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags update_flags_faces_by_cells,
+      const bool        store_mapping_support_points)
     {
       clear();
       this->mapping_collection = mapping;
@@ -353,6 +370,12 @@ namespace internal
       // the mapping that are independent of the FE
       this->update_flags_cells = compute_update_flags(update_flags_cells, quad);
 
+      // the compressed storage only holds what is needed for the Jacobians
+      // and JxW values, so second derivatives must be stored explicitly
+      this->store_mapping_support_points =
+        store_mapping_support_points &&
+        (this->update_flags_cells & update_jacobian_grads) == 0;
+
       this->update_flags_boundary_faces =
         ((update_flags_inner_faces | update_flags_boundary_faces) &
              update_quadrature_points ?
@@ -1371,6 +1394,7 @@ namespace internal
         const std::vector<GeometryType> &  cell_type,
         const std::vector<bool> &          process_cell,
         const UpdateFlags                  update_flags_cells,
+        const bool                         store_mapping_support_points,
         const AlignedVector<double> &      plain_quadrature_points,
         const ShapeInfo<VectorizedDouble> &shape_info,
         MappingInfoStorage<dim, dim, Number, VectorizedArrayType> &my_data)
@@ -1438,6 +1462,28 @@ namespace internal
                                                quadrature_points[q][d]);
                 }
 
+              // only store the support points relative to the first one,
+              // the Jacobians are computed from them within FEEvaluation
+              if (store_mapping_support_points && cell_type[cell] == general)
+                {
+                  if (process_cell[cell])
+                    for (unsigned int v = 0; v < n_lanes_d; ++v)
+                      {
+                        const double *cell_points =
+                          plain_quadrature_points.data() +
+                          (cell * n_lanes + vv + v) * n_mapping_points * dim;
+                        VectorizedArrayType *support_points =
+                          my_data.mapping_support_points.data() +
+                          my_data.data_index_offsets[cell];
+                        for (unsigned int d = 0; d < dim; ++d)
+                          for (unsigned int i = 0; i < n_mapping_points; ++i)
+                            support_points[d * n_mapping_points + i][vv + v] =
+                              cell_points[d * n_mapping_points + i] -
+                              cell_points[d * n_mapping_points];
+                      }
+                  continue;
+                }
+
               const unsigned int n_points =
                 cell_type[cell] <= affine ? 1 : n_q_points;
               if (process_cell[cell])
@@ -2817,25 +2863,37 @@ namespace internal
             cell_data[my_q];
 
           // step 4a: set the index offsets, find out how much to allocate,
-          // and allocate the memory
-          const unsigned int n_q_points = my_data.descriptor[0].n_q_points;
-          unsigned int       max_size   = 0;
+          // and allocate the memory. If requested, general cells only store
+          // the support points of the mapping in a separate array.
+          const unsigned int n_q_points      = my_data.descriptor[0].n_q_points;
+          unsigned int       max_size        = 0;
+          unsigned int       max_size_points = 0;
           my_data.data_index_offsets.resize(cell_type.size());
           for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
             {
+              const bool use_support_points =
+                store_mapping_support_points && cell_type[cell] == general;
+              unsigned int &size =
+                use_support_points ? max_size_points : max_size;
               if (process_cell[cell] == false)
                 my_data.data_index_offsets[cell] =
                   my_data.data_index_offsets[cell_data_index_vect[cell]];
               else
-                my_data.data_index_offsets[cell] = max_size;
-              max_size =
-                std::max(max_size,
-                         my_data.data_index_offsets[cell] +
-                           (cell_type[cell] <= affine ? 2 : n_q_points));
+                my_data.data_index_offsets[cell] = size;
+              size = std::max(size,
+                              my_data.data_index_offsets[cell] +
+                                (use_support_points ?
+                                   dim * n_mapping_points :
+                                   (cell_type[cell] <= affine ? 2 :
+                                                                n_q_points)));
             }
 
           my_data.JxW_values.resize_fast(max_size);
           my_data.jacobians[0].resize_fast(max_size);
+          my_data.mapping_support_points.resize_fast(max_size_points);
+          if (max_size_points > 0)
+            my_data.mapping_shape_info.reinit(my_data.descriptor[0].quadrature,
+                                              FE_DGQ<dim>(mapping_degree));
           if (update_flags_cells & update_jacobian_grads)
             my_data.jacobian_gradients[0].resize_fast(max_size);
 
@@ -2869,6 +2927,7 @@ namespace internal
                 cell_type,
                 process_cell,
                 update_flags_cells,
+                store_mapping_support_points,
                 plain_quadrature_points,
                 shape_infos[my_q],
                 my_data);
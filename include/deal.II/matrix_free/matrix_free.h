@@ -228,7 +228,9 @@ public:
       const bool         initialize_mapping  = true,
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
-      const bool         cell_vectorization_categories_strict = false)
+      const bool         cell_vectorization_categories_strict = false,
+      const bool         use_fast_hanging_node_algorithm      = false,
+      const bool         store_mapping_support_points         = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -244,6 +246,8 @@ public:
       , hold_all_faces_to_owned_cells(hold_all_faces_to_owned_cells)
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
+      , use_fast_hanging_node_algorithm(use_fast_hanging_node_algorithm)
+      , store_mapping_support_points(store_mapping_support_points)
       , communicator_sm(MPI_COMM_SELF)
     {}
 
@@ -270,6 +274,8 @@ public:
       , cell_vectorization_category(other.cell_vectorization_category)
       , cell_vectorization_categories_strict(
           other.cell_vectorization_categories_strict)
+      , use_fast_hanging_node_algorithm(other.use_fast_hanging_node_algorithm)
+      , store_mapping_support_points(other.store_mapping_support_points)
       , communicator_sm(other.communicator_sm)
     {}
 
@@ -300,7 +306,9 @@ public:
       cell_vectorization_category   = other.cell_vectorization_category;
       cell_vectorization_categories_strict =
         other.cell_vectorization_categories_strict;
-      communicator_sm = other.communicator_sm;
+      use_fast_hanging_node_algorithm = other.use_fast_hanging_node_algorithm;
+      store_mapping_support_points    = other.store_mapping_support_points;
+      communicator_sm                 = other.communicator_sm;
 
       return *this;
     }
@@ -534,6 +542,47 @@ public:
      */
     bool cell_vectorization_categories_strict;
 
+    /**
+     * If set to @p true, hanging-node constraints are not resolved
+     * into the index arrays of the DoFInfo class. Instead, each cell with
+     * hanging nodes stores the indices of the unknowns on the coarser
+     * neighbor together with a compact mask of type
+     * internal::MatrixFreeFunctions::ConstraintKinds, and FEEvaluation
+     * applies the constraints on the fly by an interpolation with sum
+     * factorization in FEEvaluation::read_dof_values() and
+     * FEEvaluation::distribute_local_to_global(). This reduces the memory
+     * transfer for the indices and avoids the indirect addressing into the
+     * constraint pool.
+     *
+     * The algorithm is currently used for scalar FE_Q elements on active
+     * cells in 2D and 3D (with standard face orientation) when no face
+     * integrals are requested. In all other cases, and if this flag is set
+     * to @p false (default), the hanging-node constraints are resolved by
+     * the general code path based on AffineConstraints.
+     */
+    bool use_fast_hanging_node_algorithm;
+
+    /**
+     * If set to @p true, cells on which the Jacobian of the transformation
+     * is not constant (cells of type internal::MatrixFreeFunctions::general)
+     * do not store the inverse Jacobians and JxW values on all quadrature
+     * points. Instead, only the support points of the mapping are kept for
+     * each cell batch, i.e., <tt>dim*(mapping_degree+1)^dim</tt> numbers per
+     * cell rather than <tt>(dim*dim+1)*n_q_points</tt>, and FEEvaluation
+     * recomputes the Jacobians in FEEvaluation::reinit() by an evaluation
+     * with sum factorization. This trades some arithmetic operations for a
+     * considerably smaller memory transfer on curved meshes, in particular
+     * for high polynomial degrees where the operator evaluation is limited
+     * by the memory bandwidth.
+     *
+     * The option is only used if the mapping is derived from
+     * MappingQGeneric, no hp-adaptivity is used, and no second derivatives
+     * of the mapping (as needed for Hessians of the shape functions) are
+     * requested; otherwise, the full data is stored. Face integrals and
+     * quadrature points are not affected. The default is @p false.
+     */
+    bool store_mapping_support_points;
+
     /**
      * Shared-memory MPI communicator. Default: MPI_COMM_SELF.
      */
@@ -34,6 +34,7 @@
 #include <deal.II/fe/fe_dgp.h>
 #include <deal.II/fe/fe_dgq.h>
 #include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_q_dg0.h>
 
 #include <deal.II/hp/q_collection.h>
@@ -779,7 +780,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.store_mapping_support_points);
 
       mapping_is_initialized = true;
     }
@@ -1026,6 +1028,7 @@ namespace internal
     const bool                       cell_vectorization_categories_strict,
     const bool                       do_face_integrals,
     const bool                       overlap_communication_computation,
+    const bool                       use_fast_hanging_node_algorithm,
     MatrixFreeFunctions::TaskInfo &  task_info,
     std::vector<std::pair<unsigned int, unsigned int>> &cell_level_index,
     std::vector<MatrixFreeFunctions::DoFInfo> &         dof_info,
@@ -1055,6 +1058,36 @@ namespace internal
 
     bool cell_categorization_enabled = !cell_vectorization_category.empty();
 
+    // the hanging-node constraints can be applied on the fly for scalar FE_Q
+    // elements on active cells, provided that no face integrals are
+    // requested (for which the index arrays of the cells are used as well)
+    std::vector<bool> use_fast_hanging_nodes(n_dof_handlers, false);
+    std::unique_ptr<MatrixFreeFunctions::HangingNodes<dim>> hanging_nodes;
+    if (use_fast_hanging_node_algorithm && dim > 1 &&
+        mg_level == numbers::invalid_unsigned_int && !do_face_integrals)
+      for (unsigned int no = 0; no < n_dof_handlers; ++no)
+        {
+          const dealii::hp::FECollection<dim> &fes =
+            dof_handler[no]->get_fe_collection();
+          use_fast_hanging_nodes[no] =
+            fes.size() == 1 && fes[0].n_components() == 1 &&
+            fes[0].n_base_elements() == 1 &&
+            dynamic_cast<const FE_Q<dim> *>(&fes[0].base_element(0)) !=
+              nullptr &&
+            fes[0].degree + 1 <=
+              MatrixFreeFunctions::max_n_dofs_1d_hanging_nodes &&
+            dof_handler[no]->get_triangulation().has_hanging_nodes();
+          if (use_fast_hanging_nodes[no] && hanging_nodes.get() == nullptr)
+            hanging_nodes =
+              std::make_unique<MatrixFreeFunctions::HangingNodes<dim>>(tria);
+          if (use_fast_hanging_nodes[no])
+            dof_info[no].hanging_node_constraint_masks.resize(
+              n_active_cells,
+              MatrixFreeFunctions::ConstraintKinds::unconstrained);
+        }
+    std::vector<types::global_dof_index> local_dof_indices_resolved;
+    std::vector<types::global_dof_index> local_dof_indices_lex;
+
     for (unsigned int no = 0; no < n_dof_handlers; ++no)
       {
         const dealii::hp::FECollection<dim> &fes =
@@ -1195,7 +1228,57 @@ namespace internal
                   dof_info[no].cell_active_fe_index[counter] = fe_index;
                 local_dof_indices.resize(dof_info[no].dofs_per_cell[fe_index]);
                 cell_it->get_dof_indices(local_dof_indices);
-                dof_info[no].read_dof_indices(local_dof_indices,
+
+                // try to express the hanging-node constraints of the cell by
+                // a mask and the indices of the coarser neighbors; in case
+                // this is not possible or the constraints are not part of
+                // the given AffineConstraints object, go through the general
+                // path
+                bool cell_has_hanging_nodes = false;
+                local_dof_indices_resolved = local_dof_indices;
+                if (use_fast_hanging_nodes[no])
+                  {
+                    const std::vector<unsigned int> &lexicographic_numbering =
+                      lexicographic[no][fe_index];
+                    local_dof_indices_lex.resize(local_dof_indices.size());
+                    for (unsigned int i = 0; i < local_dof_indices.size(); ++i)
+                      local_dof_indices_lex[i] =
+                        local_dof_indices[lexicographic_numbering[i]];
+
+                    auto mask =
+                      MatrixFreeFunctions::ConstraintKinds::unconstrained;
+                    cell_has_hanging_nodes =
+                      hanging_nodes->setup_constraints(cell_it,
+                                                       lexicographic_numbering,
+                                                       local_dof_indices_lex,
+                                                       mask) &&
+                      mask !=
+                        MatrixFreeFunctions::ConstraintKinds::unconstrained;
+                    for (unsigned int i = 0;
+                         cell_has_hanging_nodes && i < local_dof_indices.size();
+                         ++i)
+                      {
+                        const types::global_dof_index dof =
+                          local_dof_indices[lexicographic_numbering[i]];
+                        if (local_dof_indices_lex[i] != dof &&
+                            constraint[no]->is_constrained(dof) == false)
+                          cell_has_hanging_nodes = false;
+                      }
+                    if (cell_has_hanging_nodes)
+                      {
+                        for (unsigned int i = 0; i < local_dof_indices.size();
+                             ++i)
+                          local_dof_indices_resolved
+                            [lexicographic_numbering[i]] =
+                              local_dof_indices_lex[i];
+                        dof_info[no].hanging_node_constraint_masks[counter] =
+                          mask;
+                      }
+                  }
+
+                dof_info[no].read_dof_indices(local_dof_indices_resolved,
+                                              local_dof_indices,
+                                              cell_has_hanging_nodes,
                                               lexicographic[no][fe_index],
                                               *constraint[no],
                                               counter,
@@ -1223,6 +1306,8 @@ namespace internal
                 local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
                 cell_it->get_mg_dof_indices(local_dof_indices);
                 dof_info[no].read_dof_indices(local_dof_indices,
+                                              local_dof_indices,
+                                              false,
                                               lexicographic[no][0],
                                               *constraint[no],
                                               counter,
@@ -1249,6 +1334,16 @@ namespace internal
     task_info.n_active_cells = cell_level_index_end_local;
     task_info.n_ghost_cells  = n_active_cells - cell_level_index_end_local;
 
+    // no need to keep the masks around if no cell has hanging nodes
+    for (unsigned int no = 0; no < n_dof_handlers; ++no)
+      if (std::all_of(dof_info[no].hanging_node_constraint_masks.begin(),
+                      dof_info[no].hanging_node_constraint_masks.end(),
+                      [](const MatrixFreeFunctions::ConstraintKinds mask) {
+                        return mask == MatrixFreeFunctions::ConstraintKinds::
+                                         unconstrained;
+                      }))
+        dof_info[no].hanging_node_constraint_masks.clear();
+
     // Finalize the creation of the ghost indices
     {
       std::vector<unsigned int> cells_with_ghosts(subdomain_boundary_cells);
@@ -1673,6 +1768,7 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
     additional_data.cell_vectorization_categories_strict,
     do_face_integrals,
     additional_data.overlap_communication_computation,
+    additional_data.use_fast_hanging_node_algorithm,
     task_info,
     cell_level_index,
     dof_info,
@@ -32,6 +32,8 @@
 
 #include <deal.II/multigrid/mg_constrained_dofs.h>
 
+#include <functional>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -313,6 +315,31 @@ namespace MatrixFreeOperators
     void
     vmult(VectorType &dst, const VectorType &src) const;
 
+    /**
+     * Matrix-vector multiplication with additional operations on the vector
+     * entries before and after the product, as used by SolverCG and
+     * PreconditionChebyshev to fuse their vector updates into the product.
+     * The two functions are called on ranges of the locally owned entries
+     * (in the MPI-local numbering) and forwarded to the arguments
+     * @p operation_before_loop and @p operation_after_loop of
+     * MatrixFree::cell_loop() if the derived class implements
+     * apply_add_with_loop_operations(); see there for when they are called.
+     * As in the cell loop, @p dst is not zeroed by this function, which is
+     * left to @p operation_before_loop.
+     *
+     * This function is only implemented for vectors that are not block
+     * vectors. For operators on multigrid levels with refinement-edge
+     * constraints, the two operations are called on all locally owned
+     * entries before and after an ordinary product.
+     */
+    void
+    vmult(VectorType &      dst,
+          const VectorType &src,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_before_loop,
+          const std::function<void(const unsigned int, const unsigned int)>
+            &operation_after_loop) const;
+
     /**
      * Transpose matrix-vector multiplication.
      */
@@ -418,6 +445,25 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const = 0;
 
+    /**
+     * Apply operator to @p src and add result in @p dst, calling
+     * @p operation_before_loop and @p operation_after_loop on ranges of the
+     * locally owned entries of @p dst as MatrixFree::cell_loop() does.
+     *
+     * Default implementation is to call @p operation_before_loop on all
+     * locally owned entries, then apply_add(), and then
+     * @p operation_after_loop on all locally owned entries. Derived classes
+     * should forward the two operations to their cell loop instead.
+     */
+    virtual void
+    apply_add_with_loop_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const;
+
     /**
      * Apply transpose operator to @p src and add result in @p dst.
      *
@@ -772,6 +818,18 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), forwarding the two operations to the cell loop.
+     */
+    virtual void
+    apply_add_with_loop_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * For this operator, there is just a cell contribution.
      */
@@ -910,6 +968,18 @@ namespace MatrixFreeOperators
     virtual void
     apply_add(VectorType &dst, const VectorType &src) const override;
 
+    /**
+     * Same as apply_add(), forwarding the two operations to the cell loop.
+     */
+    virtual void
+    apply_add_with_loop_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const override;
+
     /**
      * Applies the Laplace operator on a cell.
      */
@@ -1334,6 +1404,60 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::vmult(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    AssertDimension(dst.size(), src.size());
+    AssertDimension(BlockHelper::n_blocks(dst), BlockHelper::n_blocks(src));
+    AssertDimension(BlockHelper::n_blocks(dst), selected_rows.size());
+    Assert(BlockHelper::n_blocks(dst) == 1, ExcNotImplemented());
+
+    // the values at refinement-edge constrained entries are set before and
+    // after the product by mult_add(), which does not fit into the ranges
+    // the operations work on
+    if (edge_constrained_indices[0].size() > 0)
+      {
+        const unsigned int n_owned =
+          BlockHelper::subblock(dst, 0).locally_owned_size();
+        operation_before_loop(0, n_owned);
+        vmult_add(dst, src);
+        operation_after_loop(0, n_owned);
+        return;
+      }
+
+    adjust_ghost_range_if_necessary(src, false);
+    adjust_ghost_range_if_necessary(dst, true);
+
+    // the constrained entries are not touched by the cell loop. as in
+    // postprocess_constraints(), the operator acts as identity on them,
+    // which we apply to each range once the product is complete there
+    const std::vector<unsigned int> &constrained_dofs =
+      data->get_constrained_dofs(selected_rows[0]);
+    apply_add_with_loop_operations(
+      dst,
+      src,
+      operation_before_loop,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (auto dof = std::lower_bound(constrained_dofs.begin(),
+                                         constrained_dofs.end(),
+                                         begin);
+             dof != constrained_dofs.end() && *dof < end;
+             ++dof)
+          BlockHelper::subblock(dst, 0).local_element(*dof) +=
+            BlockHelper::subblock(src, 0).local_element(*dof);
+        operation_after_loop(begin, end);
+      });
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::vmult_add(
@@ -1638,6 +1762,25 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim, typename VectorType, typename VectorizedArrayType>
+  void
+  Base<dim, VectorType, VectorizedArrayType>::apply_add_with_loop_operations(
+    VectorType &      dst,
+    const VectorType &src,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_before_loop,
+    const std::function<void(const unsigned int, const unsigned int)>
+      &operation_after_loop) const
+  {
+    const unsigned int n_owned =
+      BlockHelper::subblock(dst, 0).locally_owned_size();
+    operation_before_loop(0, n_owned);
+    apply_add(dst, src);
+    operation_after_loop(0, n_owned);
+  }
+
+
+
   template <int dim, typename VectorType, typename VectorizedArrayType>
   void
   Base<dim, VectorType, VectorizedArrayType>::Tapply_add(
@@ -1831,6 +1974,39 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  MassOperator<dim,
+               fe_degree,
+               n_q_points_1d,
+               n_components,
+               VectorType,
+               VectorizedArrayType>::
+    apply_add_with_loop_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &MassOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_q_points_1d,
@@ -2025,6 +2201,39 @@ namespace MatrixFreeOperators
       &LaplaceOperator::local_apply_cell, this, dst, src);
   }
 
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename VectorType,
+            typename VectorizedArrayType>
+  void
+  LaplaceOperator<dim,
+                  fe_degree,
+                  n_q_points_1d,
+                  n_components,
+                  VectorType,
+                  VectorizedArrayType>::
+    apply_add_with_loop_operations(
+      VectorType &      dst,
+      const VectorType &src,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_before_loop,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation_after_loop) const
+  {
+    Base<dim, VectorType, VectorizedArrayType>::data->cell_loop(
+      &LaplaceOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      operation_before_loop,
+      operation_after_loop,
+      this->selected_rows[0]);
+  }
+
   namespace Implementation
   {
     template <typename VectorizedArrayType>
@@ -261,6 +261,18 @@ namespace internal
        */
       std::array<AlignedVector<Number>, 2> hessians_within_subface;
 
+      /**
+       * Stores the values of the one-dimensional nodal basis functions in
+       * the support points of the first of the two children of the unit
+       * interval, i.e., the interpolation from a cell to the subinterval
+       * $(0, 0.5)$. Entry <tt>i * n_dofs_1d + j</tt> is the value of basis
+       * function <tt>j</tt> in the support point <tt>i</tt> of the child.
+       * The interpolation to the second child $(0.5, 1)$ follows by
+       * symmetry. This matrix is used to resolve hanging-node constraints on
+       * the fly and is only set up for elements with support points.
+       */
+      AlignedVector<Number> subface_interpolation_matrix;
+
       /**
        * We store a copy of the one-dimensional quadrature formula
        * used for initialization.
@@ -469,6 +469,8 @@ namespace internal
         univariate_shape_data.gradients_within_subface;
       auto &hessians_within_subface =
         univariate_shape_data.hessians_within_subface;
+      auto &subface_interpolation_matrix =
+        univariate_shape_data.subface_interpolation_matrix;
       auto &nodal_at_cell_boundaries =
         univariate_shape_data.nodal_at_cell_boundaries;
 
@@ -580,6 +582,23 @@ namespace internal
             fe.shape_grad_grad(my_i, q_point)[0][0];
         }
 
+      // interpolation from the cell to the first child in 1D, evaluating the
+      // basis functions in the support points scaled by one half
+      if (fe.has_support_points())
+        {
+          subface_interpolation_matrix.resize_fast(n_dofs_1d * n_dofs_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int j = 0; j < n_dofs_1d; ++j)
+              {
+                Point<dim> q_point = unit_point;
+                q_point[0] =
+                  0.5 *
+                  fe.get_unit_support_points()[scalar_lexicographic[i]][0];
+                subface_interpolation_matrix[i * n_dofs_1d + j] =
+                  fe.shape_value(scalar_lexicographic[j], q_point);
+              }
+        }
+
       if (n_q_points_1d < 200)
         {
           quadrature_data_on_face[0].resize(quad.size() * 3);
@@ -1067,6 +1086,8 @@ namespace internal
         MemoryConsumption::memory_consumption(shape_gradients_collocation_eo);
       memory +=
         MemoryConsumption::memory_consumption(shape_hessians_collocation_eo);
+      memory +=
+        MemoryConsumption::memory_consumption(subface_interpolation_matrix);
       for (unsigned int i = 0; i < 2; ++i)
         {
           memory +=
@@ -294,6 +294,48 @@ namespace MatrixFreeTools
                 .first;
         }
 
+        // STEP 1b: on cells with hanging-node constraints resolved on the
+        //   fly, the indices point to the degrees of freedom of the coarser
+        //   neighbors and the local values are obtained from the values at
+        //   these indices by an interpolation matrix, which we compute
+        //   column by column with the kernel used in FEEvaluation
+        using ConstraintKinds =
+          ::dealii::internal::MatrixFreeFunctions::ConstraintKinds;
+        std::array<ConstraintKinds, n_lanes> constraint_mask;
+        bool                                 cell_has_hanging_nodes = false;
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            constraint_mask[v] =
+              (v < n_lanes_filled &&
+               !dof_info.hanging_node_constraint_masks.empty()) ?
+                dof_info.hanging_node_constraint_masks[cell * n_lanes + v] :
+                ConstraintKinds::unconstrained;
+            if (constraint_mask[v] != ConstraintKinds::unconstrained)
+              cell_has_hanging_nodes = true;
+          }
+
+        AlignedVector<VectorizedArrayType> hanging_node_matrix;
+        if (cell_has_hanging_nodes)
+          {
+            hanging_node_matrix.resize_fast(dofs_per_component *
+                                            dofs_per_component);
+            AlignedVector<VectorizedArrayType> column(dofs_per_component);
+            for (unsigned int j = 0; j < dofs_per_component; ++j)
+              {
+                for (unsigned int i = 0; i < dofs_per_component; ++i)
+                  column[i] = static_cast<Number>(i == j);
+                ::dealii::internal::
+                  FEEvaluationImplHangingNodes<dim, VectorizedArrayType>::run(
+                    1,
+                    phi.get_shape_info(),
+                    false,
+                    constraint_mask,
+                    column.data());
+                for (unsigned int i = 0; i < dofs_per_component; ++i)
+                  hanging_node_matrix[i * dofs_per_component + j] = column[i];
+              }
+          }
+
         // STEP 2: setup CSR storage of transposed locally-relevant
         //   constraint matrix
         c_pools = std::array<internal::LocalCSR<Number>, n_lanes>();
@@ -421,6 +463,45 @@ namespace MatrixFreeTools
                   }
               }
 
+            // STEP 2a': compose the constraint matrix with the
+            //   interpolation matrix of the hanging nodes
+            if (constraint_mask[v] != ConstraintKinds::unconstrained)
+              {
+                std::vector<std::tuple<unsigned int, unsigned int, Number>>
+                  locally_relevant_constrains_hanging;
+                for (const auto &c : locally_relevant_constrains)
+                  for (unsigned int i = 0; i < dofs_per_component; ++i)
+                    {
+                      const Number weight =
+                        hanging_node_matrix[i * dofs_per_component +
+                                            std::get<0>(c)][v];
+                      if (weight != Number(0.))
+                        locally_relevant_constrains_hanging.emplace_back(
+                          i, std::get<1>(c), weight * std::get<2>(c));
+                    }
+
+                // sum up the weights of entries with the same indices
+                std::sort(locally_relevant_constrains_hanging.begin(),
+                          locally_relevant_constrains_hanging.end(),
+                          [](const auto &a, const auto &b) {
+                            if (std::get<1>(a) < std::get<1>(b))
+                              return true;
+                            return (std::get<1>(a) == std::get<1>(b)) &&
+                                   (std::get<0>(a) < std::get<0>(b));
+                          });
+                locally_relevant_constrains.clear();
+                for (const auto &c : locally_relevant_constrains_hanging)
+                  if (!locally_relevant_constrains.empty() &&
+                      std::get<0>(locally_relevant_constrains.back()) ==
+                        std::get<0>(c) &&
+                      std::get<1>(locally_relevant_constrains.back()) ==
+                        std::get<1>(c))
+                    std::get<2>(locally_relevant_constrains.back()) +=
+                      std::get<2>(c);
+                  else
+                    locally_relevant_constrains.push_back(c);
+              }
+
             // STEP 2b: transpose COO
 
             // presort vector for transposed access
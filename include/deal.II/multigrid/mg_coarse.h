@@ -163,6 +163,63 @@ private:
 
 
 
+/**
+ * Coarse grid multigrid operator that applies a preconditioner, i.e., calls
+ * its vmult() function.
+ *
+ * This is the natural wrapper for preconditioners that represent the exact
+ * inverse of the coarse matrix, like SparseDirectSupernodal or
+ * SparseDirectUMFPACK, which do not need an iterative solver around them.
+ */
+template <class VectorType, class PreconditionerType>
+class MGCoarseGridApplyPreconditioner : public MGCoarseGridBase<VectorType>
+{
+public:
+  /**
+   * Default constructor.
+   */
+  MGCoarseGridApplyPreconditioner();
+
+  /**
+   * Constructor. Only a reference to the preconditioner is stored, so its
+   * lifetime needs to exceed the usage in this class.
+   */
+  MGCoarseGridApplyPreconditioner(const PreconditionerType &preconditioner);
+
+  /**
+   * Initialize with a new preconditioner, see the corresponding constructor
+   * for more details.
+   */
+  void
+  initialize(const PreconditionerType &preconditioner);
+
+  /**
+   * Clear the pointer.
+   */
+  void
+  clear();
+
+  /**
+   * Implementation of the abstract function. Calls the vmult() function of
+   * the preconditioner.
+   */
+  virtual void
+  operator()(const unsigned int level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+private:
+  /**
+   * Reference to the preconditioner.
+   */
+  SmartPointer<
+    const PreconditionerType,
+    MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>>
+    preconditioner;
+};
+
+
+
 /**
  * Coarse grid solver by QR factorization implemented in the class
  * Householder.
@@ -377,6 +434,56 @@ operator()(const unsigned int /*level*/,
 
 
 
+/* ---------------- Functions for MGCoarseGridApplyPreconditioner --------- */
+
+template <class VectorType, class PreconditionerType>
+MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>::
+  MGCoarseGridApplyPreconditioner()
+  : preconditioner(0, typeid(*this).name())
+{}
+
+
+
+template <class VectorType, class PreconditionerType>
+MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>::
+  MGCoarseGridApplyPreconditioner(const PreconditionerType &preconditioner)
+  : preconditioner(&preconditioner, typeid(*this).name())
+{}
+
+
+
+template <class VectorType, class PreconditionerType>
+void
+MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>::initialize(
+  const PreconditionerType &preconditioner_)
+{
+  preconditioner = &preconditioner_;
+}
+
+
+
+template <class VectorType, class PreconditionerType>
+void
+MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>::clear()
+{
+  preconditioner = 0;
+}
+
+
+
+template <class VectorType, class PreconditionerType>
+void
+MGCoarseGridApplyPreconditioner<VectorType, PreconditionerType>::
+operator()(const unsigned int /*level*/,
+           VectorType &      dst,
+           const VectorType &src) const
+{
+  Assert(preconditioner != nullptr, ExcNotInitialized());
+  preconditioner->vmult(dst, src);
+}
+
+
+
 /* ------------------ Functions for MGCoarseGridHouseholder ------------ */
 
 template <typename number, class VectorType>
@@ -24,6 +24,8 @@
 
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#include <boost/signals2.hpp>
+
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -227,6 +229,11 @@ public:
    */
   DataOut();
 
+  /**
+   * Destructor.
+   */
+  virtual ~DataOut() override;
+
   /**
    * This is the central function of this class since it builds the list of
    * patches to be written by the low-level functions of the base class. A
@@ -284,6 +291,12 @@ public:
    *   is worth noting, however, that this requires a
    *   sufficiently new version of one of the VTK-based visualization
    *   programs.
+   *
+   * @note The patches built by a previous call to this function are not
+   *   freed, but their data tables are re-used for the new patches. If this
+   *   function is called repeatedly for the same mesh, as is typical for
+   *   output in every time step, it therefore does not allocate memory for
+   *   the patches after the first call.
    */
   virtual void
   build_patches(const unsigned int n_subdivisions = 0);
@@ -429,6 +442,43 @@ public:
   const std::pair<FirstCellFunctionType, NextCellFunctionType>
   get_cell_selection() const;
 
+  /**
+   * Enable or disable caching of the geometry of the patches. If enabled,
+   * build_patches() stores the vertices of all patches and, for cells that
+   * are output as curved, the locations of the points within the patches.
+   * Subsequent calls to build_patches() with the same number of
+   * subdivisions and the same CurvedCellRegion then take the geometry from
+   * this cache and only evaluate the data vectors. This is useful if output
+   * is generated repeatedly on the same mesh, for example in every time step
+   * of a time dependent problem.
+   *
+   * If the geometry is taken from the cache, no postprocessor needs more than
+   * the values of the solution, and the values of all finite elements in use
+   * do not depend on the mapping (as is the case for FE_Q, FE_DGQ, and
+   * similar elements), the mapping passed to build_patches() is not evaluated
+   * at all. For higher order mappings such as MappingQGeneric, this is where
+   * most of the time of build_patches() is spent.
+   *
+   * The cache is invalidated automatically whenever the triangulation
+   * changes, i.e., upon refinement and coarsening or when its vertices are
+   * moved, and when a different cell selection is set. It can not detect,
+   * however, that a different mapping is passed to build_patches(), or that
+   * a mapping such as MappingQEulerian now describes a different geometry.
+   * In that case, call clear_geometry_cache() before calling build_patches().
+   *
+   * Caching is disabled by default.
+   */
+  void
+  set_geometry_caching(const bool cache_geometry);
+
+  /**
+   * Discard the geometry stored by build_patches() if caching is enabled,
+   * so that the next call to build_patches() computes it anew. See
+   * set_geometry_caching() for more information.
+   */
+  void
+  clear_geometry_cache();
+
   /**
    * Return the first cell which we want output for. The default
    * implementation returns the first active cell, but you might want to
@@ -476,6 +526,41 @@ private:
                               const cell_iterator &)>
     next_cell_function;
 
+  /**
+   * Whether build_patches() stores the geometry of the patches it builds in
+   * #geometry_cache. See set_geometry_caching().
+   */
+  bool cache_geometry;
+
+  /**
+   * Whether #geometry_cache holds the geometry of the patches built by the
+   * last call to build_patches() and can be used by the next one.
+   */
+  bool geometry_cache_valid;
+
+  /**
+   * The geometry of the patches built by the last call to build_patches()
+   * if caching is enabled. Only the vertices and the
+   * DataOutBase::Patch::points_are_available flag of these patches are
+   * set, and, if the latter is true, their data tables contain the
+   * coordinates of the points within the patch.
+   */
+  std::vector<DataOutBase::Patch<dim, spacedim>> geometry_cache;
+
+  /**
+   * The triangulation, the number of subdivisions, and the region of
+   * curved cells for which #geometry_cache was filled.
+   */
+  const Triangulation<dim, spacedim> *geometry_cache_triangulation;
+  unsigned int                        geometry_cache_n_subdivisions;
+  CurvedCellRegion                    geometry_cache_curved_cell_region;
+
+  /**
+   * The connection to the signal of the triangulation that invalidates
+   * #geometry_cache whenever the triangulation changes.
+   */
+  boost::signals2::connection tria_listener;
+
   /**
    * Return the first cell produced by the first_cell()/next_cell() function
    * pair that is locally owned. If this object operates on a non-distributed
@@ -44,8 +44,10 @@
 #include <cmath>
 #include <cstring>
 #include <ctime>
+#include <deque>
 #include <fstream>
 #include <iomanip>
+#include <list>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -103,52 +105,700 @@ namespace
           return Z_NO_COMPRESSION;
       }
   }
+#endif
+
+
 
   /**
-   * Do a zlib compression followed by a base64 encoding of the given data. The
-   * result is then written to the given stream.
+   * The size, in bytes, of the blocks into which VtuDataArrayWriter splits
+   * data arrays. The VTK format allows compressed data arrays to consist of
+   * several independently compressed blocks, which allows us to compress the
+   * blocks in parallel. Arrays smaller than this are written as a single
+   * block.
+   */
+  constexpr std::size_t vtu_compression_block_size = std::size_t(1) << 20;
+
+
+
+#ifdef DEAL_II_WITH_ZLIB
+  /**
+   * Compress the given block of data with zlib.
+   */
+  std::vector<unsigned char>
+  compress_block(const unsigned char *        data,
+                 const std::size_t            n_bytes,
+                 const DataOutBase::VtkFlags &flags)
+  {
+    // allocate a buffer for compressing data and do so
+    auto compressed_data_length = compressBound(n_bytes);
+    std::vector<unsigned char> compressed_data(compressed_data_length);
+
+    int err = compress2(&compressed_data[0],
+                        &compressed_data_length,
+                        reinterpret_cast<const Bytef *>(data),
+                        n_bytes,
+                        get_zlib_compression_level(flags.compression_level));
+    (void)err;
+    Assert(err == Z_OK, ExcInternalError());
+
+    // Discard the unnecessary bytes
+    compressed_data.resize(compressed_data_length);
+
+    return compressed_data;
+  }
+#endif
+
+
+
+  /**
+   * Return the VTK compression header of a data array that has been split
+   * into blocks of size vtu_compression_block_size (except for the last one)
+   * and compressed block by block. It consists of the number of blocks, the
+   * size of a (full) block, the size of the last block, and the list of
+   * compressed sizes of all blocks.
+   */
+  std::vector<uint32_t>
+  vtu_compression_header(
+    const std::size_t                             uncompressed_size,
+    const std::deque<std::vector<unsigned char>> &compressed_blocks)
+  {
+    const std::size_t n_blocks        = compressed_blocks.size();
+    const std::size_t last_block_size = (n_blocks == 0) ?
+                                          0 :
+                                          uncompressed_size -
+                                            (n_blocks - 1) *
+                                              vtu_compression_block_size;
+
+    std::vector<uint32_t> compression_header(3 + n_blocks);
+    compression_header[0] = static_cast<uint32_t>(n_blocks);
+    compression_header[1] = static_cast<uint32_t>(
+      n_blocks == 1 ? uncompressed_size : vtu_compression_block_size);
+    compression_header[2] = static_cast<uint32_t>(last_block_size);
+    for (std::size_t block = 0; block < n_blocks; ++block)
+      compression_header[3 + block] =
+        static_cast<uint32_t>(compressed_blocks[block].size());
+
+    return compression_header;
+  }
+
+
+
+  /**
+   * Write the header and the blocks of data of one data array of a VTU file
+   * to the given stream. If @p encode_base64 is true, header and data are
+   * base64 encoded separately, as VTK expects for data written inline into
+   * the XML file. Otherwise, they are written as raw bytes, as needed for the
+   * appended data section.
+   */
+  void
+  write_vtu_data_array(const std::vector<uint32_t> &                 header,
+                       const std::deque<std::vector<unsigned char>> &blocks,
+                       const bool    encode_base64,
+                       std::ostream &output_stream)
+  {
+    const auto header_start =
+      reinterpret_cast<const unsigned char *>(header.data());
+    const std::size_t header_size = header.size() * sizeof(uint32_t);
+
+    if (!encode_base64)
+      {
+        output_stream.write(reinterpret_cast<const char *>(header_start),
+                            header_size);
+        for (const auto &block : blocks)
+          output_stream.write(reinterpret_cast<const char *>(block.data()),
+                              block.size());
+        return;
+      }
+
+    output_stream << Utilities::encode_base64(
+      {header_start, header_start + header_size});
+
+    // the blocks are encoded as one base64 string. rather than copying all
+    // of them into one buffer, encode them in pieces whose lengths are
+    // multiples of three bytes: for these, the encoding of the concatenation
+    // is the concatenation of the encodings
+    std::vector<unsigned char> piece;
+    for (const auto &block : blocks)
+      {
+        piece.insert(piece.end(), block.begin(), block.end());
+        const std::size_t n_bytes_to_encode = piece.size() - piece.size() % 3;
+        if (n_bytes_to_encode > 0)
+          {
+            std::vector<unsigned char> remainder(piece.begin() +
+                                                   n_bytes_to_encode,
+                                                 piece.end());
+            piece.resize(n_bytes_to_encode);
+            output_stream << Utilities::encode_base64(piece);
+            piece.swap(remainder);
+          }
+      }
+    // the rest, including the padding
+    output_stream << Utilities::encode_base64(piece);
+  }
+
+
+
+  /**
+   * Return whether the data arrays of a VTU file written with the given
+   * flags are zlib compressed.
+   */
+  bool
+  vtu_data_is_compressed(const DataOutBase::VtkFlags &flags)
+  {
+#ifdef DEAL_II_WITH_ZLIB
+    return !(flags.write_appended_raw_data &&
+             flags.compression_level == DataOutBase::VtkFlags::no_compression);
+#else
+    (void)flags;
+    return false;
+#endif
+  }
+
+
+
+  /**
+   * Return the attributes of a <code>DataArray</code> element of a VTU file
+   * that describe how its data is stored, for a data array that is about to
+   * be written by a VtuDataArrayWriter object constructed with the given
+   * @p appended_data argument. For appended data, this includes the offset
+   * of the array within the appended data section.
+   */
+  std::string
+  vtu_data_array_format(std::ostream *appended_data)
+  {
+    if (appended_data != nullptr)
+      {
+        const std::streamoff offset = appended_data->tellp();
+        return "format=\"appended\" offset=\"" + std::to_string(offset) +
+               "\"";
+      }
+
+#ifdef DEAL_II_WITH_ZLIB
+    return "format=\"binary\"";
+#else
+    return "format=\"ascii\"";
+#endif
+  }
+
+
+
+  /**
+   * A stream buffer that counts the characters written to it and passes
+   * them on to another stream buffer, or discards them if none is given.
+   * The current position reported to an output stream using this buffer,
+   * i.e., the result of <code>tellp()</code>, is the number of characters
+   * written so far. write_vtu() uses this to determine the offsets of the
+   * data arrays within the <code>AppendedData</code> section of a file.
+   */
+  class CountingStreamBuffer : public std::streambuf
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    explicit CountingStreamBuffer(std::streambuf *destination = nullptr)
+      : destination(destination)
+      , n_characters(0)
+    {}
+
+  protected:
+    virtual std::streamsize
+    xsputn(const char *s, const std::streamsize n) override
+    {
+      const std::streamsize n_written =
+        (destination != nullptr ? destination->sputn(s, n) : n);
+      n_characters += n_written;
+      return n_written;
+    }
+
+    virtual int_type
+    overflow(const int_type c) override
+    {
+      if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+      const char character = traits_type::to_char_type(c);
+      return (xsputn(&character, 1) == 1 ? c : traits_type::eof());
+    }
+
+    virtual pos_type
+    seekoff(const off_type               offset,
+            const std::ios_base::seekdir direction,
+            const std::ios_base::openmode) override
+    {
+      if (offset == 0 && direction == std::ios_base::cur)
+        return pos_type(n_characters);
+      return pos_type(off_type(-1));
+    }
+
+  private:
+    std::streambuf *const destination;
+    std::streamsize       n_characters;
+  };
+
+
+
+  /**
+   * A class that writes the values of one data array of a VTU file to a
+   * stream, given to it one value at a time. This way, no array needs to be
+   * stored as a whole in uncompressed form, and the memory used for writing
+   * a VTU file does not grow with the size of the arrays.
+   *
+   * If libz was found during configuration, the values are collected in
+   * blocks of vtu_compression_block_size bytes, and each block is compressed
+   * on a separate task as soon as it is full. Only the compressed blocks are
+   * kept until finish() is called, at which point they are written to the
+   * stream along with the VTK compression header. Otherwise, the values are
+   * written to the stream as text right away.
+   *
+   * If an output stream for appended data is given to the constructor, the
+   * data is instead written to that stream as raw bytes, compressed or not
+   * depending on vtu_data_is_compressed(). That stream collects the
+   * <code>AppendedData</code> section of the file.
    */
+  template <typename T>
+  class VtuDataArrayWriter
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    VtuDataArrayWriter(std::ostream &               stream,
+                       const DataOutBase::VtkFlags &flags,
+                       std::ostream *               appended_data = nullptr);
+
+    /**
+     * Destructor. Waits for pending compression tasks, which refer to
+     * member variables of this object.
+     */
+    ~VtuDataArrayWriter();
+
+    /**
+     * Add the next value of the data array.
+     */
+    void
+    push_back(const T value);
+
+    /**
+     * Write everything that has not yet been written to the stream. After
+     * this call, the object can be used to write another data array.
+     */
+    void
+    finish();
+
+  private:
+    /**
+     * Move the values in @p current_block into a new element of @p blocks,
+     * compressing them on a separate task if so requested.
+     */
+    void
+    finish_current_block();
+
+    std::ostream &              stream;
+    const DataOutBase::VtkFlags flags;
+
+    /**
+     * The stream collecting the appended data section, or a null pointer if
+     * the data is written inline.
+     */
+    std::ostream *const appended_data;
+
+    /**
+     * Whether the data is compressed.
+     */
+    const bool compress;
+
+    /**
+     * Whether the data is written in binary form, rather than as text.
+     */
+    const bool binary;
+
+    /**
+     * The values of the block that is currently being filled.
+     */
+    std::vector<T> current_block;
+
+    /**
+     * The number of bytes of all values added so far.
+     */
+    std::size_t uncompressed_size;
+
+    /**
+     * The finished, possibly compressed, blocks. We use a std::deque since
+     * references to its elements, which the compression tasks write into,
+     * remain valid when more elements are added.
+     */
+    std::deque<std::vector<unsigned char>> blocks;
+
+    /**
+     * The tasks compressing blocks that have not been waited for yet.
+     */
+    std::list<Threads::Task<void>> compression_tasks;
+  };
+
+
+
+  template <typename T>
+  VtuDataArrayWriter<T>::VtuDataArrayWriter(
+    std::ostream &               stream,
+    const DataOutBase::VtkFlags &flags,
+    std::ostream *               appended_data)
+    : stream(stream)
+    , flags(flags)
+    , appended_data(appended_data)
+    , compress(vtu_data_is_compressed(flags))
+#ifdef DEAL_II_WITH_ZLIB
+    , binary(true)
+#else
+    , binary(appended_data != nullptr)
+#endif
+    , uncompressed_size(0)
+  {
+    static_assert(vtu_compression_block_size % sizeof(T) == 0,
+                  "The blocks must consist of a whole number of values.");
+    if (binary)
+      current_block.reserve(vtu_compression_block_size / sizeof(T));
+  }
+
+
+
+  template <typename T>
+  VtuDataArrayWriter<T>::~VtuDataArrayWriter()
+  {
+    for (const auto &task : compression_tasks)
+      task.join();
+  }
+
+
+
+  template <typename T>
+  void
+  VtuDataArrayWriter<T>::push_back(const T value)
+  {
+    if (binary)
+      {
+        current_block.push_back(value);
+        if (current_block.size() * sizeof(T) == vtu_compression_block_size)
+          finish_current_block();
+      }
+    else
+      // the unary plus makes sure that 8-bit integers are printed as numbers
+      // rather than characters
+      stream << +value << ' ';
+  }
+
+
+
+  template <typename T>
+  void
+  VtuDataArrayWriter<T>::finish_current_block()
+  {
+    uncompressed_size += current_block.size() * sizeof(T);
+    blocks.emplace_back();
+
+    if (!compress)
+      {
+        const auto begin =
+          reinterpret_cast<const unsigned char *>(current_block.data());
+        blocks.back().assign(begin, begin + current_block.size() * sizeof(T));
+        current_block.clear();
+        return;
+      }
+
+#ifdef DEAL_II_WITH_ZLIB
+    // bound the number of uncompressed blocks in flight
+    while (compression_tasks.size() >= MultithreadInfo::n_threads())
+      {
+        compression_tasks.front().join();
+        compression_tasks.pop_front();
+      }
+
+    auto block = std::make_shared<std::vector<T>>();
+    block->swap(current_block);
+    current_block.reserve(vtu_compression_block_size / sizeof(T));
+
+    std::vector<unsigned char> &compressed_block = blocks.back();
+    const DataOutBase::VtkFlags &flags           = this->flags;
+    compression_tasks.push_back(
+      Threads::new_task([block, &compressed_block, &flags]() {
+        compressed_block =
+          compress_block(reinterpret_cast<const unsigned char *>(block->data()),
+                         block->size() * sizeof(T),
+                         flags);
+      }));
+#else
+    Assert(false, ExcInternalError());
+#endif
+  }
+
+
+
   template <typename T>
   void
-  write_compressed_block(const std::vector<T> &       data,
-                         const DataOutBase::VtkFlags &flags,
-                         std::ostream &               output_stream)
+  VtuDataArrayWriter<T>::finish()
+  {
+    if (!binary)
+      return;
+
+    if (current_block.size() > 0)
+      finish_current_block();
+
+    for (const auto &task : compression_tasks)
+      task.join();
+    compression_tasks.clear();
+
+    // inline, empty arrays are simply left empty. in the appended data
+    // section, every array needs a header since the offsets refer to it
+    if (uncompressed_size > 0 || appended_data != nullptr)
+      write_vtu_data_array(
+        compress ? vtu_compression_header(uncompressed_size, blocks) :
+                   std::vector<uint32_t>(1, uncompressed_size),
+        blocks,
+        appended_data == nullptr,
+        appended_data != nullptr ? *appended_data : stream);
+
+    blocks.clear();
+    uncompressed_size = 0;
+  }
+
+
+
+#ifdef DEAL_II_WITH_HDF5
+  /**
+   * The number of rows per chunk of compressed HDF5 datasets if
+   * Hdf5Flags::chunk_size is zero.
+   */
+  constexpr hsize_t default_hdf5_chunk_size = 65536;
+
+  /**
+   * Create the dataset creation property list for a two-dimensional HDF5
+   * dataset with the given dimensions, setting up chunking and compression
+   * as requested by @p flags.
+   */
+  hid_t
+  create_hdf5_dataset_properties(const hsize_t                 dimensions[2],
+                                 const DataOutBase::Hdf5Flags &flags)
+  {
+    const hid_t properties = H5Pcreate(H5P_DATASET_CREATE);
+    AssertThrow(properties >= 0, ExcIO());
+
+    // HDF5 does not allow chunks that are larger than a dataset of fixed
+    // size, so empty datasets are always stored contiguously
+    if ((flags.chunk_size == 0 &&
+         flags.compression_filter == DataOutBase::Hdf5Flags::no_filter) ||
+        dimensions[0] == 0 || dimensions[1] == 0)
+      return properties;
+
+    const hsize_t chunk_size =
+      (flags.chunk_size > 0 ? flags.chunk_size : default_hdf5_chunk_size);
+    const hsize_t chunk_dimensions[2] = {std::min(chunk_size, dimensions[0]),
+                                         dimensions[1]};
+    herr_t status = H5Pset_chunk(properties, 2, chunk_dimensions);
+    AssertThrow(status >= 0, ExcIO());
+
+    switch (flags.compression_filter)
+      {
+        case DataOutBase::Hdf5Flags::no_filter:
+          break;
+
+        case DataOutBase::Hdf5Flags::deflate:
+          AssertThrow(flags.deflate_level >= 1 && flags.deflate_level <= 9,
+                      ExcMessage("The deflate level must be between 1 and 9."));
+          status = H5Pset_shuffle(properties);
+          AssertThrow(status >= 0, ExcIO());
+          status = H5Pset_deflate(properties, flags.deflate_level);
+          AssertThrow(status >= 0, ExcIO());
+          break;
+
+        case DataOutBase::Hdf5Flags::szip:
+          AssertThrow(H5Zfilter_avail(H5Z_FILTER_SZIP) > 0,
+                      ExcMessage("The HDF5 library was built without support "
+                                 "for the szip filter."));
+          status = H5Pset_szip(properties, H5_SZIP_NN_OPTION_MASK, 16);
+          AssertThrow(status >= 0, ExcIO());
+          break;
+
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+
+    return properties;
+  }
+
+
+
+  /**
+   * Create the file access property list for an HDF5 file that is accessed
+   * by all processes of @p comm, using collective metadata operations if
+   * requested by @p flags and supported by the HDF5 library.
+   */
+  hid_t
+  create_hdf5_file_access_properties(const MPI_Comm &              comm,
+                                     const DataOutBase::Hdf5Flags &flags)
   {
-    if (data.size() != 0)
+    const hid_t properties = H5Pcreate(H5P_FILE_ACCESS);
+    AssertThrow(properties != -1, ExcIO());
+    // If MPI is enabled *and* HDF5 is parallel, we can do parallel output
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    // Set the access to use the specified MPI_Comm object
+    herr_t status = H5Pset_fapl_mpio(properties, comm, MPI_INFO_NULL);
+    AssertThrow(status >= 0, ExcIO());
+#      if H5_VERSION_GE(1, 10, 0)
+    if (flags.collective_metadata)
       {
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(data.size() * sizeof(T));
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err =
-          compress2(&compressed_data[0],
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
-
-        const auto header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
-
-        output_stream << Utilities::encode_base64(
-                           {header_start, header_start + 4 * sizeof(uint32_t)})
-                      << Utilities::encode_base64(compressed_data);
+        status = H5Pset_all_coll_metadata_ops(properties, true);
+        AssertThrow(status >= 0, ExcIO());
+        status = H5Pset_coll_metadata_write(properties, true);
+        AssertThrow(status >= 0, ExcIO());
       }
+#      endif
+#    else
+    (void)comm;
+    (void)flags;
+#    endif
+#  else
+    (void)comm;
+    (void)flags;
+#  endif
+
+    return properties;
+  }
+
+
+
+  /**
+   * Create the two-dimensional dataset @p name of type @p datatype with
+   * @p n_rows rows and @p n_columns columns at @p location, and write the
+   * @p n_local_rows rows of this process, starting at row @p row_offset,
+   * from @p values into it using the transfer properties
+   * @p transfer_properties.
+   */
+  void
+  write_hdf5_dataset(const hid_t                   location,
+                     const std::string &           name,
+                     const hid_t                   datatype,
+                     const hsize_t                 n_rows,
+                     const hsize_t                 n_columns,
+                     const hsize_t                 n_local_rows,
+                     const hsize_t                 row_offset,
+                     const void *                  values,
+                     const DataOutBase::Hdf5Flags &flags,
+                     const hid_t                   transfer_properties)
+  {
+    const hsize_t dimensions[2] = {n_rows, n_columns};
+    const hid_t   dataspace     = H5Screate_simple(2, dimensions, nullptr);
+    AssertThrow(dataspace >= 0, ExcIO());
+    const hid_t properties = create_hdf5_dataset_properties(dimensions, flags);
+
+#  if H5Gcreate_vers == 1
+    const hid_t dataset =
+      H5Dcreate(location, name.c_str(), datatype, dataspace, properties);
+#  else
+    const hid_t dataset = H5Dcreate(location,
+                                    name.c_str(),
+                                    datatype,
+                                    dataspace,
+                                    H5P_DEFAULT,
+                                    properties,
+                                    H5P_DEFAULT);
+#  endif
+    AssertThrow(dataset >= 0, ExcIO());
+
+    // Select the rows of this process in the file and write them
+    const hsize_t count[2]  = {n_local_rows, n_columns};
+    const hsize_t offset[2] = {row_offset, 0};
+
+    const hid_t memory_dataspace = H5Screate_simple(2, count, nullptr);
+    AssertThrow(memory_dataspace >= 0, ExcIO());
+    const hid_t file_dataspace = H5Dget_space(dataset);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+    herr_t status = H5Sselect_hyperslab(
+      file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Dwrite(dataset,
+                      datatype,
+                      memory_dataspace,
+                      file_dataspace,
+                      transfer_properties,
+                      values);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(memory_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Dclose(dataset);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Pclose(properties);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(dataspace);
+    AssertThrow(status >= 0, ExcIO());
   }
+
+
+
+  /**
+   * Create the property list for a collective write of a dataset if parallel
+   * output is possible, or for an independent write otherwise.
+   */
+  hid_t
+  create_hdf5_transfer_properties()
+  {
+    const hid_t properties = H5Pcreate(H5P_DATASET_XFER);
+    AssertThrow(properties >= 0, ExcIO());
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    const herr_t status = H5Pset_dxpl_mpio(properties, H5FD_MPIO_COLLECTIVE);
+    AssertThrow(status >= 0, ExcIO());
+#    endif
+#  endif
+
+    return properties;
+  }
+
+
+
+#  ifdef DEAL_II_WITH_MPI
+  /**
+   * Gather the @p n_local_values values pointed to by @p local_values from
+   * all processes of @p comm on its process zero, where they are returned
+   * concatenated in the order of the ranks. The returned vector is empty on
+   * all other processes.
+   */
+  template <typename T>
+  std::vector<T>
+  gather_hdf5_data(const T *          local_values,
+                   const unsigned int n_local_values,
+                   const MPI_Datatype datatype,
+                   const MPI_Comm &   comm)
+  {
+    const std::vector<unsigned int> n_values =
+      Utilities::MPI::gather(comm, n_local_values, 0);
+
+    std::vector<int> counts(n_values.begin(), n_values.end());
+    std::vector<int> displacements(counts.size(), 0);
+    for (unsigned int i = 1; i < counts.size(); ++i)
+      displacements[i] = displacements[i - 1] + counts[i - 1];
+
+    std::vector<T> values(counts.empty() ?
+                            0 :
+                            displacements.back() + counts.back());
+
+    const int ierr = MPI_Gatherv(local_values,
+                                 n_local_values,
+                                 datatype,
+                                 values.data(),
+                                 counts.data(),
+                                 displacements.data(),
+                                 datatype,
+                                 0,
+                                 comm);
+    AssertThrowMPI(ierr);
+
+    return values;
+  }
+#  endif
 #endif
 } // namespace
 
@@ -1321,7 +1971,14 @@ namespace
   class VtuStream : public StreamBase<DataOutBase::VtkFlags>
   {
   public:
-    VtuStream(std::ostream &stream, const DataOutBase::VtkFlags &flags);
+    /**
+     * Constructor. If @p appended_data is not a null pointer, the vertices
+     * and cells are written to it as raw binary data, see
+     * VtuDataArrayWriter.
+     */
+    VtuStream(std::ostream &               stream,
+              const DataOutBase::VtkFlags &flags,
+              std::ostream *               appended_data = nullptr);
 
     template <int dim>
     void
@@ -1370,32 +2027,18 @@ namespace
     void
     flush_cells();
 
-    template <typename T>
-    std::ostream &
-    operator<<(const T &);
-
-    /**
-     * Forwarding of output stream.
-     *
-     * If libz was found during configuration, this operator compresses and
-     * encodes the entire data block. Otherwise, it simply writes it element by
-     * element.
-     */
-    template <typename T>
-    std::ostream &
-    operator<<(const std::vector<T> &);
-
   private:
     /**
-     * A list of vertices and cells, to be used in case we want to compress the
-     * data.
+     * Writers for the vertices and cells, to be used in case we want to
+     * compress the data. They compress the data block by block while the
+     * points and cells are added.
      *
      * The data types of these arrays needs to match what we print in the
      * XML-preamble to the respective parts of VTU files (e.g. Float32 and
      * Int32)
      */
-    std::vector<float>   vertices;
-    std::vector<int32_t> cells;
+    VtuDataArrayWriter<float>   vertices;
+    VtuDataArrayWriter<int32_t> cells;
   };
 
 
@@ -1729,8 +2372,12 @@ namespace
     stream << '\n';
   }
 
-  VtuStream::VtuStream(std::ostream &out, const DataOutBase::VtkFlags &f)
+  VtuStream::VtuStream(std::ostream &               out,
+                       const DataOutBase::VtkFlags &f,
+                       std::ostream *               appended_data)
     : StreamBase<DataOutBase::VtkFlags>(out, f)
+    , vertices(out, f, appended_data)
+    , cells(out, f, appended_data)
   {}
 
 
@@ -1759,10 +2406,9 @@ namespace
   VtuStream::flush_points()
   {
 #ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    *this << vertices << '\n';
-    vertices.clear();
+    // compress what is left of the data and write everything to the stream
+    vertices.finish();
+    stream << '\n';
 #endif
   }
 
@@ -1849,28 +2495,10 @@ namespace
   VtuStream::flush_cells()
   {
 #ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    *this << cells << '\n';
-    cells.clear();
-#endif
-  }
-
-
-  template <typename T>
-  std::ostream &
-  VtuStream::operator<<(const std::vector<T> &data)
-  {
-#ifdef DEAL_II_WITH_ZLIB
-    // compress the data we have in memory and write them to the stream. then
-    // release the data
-    write_compressed_block(data, flags, stream);
-#else
-    for (unsigned int i = 0; i < data.size(); ++i)
-      stream << data[i] << ' ';
+    // compress what is left of the data and write everything to the stream
+    cells.finish();
+    stream << '\n';
 #endif
-
-    return stream;
   }
 } // namespace
 
@@ -2535,12 +3163,28 @@ namespace DataOutBase
                      const unsigned int                   cycle,
                      const bool                           print_date_and_time,
                      const VtkFlags::ZlibCompressionLevel compression_level,
-                     const bool write_higher_order_cells)
+                     const bool write_higher_order_cells,
+                     const bool write_appended_raw_data)
     : time(time)
     , cycle(cycle)
     , print_date_and_time(print_date_and_time)
     , compression_level(compression_level)
     , write_higher_order_cells(write_higher_order_cells)
+    , write_appended_raw_data(write_appended_raw_data)
+  {}
+
+
+
+  Hdf5Flags::Hdf5Flags(const unsigned int      chunk_size,
+                       const CompressionFilter compression_filter,
+                       const unsigned int      deflate_level,
+                       const bool              collective_metadata,
+                       const unsigned int      ranks_per_writer)
+    : chunk_size(chunk_size)
+    , compression_filter(compression_filter)
+    , deflate_level(deflate_level)
+    , collective_metadata(collective_metadata)
+    , ranks_per_writer(ranks_per_writer)
   {}
 
 
@@ -5352,9 +5996,8 @@ namespace DataOutBase
       out << ".";
     out << "\n-->\n";
     out << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\"";
-#ifdef DEAL_II_WITH_ZLIB
-    out << " compressor=\"vtkZLibDataCompressor\"";
-#endif
+    if (vtu_data_is_compressed(flags))
+      out << " compressor=\"vtkZLibDataCompressor\"";
 #ifdef DEAL_II_WORDS_BIGENDIAN
     out << " byte_order=\"BigEndian\"";
 #else
@@ -5378,31 +6021,15 @@ namespace DataOutBase
 
 
 
+  /**
+   * Write the main part of a VTU file, as write_vtu_main() does. If
+   * @p appended_data is not a null pointer, the data arrays are not written
+   * inline but as raw binary data to @p appended_data, from where the caller
+   * has to copy them into the <code>AppendedData</code> section of the file.
+   */
   template <int dim, int spacedim>
   void
-  write_vtu(
-    const std::vector<Patch<dim, spacedim>> &patches,
-    const std::vector<std::string> &         data_names,
-    const std::vector<
-      std::tuple<unsigned int,
-                 unsigned int,
-                 std::string,
-                 DataComponentInterpretation::DataComponentInterpretation>>
-      &             nonscalar_data_ranges,
-    const VtkFlags &flags,
-    std::ostream &  out)
-  {
-    write_vtu_header(out, flags);
-    write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, out);
-    write_vtu_footer(out);
-
-    out << std::flush;
-  }
-
-
-  template <int dim, int spacedim>
-  void
-  write_vtu_main(
+  write_vtu_piece(
     const std::vector<Patch<dim, spacedim>> &patches,
     const std::vector<std::string> &         data_names,
     const std::vector<
@@ -5412,7 +6039,8 @@ namespace DataOutBase
                  DataComponentInterpretation::DataComponentInterpretation>>
       &             nonscalar_data_ranges,
     const VtkFlags &flags,
-    std::ostream &  out)
+    std::ostream &  out,
+    std::ostream *  appended_data)
   {
     AssertThrow(out, ExcIO());
 
@@ -5509,7 +6137,7 @@ namespace DataOutBase
     }
 
 
-    VtuStream vtu_out(out, flags);
+    VtuStream vtu_out(out, flags, appended_data);
 
     const unsigned int n_data_sets = data_names.size();
     // check against # of data sets in first patch. checks against all other
@@ -5523,13 +6151,6 @@ namespace DataOutBase
         AssertDimension(n_data_sets, patches[0].data.n_rows())
       }
 
-#ifdef DEAL_II_WITH_ZLIB
-    const char *ascii_or_binary = "binary";
-#else
-    const char *              ascii_or_binary = "ascii";
-#endif
-
-
     // first count the number of cells and cells for later use
     unsigned int n_nodes, n_cells, n_points_and_n_cells;
     compute_sizes(patches,
@@ -5538,25 +6159,25 @@ namespace DataOutBase
                   n_cells,
                   n_points_and_n_cells);
 
-    // in gmv format the vertex coordinates and the data have an order that is a
-    // bit unpleasant (first all x coordinates, then all y coordinate, ...;
-    // first all data of variable 1, then variable 2, etc), so we have to copy
-    // the data vectors a bit around
-    //
-    // note that we copy vectors when looping over the patches since we have to
-    // write them one variable at a time and don't want to use more than one
-    // loop
-    //
-    // this copying of data vectors can be done while we already output the
-    // vertices, so do this on a separate task and when wanting to write out the
-    // data, we wait for that task to finish
-    Table<2, float> data_vectors(n_data_sets, n_nodes);
+    // all data arrays are written through this object. it compresses the
+    // data while it is generated, so that none of the (potentially large)
+    // arrays has to be stored as a whole
+    VtuDataArrayWriter<float> data(out, flags, appended_data);
 
-    void (*fun_ptr)(const std::vector<Patch<dim, spacedim>> &,
-                    Table<2, float> &) =
-      &write_gmv_reorder_data_vectors<dim, spacedim, float>;
-    Threads::Task<> reorder_task =
-      Threads::new_task(fun_ptr, patches, data_vectors);
+#ifdef DEBUG
+    // the data arrays below list the values of all nodes, patch by patch,
+    // taken right out of the data tables of the patches. check that all of
+    // these tables have the expected layout
+    for (const auto &patch : patches)
+      Assert((patch.data.n_rows() == n_data_sets &&
+              !patch.points_are_available) ||
+               (patch.data.n_rows() == n_data_sets + spacedim &&
+                patch.points_are_available),
+             ExcDimensionMismatch(patch.points_are_available ?
+                                    (n_data_sets + spacedim) :
+                                    n_data_sets,
+                                  patch.data.n_rows()));
+#endif
 
     ///////////////////////////////
     // first make up a list of used vertices along with their coordinates
@@ -5566,16 +6187,16 @@ namespace DataOutBase
     out << "<Piece NumberOfPoints=\"" << n_nodes << "\" NumberOfCells=\""
         << n_cells << "\" >\n";
     out << "  <Points>\n";
-    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+        << vtu_data_array_format(appended_data) << ">\n";
     write_nodes(patches, vtu_out);
     out << "    </DataArray>\n";
     out << "  </Points>\n\n";
     /////////////////////////////////
     // now for the cells
     out << "  <Cells>\n";
-    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" "
+        << vtu_data_array_format(appended_data) << ">\n";
     if (flags.write_higher_order_cells)
       write_high_order_cells(patches, vtu_out);
     else
@@ -5584,47 +6205,46 @@ namespace DataOutBase
 
     // XML VTU format uses offsets; this is different than the VTK format, which
     // puts the number of nodes per cell in front of the connectivity list.
-    out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
-        << ascii_or_binary << "\">\n";
-
-    std::vector<int32_t> offsets;
-    offsets.reserve(n_cells);
+    out << "    <DataArray type=\"Int32\" Name=\"offsets\" "
+        << vtu_data_array_format(appended_data) << ">\n";
 
-    // uint8_t might be an alias to unsigned char which is then not printed
-    // as ascii integers
-#ifdef DEAL_II_WITH_ZLIB
-    std::vector<uint8_t> cell_types;
-#else
-    std::vector<unsigned int> cell_types;
-#endif
-    cell_types.reserve(n_cells);
-
-    unsigned int first_vertex_of_patch = 0;
-
-    for (const auto &patch : patches)
-      {
-        const auto vtk_cell_id =
-          extract_vtk_patch_info(patch, flags.write_higher_order_cells);
-
-        for (unsigned int i = 0; i < vtk_cell_id[1]; ++i)
-          {
-            cell_types.push_back(vtk_cell_id[0]);
-            first_vertex_of_patch += vtk_cell_id[2];
-            offsets.push_back(first_vertex_of_patch);
-          }
-      }
+    {
+      VtuDataArrayWriter<int32_t> offsets(out, flags, appended_data);
+      unsigned int                first_vertex_of_patch = 0;
+      for (const auto &patch : patches)
+        {
+          const auto vtk_cell_id =
+            extract_vtk_patch_info(patch, flags.write_higher_order_cells);
 
-    vtu_out << offsets;
+          for (unsigned int i = 0; i < vtk_cell_id[1]; ++i)
+            {
+              first_vertex_of_patch += vtk_cell_id[2];
+              offsets.push_back(first_vertex_of_patch);
+            }
+        }
+      offsets.finish();
+    }
     out << "\n";
     out << "    </DataArray>\n";
 
     // next output the types of the cells. since all cells are the same, this is
     // simple
-    out << "    <DataArray type=\"UInt8\" Name=\"types\" format=\""
-        << ascii_or_binary << "\">\n";
+    out << "    <DataArray type=\"UInt8\" Name=\"types\" "
+        << vtu_data_array_format(appended_data) << ">\n";
 
     // this should compress well :-)
-    vtu_out << cell_types;
+    {
+      VtuDataArrayWriter<uint8_t> cell_types(out, flags, appended_data);
+      for (const auto &patch : patches)
+        {
+          const auto vtk_cell_id =
+            extract_vtk_patch_info(patch, flags.write_higher_order_cells);
+
+          for (unsigned int i = 0; i < vtk_cell_id[1]; ++i)
+            cell_types.push_back(vtk_cell_id[0]);
+        }
+      cell_types.finish();
+    }
     out << "\n";
     out << "    </DataArray>\n";
     out << "  </Cells>\n";
@@ -5633,10 +6253,6 @@ namespace DataOutBase
     ///////////////////////////////////////
     // data output.
 
-    // now write the data vectors to @p{out} first make sure that all data is in
-    // place
-    reorder_task.join();
-
     // then write data.  the 'POINT_DATA' means: node data (as opposed to cell
     // data, which we do not support explicitly here). all following data sets
     // are point data
@@ -5690,90 +6306,89 @@ namespace DataOutBase
             out << data_names[last_component];
           }
 
-        out << "\" NumberOfComponents=\"" << n_components << "\" format=\""
-            << ascii_or_binary << "\">\n";
+        out << "\" NumberOfComponents=\"" << n_components << "\" "
+            << vtu_data_array_format(appended_data) << ">\n";
 
         // now write data. pad all vectors to have three components
-        std::vector<float> data;
-        data.reserve(n_nodes * n_components);
+        for (const auto &patch : patches)
+          for (unsigned int n = 0; n < patch.data.n_cols(); ++n)
+            {
+              if (!is_tensor)
+                {
+                  switch (last_component - first_component)
+                    {
+                      case 0:
+                        data.push_back(patch.data(first_component, n));
+                        data.push_back(0);
+                        data.push_back(0);
+                        break;
+
+                      case 1:
+                        data.push_back(patch.data(first_component, n));
+                        data.push_back(patch.data(first_component + 1, n));
+                        data.push_back(0);
+                        break;
+
+                      case 2:
+                        data.push_back(patch.data(first_component, n));
+                        data.push_back(patch.data(first_component + 1, n));
+                        data.push_back(patch.data(first_component + 2, n));
+                        break;
+
+                      default:
+                        // Anything else is not yet implemented
+                        Assert(false, ExcInternalError());
+                    }
+                }
+              else
+                {
+                  Tensor<2, 3> vtk_data;
+                  vtk_data = 0.;
 
-        for (unsigned int n = 0; n < n_nodes; ++n)
-          {
-            if (!is_tensor)
-              {
-                switch (last_component - first_component)
-                  {
-                    case 0:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(0);
-                      data.push_back(0);
-                      break;
-
-                    case 1:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(data_vectors(first_component + 1, n));
-                      data.push_back(0);
-                      break;
-
-                    case 2:
-                      data.push_back(data_vectors(first_component, n));
-                      data.push_back(data_vectors(first_component + 1, n));
-                      data.push_back(data_vectors(first_component + 2, n));
-                      break;
-
-                    default:
-                      // Anything else is not yet implemented
+                  const unsigned int size =
+                    last_component - first_component + 1;
+                  if (size == 1)
+                    // 1D, 1 element
+                    {
+                      vtk_data[0][0] = patch.data(first_component, n);
+                    }
+                  else if (size == 4)
+                    // 2D, 4 elements
+                    {
+                      for (unsigned int c = 0; c < size; ++c)
+                        {
+                          const auto ind =
+                            Tensor<2, 2>::unrolled_to_component_indices(c);
+                          vtk_data[ind[0]][ind[1]] =
+                            patch.data(first_component + c, n);
+                        }
+                    }
+                  else if (size == 9)
+                    // 3D 9 elements
+                    {
+                      for (unsigned int c = 0; c < size; ++c)
+                        {
+                          const auto ind =
+                            Tensor<2, 3>::unrolled_to_component_indices(c);
+                          vtk_data[ind[0]][ind[1]] =
+                            patch.data(first_component + c, n);
+                        }
+                    }
+                  else
+                    {
                       Assert(false, ExcInternalError());
-                  }
-              }
-            else
-              {
-                Tensor<2, 3> vtk_data;
-                vtk_data = 0.;
-
-                const unsigned int size = last_component - first_component + 1;
-                if (size == 1)
-                  // 1D, 1 element
-                  {
-                    vtk_data[0][0] = data_vectors(first_component, n);
-                  }
-                else if (size == 4)
-                  // 2D, 4 elements
-                  {
-                    for (unsigned int c = 0; c < size; ++c)
-                      {
-                        const auto ind =
-                          Tensor<2, 2>::unrolled_to_component_indices(c);
-                        vtk_data[ind[0]][ind[1]] =
-                          data_vectors(first_component + c, n);
-                      }
-                  }
-                else if (size == 9)
-                  // 3D 9 elements
-                  {
-                    for (unsigned int c = 0; c < size; ++c)
-                      {
-                        const auto ind =
-                          Tensor<2, 3>::unrolled_to_component_indices(c);
-                        vtk_data[ind[0]][ind[1]] =
-                          data_vectors(first_component + c, n);
-                      }
-                  }
-                else
-                  {
-                    Assert(false, ExcInternalError());
-                  }
+                    }
 
-                // now put the tensor into data
-                // note we padd with zeros because VTK format always wants to
-                // see a 3x3 tensor, regardless of dimension
-                for (unsigned int i = 0; i < 3; ++i)
-                  for (unsigned int j = 0; j < 3; ++j)
-                    data.push_back(vtk_data[i][j]);
-              }
-          } // loop over nodes
+                  // now put the tensor into data
+                  // note we padd with zeros because VTK format always wants to
+                  // see a 3x3 tensor, regardless of dimension
+                  for (unsigned int i = 0; i < 3; ++i)
+                    for (unsigned int j = 0; j < 3; ++j)
+                      data.push_back(vtk_data[i][j]);
+                }
+            } // loop over nodes
 
-        vtu_out << data;
+        data.finish();
         out << "    </DataArray>\n";
 
       } // loop over ranges
@@ -5783,25 +6398,131 @@ namespace DataOutBase
       if (data_set_written[data_set] == false)
         {
           out << "    <DataArray type=\"Float32\" Name=\""
-              << data_names[data_set] << "\" format=\"" << ascii_or_binary
-              << "\">\n";
+              << data_names[data_set] << "\" "
+              << vtu_data_array_format(appended_data) << ">\n";
+
+          for (const auto &patch : patches)
+            for (unsigned int n = 0; n < patch.data.n_cols(); ++n)
+              data.push_back(patch.data(data_set, n));
+          data.finish();
+          out << "    </DataArray>\n";
+        }
+
+    out << "  </PointData>\n";
+
+    // Finish up writing a valid XML file
+    out << " </Piece>\n";
+
+    // make sure everything now gets to disk
+    out.flush();
+
+    // assert the stream is still ok
+    AssertThrow(out, ExcIO());
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    write_vtu_header(out, flags);
+    if (flags.write_appended_raw_data && vtu_data_is_compressed(flags))
+      {
+        // the sizes of compressed data arrays, and thus their offsets in the
+        // AppendedData section, are only known once the data is compressed.
+        // rather than compressing everything twice, collect the compressed
+        // arrays in a separate buffer that is then written following the
+        // XML part of the file
+        std::stringstream appended_data;
+        write_vtu_piece(patches,
+                        data_names,
+                        nonscalar_data_ranges,
+                        flags,
+                        out,
+                        &appended_data);
+
+        out << " </UnstructuredGrid>\n";
+        out << "<AppendedData encoding=\"raw\">\n_";
+        if (appended_data.tellp() > 0)
+          out << appended_data.rdbuf();
+        out << "\n</AppendedData>\n";
+        out << "</VTKFile>\n";
+      }
+    else if (flags.write_appended_raw_data)
+      {
+        // the sizes of uncompressed data arrays only depend on the patches.
+        // so first write the XML part of the file with the offsets of the
+        // arrays, which we obtain by writing the data to a stream that only
+        // counts the bytes, and then write the data arrays a second time,
+        // now straight to the output stream, while discarding the XML
+        {
+          CountingStreamBuffer counter;
+          std::ostream         appended_data(&counter);
+          write_vtu_piece(patches,
+                          data_names,
+                          nonscalar_data_ranges,
+                          flags,
+                          out,
+                          &appended_data);
+        }
 
-          std::vector<float> data(data_vectors[data_set].begin(),
-                                  data_vectors[data_set].end());
-          vtu_out << data;
-          out << "    </DataArray>\n";
+        out << " </UnstructuredGrid>\n";
+        out << "<AppendedData encoding=\"raw\">\n_";
+        out.flush();
+        {
+          CountingStreamBuffer discarded_xml_buffer;
+          std::ostream         discarded_xml(&discarded_xml_buffer);
+          CountingStreamBuffer appended_data_buffer(out.rdbuf());
+          std::ostream         appended_data(&appended_data_buffer);
+          write_vtu_piece(patches,
+                          data_names,
+                          nonscalar_data_ranges,
+                          flags,
+                          discarded_xml,
+                          &appended_data);
+          AssertThrow(appended_data, ExcIO());
         }
+        out << "\n</AppendedData>\n";
+        out << "</VTKFile>\n";
+      }
+    else
+      {
+        write_vtu_main(patches, data_names, nonscalar_data_ranges, flags, out);
+        write_vtu_footer(out);
+      }
 
-    out << "  </PointData>\n";
+    out << std::flush;
+  }
 
-    // Finish up writing a valid XML file
-    out << " </Piece>\n";
 
-    // make sure everything now gets to disk
-    out.flush();
 
-    // assert the stream is still ok
-    AssertThrow(out, ExcIO());
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string> &         data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+      &             nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::ostream &  out)
+  {
+    write_vtu_piece(
+      patches, data_names, nonscalar_data_ranges, flags, out, nullptr);
   }
 
 
@@ -7076,6 +7797,7 @@ namespace DataOutBase
 template <int dim, int spacedim>
 DataOutInterface<dim, spacedim>::DataOutInterface()
   : default_subdivisions(1)
+  , max_background_writes(1)
   , default_fmt(DataOutBase::default_format)
 {}
 
@@ -7334,8 +8056,48 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
   const unsigned int rank = Utilities::MPI::this_mpi_process(mpi_communicator);
   const unsigned int n_ranks =
     Utilities::MPI::n_mpi_processes(mpi_communicator);
-  const unsigned int n_files_written =
+  const bool one_file_per_node =
+    (n_groups == numbers::invalid_unsigned_int && n_ranks > 1);
+  unsigned int n_files_written =
     (n_groups == 0 || n_groups > n_ranks) ? n_ranks : n_groups;
+  unsigned int color = rank % n_files_written;
+
+#ifdef DEAL_II_WITH_MPI
+  MPI_Comm comm_node = MPI_COMM_NULL;
+  if (one_file_per_node)
+    {
+      int ierr = MPI_Comm_split_type(mpi_communicator,
+                                     MPI_COMM_TYPE_SHARED,
+                                     rank,
+                                     MPI_INFO_NULL,
+                                     &comm_node);
+      AssertThrowMPI(ierr);
+
+      // number the nodes in the order of their lowest ranks. (we can not
+      // rely on the process with the lowest rank being process zero of
+      // comm_node, see AlignedVector::replicate_across_communicator().)
+      const unsigned int is_first_on_node =
+        (rank == Utilities::MPI::min(rank, comm_node) ? 1 : 0);
+      n_files_written = Utilities::MPI::sum(is_first_on_node, mpi_communicator);
+
+      // the index of this node is the number of nodes whose lowest rank is
+      // smaller than the lowest rank on this node
+      unsigned int n_previous_nodes = 0;
+
+      ierr = MPI_Exscan(&is_first_on_node,
+                        &n_previous_nodes,
+                        1,
+                        MPI_UNSIGNED,
+                        MPI_SUM,
+                        mpi_communicator);
+      AssertThrowMPI(ierr);
+      // the result of MPI_Exscan is undefined on process zero
+      if (rank == 0)
+        n_previous_nodes = 0;
+      color = Utilities::MPI::max(is_first_on_node ? n_previous_nodes : 0,
+                                  comm_node);
+    }
+#endif
 
   Assert(n_files_written >= 1, ExcInternalError());
   // the "-1" is needed since we use C++ style counting starting with 0, so
@@ -7343,13 +8105,23 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
   const unsigned int n_digits =
     Utilities::needed_digits(std::max(0, int(n_files_written) - 1));
 
-  const unsigned int color = rank % n_files_written;
-  const std::string  filename =
+  const std::string filename =
     directory + filename_without_extension + "_" +
     Utilities::int_to_string(counter, n_digits_for_counter) + "." +
     Utilities::int_to_string(color, n_digits) + ".vtu";
 
-  if (n_groups == 0 || n_groups > n_ranks)
+  if (one_file_per_node)
+    {
+#ifdef DEAL_II_WITH_MPI
+      // the processes of each node write one data file in parallel
+      this->write_vtu_in_parallel(filename.c_str(), comm_node);
+      const int ierr = MPI_Comm_free(&comm_node);
+      AssertThrowMPI(ierr);
+#else
+      AssertThrow(false, ExcMessage("Logical error. Should not arrive here."));
+#endif
+    }
+  else if (n_groups == 0 || n_groups > n_ranks)
     {
       // every processor writes one file
       std::ofstream output(filename.c_str());
@@ -7688,7 +8460,8 @@ DataOutInterface<dim, spacedim>::write_hdf5_parallel(
   const std::string &               filename,
   const MPI_Comm &                  comm) const
 {
-  DataOutBase::write_hdf5_parallel(get_patches(), data_filter, filename, comm);
+  DataOutBase::write_hdf5_parallel(
+    get_patches(), data_filter, true, filename, filename, comm, hdf5_flags);
 }
 
 
@@ -7707,33 +8480,380 @@ DataOutInterface<dim, spacedim>::write_hdf5_parallel(
                                    write_mesh_file,
                                    mesh_filename,
                                    solution_filename,
-                                   comm);
+                                   comm,
+                                   hdf5_flags);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBase::write_hdf5_parallel(
+  const std::vector<Patch<dim, spacedim>> &patches,
+  const DataOutBase::DataOutFilter &       data_filter,
+  const std::string &                      filename,
+  const MPI_Comm &                         comm)
+{
+  write_hdf5_parallel(patches, data_filter, true, filename, filename, comm);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBase::write_hdf5_parallel(
+  const std::vector<Patch<dim, spacedim>> &patches,
+  const DataOutBase::DataOutFilter &       data_filter,
+  const bool                               write_mesh_file,
+  const std::string &                      mesh_filename,
+  const std::string &                      solution_filename,
+  const MPI_Comm &                         comm,
+  const DataOutBase::Hdf5Flags &           flags)
+{
+  AssertThrow(
+    spacedim >= 2,
+    ExcMessage(
+      "DataOutBase was asked to write HDF5 output for a space dimension of 1. "
+      "HDF5 only supports datasets that live in 2 or 3 dimensions."));
+
+  int ierr = 0;
+  (void)ierr;
+#ifndef DEAL_II_WITH_HDF5
+  // throw an exception, but first make sure the compiler does not warn about
+  // the now unused function arguments
+  (void)patches;
+  (void)data_filter;
+  (void)write_mesh_file;
+  (void)mesh_filename;
+  (void)solution_filename;
+  (void)comm;
+  (void)flags;
+  AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#else
+  AssertThrow(flags.ranks_per_writer >= 1,
+              ExcMessage("There must be at least one process per writer."));
+
+  // verify that there are indeed patches to be written out. most of the times,
+  // people just forget to call build_patches when there are no patches, so a
+  // warning is in order. that said, the assertion is disabled if we support MPI
+  // since then it can happen that on the coarsest mesh, a processor simply has
+  // no cells it actually owns, and in that case it is legit if there are no
+  // patches
+  Assert(patches.size() > 0, ExcNoPatches());
+
+  hid_t h5_mesh_file_id = -1, h5_solution_file_id, file_plist_id, plist_id;
+  herr_t status;
+  unsigned int local_node_cell_count[2];
+  std::vector<double> node_data_vec;
+  std::vector<unsigned int> cell_data_vec;
+
+  // If HDF5 is not parallel and we're using multiple processes, abort
+#  ifndef H5_HAVE_PARALLEL
+#    ifdef DEAL_II_WITH_MPI
+  int world_size = Utilities::MPI::n_mpi_processes(comm);
+  AssertThrow(
+    world_size <= 1,
+    ExcMessage(
+      "Serial HDF5 output on multiple processes is not yet supported."));
+#    endif
+#  endif
+
+  local_node_cell_count[0] = data_filter.n_nodes();
+  local_node_cell_count[1] = data_filter.n_cells();
+
+  // Compute the global total number of nodes/cells and determine the offset of
+  // the data for this process
+
+  unsigned int global_node_cell_count[2] = {0, 0};
+  unsigned int global_node_cell_offsets[2] = {0, 0};
+
+#  ifdef DEAL_II_WITH_MPI
+  ierr = MPI_Allreduce(local_node_cell_count,
+                       global_node_cell_count,
+                       2,
+                       MPI_UNSIGNED,
+                       MPI_SUM,
+                       comm);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Exscan(local_node_cell_count,
+                    global_node_cell_offsets,
+                    2,
+                    MPI_UNSIGNED,
+                    MPI_SUM,
+                    comm);
+  AssertThrowMPI(ierr);
+#  else
+  global_node_cell_count[0] = local_node_cell_count[0];
+  global_node_cell_count[1] = local_node_cell_count[1];
+  global_node_cell_offsets[0] = global_node_cell_offsets[1] = 0;
+#  endif
+
+  const unsigned int n_node_components = (spacedim < 2) ? 2 : spacedim;
+  const unsigned int n_cell_vertices = patches[0].reference_cell.n_vertices();
+
+  if (write_mesh_file)
+    {
+      data_filter.fill_node_data(node_data_vec);
+      data_filter.fill_cell_data(global_node_cell_offsets[0], cell_data_vec);
+    }
+
+  // Pointers to the values of the data sets written by this process. Unless
+  // the data of several processes is aggregated below, these point right into
+  // the data filter
+  std::vector<const double *> data_set_values(data_filter.n_data_sets());
+  for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+    data_set_values[i] = data_filter.get_data_set(i);
+
+  bool is_writer = true;
+
+#  ifdef DEAL_II_WITH_MPI
+  // The processes that access the file. Unless data is aggregated, these are
+  // all processes
+  MPI_Comm writer_comm = comm;
+
+  // If requested, send the data of each group of ranks_per_writer consecutive
+  // processes to the first process of the group, which then writes it. Since
+  // the groups consist of consecutive processes, the data of a group is
+  // contiguous in the file and starts at the offset of the first process
+  std::vector<std::vector<double>> aggregated_data_sets;
+  if (flags.ranks_per_writer > 1)
+    {
+      const unsigned int rank = Utilities::MPI::this_mpi_process(comm);
+      is_writer = (rank % flags.ranks_per_writer == 0);
+
+      MPI_Comm group_comm;
+      ierr =
+        MPI_Comm_split(comm, rank / flags.ranks_per_writer, rank, &group_comm);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_split(comm,
+                            is_writer ? 0 : MPI_UNDEFINED,
+                            rank,
+                            &writer_comm);
+      AssertThrowMPI(ierr);
+
+      if (write_mesh_file)
+        {
+          node_data_vec = gather_hdf5_data(node_data_vec.data(),
+                                           node_data_vec.size(),
+                                           MPI_DOUBLE,
+                                           group_comm);
+          cell_data_vec = gather_hdf5_data(cell_data_vec.data(),
+                                           cell_data_vec.size(),
+                                           MPI_UNSIGNED,
+                                           group_comm);
+        }
+
+      aggregated_data_sets.resize(data_filter.n_data_sets());
+      for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+        {
+          aggregated_data_sets[i] =
+            gather_hdf5_data(data_filter.get_data_set(i),
+                             local_node_cell_count[0] *
+                               data_filter.get_data_set_dim(i),
+                             MPI_DOUBLE,
+                             group_comm);
+          data_set_values[i] = aggregated_data_sets[i].data();
+        }
+
+      local_node_cell_count[0] =
+        Utilities::MPI::sum(local_node_cell_count[0], group_comm);
+      local_node_cell_count[1] =
+        Utilities::MPI::sum(local_node_cell_count[1], group_comm);
+
+      ierr = MPI_Comm_free(&group_comm);
+      AssertThrowMPI(ierr);
+    }
+#  endif
+
+  if (!is_writer)
+    return;
+
+  // Create file access properties
+#  ifdef DEAL_II_WITH_MPI
+  file_plist_id = create_hdf5_file_access_properties(writer_comm, flags);
+#  else
+  file_plist_id = create_hdf5_file_access_properties(comm, flags);
+#  endif
+
+  // Create the property list for a collective write
+  plist_id = create_hdf5_transfer_properties();
+
+  if (write_mesh_file)
+    {
+      // Overwrite any existing files (change this to an option?)
+      h5_mesh_file_id = H5Fcreate(mesh_filename.c_str(),
+                                  H5F_ACC_TRUNC,
+                                  H5P_DEFAULT,
+                                  file_plist_id);
+      AssertThrow(h5_mesh_file_id >= 0, ExcIO());
+
+      // Write the nodes and cells. HDF5 only supports 2- or 3-dimensional
+      // coordinates
+      write_hdf5_dataset(h5_mesh_file_id,
+                         "nodes",
+                         H5T_NATIVE_DOUBLE,
+                         global_node_cell_count[0],
+                         n_node_components,
+                         local_node_cell_count[0],
+                         global_node_cell_offsets[0],
+                         node_data_vec.data(),
+                         flags,
+                         plist_id);
+      node_data_vec.clear();
+
+      write_hdf5_dataset(h5_mesh_file_id,
+                         "cells",
+                         H5T_NATIVE_UINT,
+                         global_node_cell_count[1],
+                         n_cell_vertices,
+                         local_node_cell_count[1],
+                         global_node_cell_offsets[1],
+                         cell_data_vec.data(),
+                         flags,
+                         plist_id);
+      cell_data_vec.clear();
+
+      // If the filenames are different, we need to close the mesh file
+      if (mesh_filename != solution_filename)
+        {
+          status = H5Fclose(h5_mesh_file_id);
+          AssertThrow(status >= 0, ExcIO());
+        }
+    }
+
+  // If the filenames are identical, continue with the same file
+  if (mesh_filename == solution_filename && write_mesh_file)
+    {
+      h5_solution_file_id = h5_mesh_file_id;
+    }
+  else
+    {
+      // Otherwise we need to open a new file
+      h5_solution_file_id = H5Fcreate(solution_filename.c_str(),
+                                      H5F_ACC_TRUNC,
+                                      H5P_DEFAULT,
+                                      file_plist_id);
+      AssertThrow(h5_solution_file_id >= 0, ExcIO());
+    }
+
+  // Write the data sets. Each of them is either a scalar or a vector field
+  for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+    write_hdf5_dataset(h5_solution_file_id,
+                       data_filter.get_data_set_name(i),
+                       H5T_NATIVE_DOUBLE,
+                       global_node_cell_count[0],
+                       data_filter.get_data_set_dim(i),
+                       local_node_cell_count[0],
+                       global_node_cell_offsets[0],
+                       data_set_values[i],
+                       flags,
+                       plist_id);
+
+  // Close the file property list
+  status = H5Pclose(file_plist_id);
+  AssertThrow(status >= 0, ExcIO());
+
+  // Close the parallel access
+  status = H5Pclose(plist_id);
+  AssertThrow(status >= 0, ExcIO());
+
+  // Close the file
+  status = H5Fclose(h5_solution_file_id);
+  AssertThrow(status >= 0, ExcIO());
+
+#  ifdef DEAL_II_WITH_MPI
+  if (flags.ranks_per_writer > 1)
+    {
+      ierr = MPI_Comm_free(&writer_comm);
+      AssertThrowMPI(ierr);
+    }
+#  endif
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_hdf5_time_step(
+  DataOutBase::Hdf5TimeSeriesWriter &writer,
+  const DataOutBase::DataOutFilter & data_filter,
+  const double                       time,
+  const bool                         mesh_changed) const
+{
+  writer.write_time_step(get_patches(), data_filter, time, mesh_changed);
+}
+
+
+
+DataOutBase::Hdf5TimeSeriesWriter::Hdf5TimeSeriesWriter(
+  const std::string &h5_filename,
+  const std::string &xdmf_filename,
+  const MPI_Comm &   comm,
+  const Hdf5Flags &  flags)
+  : h5_filename(h5_filename)
+  , xdmf_filename(xdmf_filename)
+  , comm(comm)
+  , flags(flags)
+  , h5_file_id(-1)
+  , n_meshes(0)
+  , n_steps(0)
+  , mesh_node_cell_count{0, 0}
+{
+#ifndef DEAL_II_WITH_HDF5
+  AssertThrow(false, ExcMessage("HDF5 support is disabled."));
+#else
+  AssertThrow(flags.ranks_per_writer == 1,
+              ExcMessage("Aggregating the data of several processes is not "
+                         "supported for time series output."));
+
+  // If HDF5 is not parallel and we're using multiple processes, abort
+#  ifndef H5_HAVE_PARALLEL
+#    ifdef DEAL_II_WITH_MPI
+  AssertThrow(
+    Utilities::MPI::n_mpi_processes(comm) <= 1,
+    ExcMessage(
+      "Serial HDF5 output on multiple processes is not yet supported."));
+#    endif
+#  endif
+
+  const hid_t file_plist_id = create_hdf5_file_access_properties(comm, flags);
+
+  // Overwrite any existing file, like write_hdf5_parallel() does
+  h5_file_id = H5Fcreate(h5_filename.c_str(),
+                         H5F_ACC_TRUNC,
+                         H5P_DEFAULT,
+                         file_plist_id);
+  AssertThrow(h5_file_id >= 0, ExcIO());
+
+  const herr_t status = H5Pclose(file_plist_id);
+  AssertThrow(status >= 0, ExcIO());
+#endif
 }
 
 
 
-template <int dim, int spacedim>
-void
-DataOutBase::write_hdf5_parallel(
-  const std::vector<Patch<dim, spacedim>> &patches,
-  const DataOutBase::DataOutFilter &       data_filter,
-  const std::string &                      filename,
-  const MPI_Comm &                         comm)
+DataOutBase::Hdf5TimeSeriesWriter::~Hdf5TimeSeriesWriter()
 {
-  write_hdf5_parallel(patches, data_filter, true, filename, filename, comm);
+#ifdef DEAL_II_WITH_HDF5
+  if (h5_file_id >= 0)
+    {
+      const herr_t status = H5Fclose(h5_file_id);
+      (void)status;
+      AssertNothrow(status >= 0, ExcIO());
+    }
+#endif
 }
 
 
 
 template <int dim, int spacedim>
 void
-DataOutBase::write_hdf5_parallel(
+DataOutBase::Hdf5TimeSeriesWriter::write_time_step(
   const std::vector<Patch<dim, spacedim>> &patches,
-  const DataOutBase::DataOutFilter &       data_filter,
-  const bool                               write_mesh_file,
-  const std::string &                      mesh_filename,
-  const std::string &                      solution_filename,
-  const MPI_Comm &                         comm)
+  const DataOutFilter &                    data_filter,
+  const double                             time,
+  const bool                               mesh_changed)
 {
   AssertThrow(
     spacedim >= 2,
@@ -7741,83 +8861,32 @@ DataOutBase::write_hdf5_parallel(
       "DataOutBase was asked to write HDF5 output for a space dimension of 1. "
       "HDF5 only supports datasets that live in 2 or 3 dimensions."));
 
-  int ierr = 0;
-  (void)ierr;
 #ifndef DEAL_II_WITH_HDF5
   // throw an exception, but first make sure the compiler does not warn about
   // the now unused function arguments
   (void)patches;
   (void)data_filter;
-  (void)write_mesh_file;
-  (void)mesh_filename;
-  (void)solution_filename;
-  (void)comm;
+  (void)time;
+  (void)mesh_changed;
   AssertThrow(false, ExcMessage("HDF5 support is disabled."));
 #else
-#  ifndef DEAL_II_WITH_MPI
-  (void)comm;
-#  endif
-
-  // verify that there are indeed patches to be written out. most of the times,
-  // people just forget to call build_patches when there are no patches, so a
-  // warning is in order. that said, the assertion is disabled if we support MPI
-  // since then it can happen that on the coarsest mesh, a processor simply has
-  // no cells it actually owns, and in that case it is legit if there are no
-  // patches
   Assert(patches.size() > 0, ExcNoPatches());
 
-  hid_t h5_mesh_file_id = -1, h5_solution_file_id, file_plist_id, plist_id;
-  hid_t node_dataspace, node_dataset, node_file_dataspace,
-    node_memory_dataspace;
-  hid_t cell_dataspace, cell_dataset, cell_file_dataspace,
-    cell_memory_dataspace;
-  hid_t pt_data_dataspace, pt_data_dataset, pt_data_file_dataspace,
-    pt_data_memory_dataspace;
-  herr_t status;
-  unsigned int local_node_cell_count[2];
-  hsize_t count[2], offset[2], node_ds_dim[2], cell_ds_dim[2];
-  std::vector<double> node_data_vec;
-  std::vector<unsigned int> cell_data_vec;
-
-  // If HDF5 is not parallel and we're using multiple processes, abort
-#  ifndef H5_HAVE_PARALLEL
-#    ifdef DEAL_II_WITH_MPI
-  int world_size = Utilities::MPI::n_mpi_processes(comm);
-  AssertThrow(
-    world_size <= 1,
-    ExcMessage(
-      "Serial HDF5 output on multiple processes is not yet supported."));
-#    endif
-#  endif
-
-  local_node_cell_count[0] = data_filter.n_nodes();
-  local_node_cell_count[1] = data_filter.n_cells();
-
-  // Create file access properties
-  file_plist_id = H5Pcreate(H5P_FILE_ACCESS);
-  AssertThrow(file_plist_id != -1, ExcIO());
-  // If MPI is enabled *and* HDF5 is parallel, we can do parallel output
-#  ifdef DEAL_II_WITH_MPI
-#    ifdef H5_HAVE_PARALLEL
-  // Set the access to use the specified MPI_Comm object
-  status = H5Pset_fapl_mpio(file_plist_id, comm, MPI_INFO_NULL);
-  AssertThrow(status >= 0, ExcIO());
-#    endif
-#  endif
+  const unsigned int local_node_cell_count[2] = {data_filter.n_nodes(),
+                                                 data_filter.n_cells()};
 
   // Compute the global total number of nodes/cells and determine the offset of
   // the data for this process
-
-  unsigned int global_node_cell_count[2] = {0, 0};
+  unsigned int global_node_cell_count[2]   = {0, 0};
   unsigned int global_node_cell_offsets[2] = {0, 0};
 
 #  ifdef DEAL_II_WITH_MPI
-  ierr = MPI_Allreduce(local_node_cell_count,
-                       global_node_cell_count,
-                       2,
-                       MPI_UNSIGNED,
-                       MPI_SUM,
-                       comm);
+  int ierr = MPI_Allreduce(local_node_cell_count,
+                           global_node_cell_count,
+                           2,
+                           MPI_UNSIGNED,
+                           MPI_SUM,
+                           comm);
   AssertThrowMPI(ierr);
   ierr = MPI_Exscan(local_node_cell_count,
                     global_node_cell_offsets,
@@ -7829,258 +8898,160 @@ DataOutBase::write_hdf5_parallel(
 #  else
   global_node_cell_count[0] = local_node_cell_count[0];
   global_node_cell_count[1] = local_node_cell_count[1];
-  global_node_cell_offsets[0] = global_node_cell_offsets[1] = 0;
-#  endif
-
-  // Create the property list for a collective write
-  plist_id = H5Pcreate(H5P_DATASET_XFER);
-  AssertThrow(plist_id >= 0, ExcIO());
-#  ifdef DEAL_II_WITH_MPI
-#    ifdef H5_HAVE_PARALLEL
-  status = H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
-  AssertThrow(status >= 0, ExcIO());
-#    endif
 #  endif
 
-  if (write_mesh_file)
-    {
-      // Overwrite any existing files (change this to an option?)
-      h5_mesh_file_id = H5Fcreate(mesh_filename.c_str(),
-                                  H5F_ACC_TRUNC,
-                                  H5P_DEFAULT,
-                                  file_plist_id);
-      AssertThrow(h5_mesh_file_id >= 0, ExcIO());
-
-      // Create the dataspace for the nodes and cells. HDF5 only supports 2- or
-      // 3-dimensional coordinates
-      node_ds_dim[0] = global_node_cell_count[0];
-      node_ds_dim[1] = (spacedim < 2) ? 2 : spacedim;
-      node_dataspace = H5Screate_simple(2, node_ds_dim, nullptr);
-      AssertThrow(node_dataspace >= 0, ExcIO());
+  reference_cell = patches[0].reference_cell;
 
-      cell_ds_dim[0] = global_node_cell_count[1];
-      cell_ds_dim[1] = patches[0].reference_cell.n_vertices();
-      cell_dataspace = H5Screate_simple(2, cell_ds_dim, nullptr);
-      AssertThrow(cell_dataspace >= 0, ExcIO());
+  const hid_t transfer_plist_id = create_hdf5_transfer_properties();
+  herr_t      status;
 
-      // Create the dataset for the nodes and cells
-#  if H5Gcreate_vers == 1
-      node_dataset = H5Dcreate(h5_mesh_file_id,
-                               "nodes",
-                               H5T_NATIVE_DOUBLE,
-                               node_dataspace,
-                               H5P_DEFAULT);
-#  else
-      node_dataset = H5Dcreate(h5_mesh_file_id,
-                               "nodes",
-                               H5T_NATIVE_DOUBLE,
-                               node_dataspace,
-                               H5P_DEFAULT,
-                               H5P_DEFAULT,
-                               H5P_DEFAULT);
-#  endif
-      AssertThrow(node_dataset >= 0, ExcIO());
+  // Only write the mesh if it has (or might have) changed since the last
+  // time step
+  if (n_meshes == 0 || mesh_changed ||
+      global_node_cell_count[0] != mesh_node_cell_count[0] ||
+      global_node_cell_count[1] != mesh_node_cell_count[1])
+    {
+      const std::string mesh_group_name =
+        "/mesh_" + Utilities::int_to_string(n_meshes);
 #  if H5Gcreate_vers == 1
-      cell_dataset = H5Dcreate(
-        h5_mesh_file_id, "cells", H5T_NATIVE_UINT, cell_dataspace, H5P_DEFAULT);
+      const hid_t mesh_group_id =
+        H5Gcreate(h5_file_id, mesh_group_name.c_str(), 0);
 #  else
-      cell_dataset = H5Dcreate(h5_mesh_file_id,
-                               "cells",
-                               H5T_NATIVE_UINT,
-                               cell_dataspace,
-                               H5P_DEFAULT,
-                               H5P_DEFAULT,
-                               H5P_DEFAULT);
+      const hid_t mesh_group_id = H5Gcreate(h5_file_id,
+                                            mesh_group_name.c_str(),
+                                            H5P_DEFAULT,
+                                            H5P_DEFAULT,
+                                            H5P_DEFAULT);
 #  endif
-      AssertThrow(cell_dataset >= 0, ExcIO());
-
-      // Close the node and cell dataspaces since we're done with them
-      status = H5Sclose(node_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Sclose(cell_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-
-      // Create the data subset we'll use to read from memory. HDF5 only
-      // supports 2- or 3-dimensional coordinates
-      count[0] = local_node_cell_count[0];
-      count[1] = (spacedim < 2) ? 2 : spacedim;
-
-      offset[0] = global_node_cell_offsets[0];
-      offset[1] = 0;
-
-      node_memory_dataspace = H5Screate_simple(2, count, nullptr);
-      AssertThrow(node_memory_dataspace >= 0, ExcIO());
-
-      // Select the hyperslab in the file
-      node_file_dataspace = H5Dget_space(node_dataset);
-      AssertThrow(node_file_dataspace >= 0, ExcIO());
-      status = H5Sselect_hyperslab(
-        node_file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
-      AssertThrow(status >= 0, ExcIO());
+      AssertThrow(mesh_group_id >= 0, ExcIO());
 
-      // And repeat for cells
-      count[0] = local_node_cell_count[1];
-      count[1] = patches[0].reference_cell.n_vertices();
-      offset[0] = global_node_cell_offsets[1];
-      offset[1] = 0;
-      cell_memory_dataspace = H5Screate_simple(2, count, nullptr);
-      AssertThrow(cell_memory_dataspace >= 0, ExcIO());
-
-      cell_file_dataspace = H5Dget_space(cell_dataset);
-      AssertThrow(cell_file_dataspace >= 0, ExcIO());
-      status = H5Sselect_hyperslab(
-        cell_file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
-      AssertThrow(status >= 0, ExcIO());
-
-      // And finally, write the node data
+      std::vector<double> node_data_vec;
       data_filter.fill_node_data(node_data_vec);
-      status = H5Dwrite(node_dataset,
-                        H5T_NATIVE_DOUBLE,
-                        node_memory_dataspace,
-                        node_file_dataspace,
-                        plist_id,
-                        node_data_vec.data());
-      AssertThrow(status >= 0, ExcIO());
+      write_hdf5_dataset(mesh_group_id,
+                         "nodes",
+                         H5T_NATIVE_DOUBLE,
+                         global_node_cell_count[0],
+                         spacedim,
+                         local_node_cell_count[0],
+                         global_node_cell_offsets[0],
+                         node_data_vec.data(),
+                         flags,
+                         transfer_plist_id);
       node_data_vec.clear();
 
-      // And the cell data
+      std::vector<unsigned int> cell_data_vec;
       data_filter.fill_cell_data(global_node_cell_offsets[0], cell_data_vec);
-      status = H5Dwrite(cell_dataset,
-                        H5T_NATIVE_UINT,
-                        cell_memory_dataspace,
-                        cell_file_dataspace,
-                        plist_id,
-                        cell_data_vec.data());
-      AssertThrow(status >= 0, ExcIO());
+      write_hdf5_dataset(mesh_group_id,
+                         "cells",
+                         H5T_NATIVE_UINT,
+                         global_node_cell_count[1],
+                         reference_cell.n_vertices(),
+                         local_node_cell_count[1],
+                         global_node_cell_offsets[1],
+                         cell_data_vec.data(),
+                         flags,
+                         transfer_plist_id);
       cell_data_vec.clear();
 
-      // Close the file dataspaces
-      status = H5Sclose(node_file_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Sclose(cell_file_dataspace);
+      status = H5Gclose(mesh_group_id);
       AssertThrow(status >= 0, ExcIO());
 
-      // Close the memory dataspaces
-      status = H5Sclose(node_memory_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Sclose(cell_memory_dataspace);
-      AssertThrow(status >= 0, ExcIO());
+      ++n_meshes;
+      mesh_node_cell_count[0] = global_node_cell_count[0];
+      mesh_node_cell_count[1] = global_node_cell_count[1];
+    }
 
-      // Close the datasets
-      status = H5Dclose(node_dataset);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Dclose(cell_dataset);
-      AssertThrow(status >= 0, ExcIO());
+  // Then write the data sets of this time step into a group of their own
+  const std::string step_group_name =
+    "/step_" + Utilities::int_to_string(n_steps);
+#  if H5Gcreate_vers == 1
+  const hid_t step_group_id = H5Gcreate(h5_file_id, step_group_name.c_str(), 0);
+#  else
+  const hid_t step_group_id = H5Gcreate(h5_file_id,
+                                        step_group_name.c_str(),
+                                        H5P_DEFAULT,
+                                        H5P_DEFAULT,
+                                        H5P_DEFAULT);
+#  endif
+  AssertThrow(step_group_id >= 0, ExcIO());
+
+  for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+    write_hdf5_dataset(step_group_id,
+                       data_filter.get_data_set_name(i),
+                       H5T_NATIVE_DOUBLE,
+                       global_node_cell_count[0],
+                       data_filter.get_data_set_dim(i),
+                       local_node_cell_count[0],
+                       global_node_cell_offsets[0],
+                       data_filter.get_data_set(i),
+                       flags,
+                       transfer_plist_id);
+
+  status = H5Gclose(step_group_id);
+  AssertThrow(status >= 0, ExcIO());
+  status = H5Pclose(transfer_plist_id);
+  AssertThrow(status >= 0, ExcIO());
 
-      // If the filenames are different, we need to close the mesh file
-      if (mesh_filename != solution_filename)
-        {
-          status = H5Fclose(h5_mesh_file_id);
-          AssertThrow(status >= 0, ExcIO());
-        }
-    }
+  // Make sure that the file is complete on disk, so that it can be read while
+  // the simulation continues
+  status = H5Fflush(h5_file_id, H5F_SCOPE_GLOBAL);
+  AssertThrow(status >= 0, ExcIO());
 
-  // If the filenames are identical, continue with the same file
-  if (mesh_filename == solution_filename && write_mesh_file)
-    {
-      h5_solution_file_id = h5_mesh_file_id;
-    }
-  else
-    {
-      // Otherwise we need to open a new file
-      h5_solution_file_id = H5Fcreate(solution_filename.c_str(),
-                                      H5F_ACC_TRUNC,
-                                      H5P_DEFAULT,
-                                      file_plist_id);
-      AssertThrow(h5_solution_file_id >= 0, ExcIO());
-    }
+  ++n_steps;
 
-  // when writing, first write out all vector data, then handle the scalar data
-  // sets that have been left over
-  unsigned int i;
-  std::string vector_name;
-  for (i = 0; i < data_filter.n_data_sets(); ++i)
+  // Finally, add an entry for this time step that references the current mesh
+  // and rewrite the XDMF file on the root process
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
     {
-      // Allocate space for the point data
-      // Must be either 1D or 3D
-      const unsigned int pt_data_vector_dim = data_filter.get_data_set_dim(i);
-      vector_name = data_filter.get_data_set_name(i);
+      XDMFEntry entry(h5_filename,
+                      h5_filename,
+                      time,
+                      global_node_cell_count[0],
+                      global_node_cell_count[1],
+                      dim,
+                      spacedim);
+      entry.set_hdf5_groups("/mesh_" + Utilities::int_to_string(n_meshes - 1),
+                            step_group_name);
+      for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+        entry.add_attribute(data_filter.get_data_set_name(i),
+                            data_filter.get_data_set_dim(i));
+      entries.push_back(entry);
 
-      // Create the dataspace for the point data
-      node_ds_dim[0] = global_node_cell_count[0];
-      node_ds_dim[1] = pt_data_vector_dim;
-      pt_data_dataspace = H5Screate_simple(2, node_ds_dim, nullptr);
-      AssertThrow(pt_data_dataspace >= 0, ExcIO());
+      std::ofstream xdmf_file(xdmf_filename);
 
-#  if H5Gcreate_vers == 1
-      pt_data_dataset = H5Dcreate(h5_solution_file_id,
-                                  vector_name.c_str(),
-                                  H5T_NATIVE_DOUBLE,
-                                  pt_data_dataspace,
-                                  H5P_DEFAULT);
-#  else
-      pt_data_dataset = H5Dcreate(h5_solution_file_id,
-                                  vector_name.c_str(),
-                                  H5T_NATIVE_DOUBLE,
-                                  pt_data_dataspace,
-                                  H5P_DEFAULT,
-                                  H5P_DEFAULT,
-                                  H5P_DEFAULT);
-#  endif
-      AssertThrow(pt_data_dataset >= 0, ExcIO());
-
-      // Create the data subset we'll use to read from memory
-      count[0] = local_node_cell_count[0];
-      count[1] = pt_data_vector_dim;
-      offset[0] = global_node_cell_offsets[0];
-      offset[1] = 0;
-      pt_data_memory_dataspace = H5Screate_simple(2, count, nullptr);
-      AssertThrow(pt_data_memory_dataspace >= 0, ExcIO());
-
-      // Select the hyperslab in the file
-      pt_data_file_dataspace = H5Dget_space(pt_data_dataset);
-      AssertThrow(pt_data_file_dataspace >= 0, ExcIO());
-      status = H5Sselect_hyperslab(pt_data_file_dataspace,
-                                   H5S_SELECT_SET,
-                                   offset,
-                                   nullptr,
-                                   count,
-                                   nullptr);
-      AssertThrow(status >= 0, ExcIO());
+      xdmf_file << "<?xml version=\"1.0\" ?>\n";
+      xdmf_file << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n";
+      xdmf_file << "<Xdmf Version=\"2.0\">\n";
+      xdmf_file << "  <Domain>\n";
+      xdmf_file
+        << "    <Grid Name=\"CellTime\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
 
-      // And finally, write the data
-      status = H5Dwrite(pt_data_dataset,
-                        H5T_NATIVE_DOUBLE,
-                        pt_data_memory_dataspace,
-                        pt_data_file_dataspace,
-                        plist_id,
-                        data_filter.get_data_set(i));
-      AssertThrow(status >= 0, ExcIO());
+      for (const XDMFEntry &e : entries)
+        xdmf_file << e.get_xdmf_content(3, reference_cell);
 
-      // Close the dataspaces
-      status = H5Sclose(pt_data_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Sclose(pt_data_memory_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      status = H5Sclose(pt_data_file_dataspace);
-      AssertThrow(status >= 0, ExcIO());
-      // Close the dataset
-      status = H5Dclose(pt_data_dataset);
-      AssertThrow(status >= 0, ExcIO());
+      xdmf_file << "    </Grid>\n";
+      xdmf_file << "  </Domain>\n";
+      xdmf_file << "</Xdmf>\n";
+
+      AssertThrow(xdmf_file, ExcIO());
     }
+#endif
+}
 
-  // Close the file property list
-  status = H5Pclose(file_plist_id);
-  AssertThrow(status >= 0, ExcIO());
 
-  // Close the parallel access
-  status = H5Pclose(plist_id);
-  AssertThrow(status >= 0, ExcIO());
 
-  // Close the file
-  status = H5Fclose(h5_solution_file_id);
-  AssertThrow(status >= 0, ExcIO());
-#endif
+const std::vector<XDMFEntry> &
+DataOutBase::Hdf5TimeSeriesWriter::get_xdmf_entries() const
+{
+  return entries;
+}
+
+
+
+unsigned int
+DataOutBase::Hdf5TimeSeriesWriter::n_meshes_written() const
+{
+  return n_meshes;
 }
 
 
@@ -8151,6 +9122,122 @@ DataOutInterface<dim, spacedim>::write(
 
 
 
+template <int dim, int spacedim>
+class DataOutInterface<dim, spacedim>::Snapshot
+  : public DataOutInterface<dim, spacedim>
+{
+public:
+  /**
+   * Constructor. Copy the output flags and the data returned by the virtual
+   * functions of @p source.
+   */
+  explicit Snapshot(const DataOutInterface<dim, spacedim> &source)
+    : DataOutInterface<dim, spacedim>(source)
+    , patches(source.get_patches())
+    , dataset_names(source.get_dataset_names())
+    , nonscalar_data_ranges(source.get_nonscalar_data_ranges())
+  {
+    // the copy constructor of the base class also copied the list of writes
+    // pending for the source object, which are none of our business
+    this->background_writes.clear();
+  }
+
+protected:
+  virtual const std::vector<DataOutBase::Patch<dim, spacedim>> &
+  get_patches() const override
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const override
+  {
+    return dataset_names;
+  }
+
+  virtual std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+  get_nonscalar_data_ranges() const override
+  {
+    return nonscalar_data_ranges;
+  }
+
+private:
+  const std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+  const std::vector<std::string>                       dataset_names;
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    nonscalar_data_ranges;
+};
+
+
+
+template <int dim, int spacedim>
+Threads::Task<void>
+DataOutInterface<dim, spacedim>::write_in_background(
+  const std::string &             filename,
+  const DataOutBase::OutputFormat output_format) const
+{
+  // make room for the new write by waiting for the oldest ones. remove each
+  // task from the list before joining it, so that an exception thrown by it
+  // does not leave it behind to be re-thrown a second time later on
+  while (background_writes.size() >= max_background_writes)
+    {
+      const Threads::Task<void> oldest_write = background_writes.front();
+      background_writes.pop_front();
+      oldest_write.join();
+    }
+
+  // take the snapshot on the calling thread, and only leave the encoding and
+  // writing of the data to the background task
+  const std::shared_ptr<const Snapshot> snapshot =
+    std::make_shared<const Snapshot>(*this);
+
+  const Threads::Task<void> write_task =
+    Threads::new_task([snapshot, filename, output_format]() {
+      std::ofstream out(filename);
+      AssertThrow(out, ExcFileNotOpen(filename));
+      snapshot->write(out, output_format);
+    });
+
+  background_writes.push_back(write_task);
+  return write_task;
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::wait_for_background_writes() const
+{
+  while (background_writes.empty() == false)
+    {
+      const Threads::Task<void> oldest_write = background_writes.front();
+      background_writes.pop_front();
+      oldest_write.join();
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::set_max_background_writes(
+  const unsigned int max_writes)
+{
+  Assert(max_writes > 0,
+         ExcMessage("At least one write must be allowed to be pending."));
+  max_background_writes = max_writes;
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::set_default_format(
@@ -8190,6 +9277,8 @@ DataOutInterface<dim, spacedim>::set_flags(const FlagType &flags)
   else if (typeid(flags) == typeid(deal_II_intermediate_flags))
     deal_II_intermediate_flags =
       *reinterpret_cast<const DataOutBase::Deal_II_IntermediateFlags *>(&flags);
+  else if (typeid(flags) == typeid(hdf5_flags))
+    hdf5_flags = *reinterpret_cast<const DataOutBase::Hdf5Flags *>(&flags);
   else
     Assert(false, ExcNotImplemented());
 }
@@ -8323,7 +9412,8 @@ DataOutInterface<dim, spacedim>::memory_consumption() const
           MemoryConsumption::memory_consumption(tecplot_flags) +
           MemoryConsumption::memory_consumption(vtk_flags) +
           MemoryConsumption::memory_consumption(svg_flags) +
-          MemoryConsumption::memory_consumption(deal_II_intermediate_flags));
+          MemoryConsumption::memory_consumption(deal_II_intermediate_flags) +
+          MemoryConsumption::memory_consumption(hdf5_flags));
 }
 
 
@@ -8610,6 +9700,8 @@ XDMFEntry::XDMFEntry()
   : valid(false)
   , h5_sol_filename("")
   , h5_mesh_filename("")
+  , h5_sol_group("")
+  , h5_mesh_group("")
   , entry_time(0.0)
   , num_nodes(numbers::invalid_unsigned_int)
   , num_cells(numbers::invalid_unsigned_int)
@@ -8650,6 +9742,8 @@ XDMFEntry::XDMFEntry(const std::string &mesh_filename,
   : valid(true)
   , h5_sol_filename(solution_filename)
   , h5_mesh_filename(mesh_filename)
+  , h5_sol_group("")
+  , h5_mesh_group("")
   , entry_time(time)
   , num_nodes(nodes)
   , num_cells(cells)
@@ -8668,6 +9762,16 @@ XDMFEntry::add_attribute(const std::string &attr_name,
 
 
 
+void
+XDMFEntry::set_hdf5_groups(const std::string &mesh_group,
+                           const std::string &solution_group)
+{
+  h5_mesh_group = mesh_group;
+  h5_sol_group  = solution_group;
+}
+
+
+
 namespace
 {
   /**
@@ -8727,7 +9831,8 @@ XDMFEntry::get_xdmf_content(const unsigned int   indent_level,
   ss << indent(indent_level + 2) << "<DataItem Dimensions=\"" << num_nodes
      << " " << (space_dimension <= 2 ? 2 : space_dimension)
      << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
-  ss << indent(indent_level + 3) << h5_mesh_filename << ":/nodes\n";
+  ss << indent(indent_level + 3) << h5_mesh_filename << ':' << h5_mesh_group
+     << "/nodes\n";
   ss << indent(indent_level + 2) << "</DataItem>\n";
   ss << indent(indent_level + 1) << "</Geometry>\n";
   // If we have cells defined, use the topology corresponding to the dimension
@@ -8789,7 +9894,8 @@ XDMFEntry::get_xdmf_content(const unsigned int   indent_level,
         }
 
       ss << "\" NumberType=\"UInt\" Format=\"HDF\">\n";
-      ss << indent(indent_level + 3) << h5_mesh_filename << ":/cells\n";
+      ss << indent(indent_level + 3) << h5_mesh_filename << ':'
+         << h5_mesh_group << "/cells\n";
       ss << indent(indent_level + 2) << "</DataItem>\n";
       ss << indent(indent_level + 1) << "</Topology>\n";
     }
@@ -8813,8 +9919,8 @@ XDMFEntry::get_xdmf_content(const unsigned int   indent_level,
       ss << indent(indent_level + 2) << "<DataItem Dimensions=\"" << num_nodes
          << " " << (attribute_dim.second > 1 ? 3 : 1)
          << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
-      ss << indent(indent_level + 3) << h5_sol_filename << ":/"
-         << attribute_dim.first << "\n";
+      ss << indent(indent_level + 3) << h5_sol_filename << ':'
+         << h5_sol_group << '/' << attribute_dim.first << "\n";
       ss << indent(indent_level + 2) << "</DataItem>\n";
       ss << indent(indent_level + 1) << "</Attribute>\n";
     }
@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/partitioner.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/types.h>
@@ -2249,6 +2250,57 @@ namespace DoFRenumbering
            ExcInternalError());
   }
 
+
+
+  namespace internal
+  {
+    void
+    compute_matrix_free_data_locality(
+      std::vector<types::global_dof_index> &new_dof_indices,
+      const Utilities::MPI::Partitioner &   partitioner,
+      const std::vector<unsigned int> &     dof_indices_in_loop_order)
+    {
+      const unsigned int n_owned = partitioner.locally_owned_size();
+      const types::global_dof_index first_owned =
+        partitioner.local_range().first;
+
+      // mark the locally owned dofs that are ghosts on other processes,
+      // they get numbered first
+      std::vector<bool> is_shared(n_owned, false);
+      for (const auto &range : partitioner.import_indices())
+        for (unsigned int i = range.first; i < range.second; ++i)
+          is_shared[i] = true;
+
+      // go through the dofs in the order of the cell loop and record the
+      // first access to each owned dof; ghost entries (with local indices
+      // beyond the owned range) are owned by other processes and skipped
+      std::vector<unsigned int> shared_dofs, other_dofs;
+      std::vector<bool>         touched(n_owned, false);
+      other_dofs.reserve(n_owned);
+      for (const unsigned int i : dof_indices_in_loop_order)
+        if (i < n_owned && touched[i] == false)
+          {
+            touched[i] = true;
+            if (is_shared[i])
+              shared_dofs.push_back(i);
+            else
+              other_dofs.push_back(i);
+          }
+
+      new_dof_indices.resize(n_owned);
+      types::global_dof_index next_free_index = first_owned;
+      for (const unsigned int i : shared_dofs)
+        new_dof_indices[i] = next_free_index++;
+      for (const unsigned int i : other_dofs)
+        new_dof_indices[i] = next_free_index++;
+      for (unsigned int i = 0; i < n_owned; ++i)
+        if (touched[i] == false)
+          new_dof_indices[i] = next_free_index++;
+
+      Assert(next_free_index == first_owned + n_owned, ExcInternalError());
+    }
+  } // namespace internal
+
 } // namespace DoFRenumbering
 
 
@@ -15,14 +15,18 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/utilities.h>
 
+#include <deal.II/grid/cell_id.h>
 #include <deal.II/grid/grid_in.h>
 #include <deal.II/grid/grid_reordering.h>
 #include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/reference_cell.h>
 #include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/io/ios_state.hpp>
@@ -36,9 +40,13 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
 
 #ifdef DEAL_II_WITH_ASSIMP
 #  include <assimp/Importer.hpp>  // C++ importer interface
@@ -615,6 +623,402 @@ GridIn<dim, spacedim>::read_vtu(std::istream &in)
 }
 
 
+
+namespace
+{
+  /**
+   * Read an array of POD values as written by GridOut::write_binary(),
+   * including the padding that aligns the following array to eight bytes.
+   */
+  template <typename T>
+  void
+  read_binary_array(std::istream &in, std::vector<T> &values)
+  {
+    const std::size_t n_bytes = values.size() * sizeof(T);
+    in.read(reinterpret_cast<char *>(values.data()), n_bytes);
+    in.ignore((8 - n_bytes % 8) % 8);
+    AssertThrow(in, ExcIO());
+  }
+
+
+
+  /**
+   * Read the header of the binary triangulation format, see
+   * GridOut::write_binary() for the layout. Return the global number of
+   * vertices and cells and the offsets of the sections. The offsets are
+   * converted into positions in the stream.
+   */
+  template <int dim, int spacedim>
+  void
+  read_binary_header(std::istream &               in,
+                     std::uint64_t &              n_vertices,
+                     std::uint64_t &              n_cells,
+                     std::vector<std::streamoff> &section_offsets)
+  {
+    AssertThrow(in, ExcIO());
+    const std::streamoff start = in.tellg();
+
+    // the magic string and version number have to match the ones used in
+    // GridOut::write_binary()
+    char magic[8];
+    in.read(magic, 8);
+    AssertThrow(in && std::string(magic, 8) == "dealtria",
+                ExcMessage("The input is not a triangulation written by "
+                           "GridOut::write_binary()."));
+
+    std::uint32_t header[4];
+    in.read(reinterpret_cast<char *>(header), sizeof(header));
+    AssertThrow(in, ExcIO());
+    AssertThrow(header[0] == 2,
+                ExcMessage("Unsupported version " + std::to_string(header[0]) +
+                           " of the binary triangulation format."));
+    AssertThrow(header[1] == 0x01020304,
+                ExcMessage("The binary triangulation file was written on a "
+                           "machine with a different byte order."));
+    AssertThrow(header[2] == dim && header[3] == spacedim,
+                ExcMessage("The binary triangulation file was written for "
+                           "dim=" +
+                           std::to_string(header[2]) +
+                           ", spacedim=" + std::to_string(header[3]) +
+                           ", but is read into a Triangulation<" +
+                           std::to_string(dim) + "," +
+                           std::to_string(spacedim) + ">."));
+
+    std::vector<std::uint64_t> sizes(3);
+    read_binary_array(in, sizes);
+    n_vertices = sizes[0];
+    n_cells    = sizes[1];
+
+    std::vector<std::uint64_t> offsets(sizes[2] + 1);
+    read_binary_array(in, offsets);
+    section_offsets.resize(offsets.size());
+    for (unsigned int p = 0; p < offsets.size(); ++p)
+      {
+        AssertThrow(p == 0 || offsets[p - 1] <= offsets[p],
+                    ExcMessage("The binary triangulation file is corrupted."));
+        section_offsets[p] = start + offsets[p];
+      }
+  }
+
+
+
+  /**
+   * One section of the binary triangulation format, see
+   * GridOut::write_binary() for the meaning of the arrays.
+   */
+  template <int dim>
+  struct BinarySection
+  {
+    static constexpr unsigned int lines_per_cell =
+      dim >= 2 ? GeometryInfo<dim>::lines_per_cell : 0;
+    static constexpr unsigned int line_boundary_ids_per_cell =
+      dim == 3 ? GeometryInfo<dim>::lines_per_cell : 0;
+    static constexpr unsigned int quads_per_cell =
+      dim == 3 ? GeometryInfo<dim>::faces_per_cell : 0;
+
+    /**
+     * Seek to the section starting at @p offset and read it with one bulk
+     * read per array.
+     */
+    void
+    read(std::istream &       in,
+         const std::streamoff offset,
+         const unsigned int   spacedim,
+         const std::uint64_t  n_global_vertices,
+         const std::uint64_t  n_global_cells)
+    {
+      in.seekg(offset);
+      AssertThrow(in, ExcIO());
+
+      std::vector<std::uint64_t> sizes(3);
+      read_binary_array(in, sizes);
+      const std::uint64_t n_vertices = sizes[0];
+      const std::uint64_t n_cells    = sizes[1];
+
+      vertex_ids.resize(n_vertices);
+      coordinates.resize(n_vertices * spacedim);
+      offsets.resize(n_cells + 1);
+      vertex_indices.resize(sizes[2]);
+      cell_ids.resize(n_cells);
+      subdomain_ids.resize(n_cells);
+      material_ids.resize(n_cells);
+      manifold_ids.resize(n_cells);
+      face_boundary_ids.resize(n_cells * GeometryInfo<dim>::faces_per_cell);
+      line_boundary_ids.resize(n_cells * line_boundary_ids_per_cell);
+      line_manifold_ids.resize(n_cells * lines_per_cell);
+      quad_manifold_ids.resize(n_cells * quads_per_cell);
+
+      read_binary_array(in, vertex_ids);
+      read_binary_array(in, coordinates);
+      read_binary_array(in, offsets);
+      read_binary_array(in, vertex_indices);
+      read_binary_array(in, cell_ids);
+      read_binary_array(in, subdomain_ids);
+      read_binary_array(in, material_ids);
+      read_binary_array(in, manifold_ids);
+      read_binary_array(in, face_boundary_ids);
+      read_binary_array(in, line_boundary_ids);
+      read_binary_array(in, line_manifold_ids);
+      read_binary_array(in, quad_manifold_ids);
+
+      // only check what is needed to not access memory out of bounds
+      AssertThrow(offsets[0] == 0 && offsets.back() == vertex_indices.size(),
+                  ExcMessage("The binary triangulation file is corrupted."));
+      for (std::uint64_t c = 0; c < n_cells; ++c)
+        AssertThrow(offsets[c] <= offsets[c + 1] &&
+                      cell_ids[c] < n_global_cells,
+                    ExcMessage("The binary triangulation file is corrupted."));
+      for (const std::uint32_t v : vertex_indices)
+        AssertThrow(v < n_vertices,
+                    ExcMessage("The binary triangulation file is corrupted."));
+      for (const std::uint64_t v : vertex_ids)
+        AssertThrow(v < n_global_vertices,
+                    ExcMessage("The binary triangulation file is corrupted."));
+    }
+
+    /**
+     * Return the CellData object of cell @p c, with the vertex indices
+     * local to the section.
+     */
+    CellData<dim>
+    cell_data(const std::uint64_t c) const
+    {
+      CellData<dim> cell(offsets[c + 1] - offsets[c]);
+      std::copy(vertex_indices.begin() + offsets[c],
+                vertex_indices.begin() + offsets[c + 1],
+                cell.vertices.begin());
+      cell.material_id = material_ids[c];
+      cell.manifold_id = manifold_ids[c];
+      return cell;
+    }
+
+    std::vector<std::uint64_t> vertex_ids;
+    std::vector<double>        coordinates;
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint32_t> vertex_indices;
+    std::vector<std::uint64_t> cell_ids;
+    std::vector<std::uint32_t> subdomain_ids;
+    std::vector<std::uint32_t> material_ids;
+    std::vector<std::uint32_t> manifold_ids;
+    std::vector<std::uint32_t> face_boundary_ids;
+    std::vector<std::uint32_t> line_boundary_ids;
+    std::vector<std::uint32_t> line_manifold_ids;
+    std::vector<std::uint32_t> quad_manifold_ids;
+  };
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_binary(std::istream &in)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+
+  std::uint64_t               n_vertices, n_cells;
+  std::vector<std::streamoff> section_offsets;
+  read_binary_header<dim, spacedim>(in, n_vertices, n_cells, section_offsets);
+
+  // every cell is owned by exactly one section; collect the owned cells of
+  // all sections at the position given by their coarse cell id, which is
+  // also their index in the file
+  std::vector<Point<spacedim>> vertices(n_vertices);
+  std::vector<CellData<dim>>   cells(n_cells);
+  std::vector<std::uint32_t>   subdomain_ids(n_cells);
+  std::vector<std::uint32_t>   face_boundary_ids(
+    n_cells * GeometryInfo<dim>::faces_per_cell);
+  std::vector<std::uint32_t> line_boundary_ids(
+    n_cells * BinarySection<dim>::line_boundary_ids_per_cell);
+  std::vector<std::uint32_t> line_manifold_ids(
+    n_cells * BinarySection<dim>::lines_per_cell);
+  std::vector<std::uint32_t> quad_manifold_ids(
+    n_cells * BinarySection<dim>::quads_per_cell);
+  std::uint64_t n_read_cells = 0;
+
+  const auto copy_entries = [](const std::vector<std::uint32_t> &source,
+                               const std::uint64_t               source_cell,
+                               std::vector<std::uint32_t> &      target,
+                               const std::uint64_t               target_cell,
+                               const unsigned int                n_per_cell) {
+    std::copy(source.begin() + source_cell * n_per_cell,
+              source.begin() + (source_cell + 1) * n_per_cell,
+              target.begin() + target_cell * n_per_cell);
+  };
+
+  BinarySection<dim> section;
+  for (unsigned int p = 0; p + 1 < section_offsets.size(); ++p)
+    {
+      section.read(in, section_offsets[p], spacedim, n_vertices, n_cells);
+
+      for (std::uint64_t v = 0; v < section.vertex_ids.size(); ++v)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          vertices[section.vertex_ids[v]][d] =
+            section.coordinates[v * spacedim + d];
+
+      for (std::uint64_t c = 0; c < section.cell_ids.size(); ++c)
+        if (section.subdomain_ids[c] == p)
+          {
+            const std::uint64_t cell_id = section.cell_ids[c];
+            cells[cell_id]              = section.cell_data(c);
+            for (unsigned int &v : cells[cell_id].vertices)
+              v = section.vertex_ids[v];
+            subdomain_ids[cell_id] = p;
+
+            copy_entries(section.face_boundary_ids,
+                         c,
+                         face_boundary_ids,
+                         cell_id,
+                         GeometryInfo<dim>::faces_per_cell);
+            copy_entries(section.line_boundary_ids,
+                         c,
+                         line_boundary_ids,
+                         cell_id,
+                         BinarySection<dim>::line_boundary_ids_per_cell);
+            copy_entries(section.line_manifold_ids,
+                         c,
+                         line_manifold_ids,
+                         cell_id,
+                         BinarySection<dim>::lines_per_cell);
+            copy_entries(section.quad_manifold_ids,
+                         c,
+                         quad_manifold_ids,
+                         cell_id,
+                         BinarySection<dim>::quads_per_cell);
+            ++n_read_cells;
+          }
+    }
+  AssertThrow(n_read_cells == n_cells,
+              ExcMessage("The binary triangulation file is corrupted."));
+
+  tria->create_triangulation(vertices, cells, SubCellData());
+
+  // the cells of the new triangulation are in the order in which they were
+  // passed in. set their subdomain ids and the ids of their faces and
+  // edges, which include the boundary ids of vertices in 1d
+  for (const auto &cell : tria->active_cell_iterators())
+    {
+      const unsigned int c = cell->active_cell_index();
+      cell->set_subdomain_id(subdomain_ids[c]);
+      for (const unsigned int f : cell->face_indices())
+        {
+          const types::boundary_id boundary_id =
+            face_boundary_ids[c * GeometryInfo<dim>::faces_per_cell + f];
+          if (boundary_id != numbers::internal_face_boundary_id)
+            cell->face(f)->set_boundary_id(boundary_id);
+        }
+
+      if (dim == 3)
+        for (const unsigned int l : cell->line_indices())
+          {
+            const types::boundary_id boundary_id = line_boundary_ids
+              [c * BinarySection<dim>::line_boundary_ids_per_cell + l];
+            if (boundary_id != numbers::internal_face_boundary_id)
+              cell->line(l)->set_boundary_id(boundary_id);
+          }
+
+      if (dim >= 2)
+        for (const unsigned int l : cell->line_indices())
+          cell->line(l)->set_manifold_id(
+            line_manifold_ids[c * BinarySection<dim>::lines_per_cell + l]);
+
+      if (dim == 3)
+        for (const unsigned int f : cell->face_indices())
+          cell->quad(f)->set_manifold_id(
+            quad_manifold_ids[c * BinarySection<dim>::quads_per_cell + f]);
+    }
+}
+
+
+
+template <int dim, int spacedim>
+TriangulationDescription::Description<dim, spacedim>
+GridIn<dim, spacedim>::read_binary_description(const MPI_Comm &   comm,
+                                               const std::string &filename,
+                                               const unsigned int my_rank_in)
+{
+  std::ifstream in(filename, std::ios::binary);
+  AssertThrow(in, ExcFileNotOpen(filename));
+
+  std::uint64_t               n_vertices, n_cells;
+  std::vector<std::streamoff> section_offsets;
+  read_binary_header<dim, spacedim>(in, n_vertices, n_cells, section_offsets);
+
+  const unsigned int n_sections = section_offsets.size() - 1;
+  unsigned int       my_rank    = my_rank_in;
+  if (my_rank_in == numbers::invalid_unsigned_int)
+    {
+      AssertThrow(n_sections == Utilities::MPI::n_mpi_processes(comm),
+                  ExcMessage("The binary triangulation file contains " +
+                             std::to_string(n_sections) +
+                             " sections, but the communicator has " +
+                             std::to_string(
+                               Utilities::MPI::n_mpi_processes(comm)) +
+                             " processes."));
+      my_rank = Utilities::MPI::this_mpi_process(comm);
+    }
+  AssertThrow(my_rank < n_sections, ExcIndexRange(my_rank, 0, n_sections));
+
+  // only the section of this process is read, and its arrays are already
+  // in the layout of the description: the cells are sorted by their coarse
+  // cell id and the vertices by their global index
+  BinarySection<dim> section;
+  section.read(in, section_offsets[my_rank], spacedim, n_vertices, n_cells);
+
+  TriangulationDescription::Description<dim, spacedim> description;
+  description.comm      = comm;
+  description.settings  = TriangulationDescription::default_setting;
+  description.smoothing = Triangulation<dim, spacedim>::none;
+
+  description.coarse_cell_vertices.resize(section.vertex_ids.size());
+  for (std::uint64_t v = 0; v < section.vertex_ids.size(); ++v)
+    for (unsigned int d = 0; d < spacedim; ++d)
+      description.coarse_cell_vertices[v][d] =
+        section.coordinates[v * spacedim + d];
+
+  const std::uint64_t n_local_cells = section.cell_ids.size();
+  description.coarse_cells.resize(n_local_cells);
+  description.coarse_cell_index_to_coarse_cell_id.resize(n_local_cells);
+  description.cell_infos.resize(1);
+  description.cell_infos[0].resize(n_local_cells);
+  for (std::uint64_t c = 0; c < n_local_cells; ++c)
+    {
+      description.coarse_cells[c] = section.cell_data(c);
+      description.coarse_cell_index_to_coarse_cell_id[c] = section.cell_ids[c];
+
+      auto &cell_info = description.cell_infos[0][c];
+
+      cell_info.id = CellId(section.cell_ids[c], std::vector<std::uint8_t>())
+                       .template to_binary<dim>();
+
+      cell_info.subdomain_id       = section.subdomain_ids[c];
+      cell_info.level_subdomain_id = section.subdomain_ids[c];
+      cell_info.manifold_id        = section.manifold_ids[c];
+
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        {
+          const types::boundary_id boundary_id =
+            section.face_boundary_ids[c * GeometryInfo<dim>::faces_per_cell +
+                                      f];
+          if (boundary_id != numbers::internal_face_boundary_id)
+            cell_info.boundary_ids.emplace_back(f, boundary_id);
+        }
+
+      if (dim >= 2)
+        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+          cell_info.manifold_line_ids[l] =
+            section.line_manifold_ids[c * BinarySection<dim>::lines_per_cell +
+                                      l];
+      if (dim == 3)
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          cell_info.manifold_quad_ids[f] =
+            section.quad_manifold_ids[c * BinarySection<dim>::quads_per_cell +
+                                      f];
+    }
+
+  return description;
+}
+
+
 template <int dim, int spacedim>
 void
 GridIn<dim, spacedim>::read_unv(std::istream &in)
@@ -2118,6 +2522,725 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
 
 
+namespace
+{
+  /**
+   * Number of nodes of the Gmsh element types that can be read by
+   * GridIn::read_msh_distributed(), or zero for all other element types.
+   */
+  unsigned int
+  msh_element_n_nodes(const int element_type)
+  {
+    switch (element_type)
+      {
+        case 15: // point
+          return 1;
+        case 1: // line
+          return 2;
+        case 2: // triangle
+          return 3;
+        case 3: // quadrilateral
+          return 4;
+        case 4: // tetrahedron
+          return 4;
+        case 5: // hexahedron
+          return 8;
+        default:
+          return 0;
+      }
+  }
+
+
+
+  /**
+   * Skip @p n_lines lines of @p in and return the byte offsets of the lines
+   * with the (sorted) indices given in @p lines_to_record, counted from the
+   * current position.
+   */
+  std::vector<std::int64_t>
+  skip_msh_lines(std::istream &                    in,
+                 const std::uint64_t               n_lines,
+                 const std::vector<std::uint64_t> &lines_to_record)
+  {
+    std::vector<std::int64_t> offsets;
+    offsets.reserve(lines_to_record.size());
+
+    std::string line;
+    auto        next = lines_to_record.begin();
+    for (std::uint64_t l = 0; l < n_lines; ++l)
+      {
+        if (next != lines_to_record.end() && *next == l)
+          {
+            offsets.push_back(in.tellg());
+            ++next;
+          }
+        std::getline(in, line);
+      }
+    AssertThrow(in, ExcIO());
+    AssertDimension(offsets.size(), lines_to_record.size());
+
+    return offsets;
+  }
+
+
+
+  /**
+   * Split the concatenation of blocks of the given sizes into @p n_ranks
+   * contiguous ranges of (almost) equal size. Return a list of pieces,
+   * each given by the rank it belongs to, the block, and the first entry
+   * and number of entries within that block.
+   */
+  std::vector<std::array<std::uint64_t, 4>>
+  split_msh_blocks(const std::vector<std::uint64_t> &block_sizes,
+                   const unsigned int                n_ranks)
+  {
+    const std::uint64_t n_total =
+      std::accumulate(block_sizes.begin(), block_sizes.end(), std::uint64_t(0));
+    const auto range_begin = [&](const std::uint64_t rank) {
+      return rank * n_total / n_ranks;
+    };
+
+    std::vector<std::array<std::uint64_t, 4>> pieces;
+    std::uint64_t                             block_begin = 0;
+    for (std::uint64_t block = 0; block < block_sizes.size(); ++block)
+      {
+        const std::uint64_t block_end = block_begin + block_sizes[block];
+        for (std::uint64_t rank = 0; rank < n_ranks; ++rank)
+          {
+            const std::uint64_t begin =
+              std::max(range_begin(rank), block_begin);
+            const std::uint64_t end = std::min(range_begin(rank + 1), block_end);
+            if (end > begin)
+              pieces.push_back({{rank, block, begin - block_begin, end - begin}});
+          }
+        block_begin = block_end;
+      }
+    return pieces;
+  }
+
+
+
+  /**
+   * Scan a Gmsh file in format 4.1 and determine, for each of @p n_ranks
+   * processes, which parts of the file it should read. The result for each
+   * rank is encoded as a flat vector of integers that contains the coarse
+   * cell id of the first cell of that rank, the smallest and largest node
+   * tags, a list of node segments (byte offset of the first tag, byte offset
+   * of the first coordinate line, number of nodes), and a list of element
+   * segments (byte offset, number of elements, dimension of the entity,
+   * element type, physical tag of the entity).
+   */
+  template <int dim>
+  std::vector<std::vector<std::int64_t>>
+  scan_msh_for_distributed_read(const std::string &filename,
+                                const unsigned int n_ranks)
+  {
+    using ExcInvalidGMSHInput = typename GridIn<dim>::ExcInvalidGMSHInput;
+    using ExcGmshUnsupportedGeometry =
+      typename GridIn<dim>::ExcGmshUnsupportedGeometry;
+    using ExcGmshNoCellInformation =
+      typename GridIn<dim>::ExcGmshNoCellInformation;
+
+    std::ifstream in(filename);
+    AssertThrow(in, ExcFileNotOpen(filename));
+
+    std::string line;
+    std::getline(in, line);
+    AssertThrow(line.compare(0, 11, "$MeshFormat") == 0,
+                ExcMessage("The file <" + filename +
+                           "> is not a Gmsh mesh file."));
+    {
+      std::getline(in, line);
+      std::istringstream header(line);
+      double             version;
+      unsigned int       file_type, data_size;
+      header >> version >> file_type >> data_size;
+      AssertThrow(header && version == 4.1 && file_type == 0 &&
+                    data_size == sizeof(double),
+                  ExcMessage("Only ASCII files in version 4.1 of the Gmsh "
+                             "file format can be read in parallel."));
+    }
+
+    // maps from the entities of each dimension to their physical tags,
+    // followed by the header of the $Nodes section
+    std::array<std::map<int, int>, 4> tag_maps;
+    while (std::getline(in, line) && line.compare(0, 6, "$Nodes") != 0)
+      if (line.compare(0, 9, "$Entities") == 0)
+        {
+          std::getline(in, line);
+          std::istringstream counts(line);
+          std::uint64_t      n_entities[4];
+          counts >> n_entities[0] >> n_entities[1] >> n_entities[2] >>
+            n_entities[3];
+          for (unsigned int d = 0; d < 4; ++d)
+            for (std::uint64_t e = 0; e < n_entities[d]; ++e)
+              {
+                std::getline(in, line);
+                std::istringstream entity(line);
+                int                tag;
+                double             bounding_box;
+                entity >> tag;
+                for (unsigned int i = 0; i < (d == 0 ? 3 : 6); ++i)
+                  entity >> bounding_box;
+                unsigned int n_physicals = 0;
+                int          physical_tag = 0;
+                entity >> n_physicals;
+                AssertThrow(n_physicals < 2,
+                            ExcMessage("More than one tag is not supported!"));
+                if (n_physicals == 1)
+                  entity >> physical_tag;
+                AssertThrow(entity, ExcInvalidGMSHInput(line));
+                tag_maps[d][tag] = physical_tag;
+              }
+        }
+    AssertThrow(in, ExcMessage("The file <" + filename +
+                               "> does not contain a $Nodes section."));
+
+    std::vector<std::vector<std::int64_t>> node_segments(n_ranks);
+    std::int64_t                           min_node_tag, max_node_tag;
+    {
+      std::getline(in, line);
+      std::istringstream header(line);
+      std::uint64_t      n_blocks, n_nodes;
+      header >> n_blocks >> n_nodes >> min_node_tag >> max_node_tag;
+      AssertThrow(header, ExcInvalidGMSHInput(line));
+
+      // the total number of nodes is known here, so that the nodes can be
+      // split among the processes while reading through the section once
+      std::uint64_t first_node = 0;
+      for (std::uint64_t block = 0; block < n_blocks; ++block)
+        {
+          std::getline(in, line);
+          std::istringstream block_header(line);
+          int                entity_dim, entity_tag, parametric;
+          std::uint64_t      n_block_nodes;
+          block_header >> entity_dim >> entity_tag >> parametric >>
+            n_block_nodes;
+          AssertThrow(block_header, ExcInvalidGMSHInput(line));
+
+          // the pieces of the ranks that overlap with this block, which is
+          // the middle one of the following three
+          std::vector<std::array<std::uint64_t, 4>> pieces;
+          for (const auto &piece :
+               split_msh_blocks({first_node,
+                                 n_block_nodes,
+                                 n_nodes - first_node - n_block_nodes},
+                                n_ranks))
+            if (piece[1] == 1)
+              pieces.push_back(piece);
+
+          std::vector<std::uint64_t> lines_to_record;
+          for (const auto &piece : pieces)
+            lines_to_record.push_back(piece[2]);
+
+          const auto tag_offsets =
+            skip_msh_lines(in, n_block_nodes, lines_to_record);
+          const auto coordinate_offsets =
+            skip_msh_lines(in, n_block_nodes, lines_to_record);
+
+          for (unsigned int p = 0; p < pieces.size(); ++p)
+            {
+              auto &segments = node_segments[pieces[p][0]];
+              segments.push_back(tag_offsets[p]);
+              segments.push_back(coordinate_offsets[p]);
+              segments.push_back(pieces[p][3]);
+            }
+          first_node += n_block_nodes;
+        }
+      AssertDimension(first_node, n_nodes);
+
+      std::getline(in, line);
+      AssertThrow(line.compare(0, 9, "$EndNodes") == 0,
+                  ExcInvalidGMSHInput(line));
+      std::getline(in, line);
+      AssertThrow(line.compare(0, 9, "$Elements") == 0,
+                  ExcInvalidGMSHInput(line));
+    }
+
+    // In contrast to the nodes, the number of cells is only known after
+    // reading the whole section, since it also contains lower-dimensional
+    // elements. Record the blocks first and split them afterwards.
+    struct ElementBlock
+    {
+      std::int64_t offset;
+      std::int64_t entity_dim;
+      std::int64_t element_type;
+      std::int64_t physical_tag;
+    };
+    std::vector<ElementBlock>  cell_blocks, face_blocks;
+    std::vector<std::uint64_t> cell_block_sizes, face_block_sizes;
+    {
+      std::getline(in, line);
+      std::istringstream header(line);
+      std::uint64_t      n_blocks, n_elements;
+      header >> n_blocks >> n_elements;
+      AssertThrow(header, ExcInvalidGMSHInput(line));
+
+      for (std::uint64_t block = 0; block < n_blocks; ++block)
+        {
+          std::getline(in, line);
+          std::istringstream block_header(line);
+          int                entity_dim, entity_tag, element_type;
+          std::uint64_t      n_block_elements;
+          block_header >> entity_dim >> entity_tag >> element_type >>
+            n_block_elements;
+          AssertThrow(block_header && entity_dim >= 0 && entity_dim <= 3,
+                      ExcInvalidGMSHInput(line));
+
+          const ElementBlock element_block = {in.tellg(),
+                                              entity_dim,
+                                              element_type,
+                                              tag_maps[entity_dim][entity_tag]};
+          if (entity_dim == dim)
+            {
+              AssertThrow(msh_element_n_nodes(element_type) > 1,
+                          ExcGmshUnsupportedGeometry(element_type));
+              cell_blocks.push_back(element_block);
+              cell_block_sizes.push_back(n_block_elements);
+            }
+          else if (entity_dim == dim - 1 &&
+                   msh_element_n_nodes(element_type) > 0 &&
+                   element_block.physical_tag != 0)
+            {
+              face_blocks.push_back(element_block);
+              face_block_sizes.push_back(n_block_elements);
+            }
+
+          skip_msh_lines(in, n_block_elements, {});
+        }
+
+      std::getline(in, line);
+      AssertThrow(line.compare(0, 12, "$EndElements") == 0,
+                  ExcInvalidGMSHInput(line));
+    }
+
+    std::vector<std::vector<std::int64_t>> element_segments(n_ranks);
+    const auto add_element_segments =
+      [&](const std::vector<ElementBlock> & blocks,
+          const std::vector<std::uint64_t> &block_sizes) {
+        const auto pieces = split_msh_blocks(block_sizes, n_ranks);
+        for (auto piece = pieces.begin(); piece != pieces.end();)
+          {
+            // all pieces of one block are adjacent, find them in one pass
+            const std::uint64_t block = (*piece)[1];
+            const auto          end_of_block =
+              std::find_if(piece, pieces.end(), [&](const auto &p) {
+                return p[1] != block;
+              });
+
+            std::vector<std::uint64_t> lines_to_record;
+            for (auto p = piece; p != end_of_block; ++p)
+              lines_to_record.push_back((*p)[2]);
+
+            in.clear();
+            in.seekg(blocks[block].offset);
+            const auto offsets =
+              skip_msh_lines(in, lines_to_record.back() + 1, lines_to_record);
+
+            for (unsigned int i = 0; piece != end_of_block; ++piece, ++i)
+              {
+                auto &segments = element_segments[(*piece)[0]];
+                segments.push_back(offsets[i]);
+                segments.push_back((*piece)[3]);
+                segments.push_back(blocks[block].entity_dim);
+                segments.push_back(blocks[block].element_type);
+                segments.push_back(blocks[block].physical_tag);
+              }
+          }
+      };
+    add_element_segments(cell_blocks, cell_block_sizes);
+    add_element_segments(face_blocks, face_block_sizes);
+
+    const std::uint64_t n_cells = std::accumulate(cell_block_sizes.begin(),
+                                                  cell_block_sizes.end(),
+                                                  std::uint64_t(0));
+    AssertThrow(n_cells > 0, ExcGmshNoCellInformation());
+
+    std::vector<std::vector<std::int64_t>> messages(n_ranks);
+    for (unsigned int rank = 0; rank < n_ranks; ++rank)
+      {
+        auto &message = messages[rank];
+        message.push_back(rank * n_cells / n_ranks);
+        message.push_back(min_node_tag);
+        message.push_back(max_node_tag);
+        message.push_back(node_segments[rank].size() / 3);
+        message.insert(message.end(),
+                       node_segments[rank].begin(),
+                       node_segments[rank].end());
+        message.push_back(element_segments[rank].size() / 5);
+        message.insert(message.end(),
+                       element_segments[rank].begin(),
+                       element_segments[rank].end());
+      }
+    return messages;
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh_distributed(const std::string &filename)
+{
+  Assert(tria != nullptr, ExcNoTriangulationSelected());
+
+  const MPI_Comm     comm    = tria->get_communicator();
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+
+  // 1) let the first process determine which parts of the file each
+  //    process has to read
+  std::map<unsigned int, std::vector<std::int64_t>> plans;
+  if (my_rank == 0)
+    {
+      auto messages = scan_msh_for_distributed_read<dim>(filename, n_ranks);
+      for (unsigned int rank = 0; rank < n_ranks; ++rank)
+        plans[rank] = std::move(messages[rank]);
+    }
+  const std::vector<std::int64_t> plan =
+    Utilities::MPI::some_to_some(comm, plans)[0];
+  plans.clear();
+
+  // 2) read the nodes, cells, and boundary faces of this process. The
+  //    cells and faces are encoded as flat lists of integers: the coarse
+  //    cell id, the owning rank, the material id, the number of vertices,
+  //    and the vertex tags for cells; the boundary id, the number of
+  //    vertices, and the sorted vertex tags for faces
+  auto                       entry        = plan.begin();
+  const std::uint64_t        first_cell   = *entry++;
+  const std::uint64_t        min_node_tag = *entry++;
+  const std::uint64_t        max_node_tag = *entry++;
+  std::vector<std::uint64_t> node_tags;
+  std::vector<double>        node_coordinates;
+  std::vector<std::uint64_t> cells;
+  std::vector<std::uint64_t> faces;
+  {
+    std::ifstream in(filename);
+    AssertThrow(in, ExcFileNotOpen(filename));
+
+    std::string line;
+    for (std::int64_t n_segments = *entry++; n_segments > 0; --n_segments)
+      {
+        const std::int64_t  tags_offset        = *entry++;
+        const std::int64_t  coordinates_offset = *entry++;
+        const std::uint64_t n_nodes            = *entry++;
+
+        in.seekg(tags_offset);
+        for (std::uint64_t n = 0; n < n_nodes; ++n)
+          {
+            std::uint64_t tag;
+            in >> tag;
+            node_tags.push_back(tag);
+          }
+
+        // ignore the parametric coordinates that may follow the location
+        in.seekg(coordinates_offset);
+        for (std::uint64_t n = 0; n < n_nodes; ++n)
+          {
+            std::getline(in, line);
+            std::istringstream coordinates(line);
+            double             x[3];
+            coordinates >> x[0] >> x[1] >> x[2];
+            AssertThrow(coordinates, ExcInvalidGMSHInput(line));
+            node_coordinates.insert(node_coordinates.end(), x, x + spacedim);
+          }
+      }
+
+    std::uint64_t next_cell = first_cell;
+    for (std::int64_t n_segments = *entry++; n_segments > 0; --n_segments)
+      {
+        const std::int64_t  offset       = *entry++;
+        const std::uint64_t n_elements   = *entry++;
+        const int           entity_dim   = *entry++;
+        const int           element_type = *entry++;
+        const std::int64_t  physical_tag = *entry++;
+
+        const unsigned int n_vertices = msh_element_n_nodes(element_type);
+        std::vector<std::uint64_t> vertices(n_vertices);
+
+        in.seekg(offset);
+        for (std::uint64_t e = 0; e < n_elements; ++e)
+          {
+            std::uint64_t element_tag;
+            in >> element_tag;
+            for (unsigned int v = 0; v < n_vertices; ++v)
+              {
+                // hypercube cells need to be reordered
+                if (entity_dim == dim &&
+                    n_vertices == GeometryInfo<dim>::vertices_per_cell)
+                  in >> vertices[GeometryInfo<dim>::ucd_to_deal[v]];
+                else
+                  in >> vertices[v];
+              }
+
+            if (entity_dim == dim)
+              {
+                AssertIndexRange(physical_tag, numbers::invalid_material_id);
+                cells.insert(cells.end(),
+                             {next_cell++,
+                              my_rank,
+                              static_cast<std::uint64_t>(physical_tag),
+                              n_vertices});
+                cells.insert(cells.end(), vertices.begin(), vertices.end());
+              }
+            else
+              {
+                AssertIndexRange(physical_tag,
+                                 numbers::internal_face_boundary_id);
+                std::sort(vertices.begin(), vertices.end());
+                faces.insert(faces.end(),
+                             {static_cast<std::uint64_t>(physical_tag),
+                              n_vertices});
+                faces.insert(faces.end(), vertices.begin(), vertices.end());
+              }
+          }
+      }
+    AssertThrow(in, ExcIO());
+  }
+
+  // 3) send the nodes, cells, and faces to the processes responsible for
+  //    their node tags: nodes to the owner of their tag, cells to the
+  //    owners of each of their vertices, and faces to the owner of their
+  //    smallest vertex
+  const auto tag_owner = [&](const std::uint64_t tag) {
+    return static_cast<unsigned int>((tag - min_node_tag) * n_ranks /
+                                     (max_node_tag - min_node_tag + 1));
+  };
+
+  std::map<std::uint64_t, Point<spacedim>>            directory_nodes;
+  std::map<std::uint64_t, std::vector<std::uint64_t>> directory_cells;
+  std::map<std::uint64_t, std::vector<std::uint64_t>> directory_faces;
+  {
+    std::map<unsigned int, std::vector<std::uint64_t>> tags_to_send;
+    std::map<unsigned int, std::vector<double>>        coordinates_to_send;
+    for (unsigned int n = 0; n < node_tags.size(); ++n)
+      {
+        const unsigned int owner = tag_owner(node_tags[n]);
+        tags_to_send[owner].push_back(node_tags[n]);
+        coordinates_to_send[owner].insert(
+          coordinates_to_send[owner].end(),
+          node_coordinates.begin() + n * spacedim,
+          node_coordinates.begin() + (n + 1) * spacedim);
+      }
+    node_tags.clear();
+    node_coordinates.clear();
+
+    const auto received_tags = Utilities::MPI::some_to_some(comm, tags_to_send);
+    const auto received_coordinates =
+      Utilities::MPI::some_to_some(comm, coordinates_to_send);
+    for (const auto &tags : received_tags)
+      {
+        const std::vector<double> &coordinates =
+          received_coordinates.at(tags.first);
+        for (unsigned int n = 0; n < tags.second.size(); ++n)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            directory_nodes[tags.second[n]][d] = coordinates[n * spacedim + d];
+      }
+  }
+  {
+    std::map<unsigned int, std::vector<std::uint64_t>> objects_to_send;
+    for (auto cell = cells.begin(); cell != cells.end(); cell += 4 + cell[3])
+      {
+        std::set<unsigned int> owners;
+        for (auto v = cell + 4; v != cell + 4 + cell[3]; ++v)
+          owners.insert(tag_owner(*v));
+        for (const unsigned int owner : owners)
+          objects_to_send[owner].insert(objects_to_send[owner].end(),
+                                        cell,
+                                        cell + 4 + cell[3]);
+      }
+    // faces come after all cells, marked by an invalid cell id
+    for (auto face = faces.begin(); face != faces.end(); face += 2 + face[1])
+      {
+        auto &object = objects_to_send[tag_owner(face[2])];
+        object.push_back(numbers::invalid_coarse_cell_id);
+        object.insert(object.end(), face, face + 2 + face[1]);
+      }
+    faces.clear();
+
+    for (const auto &objects : Utilities::MPI::some_to_some(comm,
+                                                            objects_to_send))
+      for (auto object = objects.second.begin();
+           object != objects.second.end();)
+        if (*object == numbers::invalid_coarse_cell_id)
+          {
+            const auto face = object + 1;
+            directory_faces[face[2]].insert(directory_faces[face[2]].end(),
+                                            face,
+                                            face + 2 + face[1]);
+            object = face + 2 + face[1];
+          }
+        else
+          {
+            const auto cell = object;
+            for (auto v = cell + 4; v != cell + 4 + cell[3]; ++v)
+              if (tag_owner(*v) == my_rank)
+                directory_cells[*v].insert(directory_cells[*v].end(),
+                                           cell,
+                                           cell + 4 + cell[3]);
+            object = cell + 4 + cell[3];
+          }
+  }
+
+  // 4) ask for all cells that share a vertex with a locally owned cell:
+  //    together with the locally owned cells, these form the locally
+  //    relevant cells
+  const auto query =
+    [&](const std::set<std::uint64_t> &tags,
+        const std::function<void(const std::uint64_t,
+                                 std::vector<std::uint64_t> &,
+                                 std::vector<double> &)> &answer,
+        const std::function<void(const std::vector<std::uint64_t> &,
+                                 const std::vector<double> &)> &receive) {
+      std::map<unsigned int, std::vector<std::uint64_t>> requests;
+      for (const std::uint64_t tag : tags)
+        requests[tag_owner(tag)].push_back(tag);
+
+      std::map<unsigned int, std::vector<std::uint64_t>> integer_answers;
+      std::map<unsigned int, std::vector<double>>        double_answers;
+      for (const auto &request : Utilities::MPI::some_to_some(comm, requests))
+        {
+          auto &integers = integer_answers[request.first];
+          auto &doubles  = double_answers[request.first];
+          for (const std::uint64_t tag : request.second)
+            answer(tag, integers, doubles);
+        }
+
+      const auto integers = Utilities::MPI::some_to_some(comm, integer_answers);
+      const auto doubles  = Utilities::MPI::some_to_some(comm, double_answers);
+      for (const auto &i : integers)
+        receive(i.second, doubles.at(i.first));
+    };
+
+  std::map<std::uint64_t, std::vector<std::uint64_t>> relevant_cells;
+  {
+    std::set<std::uint64_t> tags;
+    for (auto cell = cells.begin(); cell != cells.end(); cell += 4 + cell[3])
+      tags.insert(cell + 4, cell + 4 + cell[3]);
+    cells.clear();
+
+    query(
+      tags,
+      [&](const std::uint64_t tag,
+          std::vector<std::uint64_t> &integers,
+          std::vector<double> &) {
+        const auto &cells_at_vertex = directory_cells[tag];
+        integers.insert(integers.end(),
+                        cells_at_vertex.begin(),
+                        cells_at_vertex.end());
+      },
+      [&](const std::vector<std::uint64_t> &integers,
+          const std::vector<double> &) {
+        for (auto cell = integers.begin(); cell != integers.end();
+             cell += 4 + cell[3])
+          relevant_cells[cell[0]].assign(cell + 1, cell + 4 + cell[3]);
+      });
+  }
+
+  // 5) ask for the coordinates of all vertices of the locally relevant
+  //    cells and for the faces that start at them
+  std::map<std::uint64_t, unsigned int>                   vertex_indices;
+  std::map<std::vector<std::uint64_t>, types::boundary_id> boundary_ids;
+  TriangulationDescription::Description<dim, spacedim>    description;
+  {
+    std::set<std::uint64_t> tags;
+    for (const auto &cell : relevant_cells)
+      tags.insert(cell.second.begin() + 3, cell.second.end());
+
+    query(
+      tags,
+      [&](const std::uint64_t         tag,
+          std::vector<std::uint64_t> &integers,
+          std::vector<double> &       doubles) {
+        const Point<spacedim> &vertex = directory_nodes.at(tag);
+        integers.push_back(tag);
+        for (unsigned int d = 0; d < spacedim; ++d)
+          doubles.push_back(vertex[d]);
+
+        const auto &faces_at_vertex = directory_faces[tag];
+        integers.push_back(faces_at_vertex.size());
+        integers.insert(integers.end(),
+                        faces_at_vertex.begin(),
+                        faces_at_vertex.end());
+      },
+      [&](const std::vector<std::uint64_t> &integers,
+          const std::vector<double> &       doubles) {
+        auto coordinates = doubles.begin();
+        for (auto entry = integers.begin(); entry != integers.end();)
+          {
+            vertex_indices[*entry++] = description.coarse_cell_vertices.size();
+            description.coarse_cell_vertices.emplace_back();
+            for (unsigned int d = 0; d < spacedim; ++d)
+              description.coarse_cell_vertices.back()[d] = *coordinates++;
+
+            const auto faces_end = entry + 1 + *entry;
+            for (auto face = entry + 1; face != faces_end; face += 2 + face[1])
+              boundary_ids[std::vector<std::uint64_t>(face + 2,
+                                                      face + 2 + face[1])] =
+                face[0];
+            entry = faces_end;
+          }
+      });
+  }
+  directory_nodes.clear();
+  directory_cells.clear();
+  directory_faces.clear();
+
+  // 6) set up the description of the locally relevant part of the mesh
+  description.comm      = comm;
+  description.settings  = TriangulationDescription::Settings::default_setting;
+  description.smoothing = tria->get_mesh_smoothing();
+  description.cell_infos.resize(1);
+  for (const auto &relevant_cell : relevant_cells)
+    {
+      const std::vector<std::uint64_t> &cell = relevant_cell.second;
+      const unsigned int                n_vertices = cell[2];
+
+      dealii::CellData<dim> cell_data(n_vertices);
+      cell_data.material_id = cell[1];
+      for (unsigned int v = 0; v < n_vertices; ++v)
+        cell_data.vertices[v] = vertex_indices.at(cell[3 + v]);
+      description.coarse_cells.push_back(cell_data);
+      description.coarse_cell_index_to_coarse_cell_id.push_back(
+        relevant_cell.first);
+
+      TriangulationDescription::CellData<dim> cell_info;
+      cell_info.id = CellId(relevant_cell.first, std::vector<std::uint8_t>())
+                       .template to_binary<dim>();
+      cell_info.subdomain_id       = cell[0];
+      cell_info.level_subdomain_id = cell[0];
+      cell_info.manifold_id        = numbers::flat_manifold_id;
+      std::fill(cell_info.manifold_line_ids.begin(),
+                cell_info.manifold_line_ids.end(),
+                numbers::flat_manifold_id);
+      std::fill(cell_info.manifold_quad_ids.begin(),
+                cell_info.manifold_quad_ids.end(),
+                numbers::flat_manifold_id);
+
+      const ReferenceCell reference_cell =
+        ReferenceCell::n_vertices_to_type(dim, n_vertices);
+      for (const unsigned int f : reference_cell.face_indices())
+        {
+          std::vector<std::uint64_t> face_vertices(
+            reference_cell.face_reference_cell(f).n_vertices());
+          for (unsigned int v = 0; v < face_vertices.size(); ++v)
+            face_vertices[v] =
+              cell[3 + reference_cell.face_to_cell_vertices(f, v, 1)];
+          std::sort(face_vertices.begin(), face_vertices.end());
+
+          const auto boundary_id = boundary_ids.find(face_vertices);
+          if (boundary_id != boundary_ids.end())
+            cell_info.boundary_ids.emplace_back(f, boundary_id->second);
+        }
+
+      description.cell_infos[0].push_back(cell_info);
+    }
+
+  tria->create_triangulation(description);
+}
+
+
+
 #ifdef DEAL_II_GMSH_WITH_API
 template <int dim, int spacedim>
 void
@@ -3561,6 +4684,11 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
     {
       read_exodusii(name);
     }
+  else if (format == binary)
+    {
+      std::ifstream in(name.c_str(), std::ios::binary);
+      read_binary(in);
+    }
   else
     {
       std::ifstream in(name.c_str());
@@ -3614,6 +4742,10 @@ GridIn<dim, spacedim>::read(std::istream &in, Format format)
         read_tecplot(in);
         return;
 
+      case binary:
+        read_binary(in);
+        return;
+
       case assimp:
         Assert(false,
                ExcMessage("There is no read_assimp(istream &) function. "
@@ -3663,6 +4795,8 @@ GridIn<dim, spacedim>::default_suffix(const Format format)
         return ".xda";
       case tecplot:
         return ".dat";
+      case binary:
+        return ".tria";
       default:
         Assert(false, ExcNotImplemented());
         return ".unknown_format";
@@ -3693,6 +4827,12 @@ GridIn<dim, spacedim>::parse_format(const std::string &format_name)
   if (format_name == "vtu")
     return vtu;
 
+  if (format_name == "binary")
+    return binary;
+
+  if (format_name == "tria")
+    return binary;
+
   // This is also the typical extension of Abaqus input files.
   if (format_name == "inp")
     return ucd;
@@ -3732,7 +4872,7 @@ template <int dim, int spacedim>
 std::string
 GridIn<dim, spacedim>::get_format_names()
 {
-  return "dbmesh|exodusii|msh|unv|vtk|vtu|ucd|abaqus|xda|tecplot|assimp";
+  return "dbmesh|exodusii|msh|unv|vtk|vtu|ucd|abaqus|xda|tecplot|assimp|binary";
 }
 
 
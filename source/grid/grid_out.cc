@@ -38,6 +38,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <fstream>
@@ -581,6 +582,8 @@ GridOut::default_suffix(const OutputFormat output_format)
         return ".vtk";
       case vtu:
         return ".vtu";
+      case binary:
+        return ".tria";
       default:
         Assert(false, ExcNotImplemented());
         return "";
@@ -633,6 +636,12 @@ GridOut::parse_output_format(const std::string &format_name)
   if (format_name == "vtu")
     return vtu;
 
+  if (format_name == "binary")
+    return binary;
+
+  if (format_name == "tria")
+    return binary;
+
   AssertThrow(false, ExcInvalidState());
   // return something weird
   return OutputFormat(-1);
@@ -643,7 +652,7 @@ GridOut::parse_output_format(const std::string &format_name)
 std::string
 GridOut::get_output_format_names()
 {
-  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu";
+  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|vtk|vtu|binary";
 }
 
 
@@ -3633,6 +3642,279 @@ GridOut::write_vtu(const Triangulation<dim, spacedim> &tria,
 
 
 
+namespace
+{
+  /**
+   * Write an array of POD values in their native binary representation and
+   * pad it with zeros to a multiple of eight bytes, so that every array of
+   * the binary triangulation format starts at an aligned position.
+   */
+  template <typename T>
+  void
+  write_binary_array(const std::vector<T> &values, std::ostream &out)
+  {
+    const std::size_t n_bytes = values.size() * sizeof(T);
+    out.write(reinterpret_cast<const char *>(values.data()), n_bytes);
+
+    const char zeros[8] = {};
+    out.write(zeros, (8 - n_bytes % 8) % 8);
+  }
+
+
+
+  /**
+   * One section of the binary triangulation format written by
+   * GridOut::write_binary(): the cells owned by one subdomain together with
+   * the layer of cells around them, their vertices, and all of the ids that
+   * are stored per cell. See the documentation of GridOut::write_binary()
+   * for the meaning and the order of the arrays.
+   */
+  template <int dim, int spacedim>
+  struct BinarySection
+  {
+    BinarySection()
+      : offsets(1, 0)
+    {}
+
+    /**
+     * Add a cell. Its vertices are stored with their global indices, which
+     * are only replaced by the ones local to the section in finalize().
+     */
+    void
+    add(const typename Triangulation<dim, spacedim>::active_cell_iterator
+          &                              cell,
+        const std::vector<unsigned int> &new_vertex_index)
+    {
+      for (const unsigned int v : cell->vertex_indices())
+        vertex_indices.push_back(new_vertex_index[cell->vertex_index(v)]);
+      offsets.push_back(vertex_indices.size());
+      cell_ids.push_back(cell->active_cell_index());
+      subdomain_ids.push_back(cell->subdomain_id());
+      material_ids.push_back(cell->material_id());
+      manifold_ids.push_back(cell->manifold_id());
+
+      // the per-face and per-line arrays have a fixed number of entries per
+      // cell, so that simplices leave some of them unused
+      std::size_t start = face_boundary_ids.size();
+      face_boundary_ids.resize(start + GeometryInfo<dim>::faces_per_cell,
+                               numbers::internal_face_boundary_id);
+      for (const unsigned int f : cell->face_indices())
+        face_boundary_ids[start + f] = cell->face(f)->boundary_id();
+
+      if (dim == 3)
+        {
+          start = line_boundary_ids.size();
+          line_boundary_ids.resize(start + GeometryInfo<dim>::lines_per_cell,
+                                   numbers::internal_face_boundary_id);
+          for (const unsigned int l : cell->line_indices())
+            line_boundary_ids[start + l] = cell->line(l)->boundary_id();
+        }
+
+      if (dim >= 2)
+        {
+          start = line_manifold_ids.size();
+          line_manifold_ids.resize(start + GeometryInfo<dim>::lines_per_cell,
+                                   numbers::flat_manifold_id);
+          for (const unsigned int l : cell->line_indices())
+            line_manifold_ids[start + l] = cell->line(l)->manifold_id();
+        }
+
+      if (dim == 3)
+        {
+          start = quad_manifold_ids.size();
+          quad_manifold_ids.resize(start + GeometryInfo<dim>::faces_per_cell,
+                                   numbers::flat_manifold_id);
+          for (const unsigned int f : cell->face_indices())
+            quad_manifold_ids[start + f] = cell->quad(f)->manifold_id();
+        }
+    }
+
+    /**
+     * Collect the vertices of all cells of the section, sorted by their
+     * global index, and renumber the vertex indices of the cells
+     * accordingly.
+     */
+    void
+    finalize(const std::vector<double> &all_coordinates)
+    {
+      vertex_ids.assign(vertex_indices.begin(), vertex_indices.end());
+      std::sort(vertex_ids.begin(), vertex_ids.end());
+      vertex_ids.erase(std::unique(vertex_ids.begin(), vertex_ids.end()),
+                       vertex_ids.end());
+
+      for (std::uint32_t &v : vertex_indices)
+        v = std::lower_bound(vertex_ids.begin(), vertex_ids.end(), v) -
+            vertex_ids.begin();
+
+      coordinates.reserve(vertex_ids.size() * spacedim);
+      for (const std::uint64_t v : vertex_ids)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          coordinates.push_back(all_coordinates[v * spacedim + d]);
+
+      sizes = {vertex_ids.size(), cell_ids.size(), vertex_indices.size()};
+    }
+
+    /**
+     * Call @p function for each of the arrays of the section, in the order
+     * in which they are stored in the file.
+     */
+    template <typename Function>
+    void
+    for_each_array(const Function &function) const
+    {
+      function(sizes);
+      function(vertex_ids);
+      function(coordinates);
+      function(offsets);
+      function(vertex_indices);
+      function(cell_ids);
+      function(subdomain_ids);
+      function(material_ids);
+      function(manifold_ids);
+      function(face_boundary_ids);
+      function(line_boundary_ids);
+      function(line_manifold_ids);
+      function(quad_manifold_ids);
+    }
+
+    /**
+     * Return the number of bytes the section occupies in the file.
+     */
+    std::uint64_t
+    n_bytes() const
+    {
+      std::uint64_t n_bytes = 0;
+      for_each_array([&](const auto &values) {
+        n_bytes += (values.size() * sizeof(values[0]) + 7) / 8 * 8;
+      });
+      return n_bytes;
+    }
+
+    void
+    write(std::ostream &out) const
+    {
+      for_each_array(
+        [&](const auto &values) { write_binary_array(values, out); });
+    }
+
+    std::vector<std::uint64_t> sizes;
+    std::vector<std::uint64_t> vertex_ids;
+    std::vector<double>        coordinates;
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint32_t> vertex_indices;
+    std::vector<std::uint64_t> cell_ids;
+    std::vector<std::uint32_t> subdomain_ids;
+    std::vector<std::uint32_t> material_ids;
+    std::vector<std::uint32_t> manifold_ids;
+    std::vector<std::uint32_t> face_boundary_ids;
+    std::vector<std::uint32_t> line_boundary_ids;
+    std::vector<std::uint32_t> line_manifold_ids;
+    std::vector<std::uint32_t> quad_manifold_ids;
+  };
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridOut::write_binary(const Triangulation<dim, spacedim> &tria,
+                      std::ostream &                      out) const
+{
+  AssertThrow(out, ExcIO());
+
+  // only output the vertices that are actually used, and number them
+  // consecutively
+  const std::vector<Point<spacedim>> &vertices      = tria.get_vertices();
+  const std::vector<bool> &           used_vertices = tria.get_used_vertices();
+
+  std::vector<unsigned int> new_vertex_index(vertices.size(),
+                                             numbers::invalid_unsigned_int);
+  std::vector<double>       coordinates;
+  coordinates.reserve(tria.n_used_vertices() * spacedim);
+  unsigned int n_vertices = 0;
+  for (unsigned int v = 0; v < vertices.size(); ++v)
+    if (used_vertices[v])
+      {
+        new_vertex_index[v] = n_vertices++;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          coordinates.push_back(vertices[v][d]);
+      }
+
+  // there is one section per subdomain id. a cell is stored in the sections
+  // of all subdomains that own a cell sharing a vertex with it, i.e., in the
+  // section of its own subdomain and as a ghost cell in the ones of its
+  // neighbors
+  std::vector<std::vector<types::subdomain_id>> vertex_subdomains(
+    vertices.size());
+  types::subdomain_id n_sections = 1;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      AssertThrow(cell->subdomain_id() != numbers::artificial_subdomain_id,
+                  ExcMessage("All active cells need to have a valid "
+                             "subdomain id."));
+      n_sections = std::max<types::subdomain_id>(n_sections,
+                                                 cell->subdomain_id() + 1);
+      for (const unsigned int v : cell->vertex_indices())
+        {
+          auto &subdomains = vertex_subdomains[cell->vertex_index(v)];
+          const auto position = std::lower_bound(subdomains.begin(),
+                                                 subdomains.end(),
+                                                 cell->subdomain_id());
+          if (position == subdomains.end() || *position != cell->subdomain_id())
+            subdomains.insert(position, cell->subdomain_id());
+        }
+    }
+
+  std::vector<BinarySection<dim, spacedim>> sections(n_sections);
+  std::vector<types::subdomain_id>          cell_sections;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell_sections.clear();
+      for (const unsigned int v : cell->vertex_indices())
+        {
+          const auto &subdomains = vertex_subdomains[cell->vertex_index(v)];
+          cell_sections.insert(cell_sections.end(),
+                               subdomains.begin(),
+                               subdomains.end());
+        }
+      std::sort(cell_sections.begin(), cell_sections.end());
+      cell_sections.erase(std::unique(cell_sections.begin(),
+                                      cell_sections.end()),
+                          cell_sections.end());
+
+      for (const types::subdomain_id section : cell_sections)
+        sections[section].add(cell, new_vertex_index);
+    }
+
+  for (auto &section : sections)
+    section.finalize(coordinates);
+
+  // the header: magic string, version number, byte order mark, dimensions,
+  // global sizes, and the offsets of the sections from the start of the
+  // header, with the end of the last section as additional entry
+  out.write("dealtria", 8);
+  const std::uint32_t header[4] = {2, 0x01020304, dim, spacedim};
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+  write_binary_array(std::vector<std::uint64_t>{n_vertices,
+                                                tria.n_active_cells(),
+                                                n_sections},
+                     out);
+
+  std::vector<std::uint64_t> section_offsets(n_sections + 1);
+  section_offsets[0] = 8 + sizeof(header) + 3 * 8 + 8 * (n_sections + 1);
+  for (unsigned int p = 0; p < n_sections; ++p)
+    section_offsets[p + 1] = section_offsets[p] + sections[p].n_bytes();
+  write_binary_array(section_offsets, out);
+
+  for (const auto &section : sections)
+    section.write(out);
+
+  out << std::flush;
+  AssertThrow(out, ExcIO());
+}
+
+
+
 template <int dim, int spacedim>
 void
 GridOut::write_mesh_per_processor_as_vtu(
@@ -5138,6 +5420,10 @@ GridOut::write(const Triangulation<dim, spacedim> &tria,
       case vtu:
         write_vtu(tria, out);
         return;
+
+      case binary:
+        write_binary(tria, out);
+        return;
     }
 
   Assert(false, ExcInternalError());
@@ -210,13 +210,11 @@ SparseDirectUMFPACK::sort_arrays(const BlockSparseMatrix<number> &matrix)
 
 
 template <class Matrix>
-void
-SparseDirectUMFPACK::factorize(const Matrix &matrix)
+bool
+SparseDirectUMFPACK::copy_matrix(const Matrix &matrix)
 {
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
 
-  clear();
-
   using number = typename Matrix::value_type;
 
   n_rows = matrix.m();
@@ -224,6 +222,12 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
 
   const size_type N = matrix.m();
 
+  // keep the old sparsity pattern around to compare it with the new one
+  std::vector<types::suitesparse_index> old_Ap, old_Ai;
+  old_Ap.swap(Ap);
+  old_Ai.swap(Ai);
+  const bool old_is_complex = (Az.size() != 0);
+
   // copy over the data from the matrix to the data structures UMFPACK
   // wants. note two things: first, UMFPACK wants compressed column storage
   // whereas we always do compressed row storage; we work around this by,
@@ -247,6 +251,8 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   Ax.resize(matrix.n_nonzero_elements());
   if (numbers::NumberTraits<number>::is_complex == true)
     Az.resize(matrix.n_nonzero_elements());
+  else
+    Az.clear();
 
   // first fill row lengths array
   Ap[0] = 0;
@@ -292,8 +298,24 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // different function
   sort_arrays(matrix);
 
-  int status;
-  if (numbers::NumberTraits<number>::is_complex == false)
+  return (Ap == old_Ap) && (Ai == old_Ai) &&
+         (old_is_complex == numbers::NumberTraits<number>::is_complex);
+}
+
+
+
+void
+SparseDirectUMFPACK::compute_symbolic_factorization()
+{
+  if (symbolic_decomposition != nullptr)
+    {
+      umfpack_dl_free_symbolic(&symbolic_decomposition);
+      symbolic_decomposition = nullptr;
+    }
+
+  const size_type N = n_rows;
+  int             status;
+  if (Az.size() == 0)
     status = umfpack_dl_symbolic(N,
                                  N,
                                  Ap.data(),
@@ -314,8 +336,23 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                                  nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_symbolic", status));
+}
 
-  if (numbers::NumberTraits<number>::is_complex == false)
+
+
+void
+SparseDirectUMFPACK::compute_numeric_factorization()
+{
+  Assert(symbolic_decomposition != nullptr, ExcNotInitialized());
+
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  int status;
+  if (Az.size() == 0)
     status = umfpack_dl_numeric(Ap.data(),
                                 Ai.data(),
                                 Ax.data(),
@@ -334,8 +371,57 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                                 nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::factorize(const Matrix &matrix)
+{
+  // only redo the symbolic factorization if the sparsity pattern changed
+  const bool have_symbolic_decomposition = (symbolic_decomposition != nullptr);
+  const bool same_pattern                = copy_matrix(matrix);
+  if (!have_symbolic_decomposition || !same_pattern)
+    compute_symbolic_factorization();
 
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
+  compute_numeric_factorization();
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::analyze(const Matrix &matrix)
+{
+  clear();
+  copy_matrix(matrix);
+  compute_symbolic_factorization();
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::numeric_factorize(const Matrix &matrix)
+{
+  Assert(symbolic_decomposition != nullptr,
+         ExcMessage("You need to call analyze() or factorize() before "
+                    "calling numeric_factorize()."));
+
+  // the stored symbolic factorization does not belong to the stored matrix
+  // any more if the patterns differ, so discard everything in that case
+  const bool same_pattern = copy_matrix(matrix);
+  if (!same_pattern)
+    clear();
+  AssertThrow(same_pattern,
+              ExcMessage("The sparsity pattern of the matrix passed to "
+                         "numeric_factorize() differs from the one of the "
+                         "matrix passed to analyze() or factorize(). Call "
+                         "factorize() to compute a new symbolic "
+                         "factorization."));
+
+  compute_numeric_factorization();
 }
 
 
@@ -636,6 +722,32 @@ SparseDirectUMFPACK::factorize(const Matrix &)
 }
 
 
+template <class Matrix>
+void
+SparseDirectUMFPACK::analyze(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II "
+      "without passing the necessary switch to 'cmake'. Please consult the "
+      "installation instructions in doc/readme.html."));
+}
+
+
+template <class Matrix>
+void
+SparseDirectUMFPACK::numeric_factorize(const Matrix &)
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II "
+      "without passing the necessary switch to 'cmake'. Please consult the "
+      "installation instructions in doc/readme.html."));
+}
+
+
 void
 SparseDirectUMFPACK::solve(Vector<double> &, const bool) const
 {
@@ -810,20 +922,22 @@ SparseDirectUMFPACK::n() const
 
 
 // explicit instantiations for SparseMatrixUMFPACK
-#define InstantiateUMFPACK(MatrixType)                                     \
-  template void SparseDirectUMFPACK::factorize(const MatrixType &);        \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,             \
-                                           Vector<double> &,               \
-                                           const bool);                    \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,             \
-                                           Vector<std::complex<double>> &, \
-                                           const bool);                    \
-  template void SparseDirectUMFPACK::solve(const MatrixType &,             \
-                                           BlockVector<double> &,          \
-                                           const bool);                    \
-  template void SparseDirectUMFPACK::solve(                                \
-    const MatrixType &, BlockVector<std::complex<double>> &, const bool);  \
-  template void SparseDirectUMFPACK::initialize(const MatrixType &,        \
+#define InstantiateUMFPACK(MatrixType)                                      \
+  template void SparseDirectUMFPACK::factorize(const MatrixType &);         \
+  template void SparseDirectUMFPACK::analyze(const MatrixType &);           \
+  template void SparseDirectUMFPACK::numeric_factorize(const MatrixType &); \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,              \
+                                           Vector<double> &,                \
+                                           const bool);                     \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,              \
+                                           Vector<std::complex<double>> &,  \
+                                           const bool);                     \
+  template void SparseDirectUMFPACK::solve(const MatrixType &,              \
+                                           BlockVector<double> &,           \
+                                           const bool);                     \
+  template void SparseDirectUMFPACK::solve(                                 \
+    const MatrixType &, BlockVector<std::complex<double>> &, const bool);   \
+  template void SparseDirectUMFPACK::initialize(const MatrixType &,         \
                                                 const AdditionalData)
 
 // Instantiate everything for real-valued matrices
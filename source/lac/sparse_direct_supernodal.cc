@@ -0,0 +1,1430 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/sparse_direct_supernodal.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_ez.h>
+
+#include <algorithm>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace SparseDirectSupernodalImplementation
+  {
+    using size_type = SparseDirectSupernodal::size_type;
+
+    // parts of the graph with at most this many vertices are not dissected
+    // any further by the nested dissection ordering
+    constexpr size_type nested_dissection_leaf_size = 64;
+
+    // a supernode is merged with its parent if the merged supernode has at
+    // most this many columns and not too many additional zeros
+    constexpr size_type relaxed_supernode_size = 16;
+
+    // the number of columns eliminated together in the dense factorizations
+    constexpr unsigned int panel_width = 32;
+
+    // the number of floating point operations above which the update of the
+    // trailing matrix in the dense factorizations is done in parallel
+    constexpr std::size_t parallel_update_threshold = 1 << 18;
+
+
+
+    /**
+     * The graph of a sparse matrix in compressed storage, without the
+     * diagonal.
+     */
+    struct Graph
+    {
+      std::vector<std::size_t> start;
+      std::vector<size_type>   neighbors;
+
+      size_type
+      n_vertices() const
+      {
+        return start.size() - 1;
+      }
+    };
+
+
+
+    // Compute the graph of A+A^T for the sparsity pattern of A given in
+    // compressed row storage
+    Graph
+    symmetrized_graph(const std::vector<std::size_t> &row_start,
+                      const std::vector<size_type> &  column_indices)
+    {
+      const size_type N = row_start.size() - 1;
+
+      Graph graph;
+      graph.start.resize(N + 1, 0);
+      for (size_type row = 0; row < N; ++row)
+        for (std::size_t e = row_start[row]; e < row_start[row + 1]; ++e)
+          if (column_indices[e] != row)
+            {
+              ++graph.start[row + 1];
+              ++graph.start[column_indices[e] + 1];
+            }
+      for (size_type row = 0; row < N; ++row)
+        graph.start[row + 1] += graph.start[row];
+
+      std::vector<std::size_t> next(graph.start.begin(), graph.start.end() - 1);
+      graph.neighbors.resize(graph.start.back());
+      for (size_type row = 0; row < N; ++row)
+        for (std::size_t e = row_start[row]; e < row_start[row + 1]; ++e)
+          if (column_indices[e] != row)
+            {
+              graph.neighbors[next[row]++]               = column_indices[e];
+              graph.neighbors[next[column_indices[e]]++] = row;
+            }
+
+      // remove the duplicates of entries present in both A and A^T
+      std::size_t n_unique = 0;
+      for (size_type row = 0; row < N; ++row)
+        {
+          const auto begin = graph.neighbors.begin() + graph.start[row];
+          const auto end   = graph.neighbors.begin() + graph.start[row + 1];
+          std::sort(begin, end);
+          const auto unique_end = std::unique(begin, end);
+          graph.start[row]      = n_unique;
+          n_unique = std::copy(begin, unique_end, graph.neighbors.begin() +
+                                                    n_unique) -
+                     graph.neighbors.begin();
+        }
+      graph.start[N] = n_unique;
+      graph.neighbors.resize(n_unique);
+
+      return graph;
+    }
+
+
+
+    /**
+     * Helper class for the nested dissection ordering.
+     */
+    class NestedDissection
+    {
+    public:
+      NestedDissection(const Graph &graph)
+        : graph(graph)
+        , part(graph.n_vertices(), 0)
+        , n_parts(1)
+        , marker(graph.n_vertices(), 0)
+        , current_mark(0)
+        , level(graph.n_vertices(), 0)
+      {}
+
+      // Return the ordering as a list of the vertices in elimination order
+      std::vector<size_type>
+      compute()
+      {
+        std::vector<size_type> vertices(graph.n_vertices());
+        std::iota(vertices.begin(), vertices.end(), size_type(0));
+        ordering.reserve(graph.n_vertices());
+        dissect(vertices, 0);
+        AssertDimension(ordering.size(), graph.n_vertices());
+        return std::move(ordering);
+      }
+
+    private:
+      // Compute the level structure rooted at the given vertex within the
+      // vertices with the given part id, i.e., the vertices sorted by their
+      // distance to the root, with offsets to the levels in level_start.
+      // Vertices are marked as visited with a fresh mark.
+      void
+      compute_levels(const size_type           root,
+                     const unsigned int        part_id,
+                     std::vector<size_type> &  visited,
+                     std::vector<std::size_t> &level_start)
+      {
+        ++current_mark;
+        visited.clear();
+        level_start.clear();
+        visited.push_back(root);
+        marker[root] = current_mark;
+        level[root]  = 0;
+        level_start.push_back(0);
+        for (std::size_t i = 0; i < visited.size(); ++i)
+          {
+            const size_type v = visited[i];
+            if (level[v] == level_start.size())
+              level_start.push_back(i);
+            for (std::size_t e = graph.start[v]; e < graph.start[v + 1]; ++e)
+              {
+                const size_type w = graph.neighbors[e];
+                if (part[w] == part_id && marker[w] != current_mark)
+                  {
+                    marker[w] = current_mark;
+                    level[w]  = level[v] + 1;
+                    visited.push_back(w);
+                  }
+              }
+          }
+        level_start.push_back(visited.size());
+      }
+
+      // Order the given vertices, which all carry the given part id
+      void
+      dissect(const std::vector<size_type> &vertices,
+              const unsigned int            part_id)
+      {
+        if (vertices.size() <= nested_dissection_leaf_size)
+          {
+            ordering.insert(ordering.end(), vertices.begin(), vertices.end());
+            return;
+          }
+
+        std::vector<size_type>   visited;
+        std::vector<std::size_t> level_start;
+
+        // find a pseudo-peripheral vertex by repeatedly starting the level
+        // structure from a vertex of minimal degree in the last level
+        compute_levels(vertices[0], part_id, visited, level_start);
+        for (unsigned int attempt = 0; attempt < 4; ++attempt)
+          {
+            size_type   candidate  = visited[level_start[level_start.size() -
+                                                      2]];
+            std::size_t min_degree = numbers::invalid_size_type;
+            for (std::size_t i = level_start[level_start.size() - 2];
+                 i < visited.size();
+                 ++i)
+              {
+                const size_type v = visited[i];
+                if (graph.start[v + 1] - graph.start[v] < min_degree)
+                  {
+                    min_degree = graph.start[v + 1] - graph.start[v];
+                    candidate  = v;
+                  }
+              }
+            std::vector<size_type>   new_visited;
+            std::vector<std::size_t> new_level_start;
+            compute_levels(candidate, part_id, new_visited, new_level_start);
+            if (new_level_start.size() <= level_start.size())
+              break;
+            visited.swap(new_visited);
+            level_start.swap(new_level_start);
+          }
+
+        // recompute the levels of the chosen root, which were overwritten by
+        // the last attempt
+        compute_levels(visited[0], part_id, visited, level_start);
+
+        // the vertices might not be connected, in which case we order the
+        // connected components one after the other
+        if (visited.size() < vertices.size())
+          {
+            const unsigned int mark = current_mark;
+            std::vector<size_type> rest;
+            for (const size_type v : vertices)
+              if (marker[v] != mark)
+                rest.push_back(v);
+            const unsigned int component_id = n_parts++;
+            const unsigned int rest_id      = n_parts++;
+            for (const size_type v : visited)
+              part[v] = component_id;
+            for (const size_type v : rest)
+              part[v] = rest_id;
+            dissect(visited, component_id);
+            dissect_components(rest, rest_id);
+            return;
+          }
+
+        const unsigned int n_levels = level_start.size() - 1;
+        if (n_levels < 3)
+          {
+            ordering.insert(ordering.end(), visited.begin(), visited.end());
+            return;
+          }
+
+        // the middle level separates the levels above from the ones below.
+        // vertices of the middle level without neighbors in the levels below
+        // are not needed for the separation and go to the upper part
+        const unsigned int     middle = n_levels / 2;
+        std::vector<size_type> upper_part(visited.begin(),
+                                          visited.begin() +
+                                            level_start[middle]);
+        std::vector<size_type> lower_part(visited.begin() +
+                                            level_start[middle + 1],
+                                          visited.end());
+        std::vector<size_type> separator;
+        for (std::size_t i = level_start[middle]; i < level_start[middle + 1];
+             ++i)
+          {
+            const size_type v = visited[i];
+            bool            touches_lower_part = false;
+            for (std::size_t e = graph.start[v]; e < graph.start[v + 1]; ++e)
+              {
+                const size_type w = graph.neighbors[e];
+                if (part[w] == part_id && level[w] > middle)
+                  {
+                    touches_lower_part = true;
+                    break;
+                  }
+              }
+            if (touches_lower_part)
+              separator.push_back(v);
+            else
+              upper_part.push_back(v);
+          }
+
+        const unsigned int upper_id = n_parts++;
+        const unsigned int lower_id = n_parts++;
+        for (const size_type v : upper_part)
+          part[v] = upper_id;
+        for (const size_type v : lower_part)
+          part[v] = lower_id;
+        for (const size_type v : separator)
+          part[v] = numbers::invalid_unsigned_int;
+
+        dissect(upper_part, upper_id);
+        dissect(lower_part, lower_id);
+        ordering.insert(ordering.end(), separator.begin(), separator.end());
+      }
+
+      // Split the given vertices into their connected components and order
+      // each of them by dissect(). This avoids a deep recursion for graphs
+      // with many components.
+      void
+      dissect_components(const std::vector<size_type> &vertices,
+                         const unsigned int            part_id)
+      {
+        std::vector<size_type>   visited;
+        std::vector<std::size_t> level_start;
+        std::vector<size_type>   small_components;
+        for (const size_type v : vertices)
+          if (part[v] == part_id)
+            {
+              compute_levels(v, part_id, visited, level_start);
+              const unsigned int component_id = n_parts++;
+              for (const size_type w : visited)
+                part[w] = component_id;
+              if (visited.size() <= nested_dissection_leaf_size)
+                small_components.insert(small_components.end(),
+                                        visited.begin(),
+                                        visited.end());
+              else
+                dissect(visited, component_id);
+            }
+        ordering.insert(ordering.end(),
+                        small_components.begin(),
+                        small_components.end());
+      }
+
+      const Graph &graph;
+
+      // the part of the graph each vertex currently belongs to
+      std::vector<unsigned int> part;
+      unsigned int              n_parts;
+
+      // marker for the vertices visited in a breadth-first search, and the
+      // distance of each visited vertex from the root
+      std::vector<unsigned int> marker;
+      unsigned int              current_mark;
+      std::vector<unsigned int> level;
+
+      std::vector<size_type> ordering;
+    };
+
+
+
+    // Run the given function on the rows [begin,end), in parallel if the work
+    // estimate is large enough
+    template <typename Function>
+    void
+    apply_to_rows(const unsigned int begin,
+                  const unsigned int end,
+                  const std::size_t  n_flops,
+                  const Function &   function)
+    {
+      if (n_flops > parallel_update_threshold &&
+          MultithreadInfo::n_threads() > 1)
+        parallel::apply_to_subranges(begin, end, function, 16);
+      else
+        function(begin, end);
+    }
+
+
+
+    // Eliminate the first k columns of the dense f x f matrix F, stored row
+    // by row, choosing the pivots among the first k rows. On exit, the first
+    // k columns hold the strictly lower triangular factor L (with implied
+    // unit diagonal) and the first k rows the upper triangular factor U,
+    // whereas the trailing (f-k) x (f-k) block holds the Schur complement.
+    // Return the first column without a nonzero pivot, or
+    // numbers::invalid_unsigned_int.
+    unsigned int
+    partial_lu(double *           F,
+               const unsigned int f,
+               const unsigned int k,
+               unsigned int *     pivots)
+    {
+      for (unsigned int jb = 0; jb < k; jb += panel_width)
+        {
+          const unsigned int je = std::min(jb + panel_width, k);
+
+          // factorize the panel of columns [jb,je)
+          for (unsigned int j = jb; j < je; ++j)
+            {
+              unsigned int pivot     = j;
+              double       max_entry = std::abs(F[j * f + j]);
+              for (unsigned int i = j + 1; i < k; ++i)
+                if (std::abs(F[i * f + j]) > max_entry)
+                  {
+                    max_entry = std::abs(F[i * f + j]);
+                    pivot     = i;
+                  }
+              if (max_entry == 0.)
+                return j;
+              pivots[j] = pivot;
+              if (pivot != j)
+                std::swap_ranges(F + j * f, F + j * f + f, F + pivot * f);
+
+              const double  inverse_pivot = 1. / F[j * f + j];
+              const double *pivot_row     = F + j * f;
+              for (unsigned int i = j + 1; i < f; ++i)
+                {
+                  double *     row = F + i * f;
+                  const double l   = (row[j] *= inverse_pivot);
+                  if (l != 0.)
+                    for (unsigned int c = j + 1; c < je; ++c)
+                      row[c] -= l * pivot_row[c];
+                }
+            }
+
+          // compute the rows of U right of the panel
+          for (unsigned int j = jb; j < je; ++j)
+            for (unsigned int r = j + 1; r < je; ++r)
+              {
+                const double l = F[r * f + j];
+                if (l != 0.)
+                  for (unsigned int c = je; c < f; ++c)
+                    F[r * f + c] -= l * F[j * f + c];
+              }
+
+          // update the trailing matrix
+          apply_to_rows(
+            je,
+            f,
+            std::size_t(f - je) * (f - je) * (je - jb),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int i = begin; i < end; ++i)
+                {
+                  double *row = F + i * f;
+                  for (unsigned int l = jb; l < je; ++l)
+                    {
+                      const double  a     = row[l];
+                      const double *u_row = F + l * f;
+                      if (a != 0.)
+                        for (unsigned int c = je; c < f; ++c)
+                          row[c] -= a * u_row[c];
+                    }
+                }
+            });
+        }
+
+      return numbers::invalid_unsigned_int;
+    }
+
+
+
+    // Same as partial_lu(), but for a symmetric matrix of which only the
+    // lower triangle is accessed. On exit, the first k columns hold the
+    // strictly lower triangular factor L and the diagonal matrix D of the
+    // LDL^T factorization, and the lower triangle of the trailing block holds
+    // the Schur complement.
+    unsigned int
+    partial_ldlt(double *F, const unsigned int f, const unsigned int k)
+    {
+      std::vector<double> column_in_panel(panel_width);
+      std::vector<double> scaled_panel;
+      for (unsigned int jb = 0; jb < k; jb += panel_width)
+        {
+          const unsigned int je = std::min(jb + panel_width, k);
+
+          // factorize the panel of columns [jb,je)
+          for (unsigned int j = jb; j < je; ++j)
+            {
+              const double d = F[j * f + j];
+              if (d == 0.)
+                return j;
+
+              for (unsigned int c = j + 1; c < je; ++c)
+                column_in_panel[c - j] = F[c * f + j];
+              const double inverse_d = 1. / d;
+              for (unsigned int i = j + 1; i < f; ++i)
+                {
+                  double *     row = F + i * f;
+                  const double l   = (row[j] *= inverse_d);
+                  if (l != 0.)
+                    {
+                      const unsigned int c_end = std::min(i + 1, je);
+                      for (unsigned int c = j + 1; c < c_end; ++c)
+                        row[c] -= l * column_in_panel[c - j];
+                    }
+                }
+            }
+
+          // update the lower triangle of the trailing matrix with the panel
+          // scaled by D, stored transposed for contiguous access
+          scaled_panel.resize((je - jb) * f);
+          for (unsigned int l = jb; l < je; ++l)
+            {
+              const double d = F[l * f + l];
+              for (unsigned int c = je; c < f; ++c)
+                scaled_panel[(l - jb) * f + c] = F[c * f + l] * d;
+            }
+          apply_to_rows(
+            je,
+            f,
+            std::size_t(f - je) * (f - je) * (je - jb) / 2,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int i = begin; i < end; ++i)
+                {
+                  double *row = F + i * f;
+                  for (unsigned int l = jb; l < je; ++l)
+                    {
+                      const double  a = row[l];
+                      const double *w = scaled_panel.data() + (l - jb) * f;
+                      if (a != 0.)
+                        for (unsigned int c = je; c <= i; ++c)
+                          row[c] -= a * w[c];
+                    }
+                }
+            });
+        }
+
+      return numbers::invalid_unsigned_int;
+    }
+
+
+
+    // dst -= factor * src for rows of n entries
+    inline void
+    subtract_row(double *           dst,
+                 const double       factor,
+                 const double *     src,
+                 const unsigned int n)
+    {
+      for (unsigned int c = 0; c < n; ++c)
+        dst[c] -= factor * src[c];
+    }
+  } // namespace SparseDirectSupernodalImplementation
+} // namespace internal
+
+
+
+SparseDirectSupernodal::AdditionalData::AdditionalData(
+  const Factorization factorization,
+  const Ordering      ordering)
+  : factorization(factorization)
+  , ordering(ordering)
+{}
+
+
+
+SparseDirectSupernodal::SparseDirectSupernodal()
+  : n_rows(0)
+{}
+
+
+
+void
+SparseDirectSupernodal::clear()
+{
+  n_rows = 0;
+  permutation.clear();
+  supernode_start.clear();
+  supernode_parent.clear();
+  children_start.clear();
+  children.clear();
+  structure_start.clear();
+  structure.clear();
+  level_start.clear();
+  level_supernodes.clear();
+  factor_start.clear();
+  factor_values.clear();
+  pivots.clear();
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectSupernodal::initialize(const Matrix &        matrix,
+                                   const AdditionalData &data)
+{
+  additional_data = data;
+  factorize(matrix);
+}
+
+
+
+template <class Matrix>
+void
+SparseDirectSupernodal::factorize(const Matrix &matrix)
+{
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
+
+  clear();
+
+  n_rows = matrix.m();
+  if (n_rows == 0)
+    return;
+
+  // copy the matrix to compressed row storage. note that the iterators of
+  // block matrices do not traverse the entries of a row in order, but this
+  // does not matter here
+  std::vector<std::size_t> row_start(n_rows + 1);
+  row_start[0] = 0;
+  for (size_type row = 0; row < n_rows; ++row)
+    row_start[row + 1] = row_start[row] + matrix.get_row_length(row);
+
+  std::vector<size_type> column_indices(row_start.back());
+  std::vector<double>    values(row_start.back());
+  for (size_type row = 0; row < n_rows; ++row)
+    {
+      std::size_t index = row_start[row];
+      for (typename Matrix::const_iterator p = matrix.begin(row);
+           p != matrix.end(row);
+           ++p, ++index)
+        {
+          column_indices[index] = p->column();
+          values[index]         = p->value();
+        }
+      Assert(index == row_start[row + 1], ExcInternalError());
+    }
+
+  analyze(row_start, column_indices);
+  factorize_numerically(row_start, column_indices, values);
+}
+
+
+
+void
+SparseDirectSupernodal::analyze(const std::vector<std::size_t> &row_start,
+                                const std::vector<size_type> &  column_indices)
+{
+  using namespace internal::SparseDirectSupernodalImplementation;
+
+  const size_type N = n_rows;
+  const Graph     graph = symmetrized_graph(row_start, column_indices);
+
+  // compute the fill-reducing ordering
+  std::vector<size_type> ordering;
+  if (additional_data.ordering ==
+      AdditionalData::Ordering::nested_dissection)
+    ordering = NestedDissection(graph).compute();
+  else
+    {
+      ordering.resize(N);
+      std::iota(ordering.begin(), ordering.end(), size_type(0));
+    }
+
+  std::vector<size_type> inverse_ordering(N);
+  for (size_type i = 0; i < N; ++i)
+    inverse_ordering[ordering[i]] = i;
+
+  // compute the elimination tree of the reordered matrix with the algorithm
+  // by Liu, using path compression on the ancestors
+  std::vector<size_type> parent(N, numbers::invalid_size_type);
+  {
+    std::vector<size_type> ancestor(N, numbers::invalid_size_type);
+    for (size_type i = 0; i < N; ++i)
+      {
+        const size_type original = ordering[i];
+        for (std::size_t e = graph.start[original];
+             e < graph.start[original + 1];
+             ++e)
+          {
+            size_type j = inverse_ordering[graph.neighbors[e]];
+            if (j >= i)
+              continue;
+            while (ancestor[j] != numbers::invalid_size_type &&
+                   ancestor[j] != i)
+              {
+                const size_type next = ancestor[j];
+                ancestor[j]          = i;
+                j                    = next;
+              }
+            if (ancestor[j] == numbers::invalid_size_type)
+              {
+                ancestor[j] = i;
+                parent[j]   = i;
+              }
+          }
+      }
+  }
+
+  // postorder the elimination tree, such that every subtree consists of
+  // consecutive indices, and combine the postordering with the ordering
+  {
+    std::vector<size_type> first_child(N, numbers::invalid_size_type);
+    std::vector<size_type> next_sibling(N, numbers::invalid_size_type);
+    for (size_type j = N; j-- > 0;)
+      if (parent[j] != numbers::invalid_size_type)
+        {
+          next_sibling[j]        = first_child[parent[j]];
+          first_child[parent[j]] = j;
+        }
+
+    std::vector<size_type> postorder;
+    postorder.reserve(N);
+    std::vector<size_type> stack;
+    for (size_type root = 0; root < N; ++root)
+      if (parent[root] == numbers::invalid_size_type)
+        {
+          stack.push_back(root);
+          while (!stack.empty())
+            {
+              const size_type j = stack.back();
+              if (first_child[j] != numbers::invalid_size_type)
+                {
+                  // descend into the first child not yet visited, and remove
+                  // it from the list of children
+                  const size_type child = first_child[j];
+                  first_child[j]        = next_sibling[child];
+                  stack.push_back(child);
+                }
+              else
+                {
+                  postorder.push_back(j);
+                  stack.pop_back();
+                }
+            }
+        }
+    AssertDimension(postorder.size(), N);
+
+    std::vector<size_type> inverse_postorder(N);
+    for (size_type k = 0; k < N; ++k)
+      inverse_postorder[postorder[k]] = k;
+
+    permutation.resize(N);
+    std::vector<size_type> new_parent(N);
+    for (size_type k = 0; k < N; ++k)
+      {
+        permutation[k] = ordering[postorder[k]];
+        new_parent[k]  = parent[postorder[k]] == numbers::invalid_size_type ?
+                           numbers::invalid_size_type :
+                           inverse_postorder[parent[postorder[k]]];
+      }
+    parent.swap(new_parent);
+    for (size_type k = 0; k < N; ++k)
+      inverse_ordering[permutation[k]] = k;
+  }
+
+  // compute the structure of the columns of L and group them into
+  // fundamental supernodes, i.e., chains of columns where each column is the
+  // only child of the next one and has the same structure apart from the
+  // next column
+  std::vector<size_type>              fundamental_start;
+  std::vector<std::vector<size_type>> fundamental_rows;
+  {
+    std::vector<size_type> n_children(N, 0);
+    for (size_type j = 0; j < N; ++j)
+      if (parent[j] != numbers::invalid_size_type)
+        ++n_children[parent[j]];
+    std::vector<size_type> child_start(N + 1, 0);
+    for (size_type j = 0; j < N; ++j)
+      child_start[j + 1] = child_start[j] + n_children[j];
+    std::vector<size_type> column_children(child_start[N]);
+    {
+      std::vector<size_type> next(child_start.begin(), child_start.end() - 1);
+      for (size_type j = 0; j < N; ++j)
+        if (parent[j] != numbers::invalid_size_type)
+          column_children[next[parent[j]]++] = j;
+    }
+
+    std::vector<std::vector<size_type>> column_structure(N);
+    std::vector<size_type>              marker(N, numbers::invalid_size_type);
+    for (size_type j = 0; j < N; ++j)
+      {
+        std::vector<size_type> &rows = column_structure[j];
+        marker[j]                    = j;
+        const size_type original     = permutation[j];
+        for (std::size_t e = graph.start[original];
+             e < graph.start[original + 1];
+             ++e)
+          {
+            const size_type i = inverse_ordering[graph.neighbors[e]];
+            if (i > j && marker[i] != j)
+              {
+                marker[i] = j;
+                rows.push_back(i);
+              }
+          }
+        for (size_type c = child_start[j]; c < child_start[j + 1]; ++c)
+          for (const size_type i : column_structure[column_children[c]])
+            if (i != j && marker[i] != j)
+              {
+                marker[i] = j;
+                rows.push_back(i);
+              }
+        std::sort(rows.begin(), rows.end());
+
+        const bool continues_supernode =
+          j > 0 && parent[j - 1] == j && n_children[j] == 1 &&
+          column_structure[j - 1].size() == rows.size() + 1;
+        if (!continues_supernode)
+          {
+            if (j > 0)
+              fundamental_rows.push_back(column_structure[j - 1]);
+            fundamental_start.push_back(j);
+          }
+
+        // the structures of the children are not needed any more
+        for (size_type c = child_start[j]; c < child_start[j + 1]; ++c)
+          std::vector<size_type>().swap(column_structure[column_children[c]]);
+      }
+    fundamental_rows.push_back(column_structure[N - 1]);
+    fundamental_start.push_back(N);
+  }
+
+  // merge small supernodes into their parent if they are the last child of
+  // the parent, such that the columns of the two are adjacent, and the
+  // number of additional zeros in the factor stays moderate. the rows of the
+  // merged supernode are those of the parent
+  std::vector<size_type>              first_column;
+  std::vector<std::vector<size_type>> rows;
+  for (unsigned int s = 0; s + 1 < fundamental_start.size(); ++s)
+    {
+      first_column.push_back(fundamental_start[s]);
+      rows.push_back(std::move(fundamental_rows[s]));
+      const size_type end_column = fundamental_start[s + 1];
+      while (first_column.size() > 1)
+        {
+          const unsigned int p = first_column.size() - 1;
+          const unsigned int q = p - 1;
+          if (rows[q].empty() || rows[q][0] >= end_column)
+            break;
+
+          const std::size_t k_q = first_column[p] - first_column[q];
+          const std::size_t k_p = end_column - first_column[p];
+          const std::size_t r_q = rows[q].size();
+          const std::size_t r_p = rows[p].size();
+          const std::size_t k   = k_q + k_p;
+          const std::size_t old_size =
+            k_q * (k_q + 1) / 2 + k_q * r_q + k_p * (k_p + 1) / 2 + k_p * r_p;
+          const std::size_t new_size = k * (k + 1) / 2 + k * r_p;
+          if (k > relaxed_supernode_size || 4 * new_size > 5 * old_size)
+            break;
+
+          rows[q] = std::move(rows[p]);
+          first_column.pop_back();
+          rows.pop_back();
+        }
+    }
+
+  // set up the data structures of the supernodes
+  const unsigned int n_supernodes = first_column.size();
+  supernode_start                 = first_column;
+  supernode_start.push_back(N);
+
+  std::vector<unsigned int> column_to_supernode(N);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    for (size_type j = supernode_start[s]; j < supernode_start[s + 1]; ++j)
+      column_to_supernode[j] = s;
+
+  structure_start.resize(n_supernodes + 1);
+  structure_start[0] = 0;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    structure_start[s + 1] = structure_start[s] + rows[s].size();
+  structure.resize(structure_start.back());
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    std::copy(rows[s].begin(),
+              rows[s].end(),
+              structure.begin() + structure_start[s]);
+
+  supernode_parent.resize(n_supernodes);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    supernode_parent[s] = rows[s].empty() ? numbers::invalid_unsigned_int :
+                                            column_to_supernode[rows[s][0]];
+
+  children_start.assign(n_supernodes + 1, 0);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    if (supernode_parent[s] != numbers::invalid_unsigned_int)
+      ++children_start[supernode_parent[s] + 1];
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    children_start[s + 1] += children_start[s];
+  children.resize(children_start.back());
+  {
+    std::vector<unsigned int> next(children_start.begin(),
+                                   children_start.end() - 1);
+    for (unsigned int s = 0; s < n_supernodes; ++s)
+      if (supernode_parent[s] != numbers::invalid_unsigned_int)
+        children[next[supernode_parent[s]]++] = s;
+  }
+
+  // group the supernodes by their height in the tree. children have lower
+  // indices than their parents, so a single pass suffices
+  std::vector<unsigned int> height(n_supernodes, 0);
+  unsigned int              max_height = 0;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      max_height = std::max(max_height, height[s]);
+      if (supernode_parent[s] != numbers::invalid_unsigned_int)
+        height[supernode_parent[s]] =
+          std::max(height[supernode_parent[s]], height[s] + 1);
+    }
+  level_start.assign(max_height + 2, 0);
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    ++level_start[height[s] + 1];
+  for (unsigned int l = 0; l <= max_height; ++l)
+    level_start[l + 1] += level_start[l];
+  level_supernodes.resize(n_supernodes);
+  {
+    std::vector<unsigned int> next(level_start.begin(), level_start.end() - 1);
+    for (unsigned int s = 0; s < n_supernodes; ++s)
+      level_supernodes[next[height[s]]++] = s;
+  }
+
+  const bool is_lu =
+    additional_data.factorization == AdditionalData::Factorization::lu;
+  factor_start.resize(n_supernodes + 1);
+  factor_start[0] = 0;
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const std::size_t k = supernode_start[s + 1] - supernode_start[s];
+      const std::size_t r = structure_start[s + 1] - structure_start[s];
+      factor_start[s + 1] = factor_start[s] + (k + r) * k + (is_lu ? k * r : 0);
+    }
+}
+
+
+
+void
+SparseDirectSupernodal::factorize_numerically(
+  const std::vector<std::size_t> &row_start,
+  const std::vector<size_type> &  column_indices,
+  const std::vector<double> &     values)
+{
+  const size_type N = n_rows;
+  const bool      is_lu =
+    additional_data.factorization == AdditionalData::Factorization::lu;
+
+  std::vector<size_type> inverse_permutation(N);
+  for (size_type i = 0; i < N; ++i)
+    inverse_permutation[permutation[i]] = i;
+
+  // sort the entries of the reordered matrix by the column in which they are
+  // eliminated: entries on and right of the diagonal are stored by rows,
+  // entries left of the diagonal by columns. the latter are only needed for
+  // the LU factorization
+  std::vector<std::size_t> upper_start(N + 1, 0), lower_start(N + 1, 0);
+  for (size_type row = 0; row < N; ++row)
+    {
+      const size_type a = inverse_permutation[row];
+      for (std::size_t e = row_start[row]; e < row_start[row + 1]; ++e)
+        {
+          const size_type b = inverse_permutation[column_indices[e]];
+          if (b >= a)
+            ++upper_start[a + 1];
+          else if (is_lu)
+            ++lower_start[b + 1];
+        }
+    }
+  for (size_type i = 0; i < N; ++i)
+    {
+      upper_start[i + 1] += upper_start[i];
+      lower_start[i + 1] += lower_start[i];
+    }
+  std::vector<size_type> upper_indices(upper_start.back()),
+    lower_indices(lower_start.back());
+  std::vector<double> upper_values(upper_start.back()),
+    lower_values(lower_start.back());
+  {
+    std::vector<std::size_t> upper_next(upper_start.begin(),
+                                        upper_start.end() - 1);
+    std::vector<std::size_t> lower_next(lower_start.begin(),
+                                        lower_start.end() - 1);
+    for (size_type row = 0; row < N; ++row)
+      {
+        const size_type a = inverse_permutation[row];
+        for (std::size_t e = row_start[row]; e < row_start[row + 1]; ++e)
+          {
+            const size_type b = inverse_permutation[column_indices[e]];
+            if (b >= a)
+              {
+                upper_indices[upper_next[a]] = b;
+                upper_values[upper_next[a]]  = values[e];
+                ++upper_next[a];
+              }
+            else if (is_lu)
+              {
+                lower_indices[lower_next[b]] = a;
+                lower_values[lower_next[b]]  = values[e];
+                ++lower_next[b];
+              }
+          }
+      }
+  }
+
+  factor_values.assign(factor_start.back(), 0.);
+  pivots.resize(N);
+
+  // factorize the supernodes level by level. the supernodes within a level
+  // are independent of each other
+  std::vector<std::vector<double>> update_matrices(supernode_parent.size());
+  size_type                        zero_pivot = numbers::invalid_size_type;
+  Threads::Mutex                   mutex;
+  const auto factorize_range = [&](const unsigned int begin,
+                                   const unsigned int end) {
+    for (unsigned int i = begin; i < end; ++i)
+      {
+        const size_type row = factorize_supernode(level_supernodes[i],
+                                                  upper_start,
+                                                  upper_indices,
+                                                  upper_values,
+                                                  lower_start,
+                                                  lower_indices,
+                                                  lower_values,
+                                                  update_matrices);
+        if (row != numbers::invalid_size_type)
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            zero_pivot = std::min(zero_pivot, row);
+          }
+      }
+  };
+
+  for (unsigned int l = 0; l + 1 < level_start.size(); ++l)
+    {
+      if (level_start[l + 1] - level_start[l] > 1 &&
+          MultithreadInfo::n_threads() > 1)
+        parallel::apply_to_subranges(level_start[l],
+                                     level_start[l + 1],
+                                     factorize_range,
+                                     1);
+      else
+        factorize_range(level_start[l], level_start[l + 1]);
+
+      AssertThrow(zero_pivot == numbers::invalid_size_type,
+                  ExcZeroPivot(permutation[zero_pivot]));
+    }
+}
+
+
+
+SparseDirectSupernodal::size_type
+SparseDirectSupernodal::factorize_supernode(
+  const unsigned int                supernode,
+  const std::vector<std::size_t> &  upper_start,
+  const std::vector<size_type> &    upper_indices,
+  const std::vector<double> &       upper_values,
+  const std::vector<std::size_t> &  lower_start,
+  const std::vector<size_type> &    lower_indices,
+  const std::vector<double> &       lower_values,
+  std::vector<std::vector<double>> &update_matrices)
+{
+  using namespace internal::SparseDirectSupernodalImplementation;
+
+  const bool is_lu =
+    additional_data.factorization == AdditionalData::Factorization::lu;
+
+  const size_type    first = supernode_start[supernode];
+  const size_type    last  = supernode_start[supernode + 1];
+  const unsigned int k     = last - first;
+  const unsigned int r =
+    structure_start[supernode + 1] - structure_start[supernode];
+  const unsigned int f    = k + r;
+  const size_type *  rows = structure.data() + structure_start[supernode];
+
+  // the frontal matrix is indexed by the columns of the supernode followed
+  // by the rows below its diagonal block
+  const auto local_index = [&](const size_type index) -> unsigned int {
+    if (index < last)
+      return index - first;
+    const size_type *position = std::lower_bound(rows, rows + r, index);
+    Assert(position != rows + r && *position == index, ExcInternalError());
+    return k + (position - rows);
+  };
+
+  std::vector<double> front(std::size_t(f) * f, 0.);
+
+  // add the entries of the matrix
+  for (size_type column = first; column < last; ++column)
+    {
+      const unsigned int j = column - first;
+      for (std::size_t e = upper_start[column]; e < upper_start[column + 1];
+           ++e)
+        {
+          const unsigned int i = local_index(upper_indices[e]);
+          if (is_lu)
+            front[std::size_t(j) * f + i] += upper_values[e];
+          else
+            front[std::size_t(i) * f + j] += upper_values[e];
+        }
+      for (std::size_t e = lower_start[column]; e < lower_start[column + 1];
+           ++e)
+        front[std::size_t(local_index(lower_indices[e])) * f + j] +=
+          lower_values[e];
+    }
+
+  // add the update matrices of the children
+  std::vector<unsigned int> child_to_front;
+  for (unsigned int c = children_start[supernode];
+       c < children_start[supernode + 1];
+       ++c)
+    {
+      const unsigned int child      = children[c];
+      const size_type *  child_rows = structure.data() + structure_start[child];
+      const unsigned int child_r =
+        structure_start[child + 1] - structure_start[child];
+
+      // the rows of the child are a sorted subset of the indices of the front
+      child_to_front.resize(child_r);
+      unsigned int position = 0;
+      for (unsigned int i = 0; i < child_r; ++i)
+        if (child_rows[i] < last)
+          child_to_front[i] = child_rows[i] - first;
+        else
+          {
+            while (rows[position] < child_rows[i])
+              ++position;
+            Assert(rows[position] == child_rows[i], ExcInternalError());
+            child_to_front[i] = k + position;
+          }
+
+      const std::vector<double> &update = update_matrices[child];
+      for (unsigned int i = 0; i < child_r; ++i)
+        {
+          double *front_row = front.data() + std::size_t(child_to_front[i]) * f;
+          const double *update_row = update.data() + std::size_t(i) * child_r;
+          const unsigned int n_columns = is_lu ? child_r : i + 1;
+          for (unsigned int j = 0; j < n_columns; ++j)
+            front_row[child_to_front[j]] += update_row[j];
+        }
+      std::vector<double>().swap(update_matrices[child]);
+    }
+
+  // eliminate the columns of the supernode
+  const unsigned int zero_pivot =
+    is_lu ? partial_lu(front.data(), f, k, pivots.data() + first) :
+            partial_ldlt(front.data(), f, k);
+  if (zero_pivot != numbers::invalid_unsigned_int)
+    return first + zero_pivot;
+
+  // store the factors and the update matrix for the parent
+  double *factor = factor_values.data() + factor_start[supernode];
+  for (unsigned int i = 0; i < f; ++i)
+    std::copy(front.data() + std::size_t(i) * f,
+              front.data() + std::size_t(i) * f + k,
+              factor + std::size_t(i) * k);
+  if (is_lu)
+    for (unsigned int j = 0; j < k; ++j)
+      std::copy(front.data() + std::size_t(j) * f + k,
+                front.data() + std::size_t(j) * f + f,
+                factor + std::size_t(f) * k + std::size_t(j) * r);
+
+  if (r > 0)
+    {
+      std::vector<double> &update = update_matrices[supernode];
+      update.resize(std::size_t(r) * r);
+      for (unsigned int i = 0; i < r; ++i)
+        std::copy(front.data() + std::size_t(k + i) * f + k,
+                  front.data() + std::size_t(k + i) * f + f,
+                  update.data() + std::size_t(i) * r);
+    }
+
+  return numbers::invalid_size_type;
+}
+
+
+
+void
+SparseDirectSupernodal::solve_permuted(double *           values,
+                                       const unsigned int n_rhs,
+                                       const bool         transpose) const
+{
+  using internal::SparseDirectSupernodalImplementation::subtract_row;
+
+  const bool is_lu =
+    additional_data.factorization == AdditionalData::Factorization::lu;
+  const unsigned int n_supernodes = supernode_parent.size();
+
+  const auto row = [&](const size_type index) {
+    return values + index * n_rhs;
+  };
+
+  // forward substitution, from the leaves to the roots
+  for (unsigned int s = 0; s < n_supernodes; ++s)
+    {
+      const size_type    first = supernode_start[s];
+      const unsigned int k     = supernode_start[s + 1] - first;
+      const unsigned int r     = structure_start[s + 1] - structure_start[s];
+      const size_type *  rows  = structure.data() + structure_start[s];
+      const double *     L     = factor_values.data() + factor_start[s];
+      const double *     U     = L + std::size_t(k + r) * k;
+      double *           x     = row(first);
+
+      if (is_lu && transpose)
+        {
+          // solve with U^T, which is lower triangular
+          for (unsigned int j = 0; j < k; ++j)
+            {
+              for (unsigned int c = 0; c < j; ++c)
+                subtract_row(x + j * n_rhs, L[c * k + j], x + c * n_rhs, n_rhs);
+              const double inverse_diagonal = 1. / L[j * k + j];
+              for (unsigned int c = 0; c < n_rhs; ++c)
+                x[j * n_rhs + c] *= inverse_diagonal;
+            }
+          for (unsigned int i = 0; i < r; ++i)
+            for (unsigned int j = 0; j < k; ++j)
+              subtract_row(row(rows[i]), U[j * r + i], x + j * n_rhs, n_rhs);
+        }
+      else
+        {
+          if (is_lu)
+            for (unsigned int j = 0; j < k; ++j)
+              if (pivots[first + j] != j)
+                std::swap_ranges(x + j * n_rhs,
+                                 x + (j + 1) * n_rhs,
+                                 x + pivots[first + j] * n_rhs);
+
+          // solve with the unit lower triangular diagonal block of L
+          for (unsigned int j = 0; j < k; ++j)
+            for (unsigned int i = j + 1; i < k; ++i)
+              subtract_row(x + i * n_rhs, L[i * k + j], x + j * n_rhs, n_rhs);
+          for (unsigned int i = 0; i < r; ++i)
+            for (unsigned int j = 0; j < k; ++j)
+              subtract_row(row(rows[i]),
+                           L[(k + i) * k + j],
+                           x + j * n_rhs,
+                           n_rhs);
+
+          if (!is_lu)
+            for (unsigned int j = 0; j < k; ++j)
+              {
+                const double inverse_diagonal = 1. / L[j * k + j];
+                for (unsigned int c = 0; c < n_rhs; ++c)
+                  x[j * n_rhs + c] *= inverse_diagonal;
+              }
+        }
+    }
+
+  // backward substitution, from the roots to the leaves
+  for (unsigned int s = n_supernodes; s-- > 0;)
+    {
+      const size_type    first = supernode_start[s];
+      const unsigned int k     = supernode_start[s + 1] - first;
+      const unsigned int r     = structure_start[s + 1] - structure_start[s];
+      const size_type *  rows  = structure.data() + structure_start[s];
+      const double *     L     = factor_values.data() + factor_start[s];
+      const double *     U     = L + std::size_t(k + r) * k;
+      double *           x     = row(first);
+
+      if (is_lu && !transpose)
+        {
+          // solve with U
+          for (unsigned int j = 0; j < k; ++j)
+            for (unsigned int i = 0; i < r; ++i)
+              subtract_row(x + j * n_rhs, U[j * r + i], row(rows[i]), n_rhs);
+          for (unsigned int j = k; j-- > 0;)
+            {
+              for (unsigned int c = j + 1; c < k; ++c)
+                subtract_row(x + j * n_rhs, L[j * k + c], x + c * n_rhs, n_rhs);
+              const double inverse_diagonal = 1. / L[j * k + j];
+              for (unsigned int c = 0; c < n_rhs; ++c)
+                x[j * n_rhs + c] *= inverse_diagonal;
+            }
+        }
+      else
+        {
+          // solve with L^T, which is unit upper triangular
+          for (unsigned int j = 0; j < k; ++j)
+            for (unsigned int i = 0; i < r; ++i)
+              subtract_row(x + j * n_rhs,
+                           L[(k + i) * k + j],
+                           row(rows[i]),
+                           n_rhs);
+          for (unsigned int j = k; j-- > 0;)
+            for (unsigned int i = j + 1; i < k; ++i)
+              subtract_row(x + j * n_rhs, L[i * k + j], x + i * n_rhs, n_rhs);
+
+          if (is_lu)
+            for (unsigned int j = k; j-- > 0;)
+              if (pivots[first + j] != j)
+                std::swap_ranges(x + j * n_rhs,
+                                 x + (j + 1) * n_rhs,
+                                 x + pivots[first + j] * n_rhs);
+        }
+    }
+}
+
+
+
+void
+SparseDirectSupernodal::solve(Vector<double> &rhs_and_solution,
+                              const bool      transpose) const
+{
+  AssertDimension(rhs_and_solution.size(), n_rows);
+
+  std::vector<double> values(n_rows);
+  for (size_type i = 0; i < n_rows; ++i)
+    values[i] = rhs_and_solution(permutation[i]);
+  solve_permuted(values.data(), 1, transpose);
+  for (size_type i = 0; i < n_rows; ++i)
+    rhs_and_solution(permutation[i]) = values[i];
+}
+
+
+
+void
+SparseDirectSupernodal::solve(BlockVector<double> &rhs_and_solution,
+                              const bool           transpose) const
+{
+  // the factorization works on the unblocked system, so copy the vector
+  Vector<double> vector(rhs_and_solution.size());
+  vector = rhs_and_solution;
+  solve(vector, transpose);
+  rhs_and_solution = vector;
+}
+
+
+
+void
+SparseDirectSupernodal::solve(FullMatrix<double> &rhs_and_solution,
+                              const bool          transpose) const
+{
+  AssertDimension(rhs_and_solution.m(), n_rows);
+
+  const unsigned int  n_rhs = rhs_and_solution.n();
+  std::vector<double> values(std::size_t(n_rows) * n_rhs);
+  for (size_type i = 0; i < n_rows; ++i)
+    for (unsigned int c = 0; c < n_rhs; ++c)
+      values[i * n_rhs + c] = rhs_and_solution(permutation[i], c);
+  solve_permuted(values.data(), n_rhs, transpose);
+  for (size_type i = 0; i < n_rows; ++i)
+    for (unsigned int c = 0; c < n_rhs; ++c)
+      rhs_and_solution(permutation[i], c) = values[i * n_rhs + c];
+}
+
+
+
+void
+SparseDirectSupernodal::vmult(Vector<double> &      dst,
+                              const Vector<double> &src) const
+{
+  dst = src;
+  this->solve(dst);
+}
+
+
+
+void
+SparseDirectSupernodal::vmult(BlockVector<double> &      dst,
+                              const BlockVector<double> &src) const
+{
+  dst = src;
+  this->solve(dst);
+}
+
+
+
+void
+SparseDirectSupernodal::Tvmult(Vector<double> &      dst,
+                               const Vector<double> &src) const
+{
+  dst = src;
+  this->solve(dst, /*transpose=*/true);
+}
+
+
+
+void
+SparseDirectSupernodal::Tvmult(BlockVector<double> &      dst,
+                               const BlockVector<double> &src) const
+{
+  dst = src;
+  this->solve(dst, /*transpose=*/true);
+}
+
+
+
+SparseDirectSupernodal::size_type
+SparseDirectSupernodal::m() const
+{
+  Assert(n_rows != 0, ExcNotInitialized());
+  return n_rows;
+}
+
+
+
+SparseDirectSupernodal::size_type
+SparseDirectSupernodal::n() const
+{
+  Assert(n_rows != 0, ExcNotInitialized());
+  return n_rows;
+}
+
+
+
+std::size_t
+SparseDirectSupernodal::n_nonzero_elements() const
+{
+  return factor_values.size();
+}
+
+
+
+unsigned int
+SparseDirectSupernodal::n_supernodes() const
+{
+  return supernode_parent.size();
+}
+
+
+
+std::size_t
+SparseDirectSupernodal::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(permutation) +
+         MemoryConsumption::memory_consumption(supernode_start) +
+         MemoryConsumption::memory_consumption(supernode_parent) +
+         MemoryConsumption::memory_consumption(children_start) +
+         MemoryConsumption::memory_consumption(children) +
+         MemoryConsumption::memory_consumption(structure_start) +
+         MemoryConsumption::memory_consumption(structure) +
+         MemoryConsumption::memory_consumption(level_start) +
+         MemoryConsumption::memory_consumption(level_supernodes) +
+         MemoryConsumption::memory_consumption(factor_start) +
+         MemoryConsumption::memory_consumption(factor_values) +
+         MemoryConsumption::memory_consumption(pivots);
+}
+
+
+
+// explicit instantiations
+#define InstantiateSupernodal(MatrixType)                              \
+  template void SparseDirectSupernodal::factorize(const MatrixType &);   \
+  template void SparseDirectSupernodal::initialize(const MatrixType &,   \
+                                                   const AdditionalData &)
+
+InstantiateSupernodal(SparseMatrix<double>);
+InstantiateSupernodal(SparseMatrix<float>);
+InstantiateSupernodal(SparseMatrixEZ<double>);
+InstantiateSupernodal(SparseMatrixEZ<float>);
+InstantiateSupernodal(BlockSparseMatrix<double>);
+InstantiateSupernodal(BlockSparseMatrix<float>);
+
+DEAL_II_NAMESPACE_CLOSE
@@ -26,6 +26,7 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -45,6 +46,7 @@ SparsityPatternBase::SparsityPatternBase()
   , max_row_length(0)
   , rowstart(nullptr)
   , colnums(nullptr)
+  , column_offsets(nullptr)
   , compressed(false)
 {}
 
@@ -235,6 +237,9 @@ SparsityPattern::reinit(const size_type                      m,
   rows = m;
   cols = n;
 
+  // the column offsets refer to the previous content of the object
+  column_offsets.reset();
+
   // delete empty matrices
   if ((m == 0) || (n == 0))
     {
@@ -438,6 +443,33 @@ SparsityPattern::compress()
 
 
 
+bool
+SparsityPattern::store_column_offsets()
+{
+  Assert(compressed, ExcNotCompressed());
+
+  column_offsets.reset();
+
+  // nothing to store for an empty matrix, and nothing we can store if the
+  // difference between row and column index of some entry does not fit into
+  // a 32-bit signed integer
+  if ((rowstart == nullptr) ||
+      (bandwidth() >
+       static_cast<size_type>(std::numeric_limits<std::int32_t>::max())))
+    return false;
+
+  column_offsets = std::make_unique<std::int32_t[]>(max_vec_len);
+  for (size_type row = 0; row < rows; ++row)
+    for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+      column_offsets[j] = static_cast<std::int32_t>(
+        static_cast<long long int>(colnums[j]) -
+        static_cast<long long int>(row));
+
+  return true;
+}
+
+
+
 void
 SparsityPattern::copy_from(const SparsityPattern &sp)
 {
@@ -1008,6 +1040,7 @@ SparsityPattern::block_read(std::istream &in)
   // reallocate space
   rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
   colnums  = std::make_unique<size_type[]>(max_vec_len);
+  column_offsets.reset();
 
   // then read data
   in.read(reinterpret_cast<char *>(rowstart.get()),
@@ -1030,7 +1063,9 @@ std::size_t
 SparsityPatternBase::memory_consumption() const
 {
   return (max_dim * sizeof(size_type) + sizeof(*this) +
-          max_vec_len * sizeof(size_type));
+          max_vec_len * sizeof(size_type) +
+          (column_offsets != nullptr ? max_vec_len * sizeof(std::int32_t) :
+                                       0));
 }
 
 
@@ -67,6 +67,11 @@ namespace internal
 
 template <int dim, typename DoFHandlerType>
 DataOut<dim, DoFHandlerType>::DataOut()
+  : cache_geometry(false)
+  , geometry_cache_valid(false)
+  , geometry_cache_triangulation(nullptr)
+  , geometry_cache_n_subdivisions(0)
+  , geometry_cache_curved_cell_region(no_curved_cells)
 {
   // For the moment, just call the existing virtual functions. This
   // preserves backward compatibility. When these deprecated functions are
@@ -83,6 +88,14 @@ DataOut<dim, DoFHandlerType>::DataOut()
 
 
 
+template <int dim, typename DoFHandlerType>
+DataOut<dim, DoFHandlerType>::~DataOut()
+{
+  tria_listener.disconnect();
+}
+
+
+
 template <int dim, typename DoFHandlerType>
 void
 DataOut<dim, DoFHandlerType>::build_one_patch(
@@ -93,10 +106,21 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   const unsigned int     n_subdivisions,
   const CurvedCellRegion curved_cell_region)
 {
-  // first create the output object that we will write into
+  const unsigned int patch_idx =
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx < this->patches.size(), ExcInternalError());
+
+  // first create the output object that we will write into. if this
+  // function has been called before for the same cell, the patches vector
+  // still holds the data table of the patch built back then; take over its
+  // memory so that reinit() below does not need to allocate in the common
+  // case of repeated output on the same mesh
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
                                DoFHandlerType::space_dimension>
     patch;
+  patch.data.swap(this->patches[patch_idx].data);
   patch.n_subdivisions = n_subdivisions;
   patch.reference_cell = cell_and_index->first->reference_cell();
 
@@ -106,11 +130,15 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   const FEValuesBase<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
     &fe_patch_values = scratch_data.get_present_fe_values(0);
 
-  // set the vertices of the patch. if the mapping does not preserve locations
-  // (e.g. MappingQEulerian), we need to compute the offset of the vertex for
-  // the graphical output. Otherwise, we can just use the vertex info.
+  // set the vertices of the patch. if they have been cached by a previous
+  // call to build_patches(), take them from there. if the mapping does not
+  // preserve locations (e.g. MappingQEulerian), we need to compute the offset
+  // of the vertex for the graphical output. Otherwise, we can just use the
+  // vertex info.
   for (const unsigned int vertex : cell_and_index->first->vertex_indices())
-    if (scratch_data.mapping_collection[0].preserves_vertex_locations())
+    if (geometry_cache_valid)
+      patch.vertices[vertex] = geometry_cache[patch_idx].vertices[vertex];
+    else if (scratch_data.mapping_collection[0].preserves_vertex_locations())
       patch.vertices[vertex] = cell_and_index->first->vertex(vertex);
     else
       patch.vertices[vertex] =
@@ -143,7 +171,28 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
   // want to produce curved cells everywhere
   //
   // note: a cell is *always* at the boundary if dim<spacedim
-  if (curved_cell_region == curved_inner_cells ||
+  //
+  // if the geometry has been cached, simply copy the points from there
+  if (geometry_cache_valid)
+    {
+      const auto &cached_patch = geometry_cache[patch_idx];
+
+      patch.points_are_available = cached_patch.points_are_available;
+      if (patch.points_are_available)
+        {
+          patch.data.reinit(scratch_data.n_datasets +
+                              DoFHandlerType::space_dimension,
+                            n_q_points);
+          for (unsigned int i = 0; i < DoFHandlerType::space_dimension; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              patch.data(patch.data.size(0) - DoFHandlerType::space_dimension +
+                           i,
+                         q) = cached_patch.data(i, q);
+        }
+      else
+        patch.data.reinit(scratch_data.n_datasets, n_q_points);
+    }
+  else if (curved_cell_region == curved_inner_cells ||
       (curved_cell_region == curved_boundary &&
        (cell_and_index->first->at_boundary() ||
         (DoFHandlerType::dimension != DoFHandlerType::space_dimension))) ||
@@ -176,6 +225,28 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
       patch.points_are_available = false;
     }
 
+  // store the geometry for later calls if requested. every patch is built by
+  // exactly one thread, so no synchronization is necessary here
+  if (cache_geometry && !geometry_cache_valid)
+    {
+      auto &cached_patch = geometry_cache[patch_idx];
+
+      for (const unsigned int vertex : cell_and_index->first->vertex_indices())
+        cached_patch.vertices[vertex] = patch.vertices[vertex];
+      cached_patch.points_are_available = patch.points_are_available;
+      if (patch.points_are_available)
+        {
+          cached_patch.data.reinit(DoFHandlerType::space_dimension,
+                                   n_q_points);
+          for (unsigned int i = 0; i < DoFHandlerType::space_dimension; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              cached_patch.data(i, q) =
+                patch.data(patch.data.size(0) -
+                             DoFHandlerType::space_dimension + i,
+                           q);
+        }
+    }
+
 
   // Next fill the information we get from DoF data
   if (scratch_data.n_datasets > 0)
@@ -1065,11 +1136,6 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
     }
 
-  const unsigned int patch_idx =
-    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < this->patches.size(), ExcInternalError());
   patch.patch_index = patch_idx;
 
   // Put the patch into the patches vector. instead of copying the data,
@@ -1210,7 +1276,9 @@ DataOut<dim, DoFHandlerType>::build_patches(
       }
   }
 
-  this->patches.clear();
+  // do not clear the patches vector, but only adjust its size: the patches
+  // left over from a previous call are overwritten one by one, and
+  // build_one_patch() re-uses the memory of their data tables
   this->patches.resize(all_cells.size());
 
   // Now create a default object for the WorkStream object to work with. The
@@ -1243,8 +1311,19 @@ DataOut<dim, DoFHandlerType>::build_patches(
   const CurvedCellRegion curved_cell_region =
     (n_subdivisions < 2 ? no_curved_cells : curved_region);
 
+  // the geometry stored by a previous call can only be used if it was
+  // computed for the same set of patches
+  if (geometry_cache_valid &&
+      (this->triangulation != geometry_cache_triangulation ||
+       n_subdivisions != geometry_cache_n_subdivisions ||
+       curved_cell_region != geometry_cache_curved_cell_region ||
+       all_cells.size() != geometry_cache.size()))
+    clear_geometry_cache();
+  if (cache_geometry && !geometry_cache_valid)
+    geometry_cache.resize(all_cells.size());
+
   UpdateFlags update_flags = update_values;
-  if (curved_cell_region != no_curved_cells)
+  if (curved_cell_region != no_curved_cells && !geometry_cache_valid)
     update_flags |= update_quadrature_points;
 
   for (unsigned int i = 0; i < this->dof_data.size(); ++i)
@@ -1259,15 +1338,54 @@ DataOut<dim, DoFHandlerType>::build_patches(
       "The update of normal vectors may not be requested for evaluation of "
       "data on cells via DataPostprocessor."));
 
+  // if the geometry is taken from the cache and we only need the values of
+  // finite elements whose values do not depend on the mapping, then the
+  // mapping is not needed at all. use the cheapest one available instead of
+  // the one we were given. whether the values of an element depend on the
+  // mapping can be seen from the update flags an FEValues object on a single
+  // point ends up with
+  bool use_linear_mapping =
+    geometry_cache_valid && (update_flags == update_values) &&
+    (this->triangulation->get_reference_cells().size() == 1);
+  if (use_linear_mapping)
+    {
+      const ReferenceCell reference_cell =
+        this->triangulation->get_reference_cells()[0];
+      const Quadrature<DoFHandlerType::dimension> quadrature(
+        reference_cell
+          .template get_gauss_type_quadrature<DoFHandlerType::dimension>(1)
+          .point(0));
+      for (const auto &fe_collection : this->get_fes())
+        for (unsigned int i = 0; i < fe_collection->size(); ++i)
+          if (FEValues<DoFHandlerType::dimension,
+                       DoFHandlerType::space_dimension>(
+                reference_cell.template get_default_linear_mapping<
+                  DoFHandlerType::dimension,
+                  DoFHandlerType::space_dimension>(),
+                (*fe_collection)[i],
+                quadrature,
+                update_values)
+                .get_update_flags() != update_values)
+            use_linear_mapping = false;
+    }
+
   internal::DataOutImplementation::ParallelData<DoFHandlerType::dimension,
                                                 DoFHandlerType::space_dimension>
-    thread_data(n_datasets,
-                n_subdivisions,
-                n_postprocessor_outputs,
-                mapping,
-                this->get_fes(),
-                update_flags,
-                cell_to_patch_index_map);
+    thread_data(
+      n_datasets,
+      n_subdivisions,
+      n_postprocessor_outputs,
+      (use_linear_mapping ?
+         hp::MappingCollection<DoFHandlerType::dimension,
+                               DoFHandlerType::space_dimension>(
+           this->triangulation->get_reference_cells()[0]
+             .template get_default_linear_mapping<
+               DoFHandlerType::dimension,
+               DoFHandlerType::space_dimension>()) :
+         mapping),
+      this->get_fes(),
+      update_flags,
+      cell_to_patch_index_map);
 
   auto worker = [this, n_subdivisions, curved_cell_region](
                   const std::pair<cell_iterator, unsigned int> *cell_and_index,
@@ -1300,6 +1418,20 @@ DataOut<dim, DoFHandlerType>::build_patches(
                     // @ref workstream_paper, on 32 cores) and if
                     8 * MultithreadInfo::n_threads(),
                     64);
+
+  // if requested, the geometry of all patches has now been stored. make sure
+  // it is discarded as soon as the triangulation changes
+  if (cache_geometry && !geometry_cache_valid)
+    {
+      geometry_cache_valid              = true;
+      geometry_cache_triangulation      = &*this->triangulation;
+      geometry_cache_n_subdivisions     = n_subdivisions;
+      geometry_cache_curved_cell_region = curved_cell_region;
+
+      tria_listener.disconnect();
+      tria_listener = this->triangulation->signals.any_change.connect(
+        [this]() { this->clear_geometry_cache(); });
+    }
 }
 
 
@@ -1314,6 +1446,9 @@ DataOut<dim, DoFHandlerType>::set_cell_selection(
 {
   first_cell_function = first_cell;
   next_cell_function  = next_cell;
+
+  // the patches built from now on may belong to different cells
+  clear_geometry_cache();
 }
 
 
@@ -1369,6 +1504,27 @@ DataOut<dim, DoFHandlerType>::get_cell_selection() const
 
 
 
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::set_geometry_caching(const bool cache_geometry)
+{
+  this->cache_geometry = cache_geometry;
+  if (cache_geometry == false)
+    clear_geometry_cache();
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::clear_geometry_cache()
+{
+  geometry_cache_valid = false;
+  geometry_cache.clear();
+}
+
+
+
 template <int dim, typename DoFHandlerType>
 typename DataOut<dim, DoFHandlerType>::cell_iterator
 DataOut<dim, DoFHandlerType>::first_cell()
@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test DataOutInterface::write_in_background: rebuilding the patches and
+// changing the flags right after starting a write must not affect the file
+// being written
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include "../tests.h"
+
+
+
+std::string
+file_contents(const std::string &filename)
+{
+  std::ostringstream contents;
+  {
+    std::ifstream in(filename);
+    contents << in.rdbuf();
+  }
+  std::remove(filename.c_str());
+  return contents.str();
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  FE_Q<dim>       fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = i;
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches();
+  data_out.set_max_background_writes(2);
+
+  // suppress the time stamp so that the files can be compared
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  // the reference output, written synchronously
+  std::ostringstream first_reference;
+  data_out.write_vtu(first_reference);
+
+  Threads::Task<void> first_write =
+    data_out.write_in_background("output_1", DataOutBase::vtu);
+
+  // change both the data and the flags while the first write may still be
+  // running
+  solution *= 2.;
+  data_out.build_patches();
+  flags.compression_level = DataOutBase::VtkFlags::best_compression;
+  data_out.set_flags(flags);
+
+  std::ostringstream second_reference;
+  data_out.write_vtu(second_reference);
+  data_out.write_in_background("output_2", DataOutBase::vtu);
+
+  first_write.join();
+  deallog << "First file matches: "
+          << (file_contents("output_1") == first_reference.str() ? "yes" :
+                                                                    "no")
+          << std::endl;
+
+  data_out.wait_for_background_writes();
+  deallog << "Second file matches: "
+          << (file_contents("output_2") == second_reference.str() ? "yes" :
+                                                                     "no")
+          << std::endl;
+
+  // the snapshots must not refer to the DataOut object any more
+  data_out.write_in_background("output_3", DataOutBase::vtu);
+  data_out.clear();
+  data_out.wait_for_background_writes();
+  deallog << "Third file matches: "
+          << (file_contents("output_3") == second_reference.str() ? "yes" :
+                                                                    "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(2);
+
+  check<1>();
+  check<2>();
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check VtkFlags::write_appended_raw_data: write uncompressed VTU output with
+// the data arrays in the AppendedData section, and decode the arrays using
+// the offsets given in the XML part of the file
+
+#include <deal.II/base/data_out_base.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+#include "patches.h"
+
+
+
+template <typename T>
+void
+print_values(const char *data, const std::uint32_t n_bytes)
+{
+  for (std::uint32_t i = 0; i < n_bytes / sizeof(T); ++i)
+    {
+      T value;
+      std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+      deallog << +value << ' ';
+    }
+  deallog << std::endl;
+}
+
+
+
+std::string
+get_attribute(const std::string &element, const std::string &name)
+{
+  const std::string::size_type begin =
+    element.find(' ' + name + "=\"") + name.size() + 3;
+  return element.substr(begin, element.find('"', begin) - begin);
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(2);
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time     = false;
+  flags.compression_level       = DataOutBase::VtkFlags::no_compression;
+  flags.write_appended_raw_data = true;
+
+  std::ostringstream out;
+  DataOutBase::write_vtu(patches, names, vectors, flags, out);
+  const std::string vtu = out.str();
+
+  const std::string appended_tag = "<AppendedData encoding=\"raw\">";
+
+  // print the XML part of the file
+  const std::string::size_type appended_begin = vtu.find(appended_tag);
+  AssertThrow(appended_begin != std::string::npos, ExcInternalError());
+  deallog << vtu.substr(0, appended_begin) << appended_tag << std::endl;
+
+  // the raw data starts after the underscore following the tag
+  const std::string::size_type data_begin =
+    vtu.find('_', appended_begin) + 1;
+
+  // then decode the data arrays one by one
+  std::string::size_type position = 0;
+  while ((position = vtu.find("<DataArray", position)) < appended_begin)
+    {
+      const std::string element =
+        vtu.substr(position, vtu.find('>', position) - position);
+      position += element.size();
+      if (get_attribute(element, "format") != "appended")
+        continue;
+
+      const std::string type = get_attribute(element, "type");
+      const char *      data =
+        vtu.data() + data_begin + std::stoul(get_attribute(element, "offset"));
+
+      std::uint32_t n_bytes;
+      std::memcpy(&n_bytes, data, sizeof(n_bytes));
+      deallog << type << ", " << n_bytes << " bytes:" << std::endl;
+
+      if (type == "Float32")
+        print_values<float>(data + sizeof(n_bytes), n_bytes);
+      else if (type == "Int32")
+        print_values<std::int32_t>(data + sizeof(n_bytes), n_bytes);
+      else if (type == "UInt8")
+        print_values<std::uint8_t>(data + sizeof(n_bytes), n_bytes);
+      else
+        AssertThrow(false, ExcNotImplemented());
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<1, 1>();
+  check<2, 2>();
+}
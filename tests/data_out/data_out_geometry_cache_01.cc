@@ -0,0 +1,170 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DataOut::set_geometry_caching(): check that repeated calls to
+// build_patches() on the same mesh, with changing data and with and without a
+// postprocessor that needs gradients, give the same output as a fresh object
+// without caching, that the cache is really used, and that it is invalidated
+// when the mesh is refined
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/data_postprocessor.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+class Gradient : public DataPostprocessorVector<dim>
+{
+public:
+  Gradient()
+    : DataPostprocessorVector<dim>("gradient", update_gradients)
+  {}
+
+  virtual void
+  evaluate_scalar_field(
+    const DataPostprocessorInputs::Scalar<dim> &inputs,
+    std::vector<Vector<double>> &computed_quantities) const override
+  {
+    for (unsigned int q = 0; q < inputs.solution_gradients.size(); ++q)
+      for (unsigned int d = 0; d < dim; ++d)
+        computed_quantities[q](d) = inputs.solution_gradients[q][d];
+  }
+};
+
+
+
+template <int dim>
+std::string
+output(DataOut<dim> &                data_out,
+       const DoFHandler<dim> &       dof_handler,
+       const Vector<double> &        solution,
+       const Mapping<dim> &          mapping,
+       const DataPostprocessor<dim> *postprocessor)
+{
+  data_out.clear_data_vectors();
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  if (postprocessor != nullptr)
+    data_out.add_data_vector(solution, *postprocessor);
+  data_out.build_patches(mapping, 3, DataOut<dim>::curved_inner_cells);
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  return out.str();
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  MappingQ<dim>   mapping(3);
+  Vector<double>  solution;
+  Gradient<dim>   gradient;
+
+  DataOut<dim> cached_data_out;
+  cached_data_out.set_geometry_caching(true);
+
+  for (unsigned int step = 0; step < 5; ++step)
+    {
+      // refine in the fourth step, which must invalidate the cache
+      if (step == 3)
+        {
+          tria.begin_active()->set_refine_flag();
+          tria.execute_coarsening_and_refinement();
+        }
+
+      dof_handler.distribute_dofs(fe);
+      solution.reinit(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + 1. / (i + 1);
+
+      const DataPostprocessor<dim> *postprocessor =
+        (step % 2 == 1 ? &gradient : nullptr);
+
+      DataOut<dim>      fresh_data_out;
+      const std::string fresh_output = output<dim>(
+        fresh_data_out, dof_handler, solution, mapping, postprocessor);
+      const std::string cached_output = output<dim>(
+        cached_data_out, dof_handler, solution, mapping, postprocessor);
+
+      deallog << "Step " << step << ", " << tria.n_active_cells()
+              << " cells: "
+              << (cached_output == fresh_output ? "OK" : "output differs")
+              << std::endl;
+    }
+
+  // the geometry is now cached for the refined mesh and the higher order
+  // mapping. passing a linear mapping does not change the output because
+  // the cached geometry is used
+  DataOut<dim>      fresh_data_out;
+  const std::string fresh_output =
+    output<dim>(fresh_data_out, dof_handler, solution, mapping, nullptr);
+  const std::string cached_output =
+    output<dim>(cached_data_out,
+                dof_handler,
+                solution,
+                StaticMappingQ1<dim>::mapping,
+                nullptr);
+  deallog << "Cached geometry used: "
+          << (cached_output == fresh_output ? "yes" : "no") << std::endl;
+
+  // until the cache is cleared
+  cached_data_out.clear_geometry_cache();
+  const std::string linear_output =
+    output<dim>(cached_data_out,
+                dof_handler,
+                solution,
+                StaticMappingQ1<dim>::mapping,
+                nullptr);
+  deallog << "Cached geometry used after clearing: "
+          << (linear_output == fresh_output ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>();
+  check<3>();
+}
@@ -0,0 +1,219 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check DataOutBase::Hdf5Flags: write chunked and compressed datasets, and
+// verify their layout and that they hold the same data as the contiguous
+// datasets written by default
+
+#include <deal.II/base/data_out_base.h>
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+double cell_coordinates[3][8] = {{0, 1, 0, 1, 0, 1, 0, 1},
+                                 {0, 0, 1, 1, 0, 0, 1, 1},
+                                 {0, 0, 0, 0, 1, 1, 1, 1}};
+
+
+// This function is a copy from tests/base/patches.h, included here
+// to not introduce dependencies between different test targets
+template <int dim, int spacedim>
+void
+create_patches(std::vector<DataOutBase::Patch<dim, spacedim>> &patches)
+{
+  for (unsigned int p = 0; p < patches.size(); ++p)
+    {
+      DataOutBase::Patch<dim, spacedim> &patch = patches[p];
+
+      const unsigned int nsub  = p + 1;
+      const unsigned int nsubp = nsub + 1;
+
+      patch.n_subdivisions = nsub;
+      for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+        for (unsigned int d = 0; d < spacedim; ++d)
+          patch.vertices[v](d) =
+            p + cell_coordinates[d][v] + ((d >= dim) ? v : 0);
+
+      unsigned int n1 = (dim > 0) ? nsubp : 1;
+      unsigned int n2 = (dim > 1) ? nsubp : 1;
+      unsigned int n3 = (dim > 2) ? nsubp : 1;
+      patch.data.reinit(5, n1 * n2 * n3);
+
+      for (unsigned int i3 = 0; i3 < n3; ++i3)
+        for (unsigned int i2 = 0; i2 < n2; ++i2)
+          for (unsigned int i1 = 0; i1 < n1; ++i1)
+            {
+              const unsigned int i = i1 + nsubp * (i2 + nsubp * i3);
+
+              patch.data(0, i) = p + 1. * i1 / nsub;
+              patch.data(1, i) = p + 1. * i2 / nsub;
+              patch.data(2, i) = p + 1. * i3 / nsub;
+              patch.data(3, i) = p;
+              patch.data(4, i) = i;
+            }
+      patch.patch_index = p;
+    }
+}
+
+
+
+// print the layout of the given dataset and return its values
+template <typename T>
+std::vector<T>
+read_dataset(const std::string &filename,
+             const std::string &dataset_name,
+             const hid_t        type)
+{
+  const hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  AssertThrow(file >= 0, ExcIO());
+  const hid_t dataset = H5Dopen2(file, dataset_name.c_str(), H5P_DEFAULT);
+  AssertThrow(dataset >= 0, ExcIO());
+
+  const hid_t dataspace = H5Dget_space(dataset);
+  hsize_t     dimensions[2];
+  H5Sget_simple_extent_dims(dataspace, dimensions, nullptr);
+
+  const hid_t properties = H5Dget_create_plist(dataset);
+  deallog << dataset_name << ": " << dimensions[0] << 'x' << dimensions[1];
+  if (H5Pget_layout(properties) == H5D_CHUNKED)
+    {
+      hsize_t chunk_dimensions[2];
+      H5Pget_chunk(properties, 2, chunk_dimensions);
+      deallog << ", chunks of " << chunk_dimensions[0] << 'x'
+              << chunk_dimensions[1] << ", filters:";
+      for (int i = 0; i < H5Pget_nfilters(properties); ++i)
+        {
+          unsigned int flags;
+          std::size_t  n_values = 0;
+          char         name[64];
+          unsigned int filter_config;
+          const H5Z_filter_t filter = H5Pget_filter2(properties,
+                                                     i,
+                                                     &flags,
+                                                     &n_values,
+                                                     nullptr,
+                                                     sizeof(name),
+                                                     name,
+                                                     &filter_config);
+          deallog << ' '
+                  << (filter == H5Z_FILTER_SHUFFLE ?
+                        "shuffle" :
+                        (filter == H5Z_FILTER_DEFLATE ? "deflate" : "other"));
+        }
+    }
+  else
+    deallog << ", contiguous";
+  deallog << std::endl;
+
+  std::vector<T> values(dimensions[0] * dimensions[1]);
+  const herr_t   status = H5Dread(
+    dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data());
+  AssertThrow(status >= 0, ExcIO());
+
+  H5Pclose(properties);
+  H5Sclose(dataspace);
+  H5Dclose(dataset);
+  H5Fclose(file);
+
+  return values;
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim>> patches(4);
+  create_patches(patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  DataOutBase::DataOutFilter data_filter(
+    DataOutBase::DataOutFilterFlags(false, false));
+  DataOutBase::write_filtered_data(patches, names, vectors, data_filter);
+
+  DataOutBase::write_hdf5_parallel(
+    patches, data_filter, true, "default.h5", "default.h5", MPI_COMM_SELF);
+
+  DataOutBase::Hdf5Flags flags;
+  flags.chunk_size         = 16;
+  flags.compression_filter = DataOutBase::Hdf5Flags::deflate;
+  flags.deflate_level      = 9;
+  DataOutBase::write_hdf5_parallel(patches,
+                                   data_filter,
+                                   true,
+                                   "compressed.h5",
+                                   "compressed.h5",
+                                   MPI_COMM_SELF,
+                                   flags);
+
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << std::endl;
+
+  // compare the datasets of the two files, the ones of the default file
+  // must be stored contiguously
+  std::vector<std::string> dataset_names = {"nodes", "cells"};
+  for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+    dataset_names.emplace_back(data_filter.get_data_set_name(i));
+
+  for (const std::string &name : dataset_names)
+    if (name == "cells")
+      {
+        const std::vector<unsigned int> values =
+          read_dataset<unsigned int>("default.h5", name, H5T_NATIVE_UINT);
+        AssertThrow(read_dataset<unsigned int>("compressed.h5",
+                                               name,
+                                               H5T_NATIVE_UINT) == values,
+                    ExcInternalError());
+      }
+    else
+      {
+        const std::vector<double> values =
+          read_dataset<double>("default.h5", name, H5T_NATIVE_DOUBLE);
+        AssertThrow(read_dataset<double>("compressed.h5",
+                                         name,
+                                         H5T_NATIVE_DOUBLE) == values,
+                    ExcInternalError());
+      }
+  deallog << "OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2, 2>();
+  check<2, 3>();
+  check<3, 3>();
+}
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check DataOutBase::Hdf5TimeSeriesWriter: the mesh is only written for the
+// first time step and when it has changed, and the XDMF file references the
+// shared mesh groups
+
+#include <deal.II/base/data_out_base.h>
+
+#include <hdf5.h>
+
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+double cell_coordinates[3][8] = {{0, 1, 0, 1, 0, 1, 0, 1},
+                                 {0, 0, 1, 1, 0, 0, 1, 1},
+                                 {0, 0, 0, 0, 1, 1, 1, 1}};
+
+
+// This function is a copy from tests/base/patches.h, included here
+// to not introduce dependencies between different test targets
+template <int dim, int spacedim>
+void
+create_patches(std::vector<DataOutBase::Patch<dim, spacedim>> &patches)
+{
+  for (unsigned int p = 0; p < patches.size(); ++p)
+    {
+      DataOutBase::Patch<dim, spacedim> &patch = patches[p];
+
+      const unsigned int nsub  = p + 1;
+      const unsigned int nsubp = nsub + 1;
+
+      patch.n_subdivisions = nsub;
+      for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+        for (unsigned int d = 0; d < spacedim; ++d)
+          patch.vertices[v](d) =
+            p + cell_coordinates[d][v] + ((d >= dim) ? v : 0);
+
+      unsigned int n1 = (dim > 0) ? nsubp : 1;
+      unsigned int n2 = (dim > 1) ? nsubp : 1;
+      unsigned int n3 = (dim > 2) ? nsubp : 1;
+      patch.data.reinit(5, n1 * n2 * n3);
+
+      for (unsigned int i3 = 0; i3 < n3; ++i3)
+        for (unsigned int i2 = 0; i2 < n2; ++i2)
+          for (unsigned int i1 = 0; i1 < n1; ++i1)
+            {
+              const unsigned int i = i1 + nsubp * (i2 + nsubp * i3);
+
+              patch.data(0, i) = p + 1. * i1 / nsub;
+              patch.data(1, i) = p + 1. * i2 / nsub;
+              patch.data(2, i) = p + 1. * i3 / nsub;
+              patch.data(3, i) = p;
+              patch.data(4, i) = i;
+            }
+      patch.patch_index = p;
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+check()
+{
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  {
+    DataOutBase::Hdf5TimeSeriesWriter writer("output.h5",
+                                             "output.xdmf",
+                                             MPI_COMM_SELF);
+
+    // write two steps on the same mesh, then one on a mesh with fewer
+    // patches, and finally one on a mesh that is marked as changed
+    const unsigned int n_patches[4]    = {4, 4, 3, 3};
+    const bool         mesh_changed[4] = {false, false, false, true};
+    for (unsigned int step = 0; step < 4; ++step)
+      {
+        std::vector<DataOutBase::Patch<dim, spacedim>> patches(
+          n_patches[step]);
+        create_patches(patches);
+
+        DataOutBase::DataOutFilter data_filter(
+          DataOutBase::DataOutFilterFlags(false, false));
+        DataOutBase::write_filtered_data(patches,
+                                         names,
+                                         vectors,
+                                         data_filter);
+        writer.write_time_step(patches,
+                               data_filter,
+                               0.5 * step,
+                               mesh_changed[step]);
+
+        deallog << "step " << step << ": " << writer.n_meshes_written()
+                << " meshes written" << std::endl;
+      }
+  }
+
+  const hid_t file = H5Fopen("output.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+  AssertThrow(file >= 0, ExcIO());
+  for (const std::string group : {"mesh_0", "mesh_1", "mesh_2", "mesh_3"})
+    deallog << group << ": "
+            << (H5Lexists(file, group.c_str(), H5P_DEFAULT) > 0 ? "yes" :
+                                                                   "no")
+            << std::endl;
+  H5Fclose(file);
+
+  cat_file("output.xdmf");
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2, 2>();
+}
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DataOut::build_patches() re-uses the memory of the patches built by a
+// previous call. check that calling it repeatedly on the same object, with
+// changing data, number of subdivisions, and mesh, gives the same output as
+// using a fresh object every time
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+std::string
+output(DataOut<dim> &         data_out,
+       const DoFHandler<dim> &dof_handler,
+       const Vector<double> & solution,
+       const MappingQ<dim> &  mapping,
+       const unsigned int     n_subdivisions)
+{
+  data_out.clear_data_vectors();
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches(mapping,
+                         n_subdivisions,
+                         DataOut<dim>::curved_boundary);
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  return out.str();
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  MappingQ<dim>   mapping(2);
+  Vector<double>  solution;
+
+  DataOut<dim> reused_data_out;
+
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      // refine in the second step and coarsen again in the fourth
+      if (step == 1)
+        {
+          tria.begin_active()->set_refine_flag();
+          tria.execute_coarsening_and_refinement();
+        }
+      else if (step == 3)
+        {
+          for (const auto &cell : tria.active_cell_iterators())
+            if (cell->level() == 2)
+              cell->set_coarsen_flag();
+          tria.execute_coarsening_and_refinement();
+        }
+
+      dof_handler.distribute_dofs(fe);
+      solution.reinit(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + 1. / (i + 1);
+
+      const unsigned int n_subdivisions = 1 + step % 3;
+
+      DataOut<dim>      fresh_data_out;
+      const std::string fresh_output =
+        output(fresh_data_out, dof_handler, solution, mapping, n_subdivisions);
+      const std::string reused_output = output(
+        reused_data_out, dof_handler, solution, mapping, n_subdivisions);
+
+      deallog << "Step " << step << ", " << tria.n_active_cells()
+              << " cells, " << n_subdivisions << " subdivisions: "
+              << (reused_output == fresh_output ? "OK" : "output differs")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check<2>();
+  check<3>();
+}
@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that large data arrays in compressed VTU files are split into
+// several independently compressed blocks, and that these blocks can be
+// decompressed to the original data
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <zlib.h>
+
+#include <string>
+
+#include "../tests.h"
+
+
+
+int
+main()
+{
+  initlog();
+
+  // in 1d, every cell writes 2 points with 3 float coordinates each, so this
+  // mesh results in 1.5 MiB of point data
+  Triangulation<1> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(16);
+
+  DataOut<1> data_out;
+  data_out.attach_triangulation(tria);
+  data_out.build_patches();
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  const std::string vtu = out.str();
+
+  // extract the base64 encoded header and data of the point coordinates
+  const std::string::size_type points = vtu.find("<Points>");
+  const std::string::size_type begin =
+    vtu.find('\n', vtu.find('>', points + 8));
+  const std::string::size_type end = vtu.find('<', begin);
+  const std::string encoded =
+    vtu.substr(begin + 1, vtu.find_last_not_of(" \n", end - 1) - begin);
+
+  // the header consists of the number of blocks, the size of a block, the
+  // size of the last block, and one compressed size per block. all entries
+  // are 32-bit unsigned integers and the header is encoded on its own. read
+  // the first entry to find out how long it is
+  const std::vector<unsigned char> first_entry =
+    Utilities::decode_base64(encoded.substr(0, 8));
+  const std::uint32_t n_blocks =
+    *reinterpret_cast<const std::uint32_t *>(first_entry.data());
+  const std::size_t header_length = 4 * ((4 * (3 + n_blocks) + 2) / 3);
+
+  const std::vector<unsigned char> header_bytes =
+    Utilities::decode_base64(encoded.substr(0, header_length));
+  const std::uint32_t *header =
+    reinterpret_cast<const std::uint32_t *>(header_bytes.data());
+  deallog << "Number of blocks: " << header[0] << std::endl;
+  deallog << "Block size: " << header[1] << std::endl;
+  deallog << "Last block size: " << header[2] << std::endl;
+
+  const std::vector<unsigned char> compressed =
+    Utilities::decode_base64(encoded.substr(header_length));
+
+  std::vector<float> points_data(3 * 2 * tria.n_active_cells());
+  std::size_t        compressed_offset   = 0;
+  std::size_t        uncompressed_offset = 0;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      uLongf uncompressed_size =
+        (block == n_blocks - 1 ? header[2] : header[1]);
+      const int err = uncompress(
+        reinterpret_cast<Bytef *>(points_data.data()) + uncompressed_offset,
+        &uncompressed_size,
+        compressed.data() + compressed_offset,
+        header[3 + block]);
+      AssertThrow(err == Z_OK, ExcInternalError());
+      AssertThrow(uncompressed_size ==
+                    (block == n_blocks - 1 ? header[2] : header[1]),
+                  ExcInternalError());
+
+      compressed_offset += header[3 + block];
+      uncompressed_offset += uncompressed_size;
+    }
+  AssertThrow(compressed_offset == compressed.size(), ExcInternalError());
+  AssertThrow(uncompressed_offset == points_data.size() * sizeof(float),
+              ExcInternalError());
+
+  // the points are the vertices of all cells, in order
+  bool points_match = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      {
+        const unsigned int index = 2 * cell->active_cell_index() + v;
+        if (points_data[3 * index] != static_cast<float>(cell->vertex(v)[0]) ||
+            points_data[3 * index + 1] != 0.f ||
+            points_data[3 * index + 2] != 0.f)
+          points_match = false;
+      }
+  deallog << "Points match: " << (points_match ? "yes" : "no") << std::endl;
+}
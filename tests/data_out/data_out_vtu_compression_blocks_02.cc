@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// like _01, but check a vector-valued data array, which write_vtu() pads to
+// three components and streams to the file node by node
+
+#include <deal.II/base/data_out_base.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <zlib.h>
+
+#include <string>
+
+#include "../tests.h"
+
+
+
+// decompress the data array that follows the given position in the VTU file
+std::vector<float>
+decode_data_array(const std::string &vtu, const std::string::size_type position)
+{
+  const std::string::size_type begin =
+    vtu.find('\n', vtu.find('>', position));
+  const std::string::size_type end = vtu.find('<', begin);
+  const std::string encoded =
+    vtu.substr(begin + 1, vtu.find_last_not_of(" \n", end - 1) - begin);
+
+  // the header consists of the number of blocks, the size of a block, the
+  // size of the last block, and one compressed size per block
+  const std::vector<unsigned char> first_entry =
+    Utilities::decode_base64(encoded.substr(0, 8));
+  const std::uint32_t n_blocks =
+    *reinterpret_cast<const std::uint32_t *>(first_entry.data());
+  const std::size_t header_length = 4 * ((4 * (3 + n_blocks) + 2) / 3);
+
+  const std::vector<unsigned char> header_bytes =
+    Utilities::decode_base64(encoded.substr(0, header_length));
+  const std::uint32_t *header =
+    reinterpret_cast<const std::uint32_t *>(header_bytes.data());
+  deallog << "Number of blocks: " << header[0] << std::endl;
+
+  const std::vector<unsigned char> compressed =
+    Utilities::decode_base64(encoded.substr(header_length));
+
+  std::vector<float> values(
+    ((n_blocks - 1) * header[1] + header[2]) / sizeof(float));
+  std::size_t compressed_offset   = 0;
+  std::size_t uncompressed_offset = 0;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      uLongf uncompressed_size =
+        (block == n_blocks - 1 ? header[2] : header[1]);
+      const int err = uncompress(
+        reinterpret_cast<Bytef *>(values.data()) + uncompressed_offset,
+        &uncompressed_size,
+        compressed.data() + compressed_offset,
+        header[3 + block]);
+      AssertThrow(err == Z_OK, ExcInternalError());
+
+      compressed_offset += header[3 + block];
+      uncompressed_offset += uncompressed_size;
+    }
+  AssertThrow(compressed_offset == compressed.size(), ExcInternalError());
+  AssertThrow(uncompressed_offset == values.size() * sizeof(float),
+              ExcInternalError());
+
+  return values;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // in 2d, every cell has 4 nodes, with 3 float values for the padded vector
+  // each, so this mesh results in 3 MiB of vector data
+  Triangulation<2> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(8);
+
+  // a vector field whose values are the coordinates of the vertices
+  std::vector<DataOutBase::Patch<2, 2>> patches;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      DataOutBase::Patch<2, 2> patch;
+      patch.data.reinit(2, cell->n_vertices());
+      for (const unsigned int v : cell->vertex_indices())
+        {
+          patch.vertices[v] = cell->vertex(v);
+          for (unsigned int d = 0; d < 2; ++d)
+            patch.data(d, v) = cell->vertex(v)[d];
+        }
+      patches.push_back(patch);
+    }
+
+  const std::vector<std::string> names = {"u", "v"};
+  std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    ranges;
+  ranges.emplace_back(0,
+                      1,
+                      "velocity",
+                      DataComponentInterpretation::component_is_part_of_vector);
+
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+
+  std::ostringstream out;
+  DataOutBase::write_vtu(patches, names, ranges, flags, out);
+  const std::string vtu = out.str();
+
+  const std::vector<float> points =
+    decode_data_array(vtu, vtu.find("<Points>") + 8);
+  const std::vector<float> velocity =
+    decode_data_array(vtu, vtu.find("Name=\"velocity\""));
+
+  // the data are the coordinates of the points, so the two arrays must agree
+  deallog << "Data matches: " << (points == velocity ? "yes" : "no")
+          << std::endl;
+}
@@ -0,0 +1,108 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Partition a mesh by setting subdomain ids, write it with
+// GridOut::write_binary(), and check that the descriptions read by
+// GridIn::read_binary_description() on each process are the ones created
+// from the serial mesh by create_description_from_triangulation(). Then use
+// them to set up a parallel::fullydistributed::Triangulation.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_description.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "./tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const MPI_Comm comm)
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+  const std::string  filename =
+    "mesh_" + std::to_string(dim) + "d_" + std::to_string(n_procs) + ".tria";
+
+  Triangulation<dim> serial_tria;
+  GridGenerator::subdivided_hyper_cube(serial_tria, 4, 0., 1., true);
+  serial_tria.begin_active()->set_all_manifold_ids(1);
+  if (dim == 1)
+    serial_tria.begin_active()->face(0)->set_boundary_id(3);
+
+  for (const auto &cell : serial_tria.active_cell_iterators())
+    {
+      const types::subdomain_id subdomain =
+        cell->active_cell_index() * n_procs / serial_tria.n_active_cells();
+      cell->set_subdomain_id(subdomain);
+      cell->set_level_subdomain_id(subdomain);
+    }
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      std::ofstream out(filename, std::ios::binary);
+      GridOut().write_binary(serial_tria, out);
+    }
+  MPI_Barrier(comm);
+
+  const auto description =
+    GridIn<dim>::read_binary_description(comm, filename);
+  const auto reference = TriangulationDescription::Utilities::
+    create_description_from_triangulation(serial_tria, comm);
+  AssertThrow(description == reference, ExcInternalError());
+
+  if (dim > 1)
+    {
+      parallel::fullydistributed::Triangulation<dim> tria(comm);
+      tria.create_triangulation(description);
+      deallog << "n_global_active_cells: " << tria.n_global_active_cells()
+              << std::endl;
+    }
+
+  deallog << "OK" << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  mpi_initlog();
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  {
+    deallog.push("1d");
+    test<1>(comm);
+    deallog.pop();
+  }
+  {
+    deallog.push("2d");
+    test<2>(comm);
+    deallog.pop();
+  }
+  {
+    deallog.push("3d");
+    test<3>(comm);
+    deallog.pop();
+  }
+}
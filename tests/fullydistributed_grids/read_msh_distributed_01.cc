@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Read a simplex mesh with GridIn::read_msh_distributed() into a
+// parallel::fullydistributed::Triangulation and compare the locally
+// owned cells with the ones of the same mesh read by GridIn::read_msh().
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "./tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const std::string &filename, const MPI_Comm comm)
+{
+  Triangulation<dim> serial_tria;
+  {
+    GridIn<dim> grid_in(serial_tria);
+    std::ifstream input_file(filename);
+    grid_in.read_msh(input_file);
+  }
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  {
+    GridIn<dim> grid_in(tria);
+    grid_in.read_msh_distributed(filename);
+  }
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const typename Triangulation<dim>::active_cell_iterator serial_cell(
+          &serial_tria, 0, cell->id().get_coarse_cell_id());
+
+        AssertThrow(cell->reference_cell() == serial_cell->reference_cell(),
+                    ExcInternalError());
+        AssertThrow(cell->material_id() == serial_cell->material_id(),
+                    ExcInternalError());
+        for (const unsigned int v : cell->vertex_indices())
+          AssertThrow(cell->vertex(v).distance(serial_cell->vertex(v)) < 1e-12,
+                      ExcInternalError());
+        for (const unsigned int f : cell->face_indices())
+          AssertThrow(cell->face(f)->boundary_id() ==
+                        serial_cell->face(f)->boundary_id(),
+                      ExcInternalError());
+      }
+
+  deallog << "n_global_active_cells: " << tria.n_global_active_cells()
+          << std::endl;
+  deallog << "OK" << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  mpi_initlog();
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  {
+    deallog.push("2d");
+    test<2>(SOURCE_DIR "/../simplex/grid_in_msh/tri.msh", comm);
+    deallog.pop();
+  }
+  {
+    deallog.push("3d");
+    test<3>(SOURCE_DIR "/../simplex/grid_in_msh/tet.msh", comm);
+    deallog.pop();
+  }
+}
@@ -0,0 +1,144 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// write a triangulation in the binary format, then read it back in, and
+// check that the triangulations are identical. some cells are put into a
+// second subdomain, so that the file consists of two sections.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+template <int dim, int spacedim>
+void
+check(Triangulation<dim, spacedim> &tria)
+{
+  std::stringstream stream;
+  GridOut           go;
+  go.write(tria, stream, GridOut::binary);
+
+  Triangulation<dim, spacedim> tria2;
+  GridIn<dim, spacedim>        gi;
+  gi.attach_triangulation(tria2);
+  gi.read(stream, GridIn<dim, spacedim>::binary);
+
+  deallog << "Testing Triangulation<" << dim << "," << spacedim << ">"
+          << std::endl;
+  AssertDimension(tria.n_vertices(), tria2.n_vertices());
+  AssertDimension(tria.n_active_cells(), tria2.n_active_cells());
+  auto cell2 = tria2.begin_active();
+  for (const auto &cell1 : tria.active_cell_iterators())
+    {
+      AssertDimension(cell1->material_id(), cell2->material_id());
+      AssertDimension(cell1->manifold_id(), cell2->manifold_id());
+      AssertDimension(cell1->subdomain_id(), cell2->subdomain_id());
+      Assert(cell1->reference_cell() == cell2->reference_cell(),
+             ExcInternalError());
+
+      for (const unsigned int i : cell1->vertex_indices())
+        {
+          AssertDimension(cell1->vertex_index(i), cell2->vertex_index(i));
+          Assert(cell1->vertex(i).distance(cell2->vertex(i)) == 0,
+                 ExcInternalError());
+        }
+      if (dim == 3)
+        for (const unsigned int i : cell1->line_indices())
+          {
+            AssertDimension(cell1->line(i)->manifold_id(),
+                            cell2->line(i)->manifold_id());
+            AssertDimension(cell1->line(i)->boundary_id(),
+                            cell2->line(i)->boundary_id());
+          }
+      for (const unsigned int i : cell1->face_indices())
+        {
+          if (dim > 1)
+            AssertDimension(cell1->face(i)->manifold_id(),
+                            cell2->face(i)->manifold_id());
+          AssertDimension(cell1->face(i)->boundary_id(),
+                          cell2->face(i)->boundary_id());
+        }
+      ++cell2;
+    }
+  deallog << "OK" << std::endl;
+}
+
+template <int dim, int spacedim>
+void
+test()
+{
+  Triangulation<dim, spacedim> tria;
+
+  GridGenerator::hyper_cube(tria, 0, 1, true);
+
+  tria.refine_global(1);
+
+  tria.begin_active()->set_all_manifold_ids(5);
+  tria.begin_active()->set_material_id(3);
+
+  if (dim > 1)
+    tria.begin_active()->face(0)->set_all_manifold_ids(6);
+  else
+    tria.begin_active()->face(0)->set_boundary_id(4);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.5)
+      cell->set_subdomain_id(1);
+
+  check(tria);
+}
+
+template <int dim>
+void
+test_simplex()
+{
+  Triangulation<dim> tria;
+
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, 2);
+
+  for (const auto &face : tria.active_face_iterators())
+    if (face->at_boundary() && face->center()[0] == 0)
+      face->set_boundary_id(2);
+  tria.begin_active()->set_material_id(7);
+
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] > 0.5)
+      cell->set_subdomain_id(1);
+
+  check(tria);
+}
+
+int
+main()
+{
+  initlog();
+
+  test<1, 1>();
+  test<1, 2>();
+  test<1, 3>();
+  test<2, 2>();
+  test<2, 3>();
+  test<3, 3>();
+
+  test_simplex<2>();
+  test_simplex<3>();
+}
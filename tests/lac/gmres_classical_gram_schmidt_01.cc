@@ -0,0 +1,251 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// tests GMRES with the classical Gram-Schmidt orthogonalization and with
+// its delayed variant for the difficult test matrices of
+// gmres_reorthogonalize_01 and for a restarted iteration, and compares the
+// solutions to the ones obtained with the modified Gram-Schmidt algorithm,
+// for the vector types with a batched implementation of the inner products
+// (Vector, LinearAlgebra::distributed::Vector) and with the general one
+// (BlockVector)
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+
+// a matrix that applies a FullMatrix or a SparseMatrix to any vector type
+template <typename MatrixType>
+class Matrix
+{
+public:
+  Matrix(const MatrixType &matrix)
+    : matrix(matrix)
+  {}
+
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    Vector<double> src_copy(src.size()), dst_copy(dst.size());
+    for (unsigned int i = 0; i < src.size(); ++i)
+      src_copy(i) = src(i);
+    matrix.vmult(dst_copy, src_copy);
+    for (unsigned int i = 0; i < dst.size(); ++i)
+      dst(i) = dst_copy(i);
+  }
+
+private:
+  const MatrixType &matrix;
+};
+
+
+
+template <typename VectorType>
+void
+test(const unsigned int variant,
+     const unsigned int min_convergence_steps,
+     const VectorType & vector,
+     const typename SolverGMRES<VectorType>::AdditionalData::
+       OrthogonalizationStrategy strategy)
+{
+  using number         = typename VectorType::value_type;
+  const unsigned int n = vector.size();
+
+  FullMatrix<number> matrix(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      matrix(i, j) = random_value<double>(-.1, .1);
+
+  if (variant == 0)
+    for (unsigned int i = 0; i < n; ++i)
+      matrix(i, i) = (i + 1);
+  else if (variant == 1)
+    for (unsigned int i = 0; i < n; ++i)
+      matrix(i, i) = (i + 1) * (i + 1) * (i + 1) * (i + 1);
+  else if (variant == 2)
+    for (unsigned int i = 0; i < n; ++i)
+      matrix(i, i) = 1e10 * (i + 1) * (i + 1) * (i + 1) * (i + 1);
+  else
+    Assert(false, ExcMessage("Invalid variant"));
+
+  deallog.push(Utilities::int_to_string(variant, 1));
+
+  VectorType rhs, sol_modified, sol;
+  rhs.reinit(vector);
+  sol_modified.reinit(vector);
+  sol.reinit(vector);
+  rhs = 1.;
+
+  using AdditionalData = typename SolverGMRES<VectorType>::AdditionalData;
+  AdditionalData data;
+  data.max_n_tmp_vectors = 80;
+
+  SolverControl control_modified(1000,
+                                 1e2 * std::numeric_limits<number>::epsilon());
+  SolverGMRES<VectorType> solver_modified(control_modified, data);
+  solver_modified.solve(Matrix<FullMatrix<number>>(matrix),
+                        sol_modified,
+                        rhs,
+                        PreconditionIdentity());
+
+  data.orthogonalization_strategy = strategy;
+  SolverControl control(1000, 1e2 * std::numeric_limits<number>::epsilon());
+  SolverGMRES<VectorType> solver(control, data);
+  check_solver_within_range(
+    solver.solve(Matrix<FullMatrix<number>>(matrix),
+                 sol,
+                 rhs,
+                 PreconditionIdentity()),
+    control.last_step(),
+    min_convergence_steps,
+    min_convergence_steps + 2);
+
+  sol -= sol_modified;
+  deallog << "Solutions agree: "
+          << (sol.linfty_norm() < 1e-8 * sol_modified.linfty_norm() ? "yes" :
+                                                                       "no")
+          << std::endl;
+
+  deallog.pop();
+}
+
+
+
+// solve a Laplace problem with a short Arnoldi basis, so that the solver is
+// restarted several times
+template <typename VectorType>
+void
+test_restart(const SparseMatrix<double> &matrix,
+             const VectorType &          vector,
+             const bool                  right_preconditioning,
+             const typename SolverGMRES<VectorType>::AdditionalData::
+               OrthogonalizationStrategy strategy)
+{
+  VectorType rhs, sol_modified, sol;
+  rhs.reinit(vector);
+  sol_modified.reinit(vector);
+  sol.reinit(vector);
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = random_value<double>();
+
+  using AdditionalData = typename SolverGMRES<VectorType>::AdditionalData;
+  AdditionalData data;
+  data.max_n_tmp_vectors     = 12;
+  data.right_preconditioning = right_preconditioning;
+
+  SolverControl           control_modified(2000, 1e-10);
+  SolverGMRES<VectorType> solver_modified(control_modified, data);
+  solver_modified.solve(Matrix<SparseMatrix<double>>(matrix),
+                        sol_modified,
+                        rhs,
+                        PreconditionIdentity());
+
+  data.orthogonalization_strategy = strategy;
+  SolverControl           control(2000, 1e-10);
+  SolverGMRES<VectorType> solver(control, data);
+  solver.solve(Matrix<SparseMatrix<double>>(matrix),
+               sol,
+               rhs,
+               PreconditionIdentity());
+
+  sol -= sol_modified;
+  deallog << "Restarted, "
+          << (right_preconditioning ? "right" : "left")
+          << " preconditioning: iterations agree: "
+          << (std::abs(static_cast<int>(control.last_step()) -
+                       static_cast<int>(control_modified.last_step())) <= 1 ?
+                "yes" :
+                "no")
+          << ", solutions agree: "
+          << (sol.l2_norm() < 1e-8 * sol_modified.l2_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+template <typename VectorType>
+void
+test_all(const SparseMatrix<double> &laplace_matrix,
+         const VectorType &          vector,
+         const VectorType &          laplace_vector,
+         const std::string &         name)
+{
+  using AdditionalData = typename SolverGMRES<VectorType>::AdditionalData;
+
+  for (const auto strategy :
+       {AdditionalData::OrthogonalizationStrategy::classical_gram_schmidt,
+        AdditionalData::OrthogonalizationStrategy::
+          delayed_classical_gram_schmidt})
+    {
+      deallog.push(name);
+      deallog.push(strategy == AdditionalData::OrthogonalizationStrategy::
+                                 classical_gram_schmidt ?
+                     "classical" :
+                     "delayed");
+
+      for (unsigned int variant = 0; variant < 3; ++variant)
+        test(variant, variant == 0 ? 56 : 64, vector, strategy);
+
+      for (const bool right_preconditioning : {false, true})
+        test_restart(laplace_matrix,
+                     laplace_vector,
+                     right_preconditioning,
+                     strategy);
+
+      deallog.pop();
+      deallog.pop();
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> laplace_matrix(structure);
+  testproblem.five_point(laplace_matrix);
+
+  const unsigned int n = 64;
+  test_all(laplace_matrix, Vector<double>(n), Vector<double>(dim), "Vector");
+  test_all(laplace_matrix,
+           LinearAlgebra::distributed::Vector<double>(n),
+           LinearAlgebra::distributed::Vector<double>(dim),
+           "distributed::Vector");
+  test_all(laplace_matrix,
+           BlockVector<double>(std::vector<types::global_dof_index>{n / 2,
+                                                                     n / 2}),
+           BlockVector<double>(
+             std::vector<types::global_dof_index>{dim / 2, dim / 2}),
+           "BlockVector");
+}
@@ -0,0 +1,203 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the eigenvalue estimation of PreconditionChebyshev by the power
+// iteration, the warm start of the power iteration, the reuse of eigenvalue
+// estimates upon re-initialization and the estimation for several
+// preconditioners in one pass
+
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+// a wrapper around a matrix that counts the matrix-vector products
+template <typename MatrixType>
+class CountingMatrix : public Subscriptor
+{
+public:
+  CountingMatrix(const MatrixType &matrix)
+    : matrix(matrix)
+    , n_vmults(0)
+  {}
+
+  types::global_dof_index
+  m() const
+  {
+    return matrix.m();
+  }
+
+  double
+  el(const types::global_dof_index i, const types::global_dof_index j) const
+  {
+    return matrix.el(i, j);
+  }
+
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    ++n_vmults;
+    matrix.vmult(dst, src);
+  }
+
+  const MatrixType &   matrix;
+  mutable unsigned int n_vmults;
+};
+
+
+
+template <typename VectorType>
+void
+check(const SparseMatrix<double> &A, const VectorType &vector)
+{
+  using MatrixType = CountingMatrix<SparseMatrix<double>>;
+  using ChebyshevType =
+    PreconditionChebyshev<MatrixType, VectorType, DiagonalMatrix<VectorType>>;
+  using EigenvalueAlgorithm =
+    typename ChebyshevType::AdditionalData::EigenvalueAlgorithm;
+
+  const MatrixType matrix(A);
+
+  SparseMatrix<double> A2(A.get_sparsity_pattern());
+  A2.copy_from(A);
+  for (unsigned int i = 0; i < A2.m(); ++i)
+    A2.diag_element(i) += 1.;
+  const MatrixType matrix2(A2);
+
+  typename ChebyshevType::AdditionalData data;
+  data.smoothing_range     = 20.;
+  data.degree              = 3;
+  data.eig_cg_n_iterations = 50;
+
+  // reference estimate with the Lanczos iteration
+  ChebyshevType lanczos;
+  lanczos.initialize(matrix, data);
+  const double lanczos_estimate =
+    lanczos.estimate_eigenvalues(vector).max_eigenvalue_estimate;
+  deallog << "Lanczos estimate: " << lanczos_estimate << std::endl;
+
+  // estimates with the power iteration with a cold and a warm start
+  data.eigenvalue_algorithm = EigenvalueAlgorithm::power_iteration;
+  ChebyshevType power;
+  power.initialize(matrix, data);
+  const double power_estimate =
+    power.estimate_eigenvalues(vector).max_eigenvalue_estimate;
+  deallog << "Power iteration estimate with 50 iterations: " << power_estimate
+          << std::endl;
+
+  data.eig_cg_n_iterations = 5;
+  ChebyshevType power_cold;
+  power_cold.initialize(matrix, data);
+  const double cold_estimate =
+    power_cold.estimate_eigenvalues(vector).max_eigenvalue_estimate;
+  deallog << "Power iteration estimate with 5 iterations, cold start: "
+          << cold_estimate << std::endl;
+
+  power.initialize(matrix, data);
+  const double warm_estimate =
+    power.estimate_eigenvalues(vector).max_eigenvalue_estimate;
+  deallog << "Power iteration estimate with 5 iterations, warm start: "
+          << warm_estimate << std::endl;
+
+  // reuse the estimates upon re-initialization: only the matrix-vector
+  // products of the Chebyshev iteration itself should be done
+  VectorType src, dst;
+  src.reinit(vector);
+  dst.reinit(vector);
+  src = 1.;
+
+  data.reuse_eigenvalue_estimates = true;
+  ChebyshevType reuse;
+  reuse.initialize(matrix, data);
+  matrix.n_vmults = 0;
+  reuse.vmult(dst, src);
+  deallog << "Matrix-vector products in first vmult: " << matrix.n_vmults
+          << std::endl;
+  matrix.n_vmults = 0;
+  reuse.initialize(matrix, data);
+  reuse.vmult(dst, src);
+  deallog << "Matrix-vector products in vmult after reuse: "
+          << matrix.n_vmults << std::endl;
+  matrix.n_vmults = 0;
+  data.reuse_eigenvalue_estimates = false;
+  reuse.initialize(matrix, data);
+  reuse.vmult(dst, src);
+  deallog << "Matrix-vector products in vmult without reuse: "
+          << matrix.n_vmults << std::endl;
+
+  // estimate several preconditioners in one pass, mixing the two algorithms,
+  // and compare to the estimates one by one
+  data.eig_cg_n_iterations = 20;
+  std::vector<typename ChebyshevType::AdditionalData> all_data(3, data);
+  all_data[2].eigenvalue_algorithm = EigenvalueAlgorithm::lanczos;
+  std::vector<ChebyshevType> preconditioners(3);
+  preconditioners[0].initialize(matrix, all_data[0]);
+  preconditioners[1].initialize(matrix2, all_data[1]);
+  preconditioners[2].initialize(matrix2, all_data[2]);
+
+  const auto info = ChebyshevType::estimate_eigenvalues(
+    std::vector<const ChebyshevType *>{&preconditioners[0],
+                                       &preconditioners[1],
+                                       &preconditioners[2]},
+    std::vector<const VectorType *>(3, &vector));
+  for (unsigned int i = 0; i < preconditioners.size(); ++i)
+    {
+      ChebyshevType single;
+      single.initialize(i == 0 ? matrix : matrix2, all_data[i]);
+      const auto single_info = single.estimate_eigenvalues(vector);
+      deallog << "Preconditioner " << i
+              << " estimate: " << info[i].max_eigenvalue_estimate
+              << " iterations: " << info[i].cg_iterations
+              << " difference to single estimate: "
+              << std::abs(info[i].max_eigenvalue_estimate -
+                          single_info.max_eigenvalue_estimate)
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  deallog.push("Vector");
+  check(A, Vector<double>(dim));
+  deallog.pop();
+
+  deallog.push("distributed::Vector");
+  check(A, LinearAlgebra::distributed::Vector<double>(dim));
+  deallog.pop();
+}
@@ -0,0 +1,157 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Same setup as precondition_chebyshev_03, but run PreconditionChebyshev on
+// a SparseMatrix<float> with a SparseILU<float> inner preconditioner and
+// column offsets stored in the sparsity pattern, applied to vectors of
+// doubles. Compare with the double precision preconditioner and use the float
+// preconditioners in SolverCG for the double system, also with
+// LinearAlgebra::distributed::Vector
+
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+check_solve(const SparseMatrix<double> &A,
+            const PreconditionerType &  preconditioner,
+            const std::string &         name)
+{
+  VectorType rhs(A.m()), solution(A.m()), residual(A.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = random_value<double>();
+
+  SolverControl        control(1000, 1e-12 * rhs.l2_norm(), false, false);
+  SolverCG<VectorType> solver(control);
+  solver.solve(A, solution, rhs, preconditioner);
+
+  // the float preconditioner must not limit the accuracy of the solution
+  A.vmult(residual, solution);
+  residual -= rhs;
+  deallog << name
+          << (residual.l2_norm() < 1e-11 * rhs.l2_norm() ? " converged" :
+                                                          " failed")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog << std::fixed;
+  deallog << std::setprecision(4);
+  deallog.attach(logfile);
+
+  for (unsigned int size = 4; size <= 16; size *= 2)
+    {
+      unsigned int dim = (size - 1) * (size - 1);
+
+      deallog << "Size " << size << " Unknowns " << dim << std::endl;
+
+      // Make matrix
+      FDMatrix        testproblem(size, size);
+      SparsityPattern structure(dim, dim, 5);
+      testproblem.five_point_structure(structure);
+      structure.compress();
+      SparseMatrix<double> A(structure);
+      testproblem.five_point(A);
+
+      SparsityPattern structure_float;
+      structure_float.copy_from(structure);
+      structure_float.store_column_offsets();
+      SparseMatrix<float> A_float(structure_float);
+      A_float.copy_from(A);
+
+      PreconditionChebyshev<SparseMatrix<double>,
+                            Vector<double>,
+                            SparseILU<double>>
+                                                               cheby;
+      PreconditionChebyshev<SparseMatrix<double>,
+                            Vector<double>,
+                            SparseILU<double>>::AdditionalData cheby_data;
+      cheby_data.preconditioner.reset(new SparseILU<double>());
+      cheby_data.preconditioner->initialize(A);
+      cheby_data.degree          = 11;
+      cheby_data.smoothing_range = 40;
+      cheby.initialize(A, cheby_data);
+
+      PreconditionChebyshev<SparseMatrix<float>,
+                            Vector<double>,
+                            SparseILU<float>>
+                                                              cheby_float;
+      PreconditionChebyshev<SparseMatrix<float>,
+                            Vector<double>,
+                            SparseILU<float>>::AdditionalData cheby_float_data;
+      cheby_float_data.preconditioner.reset(new SparseILU<float>());
+      cheby_float_data.preconditioner->initialize(A_float);
+      cheby_float_data.degree          = 11;
+      cheby_float_data.smoothing_range = 40;
+      cheby_float.initialize(A_float, cheby_float_data);
+
+      Vector<double> v(dim);
+      Vector<double> tmp1(dim), tmp2(dim);
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+          for (unsigned int j = 0; j < dim; ++j)
+            v(j) = random_value<double>();
+
+          A.vmult(tmp1, v);
+          cheby.vmult(tmp2, tmp1);
+          tmp2 -= v;
+          const double cheby_residual = tmp2.l2_norm();
+
+          A.vmult(tmp1, v);
+          cheby_float.vmult(tmp2, tmp1);
+          tmp2 -= v;
+          const double cheby_float_residual = tmp2.l2_norm();
+
+          deallog << "Residual step i=" << i << ":  "
+                  << " cheby=" << cheby_residual
+                  << ", cheby float=" << cheby_float_residual << std::endl;
+        }
+
+      check_solve<Vector<double>>(A, cheby_float, "CG with float Chebyshev");
+
+      // Chebyshev iteration around the point Jacobi method of the float
+      // matrix on a distributed vector
+      using VectorType = LinearAlgebra::distributed::Vector<double>;
+      PreconditionChebyshev<SparseMatrix<float>, VectorType> cheby_jacobi;
+      PreconditionChebyshev<SparseMatrix<float>, VectorType>::AdditionalData
+        cheby_jacobi_data;
+      cheby_jacobi_data.degree          = 5;
+      cheby_jacobi_data.smoothing_range = 20;
+      cheby_jacobi.initialize(A_float, cheby_jacobi_data);
+      check_solve<VectorType>(A,
+                              cheby_jacobi,
+                              "CG with float Chebyshev-Jacobi");
+    }
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SparseMatrix::vmult for several vectors at once and SolverBlockCG,
+// including right hand sides that are linearly dependent
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_block_cg.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType>
+void
+check_vmult(const SparseMatrix<double> &A)
+{
+  std::vector<VectorType> src(11), dst(11);
+  for (unsigned int v = 0; v < src.size(); ++v)
+    {
+      src[v].reinit(A.n());
+      dst[v].reinit(A.m());
+      for (unsigned int i = 0; i < A.n(); ++i)
+        src[v](i) = random_value<double>();
+    }
+
+  A.vmult(dst, src);
+
+  double     difference = 0;
+  VectorType single(A.m());
+  for (unsigned int v = 0; v < src.size(); ++v)
+    {
+      A.vmult(single, src[v]);
+      single -= dst[v];
+      difference = std::max(difference, single.linfty_norm());
+    }
+  deallog << "vmult difference: " << difference << std::endl;
+}
+
+
+
+template <typename PreconditionerType>
+void
+check_solve(const SparseMatrix<double> &A,
+            const PreconditionerType &  preconditioner,
+            const std::string &         name)
+{
+  const unsigned int          n_rhs = 6;
+  std::vector<Vector<double>> b(n_rhs, Vector<double>(A.m()));
+  for (unsigned int j = 0; j < 4; ++j)
+    for (unsigned int i = 0; i < A.m(); ++i)
+      b[j](i) = random_value<double>();
+  // one right hand side appears twice, and one is a linear combination of
+  // two others
+  b[4] = b[0];
+  b[5].equ(2., b[1]);
+  b[5].add(-1., b[2]);
+
+  const double tolerance = 1e-8;
+
+  unsigned int max_cg_iterations = 0;
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    {
+      SolverControl            control(1000, tolerance);
+      SolverCG<Vector<double>> cg(control);
+      Vector<double>           x(A.m());
+      cg.solve(A, x, b[j], preconditioner);
+      max_cg_iterations = std::max(max_cg_iterations, control.last_step());
+    }
+
+  std::vector<Vector<double>>   x(n_rhs, Vector<double>(A.m()));
+  SolverControl                 control(1000, tolerance);
+  SolverBlockCG<Vector<double>> block_cg(control);
+  block_cg.solve(A, x, b, preconditioner);
+
+  // the residual norms are computed by a recurrence in the solver, so allow
+  // for some roundoff in the true residuals
+  double         max_residual = 0;
+  Vector<double> residual(A.m());
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    max_residual = std::max(max_residual, A.residual(residual, x[j], b[j]));
+
+  deallog << name << ": block CG needs fewer iterations than CG: "
+          << (control.last_step() < max_cg_iterations ? "yes" : "no")
+          << std::endl;
+  deallog << name << ": all residuals below tolerance: "
+          << (max_residual < 10 * tolerance ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  check_vmult<Vector<double>>(A);
+  check_vmult<LinearAlgebra::distributed::Vector<double>>(A);
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  check_solve(A, PreconditionIdentity(), "identity");
+  check_solve(A, ssor, "SSOR");
+}
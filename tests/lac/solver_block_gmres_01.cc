@@ -0,0 +1,118 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SolverBlockGMRES on a nonsymmetric matrix, including right hand
+// sides that are linearly dependent and a basis size that enforces restarts
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_block_gmres.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename PreconditionerType>
+void
+check_solve(const SparseMatrix<double> &A,
+            const PreconditionerType &  preconditioner,
+            const unsigned int          max_basis_size,
+            const std::string &         name)
+{
+  const unsigned int          n_rhs = 6;
+  std::vector<Vector<double>> b(n_rhs, Vector<double>(A.m()));
+  for (unsigned int j = 0; j < 4; ++j)
+    for (unsigned int i = 0; i < A.m(); ++i)
+      b[j](i) = random_value<double>();
+  // one right hand side appears twice, and one is a linear combination of
+  // two others
+  b[4] = b[0];
+  b[5].equ(2., b[1]);
+  b[5].add(-1., b[2]);
+
+  const double tolerance = 1e-8;
+
+  std::vector<Vector<double>>      x(n_rhs, Vector<double>(A.m()));
+  SolverControl                    control(1000, tolerance);
+  control.enable_history_data();
+  SolverBlockGMRES<Vector<double>> block_gmres(
+    control,
+    typename SolverBlockGMRES<Vector<double>>::AdditionalData(max_basis_size));
+  block_gmres.solve(A, x, b, preconditioner);
+
+  double         max_residual = 0;
+  Vector<double> residual(A.m());
+  for (unsigned int j = 0; j < n_rhs; ++j)
+    max_residual = std::max(max_residual, A.residual(residual, x[j], b[j]));
+
+  deallog << name << ": all residuals below tolerance: "
+          << (max_residual < tolerance ? "yes" : "no") << std::endl;
+
+  // the convergence status is checked exactly once per step
+  deallog << name << ": one status check per step: "
+          << (control.get_history_data().size() == control.last_step() + 1 ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  PreconditionSOR<SparseMatrix<double>> sor;
+  sor.initialize(A, 1.2);
+
+  check_solve(A, PreconditionIdentity(), 200, "identity");
+  check_solve(A, sor, 200, "SOR");
+  check_solve(A, sor, 12, "SOR, restarted");
+
+  // the solver must throw if the initial residual is already reported as
+  // a failure
+  {
+    std::vector<Vector<double>>      x(1, Vector<double>(dim));
+    std::vector<Vector<double>>      b(1, Vector<double>(dim));
+    SolverControl                    control(0, 1e-8);
+    SolverBlockGMRES<Vector<double>> block_gmres(control);
+    b[0] = 1.;
+    try
+      {
+        block_gmres.solve(A, x, b, PreconditionIdentity());
+      }
+    catch (const SolverControl::NoConvergence &)
+      {
+        deallog << "NoConvergence thrown for zero iterations" << std::endl;
+      }
+  }
+}
@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SolverPipelinedCG computes the same iterates as SolverCG, for
+// the vector types with a fused implementation (Vector,
+// LinearAlgebra::distributed::Vector) and with the general one (BlockVector)
+
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename MatrixType, typename PreconditionerType>
+void
+check(const MatrixType &        A,
+      const PreconditionerType &preconditioner,
+      const VectorType &        vector,
+      const std::string &       name)
+{
+  VectorType b, x_cg, x_pipelined;
+  b.reinit(vector);
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = random_value<double>();
+  x_cg.reinit(b);
+  x_pipelined.reinit(b);
+
+  SolverControl                          control_cg(200, 1.e-10);
+  SolverCG<VectorType>                   cg(control_cg);
+  std::vector<std::pair<double, double>> coefficients_cg;
+  cg.connect_coefficients_slot([&](const double alpha, const double beta) {
+    coefficients_cg.emplace_back(alpha, beta);
+  });
+  double condition_number_cg = 0;
+  cg.connect_condition_number_slot(
+    [&](const double cond) { condition_number_cg = cond; });
+  cg.solve(A, x_cg, b, preconditioner);
+
+  SolverControl                          control_pipelined(200, 1.e-10);
+  SolverPipelinedCG<VectorType>          pipelined_cg(control_pipelined);
+  std::vector<std::pair<double, double>> coefficients_pipelined;
+  pipelined_cg.connect_coefficients_slot(
+    [&](const double alpha, const double beta) {
+      coefficients_pipelined.emplace_back(alpha, beta);
+    });
+  double condition_number_pipelined = 0;
+  pipelined_cg.connect_condition_number_slot(
+    [&](const double cond) { condition_number_pipelined = cond; });
+  pipelined_cg.solve(A, x_pipelined, b, preconditioner);
+
+  // the coefficients of the two recurrences drift apart by roundoff as the
+  // iteration proceeds, so only compare the first ones
+  AssertDimension(coefficients_cg.size(), coefficients_pipelined.size());
+  double max_coefficient_difference = 0;
+  for (unsigned int i = 0;
+       i < std::min<std::size_t>(coefficients_cg.size(), 20);
+       ++i)
+    max_coefficient_difference =
+      std::max({max_coefficient_difference,
+                std::abs(coefficients_cg[i].first -
+                         coefficients_pipelined[i].first) /
+                  std::abs(coefficients_cg[i].first),
+                std::abs(coefficients_cg[i].second -
+                         coefficients_pipelined[i].second) /
+                  std::abs(coefficients_cg[i].second)});
+
+  x_pipelined -= x_cg;
+  deallog << name << " iterations: " << control_cg.last_step() << ' '
+          << control_pipelined.last_step() << std::endl;
+  deallog << name << " coefficients agree: "
+          << (max_coefficient_difference < 1e-10 ? "yes" : "no") << std::endl;
+  deallog << name << " condition numbers agree: "
+          << (std::abs(condition_number_cg - condition_number_pipelined) <
+                  1e-6 * condition_number_cg ?
+                "yes" :
+                "no")
+          << std::endl;
+  deallog << name << " solutions agree: "
+          << (x_pipelined.l2_norm() < 1e-8 * x_cg.l2_norm() ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(1);
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  PreconditionSSOR<SparseMatrix<double>> ssor;
+  ssor.initialize(A, 1.2);
+
+  Vector<double> vector(dim);
+  check(A, PreconditionIdentity(), vector, "Vector, identity");
+  check(A, ssor, vector, "Vector, SSOR");
+
+  LinearAlgebra::distributed::Vector<double> distributed_vector(dim);
+  check(A,
+        PreconditionIdentity(),
+        distributed_vector,
+        "distributed::Vector, identity");
+
+  BlockSparsityPattern block_structure(1, 1);
+  block_structure.block(0, 0).copy_from(structure);
+  block_structure.collect_sizes();
+  BlockSparseMatrix<double> block_A(block_structure);
+  block_A.block(0, 0).copy_from(A);
+  BlockVector<double> block_vector(
+    std::vector<types::global_dof_index>(1, dim));
+  check(block_A, PreconditionIdentity(), block_vector, "BlockVector");
+}
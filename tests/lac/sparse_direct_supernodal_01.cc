@@ -0,0 +1,286 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check SparseDirectSupernodal: LDL^T and LU factorizations with and without
+// nested dissection ordering, several right hand sides at once, transposed
+// solves, pivoting within supernodes, block matrices, and the use as a
+// coarse grid solver
+
+
+#include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/sparse_direct_supernodal.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_ez.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+using AdditionalData = SparseDirectSupernodal::AdditionalData;
+
+
+template <typename MatrixType, typename VectorType>
+double
+residual(const MatrixType &A,
+         const VectorType &x,
+         const VectorType &b,
+         const bool        transpose = false)
+{
+  VectorType r(b);
+  if (transpose)
+    A.Tvmult(r, x);
+  else
+    A.vmult(r, x);
+  r -= b;
+  return r.l2_norm() / b.l2_norm();
+}
+
+
+
+void
+check_laplace(const unsigned int size)
+{
+  const unsigned int dim = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  Vector<double> b(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = 1. + (i % 7);
+
+  for (const auto factorization :
+       {AdditionalData::Factorization::ldlt, AdditionalData::Factorization::lu})
+    for (const auto ordering : {AdditionalData::Ordering::none,
+                                AdditionalData::Ordering::nested_dissection})
+      {
+        SparseDirectSupernodal solver;
+        solver.initialize(A, AdditionalData(factorization, ordering));
+
+        Vector<double> x(dim);
+        solver.vmult(x, b);
+        deallog << "size " << dim
+                << (factorization == AdditionalData::Factorization::ldlt ?
+                      " LDLT" :
+                      " LU")
+                << (ordering == AdditionalData::Ordering::none ?
+                      " natural ordering" :
+                      " nested dissection")
+                << ": factor entries " << solver.n_nonzero_elements()
+                << ", residual ok: "
+                << (residual(A, x, b) < 1e-12 ? "yes" : "no") << std::endl;
+      }
+}
+
+
+
+void
+check_multiple_rhs_and_transpose()
+{
+  // a nonsymmetric matrix
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A, true);
+
+  SparseDirectSupernodal solver;
+  solver.initialize(A);
+
+  const unsigned int n_rhs = 3;
+  FullMatrix<double> B(dim, n_rhs);
+  for (unsigned int i = 0; i < dim; ++i)
+    for (unsigned int c = 0; c < n_rhs; ++c)
+      B(i, c) = std::sin(1. + i * (c + 1));
+
+  for (const bool transpose : {false, true})
+    {
+      FullMatrix<double> X(B);
+      solver.solve(X, transpose);
+
+      double max_residual = 0, max_difference = 0;
+      for (unsigned int c = 0; c < n_rhs; ++c)
+        {
+          Vector<double> b(dim), x(dim);
+          for (unsigned int i = 0; i < dim; ++i)
+            {
+              b(i) = B(i, c);
+              x(i) = X(i, c);
+            }
+          max_residual = std::max(max_residual, residual(A, x, b, transpose));
+
+          Vector<double> y(dim);
+          if (transpose)
+            solver.Tvmult(y, b);
+          else
+            solver.vmult(y, b);
+          y -= x;
+          max_difference = std::max(max_difference, y.linfty_norm());
+        }
+      deallog << (transpose ? "transposed " : "") << n_rhs
+              << " right hand sides, residual ok: "
+              << (max_residual < 1e-12 ? "yes" : "no")
+              << ", agree with single solves: "
+              << (max_difference < 1e-12 ? "yes" : "no") << std::endl;
+    }
+}
+
+
+
+void
+check_pivoting()
+{
+  // a matrix with zero diagonal entries that needs pivoting: the coupling of
+  // the unknowns 2i and 2i+1 is [0 1; 1 1], and neighboring pairs are coupled
+  // weakly
+  const unsigned int     n_pairs = 50;
+  const unsigned int     dim     = 2 * n_pairs;
+  SparseMatrixEZ<double> A(dim, dim, 6);
+  for (unsigned int p = 0; p < n_pairs; ++p)
+    {
+      A.set(2 * p, 2 * p + 1, 1.);
+      A.set(2 * p + 1, 2 * p, 1.);
+      A.set(2 * p + 1, 2 * p + 1, 1.);
+      if (p > 0)
+        {
+          A.set(2 * p, 2 * p - 2, 0.1);
+          A.set(2 * p - 2, 2 * p, -0.1);
+        }
+    }
+
+  Vector<double> b(dim), x(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = 1. + i;
+
+  SparseDirectSupernodal solver;
+  solver.initialize(A,
+                    AdditionalData(AdditionalData::Factorization::lu,
+                                   AdditionalData::Ordering::none));
+  solver.vmult(x, b);
+  deallog << "Zero diagonal with LU, residual ok: "
+          << (residual(A, x, b) < 1e-12 ? "yes" : "no") << std::endl;
+
+  try
+    {
+      solver.initialize(A,
+                        AdditionalData(AdditionalData::Factorization::ldlt,
+                                       AdditionalData::Ordering::none));
+    }
+  catch (const SparseDirectSupernodal::ExcZeroPivot &)
+    {
+      deallog << "Zero diagonal with LDLT: zero pivot detected" << std::endl;
+    }
+}
+
+
+
+void
+check_block_matrix()
+{
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  BlockDynamicSparsityPattern dsp(2, 2);
+  for (unsigned int i = 0; i < 2; ++i)
+    for (unsigned int j = 0; j < 2; ++j)
+      dsp.block(i, j).reinit(dim, dim);
+  dsp.collect_sizes();
+  testproblem.five_point_structure(dsp.block(0, 0));
+  testproblem.five_point_structure(dsp.block(1, 1));
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      dsp.block(0, 1).add(i, i);
+      dsp.block(1, 0).add(i, i);
+    }
+  BlockSparsityPattern pattern;
+  pattern.copy_from(dsp);
+
+  BlockSparseMatrix<double> A(pattern);
+  testproblem.five_point(A.block(0, 0));
+  testproblem.five_point(A.block(1, 1));
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      A.block(0, 1).set(i, i, 0.5);
+      A.block(1, 0).set(i, i, 0.5);
+    }
+
+  BlockVector<double> b(2, dim), x(2, dim);
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = 1. + (i % 5);
+
+  SparseDirectSupernodal solver;
+  solver.initialize(A,
+                    AdditionalData(AdditionalData::Factorization::ldlt));
+  solver.vmult(x, b);
+  deallog << "Block matrix, residual ok: "
+          << (residual(A, x, b) < 1e-12 ? "yes" : "no") << std::endl;
+}
+
+
+
+void
+check_coarse_grid_solver()
+{
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  SparseDirectSupernodal solver;
+  solver.initialize(A,
+                    AdditionalData(AdditionalData::Factorization::ldlt));
+
+  MGCoarseGridApplyPreconditioner<Vector<double>, SparseDirectSupernodal>
+    coarse_grid_solver(solver);
+
+  Vector<double> b(dim), x(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    b(i) = 1. + (i % 3);
+  coarse_grid_solver(0, x, b);
+  deallog << "Coarse grid solver, residual ok: "
+          << (residual(A, x, b) < 1e-12 ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  check_laplace(9);
+  check_laplace(33);
+  check_laplace(65);
+  check_multiple_rhs_and_transpose();
+  check_pivoting();
+  check_block_matrix();
+  check_coarse_grid_solver();
+}
@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SparseILU and SparseMIC give the same results with one and with
+// several threads. the rows of a five-point matrix are permuted so that the
+// level sets of the substitutions are large enough to be run in parallel
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename PreconditionerType>
+void
+check(const SparseMatrix<double> &                    matrix,
+      const typename PreconditionerType::AdditionalData &data,
+      const std::string &                              name,
+      const bool                                       check_transpose)
+{
+  Vector<double> src(matrix.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  Vector<double> dst_serial(matrix.m()), dst_parallel(matrix.m());
+  Vector<double> tdst_serial(matrix.m()), tdst_parallel(matrix.m());
+
+  MultithreadInfo::set_thread_limit(1);
+  {
+    PreconditionerType preconditioner;
+    preconditioner.initialize(matrix, data);
+    preconditioner.vmult(dst_serial, src);
+    if (check_transpose)
+      preconditioner.Tvmult(tdst_serial, src);
+  }
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  {
+    PreconditionerType preconditioner;
+    preconditioner.initialize(matrix, data);
+    preconditioner.vmult(dst_parallel, src);
+    if (check_transpose)
+      preconditioner.Tvmult(tdst_parallel, src);
+  }
+
+  dst_parallel -= dst_serial;
+  deallog << name << " vmult difference: " << dst_parallel.linfty_norm()
+          << std::endl;
+  if (check_transpose)
+    {
+      tdst_parallel -= tdst_serial;
+      deallog << name << " Tvmult difference: " << tdst_parallel.linfty_norm()
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 129;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> matrix(structure);
+  testproblem.five_point(matrix);
+
+  // renumber the rows and columns with a permutation that scatters
+  // neighboring unknowns
+  std::vector<types::global_dof_index> permutation(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    permutation[i] = (static_cast<std::size_t>(i) * 9973) % dim;
+
+  DynamicSparsityPattern dsp(dim, dim);
+  for (const auto &entry : structure)
+    dsp.add(permutation[entry.row()], permutation[entry.column()]);
+  SparsityPattern permuted_structure;
+  permuted_structure.copy_from(dsp);
+
+  SparseMatrix<double> permuted_matrix(permuted_structure);
+  for (const auto &entry : matrix)
+    permuted_matrix.set(permutation[entry.row()],
+                        permutation[entry.column()],
+                        entry.value());
+
+  check<SparseILU<double>>(permuted_matrix,
+                           SparseILU<double>::AdditionalData(),
+                           "SparseILU",
+                           true);
+
+  // the modified factorization breaks down for this ordering unless the
+  // diagonal is strengthened. SparseMIC does not implement Tvmult
+  check<SparseMIC<double>>(permuted_matrix,
+                           SparseMIC<double>::AdditionalData(1.),
+                           "SparseMIC",
+                           false);
+}
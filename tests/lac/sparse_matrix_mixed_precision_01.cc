@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// use a SparseMatrix<float> on vectors of doubles: check that products are
+// accumulated in double precision for both Vector and
+// LinearAlgebra::distributed::Vector, and that preconditioners built from
+// the float matrix let SolverCG and SolverGMRES on the double system
+// converge to full accuracy
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+check_products(const SparseMatrix<float> &matrix)
+{
+  Vector<double> src(matrix.n()), dst(matrix.m()), reference(matrix.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  // compute the product by hand, converting the matrix entries to double
+  for (unsigned int row = 0; row < matrix.m(); ++row)
+    {
+      double sum = 0.;
+      for (auto entry = matrix.begin(row); entry != matrix.end(row); ++entry)
+        sum += static_cast<double>(entry->value()) * src(entry->column());
+      reference(row) = sum;
+    }
+
+  matrix.vmult(dst, src);
+  dst -= reference;
+  // an accumulation in float would lead to errors of the order of 1e-7
+  deallog << "Vector<double> vmult "
+          << (dst.linfty_norm() < 1e-12 ? "OK" : "failed") << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> src_dist(matrix.n()),
+    dst_dist(matrix.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src_dist(i) = src(i);
+  matrix.vmult(dst_dist, src_dist);
+  for (unsigned int i = 0; i < dst.size(); ++i)
+    dst_dist(i) -= reference(i);
+  deallog << "LinearAlgebra::distributed::Vector<double> vmult "
+          << (dst_dist.linfty_norm() < 1e-12 ? "OK" : "failed") << std::endl;
+}
+
+
+
+template <typename SolverType, typename PreconditionerType>
+void
+check_solve(const SparseMatrix<double> &               matrix,
+            const PreconditionerType &                 preconditioner,
+            const std::string &                        name,
+            const typename SolverType::AdditionalData &data =
+              typename SolverType::AdditionalData())
+{
+  Vector<double> rhs(matrix.m()), solution(matrix.m()), residual(matrix.m());
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    rhs(i) = random_value<double>();
+
+  SolverControl control(1000, 1e-12 * rhs.l2_norm(), false, false);
+  SolverType    solver(control, data);
+  solver.solve(matrix, solution, rhs, preconditioner);
+
+  // the residual of the double system has to reach the tolerance even
+  // though the preconditioner only works with float matrix entries
+  const double relative_residual =
+    matrix.residual(residual, solution, rhs) / rhs.l2_norm();
+  deallog << name << (relative_residual < 1e-11 ? " converged" : " failed")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+  SparsityPattern    structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  SparseMatrix<double> matrix(structure);
+  SparseMatrix<float>  matrix_float(structure);
+
+  testproblem.five_point(matrix);
+  matrix_float.copy_from(matrix);
+  check_products(matrix_float);
+  {
+    PreconditionSSOR<SparseMatrix<float>> preconditioner;
+    preconditioner.initialize(matrix_float, 1.2);
+    check_solve<SolverCG<Vector<double>>>(matrix,
+                                          preconditioner,
+                                          "CG with float SSOR");
+  }
+
+  testproblem.five_point(matrix, true);
+  matrix_float.copy_from(matrix);
+  check_products(matrix_float);
+  {
+    SparseILU<float> preconditioner;
+    preconditioner.initialize(matrix_float);
+    // use right preconditioning so that the solver monitors the residual
+    // of the double system
+    SolverGMRES<Vector<double>>::AdditionalData data;
+    data.right_preconditioning = true;
+    check_solve<SolverGMRES<Vector<double>>>(matrix,
+                                             preconditioner,
+                                             "GMRES with float ILU",
+                                             data);
+  }
+}
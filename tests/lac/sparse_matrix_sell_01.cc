@@ -0,0 +1,154 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the matrix-vector products of SparseMatrixSELL agree with the
+// ones of the SparseMatrix it was created from, both for a square matrix
+// and for a rectangular one with very different row lengths and empty rows
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix_sell.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename number>
+void
+check_vector(const Vector<number> &reference,
+             const Vector<number> &result,
+             const std::string &   name)
+{
+  Vector<number> difference = reference;
+  difference -= result;
+  const double tolerance = std::is_same<number, float>::value ? 1e-5 : 1e-12;
+  if (difference.linfty_norm() <= tolerance * reference.linfty_norm())
+    deallog << name << " OK" << std::endl;
+  else
+    deallog << name << " failed: " << difference.linfty_norm() << std::endl;
+}
+
+
+
+template <typename number>
+void
+check_products(const SparseMatrix<number> &    matrix,
+               const SparseMatrixSELL<number> &sell)
+{
+  Vector<number> src(matrix.n()), tsrc(matrix.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<number>();
+  for (unsigned int i = 0; i < tsrc.size(); ++i)
+    tsrc(i) = random_value<number>();
+
+  Vector<number> reference(matrix.m()), result(matrix.m());
+  matrix.vmult(reference, src);
+  sell.vmult(result, src);
+  check_vector(reference, result, "vmult");
+
+  matrix.vmult_add(reference, src);
+  sell.vmult_add(result, src);
+  check_vector(reference, result, "vmult_add");
+
+  Vector<number> treference(matrix.n()), tresult(matrix.n());
+  matrix.Tvmult(treference, tsrc);
+  sell.Tvmult(tresult, tsrc);
+  check_vector(treference, tresult, "Tvmult");
+
+  matrix.Tvmult_add(treference, tsrc);
+  sell.Tvmult_add(tresult, tsrc);
+  check_vector(treference, tresult, "Tvmult_add");
+
+  if (matrix.m() == matrix.n())
+    {
+      matrix.precondition_Jacobi(reference, src, 0.8);
+      sell.precondition_Jacobi(result, src, 0.8);
+      check_vector(reference, result, "precondition_Jacobi");
+    }
+}
+
+
+
+template <typename number>
+void
+test()
+{
+  // a nonsymmetric five-point stencil
+  {
+    FDMatrix        testproblem(13, 11);
+    SparsityPattern sparsity(12 * 10, 12 * 10, 5);
+    testproblem.five_point_structure(sparsity);
+    sparsity.compress();
+    SparseMatrix<number> matrix(sparsity);
+    testproblem.five_point(matrix, true);
+
+    for (const unsigned int sorting_scope : {1U, 16U, 256U})
+      {
+        SparseMatrixSELL<number> sell(matrix, sorting_scope);
+        deallog << "Square matrix, sorting scope " << sorting_scope
+                << ", nonzeros: " << sell.n_nonzero_elements() << std::endl;
+        check_products(matrix, sell);
+      }
+
+    // change the values and update the converted matrix
+    SparseMatrixSELL<number> sell(matrix);
+    for (auto &entry : matrix)
+      entry.value() *= 2. + random_value<number>();
+    sell.copy_from(matrix);
+    deallog << "After copy_from" << std::endl;
+    check_products(matrix, sell);
+  }
+
+  // a rectangular matrix with rows of very different lengths
+  {
+    const unsigned int     n_rows = 97, n_cols = 61;
+    DynamicSparsityPattern dsp(n_rows, n_cols);
+    for (unsigned int row = 0; row < n_rows; ++row)
+      if (row % 7 != 3)
+        for (unsigned int col = 0; col < n_cols; ++col)
+          if ((row * col + row) % (1 + row % 13) == 0)
+            dsp.add(row, col);
+    SparsityPattern sparsity;
+    sparsity.copy_from(dsp);
+
+    SparseMatrix<number> matrix(sparsity);
+    for (auto &entry : matrix)
+      entry.value() = random_value<number>() - 0.5;
+
+    SparseMatrixSELL<number> sell(matrix, 32);
+    deallog << "Rectangular matrix, nonzeros: " << sell.n_nonzero_elements()
+            << std::endl;
+    check_products(matrix, sell);
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("float");
+  test<float>();
+  deallog.pop();
+
+  deallog.push("double");
+  test<double>();
+  deallog.pop();
+}
@@ -0,0 +1,117 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that SparseMatrix and SparseILU give the same results whether the
+// sparsity pattern stores 32-bit column offsets or not
+
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename MatrixType>
+void
+compare(const MatrixType &matrix,
+        const MatrixType &matrix_offsets,
+        const std::string name)
+{
+  Vector<double> src(matrix.n()), dst(matrix.m()), dst_offsets(matrix.m());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  matrix.vmult(dst, src);
+  matrix_offsets.vmult(dst_offsets, src);
+  dst -= dst_offsets;
+  deallog << name << " vmult difference: " << dst.linfty_norm() << std::endl;
+
+  matrix.Tvmult(dst, src);
+  matrix_offsets.Tvmult(dst_offsets, src);
+  dst -= dst_offsets;
+  deallog << name << " Tvmult difference: " << dst.linfty_norm() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 9);
+  testproblem.nine_point_structure(structure);
+  structure.compress();
+
+  SparsityPattern structure_offsets;
+  structure_offsets.copy_from(structure);
+  deallog << "Offsets stored: " << structure_offsets.store_column_offsets()
+          << ' ' << structure_offsets.has_column_offsets() << std::endl;
+  deallog << "Memory overhead per entry: "
+          << (structure_offsets.memory_consumption() -
+              structure.memory_consumption()) /
+               structure.n_nonzero_elements()
+          << std::endl;
+
+  SparseMatrix<double> matrix(structure), matrix_offsets(structure_offsets);
+  testproblem.nine_point(matrix, true);
+  testproblem.nine_point(matrix_offsets, true);
+  compare(matrix, matrix_offsets, "SparseMatrix");
+
+  Vector<double> u(dim), b(dim), r(dim), r_offsets(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      u(i) = random_value<double>();
+      b(i) = random_value<double>();
+    }
+  deallog << "SparseMatrix residual difference: "
+          << std::abs(matrix.residual(r, u, b) -
+                      matrix_offsets.residual(r_offsets, u, b))
+          << std::endl;
+  r -= r_offsets;
+  deallog << "SparseMatrix residual vector difference: " << r.linfty_norm()
+          << std::endl;
+  deallog << "SparseMatrix matrix_norm_square difference: "
+          << std::abs(matrix.matrix_norm_square(u) -
+                      matrix_offsets.matrix_norm_square(u))
+          << std::endl;
+  deallog << "SparseMatrix matrix_scalar_product difference: "
+          << std::abs(matrix.matrix_scalar_product(u, b) -
+                      matrix_offsets.matrix_scalar_product(u, b))
+          << std::endl;
+
+  for (const unsigned int extra_off_diagonals : {0U, 2U})
+    {
+      SparseILU<double>::AdditionalData data(0., extra_off_diagonals);
+
+      SparseILU<double> ilu, ilu_offsets;
+      ilu.initialize(matrix, data);
+      ilu_offsets.initialize(matrix_offsets, data);
+      compare(ilu, ilu_offsets, "SparseILU");
+    }
+
+  // re-initializing the pattern discards the offsets
+  structure_offsets.reinit(dim, dim, 5);
+  deallog << "Offsets after reinit: " << structure_offsets.has_column_offsets()
+          << std::endl;
+}
@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the relaxation methods of SparseMatrix and SparseMIC give the
+// same results whether the sparsity pattern stores 32-bit column offsets or
+// not
+
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparse_mic.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename Operation>
+void
+compare(const Vector<double> &src, const std::string name, Operation operation)
+{
+  Vector<double> dst(src.size()), dst_offsets(src.size());
+  operation(false, dst, src);
+  operation(true, dst_offsets, src);
+  deallog << name << " norm: " << dst.l2_norm() << std::endl;
+  dst -= dst_offsets;
+  deallog << name << " difference: " << dst.linfty_norm() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  SparsityPattern structure_offsets;
+  structure_offsets.copy_from(structure);
+  deallog << "Offsets stored: " << structure_offsets.store_column_offsets()
+          << std::endl;
+
+  SparseMatrix<double> matrix(structure), matrix_offsets(structure_offsets);
+  testproblem.five_point(matrix, true);
+  testproblem.five_point(matrix_offsets, true);
+
+  Vector<double> src(dim), b(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    {
+      src(i) = random_value<double>();
+      b(i)   = random_value<double>();
+    }
+
+  std::vector<types::global_dof_index> permutation(dim), inverse(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    permutation[i] = dim - 1 - i;
+  for (unsigned int i = 0; i < dim; ++i)
+    inverse[permutation[i]] = i;
+
+  const auto get_matrix = [&](const bool offsets) -> SparseMatrix<double> & {
+    return offsets ? matrix_offsets : matrix;
+  };
+
+  compare(src, "SOR", [&](const bool offsets, auto &out, const auto &in) {
+    get_matrix(offsets).precondition_SOR(out, in, 1.2);
+  });
+  compare(src, "TSOR", [&](const bool offsets, auto &out, const auto &in) {
+    get_matrix(offsets).precondition_TSOR(out, in, 1.2);
+  });
+  compare(src, "SSOR", [&](const bool offsets, auto &out, const auto &in) {
+    get_matrix(offsets).precondition_SSOR(out, in, 1.2);
+  });
+  compare(src,
+          "SSOR with positions",
+          [&](const bool offsets, auto &out, const auto &in) {
+            PreconditionSSOR<SparseMatrix<double>> ssor;
+            ssor.initialize(get_matrix(offsets), 1.2);
+            ssor.vmult(out, in);
+          });
+  compare(src, "PSOR", [&](const bool offsets, auto &out, const auto &in) {
+    out = in;
+    get_matrix(offsets).PSOR(out, permutation, inverse, 1.2);
+  });
+  compare(src, "TPSOR", [&](const bool offsets, auto &out, const auto &in) {
+    out = in;
+    get_matrix(offsets).TPSOR(out, permutation, inverse, 1.2);
+  });
+  compare(src, "SOR_step", [&](const bool offsets, auto &out, const auto &in) {
+    out = in;
+    get_matrix(offsets).SOR_step(out, b, 1.2);
+  });
+  compare(src,
+          "TSOR_step",
+          [&](const bool offsets, auto &out, const auto &in) {
+            out = in;
+            get_matrix(offsets).TSOR_step(out, b, 1.2);
+          });
+  compare(src,
+          "SparseMIC",
+          [&](const bool offsets, auto &out, const auto &in) {
+            SparseMIC<double> mic;
+            mic.initialize(get_matrix(offsets));
+            mic.vmult(out, in);
+          });
+}
@@ -0,0 +1,299 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that SolverCG, PreconditionChebyshev and PreconditionJacobi fuse
+// their vector updates into the matrix-vector product of an operator that
+// provides vmult() with operations before and after the product, and that
+// the results agree with the ones of the separate vector operations
+
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// a symmetric positive definite tridiagonal matrix with varying diagonal
+class TridiagonalOperator : public Subscriptor
+{
+public:
+  using size_type = types::global_dof_index;
+
+  TridiagonalOperator(const unsigned int size)
+    : size(size)
+    , diagonal_inverse(std::make_shared<DiagonalMatrix<VectorType>>())
+  {
+    diagonal_inverse->get_vector().reinit(size);
+    for (unsigned int i = 0; i < size; ++i)
+      diagonal_inverse->get_vector()(i) = 1. / diagonal_entry(i);
+  }
+
+  types::global_dof_index
+  m() const
+  {
+    return size;
+  }
+
+  double
+  el(const size_type i, const size_type j) const
+  {
+    AssertDimension(i, j);
+    (void)j;
+    return diagonal_entry(i);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    for (unsigned int i = 0; i < size; ++i)
+      dst(i) = row_times_vector(i, src);
+  }
+
+  const std::shared_ptr<DiagonalMatrix<VectorType>> &
+  get_matrix_diagonal_inverse() const
+  {
+    return diagonal_inverse;
+  }
+
+protected:
+  double
+  diagonal_entry(const unsigned int i) const
+  {
+    return 2. + 0.5 * (i % 3);
+  }
+
+  double
+  row_times_vector(const unsigned int i, const VectorType &src) const
+  {
+    double sum = diagonal_entry(i) * src(i);
+    if (i > 0)
+      sum -= src(i - 1);
+    if (i + 1 < size)
+      sum -= src(i + 1);
+    return sum;
+  }
+
+  const unsigned int                          size;
+  std::shared_ptr<DiagonalMatrix<VectorType>> diagonal_inverse;
+};
+
+
+
+// the same matrix, with a matrix-vector product that works on chunks of
+// rows and calls the operations before and after the product in the same
+// way as MatrixFree::cell_loop()
+class FusedTridiagonalOperator : public TridiagonalOperator
+{
+public:
+  FusedTridiagonalOperator(const unsigned int size)
+    : TridiagonalOperator(size)
+    , n_fused_vmults(0)
+  {}
+
+  using TridiagonalOperator::vmult;
+
+  void
+  vmult(VectorType &      dst,
+        const VectorType &src,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_before,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_after) const
+  {
+    ++n_fused_vmults;
+
+    const unsigned int chunk_size = 16;
+    const unsigned int n_chunks   = (size + chunk_size - 1) / chunk_size;
+    const auto         range      = [&](const unsigned int chunk) {
+      return std::make_pair(chunk * chunk_size,
+                            std::min(size, (chunk + 1) * chunk_size));
+    };
+
+    // rows of a chunk access the entries of the neighboring chunks
+    operation_before(range(0).first, range(0).second);
+    for (unsigned int chunk = 0; chunk < n_chunks; ++chunk)
+      {
+        if (chunk + 1 < n_chunks)
+          operation_before(range(chunk + 1).first, range(chunk + 1).second);
+        for (unsigned int i = range(chunk).first; i < range(chunk).second; ++i)
+          dst(i) += row_times_vector(i, src);
+        if (chunk > 0)
+          operation_after(range(chunk - 1).first, range(chunk - 1).second);
+      }
+    operation_after(range(n_chunks - 1).first, range(n_chunks - 1).second);
+  }
+
+  mutable unsigned int n_fused_vmults;
+};
+
+
+
+template <typename PreconditionerType>
+void
+check_cg(const TridiagonalOperator &     matrix,
+         const FusedTridiagonalOperator &fused_matrix,
+         const PreconditionerType &      preconditioner,
+         const VectorType &              rhs)
+{
+  VectorType solution(rhs), fused_solution(rhs);
+  solution       = 0;
+  fused_solution = 0;
+
+  SolverControl      control(200, 1e-10);
+  SolverCG<VectorType> solver(control);
+  solver.solve(matrix, solution, rhs, preconditioner);
+  const unsigned int n_iterations = control.last_step();
+
+  fused_matrix.n_fused_vmults = 0;
+  solver.solve(fused_matrix, fused_solution, rhs, preconditioner);
+
+  deallog << "Same number of iterations: "
+          << (control.last_step() == n_iterations ? "yes" : "no")
+          << ", fused: " << (fused_matrix.n_fused_vmults > 0 ? "yes" : "no")
+          << std::endl;
+  fused_solution -= solution;
+  deallog << "Solutions agree: "
+          << (fused_solution.linfty_norm() < 1e-10 * solution.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+template <typename MatrixType>
+void
+apply_chebyshev(const MatrixType &matrix,
+                const VectorType &rhs,
+                VectorType &      vmult_result,
+                VectorType &      step_result)
+{
+  using ChebyshevType =
+    PreconditionChebyshev<MatrixType, VectorType, DiagonalMatrix<VectorType>>;
+  typename ChebyshevType::AdditionalData data;
+  data.degree          = 4;
+  data.smoothing_range = 20.;
+  data.preconditioner  = matrix.get_matrix_diagonal_inverse();
+
+  ChebyshevType chebyshev;
+  chebyshev.initialize(matrix, data);
+  chebyshev.vmult(vmult_result, rhs);
+  step_result = vmult_result;
+  chebyshev.step(step_result, rhs);
+}
+
+
+
+void
+check_chebyshev(const TridiagonalOperator &     matrix,
+                const FusedTridiagonalOperator &fused_matrix,
+                const VectorType &              rhs)
+{
+  VectorType result(rhs), step_result(rhs), fused_result(rhs),
+    fused_step_result(rhs);
+  apply_chebyshev(matrix, rhs, result, step_result);
+
+  fused_matrix.n_fused_vmults = 0;
+  apply_chebyshev(fused_matrix, rhs, fused_result, fused_step_result);
+
+  fused_result -= result;
+  fused_step_result -= step_result;
+  deallog << "Chebyshev vmult agrees: "
+          << (fused_result.linfty_norm() < 1e-12 * result.linfty_norm() ?
+                "yes" :
+                "no")
+          << ", step agrees: "
+          << (fused_step_result.linfty_norm() <
+                  1e-12 * step_result.linfty_norm() ?
+                "yes" :
+                "no")
+          << ", fused: " << (fused_matrix.n_fused_vmults > 0 ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+void
+check_jacobi(const TridiagonalOperator &     matrix,
+             const FusedTridiagonalOperator &fused_matrix,
+             const VectorType &              rhs)
+{
+  const double relaxation = 0.7;
+
+  PreconditionJacobi<FusedTridiagonalOperator> jacobi;
+  jacobi.initialize(fused_matrix, relaxation);
+
+  // reference results of the separate operations
+  const VectorType &diagonal_inverse =
+    matrix.get_matrix_diagonal_inverse()->get_vector();
+  VectorType reference(rhs), product(rhs);
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    reference(i) = relaxation * diagonal_inverse(i) * rhs(i);
+
+  VectorType result(rhs);
+  jacobi.vmult(result, rhs);
+  result -= reference;
+  deallog << "Jacobi vmult agrees: "
+          << (result.linfty_norm() < 1e-12 * reference.linfty_norm() ? "yes" :
+                                                                       "no")
+          << std::endl;
+
+  result = reference;
+  matrix.vmult(product, reference);
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    reference(i) += relaxation * diagonal_inverse(i) * (rhs(i) - product(i));
+
+  fused_matrix.n_fused_vmults = 0;
+  jacobi.step(result, rhs);
+  result -= reference;
+  deallog << "Jacobi step agrees: "
+          << (result.linfty_norm() < 1e-12 * reference.linfty_norm() ? "yes" :
+                                                                       "no")
+          << ", fused: " << (fused_matrix.n_fused_vmults > 0 ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int       size = 200;
+  TridiagonalOperator      matrix(size);
+  FusedTridiagonalOperator fused_matrix(size);
+
+  VectorType rhs(size);
+  for (unsigned int i = 0; i < size; ++i)
+    rhs(i) = std::sin(1. + 1.7 * i);
+
+  deallog.push("PreconditionIdentity");
+  check_cg(matrix, fused_matrix, PreconditionIdentity(), rhs);
+  deallog.pop();
+
+  deallog.push("DiagonalMatrix");
+  check_cg(matrix, fused_matrix, *matrix.get_matrix_diagonal_inverse(), rhs);
+  deallog.pop();
+
+  check_chebyshev(matrix, fused_matrix, rhs);
+  check_jacobi(matrix, fused_matrix, rhs);
+}
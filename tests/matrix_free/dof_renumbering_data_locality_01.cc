@@ -0,0 +1,194 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check DoFRenumbering::matrix_free_data_locality(): after renumbering, the
+// cell batches of MatrixFree access the degrees of freedom in increasing
+// order of first access, and the result of a Laplace operator is the same as
+// before renumbering
+
+#include <deal.II/base/function_lib.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+vmult(const MatrixFree<dim, double> &                   matrix_free,
+      LinearAlgebra::distributed::Vector<double> &      dst,
+      const LinearAlgebra::distributed::Vector<double> &src)
+{
+  matrix_free.template cell_loop<LinearAlgebra::distributed::Vector<double>,
+                                 LinearAlgebra::distributed::Vector<double>>(
+    [](const MatrixFree<dim, double> &                   data,
+       LinearAlgebra::distributed::Vector<double> &      dst,
+       const LinearAlgebra::distributed::Vector<double> &src,
+       const std::pair<unsigned int, unsigned int> &     cell_range) {
+      FEEvaluation<dim, fe_degree> phi(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src, EvaluationFlags::gradients);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            phi.submit_gradient(phi.get_gradient(q), q);
+          phi.integrate_scatter(EvaluationFlags::gradients, dst);
+        }
+    },
+    dst,
+    src,
+    true);
+}
+
+
+
+template <int dim, int fe_degree>
+double
+setup_and_apply(const DoFHandler<dim> &  dof_handler,
+                MatrixFree<dim, double> &matrix_free)
+{
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.tasks_parallel_scheme =
+    MatrixFree<dim, double>::AdditionalData::none;
+  additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+  matrix_free.reinit(MappingQ1<dim>(),
+                     dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  LinearAlgebra::distributed::Vector<double> src, dst;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  VectorTools::interpolate(dof_handler,
+                           Functions::Q1WedgeFunction<dim>(),
+                           src);
+  constraints.distribute(src);
+  vmult<dim, fe_degree>(matrix_free, dst, src);
+  return dst.l2_norm();
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.3)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  MatrixFree<dim, double> matrix_free;
+  const double norm_before = setup_and_apply<dim, fe_degree>(dof_handler,
+                                                              matrix_free);
+
+  std::vector<types::global_dof_index> new_dof_indices;
+  DoFRenumbering::compute_matrix_free_data_locality(new_dof_indices,
+                                                    dof_handler,
+                                                    matrix_free);
+  std::vector<bool> is_image(dof_handler.n_dofs(), false);
+  for (const types::global_dof_index i : new_dof_indices)
+    if (i < is_image.size())
+      is_image[i] = true;
+  deallog << "Renumbering is a permutation: "
+          << (new_dof_indices.size() == dof_handler.n_dofs() &&
+                  std::find(is_image.begin(), is_image.end(), false) ==
+                    is_image.end() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  DoFRenumbering::matrix_free_data_locality(dof_handler, matrix_free);
+  const double norm_after = setup_and_apply<dim, fe_degree>(dof_handler,
+                                                             matrix_free);
+
+  // the first access to each dof in the cell loop should now be in
+  // increasing order
+  bool                      increasing = true;
+  unsigned int              next_dof   = 0;
+  std::vector<unsigned int> dof_indices;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      matrix_free.get_dof_info(0).get_dof_indices_on_cell_batch(dof_indices,
+                                                                cell,
+                                                                false);
+      const unsigned int n_filled =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+      const unsigned int dofs_per_cell = dof_indices.size() / n_filled;
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int v = 0; v < n_filled; ++v)
+          {
+            const unsigned int index = dof_indices[v * dofs_per_cell + i];
+            if (index == next_dof)
+              ++next_dof;
+            else if (index > next_dof)
+              increasing = false;
+          }
+    }
+  deallog << "Numbering follows the cell loop: "
+          << (increasing && next_dof == dof_handler.n_dofs() ? "yes" : "no")
+          << std::endl;
+
+  deallog << "Operator evaluation agrees: "
+          << (std::abs(norm_before - norm_after) < 1e-12 * norm_before ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>();
+  test<2, 3>();
+  test<3, 2>();
+}
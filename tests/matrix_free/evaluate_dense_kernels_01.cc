@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check the correctness of the dense evaluation and integration kernels used
+// in FEEvaluation and FEFaceEvaluation for elements without tensor-product
+// structure, against a straight-forward implementation with separate
+// matrix-vector products for the values and the gradients, including sizes
+// that are not multiples of the block size and strided gradient matrices
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int n_components,
+     const unsigned int n_dofs,
+     const unsigned int n_q_points,
+     const unsigned int padding)
+{
+  using Number = VectorizedArray<double>;
+
+  deallog << "Test dim=" << dim << ", " << n_components << " components, "
+          << n_dofs << " x " << n_q_points << std::endl;
+
+  const unsigned int    stride = n_dofs * n_q_points + padding;
+  AlignedVector<Number> shape_values(n_dofs * n_q_points);
+  AlignedVector<Number> shape_gradients(dim * stride);
+  for (auto &entry : shape_values)
+    entry = -1. + 2. * random_value<double>();
+  for (auto &entry : shape_gradients)
+    entry = -1. + 2. * random_value<double>();
+
+  AlignedVector<Number> dofs(n_components * n_dofs);
+  AlignedVector<Number> values(n_components * n_q_points);
+  AlignedVector<Number> gradients(n_components * dim * n_q_points);
+  for (auto &entry : dofs)
+    for (unsigned int v = 0; v < Number::size(); ++v)
+      entry[v] = random_value<double>();
+  for (auto &entry : values)
+    for (unsigned int v = 0; v < Number::size(); ++v)
+      entry[v] = random_value<double>();
+  for (auto &entry : gradients)
+    for (unsigned int v = 0; v < Number::size(); ++v)
+      entry[v] = random_value<double>();
+
+  const auto max_difference = [](const AlignedVector<Number> &a,
+                                 const AlignedVector<Number> &b) {
+    double difference = 0;
+    for (unsigned int i = 0; i < a.size(); ++i)
+      for (unsigned int v = 0; v < Number::size(); ++v)
+        difference = std::max(difference, std::abs(a[i][v] - b[i][v]));
+    return difference;
+  };
+
+  // evaluate
+  {
+    AlignedVector<Number> values_ref(values.size()), values_test(values.size());
+    AlignedVector<Number> gradients_ref(gradients.size()),
+      gradients_test(gradients.size());
+    const AlignedVector<Number> zero_values(values.size()),
+      zero_gradients(gradients.size());
+    for (unsigned int c = 0; c < n_components; ++c)
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            values_ref[c * n_q_points + q] +=
+              shape_values[i * n_q_points + q] * dofs[c * n_dofs + i];
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int i = 0; i < n_dofs; ++i)
+              gradients_ref[(c * dim + d) * n_q_points + q] +=
+                shape_gradients[d * stride + i * n_q_points + q] *
+                dofs[c * n_dofs + i];
+        }
+
+    for (unsigned int flags = 1; flags < 4; ++flags)
+      {
+        const bool do_values    = flags & 1;
+        const bool do_gradients = flags & 2;
+        values_test.fill(Number());
+        gradients_test.fill(Number());
+        internal::FEEvaluationImplDense<dim, Number>::evaluate(
+          n_components,
+          n_dofs,
+          n_q_points,
+          shape_values.data(),
+          shape_gradients.data(),
+          stride,
+          dofs.data(),
+          values_test.data(),
+          gradients_test.data(),
+          do_values,
+          do_gradients);
+
+        // the fields that are not requested must remain untouched
+        const AlignedVector<Number> &values_expected =
+          do_values ? values_ref : zero_values;
+        const AlignedVector<Number> &gradients_expected =
+          do_gradients ? gradients_ref : zero_gradients;
+        deallog << "evaluate values " << do_values << " gradients "
+                << do_gradients << ": "
+                << (max_difference(values_test, values_expected) < 1e-12 &&
+                        max_difference(gradients_test, gradients_expected) <
+                          1e-12 ?
+                      "yes" :
+                      "no")
+                << std::endl;
+      }
+  }
+
+  // integrate
+  for (unsigned int flags = 1; flags < 4; ++flags)
+    for (const bool add : {false, true})
+      {
+        const bool do_values    = flags & 1;
+        const bool do_gradients = flags & 2;
+
+        AlignedVector<Number> dofs_ref(dofs.size()), dofs_test(dofs);
+        for (unsigned int c = 0; c < n_components; ++c)
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            {
+              Number sum = add ? dofs[c * n_dofs + i] : Number();
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  if (do_values)
+                    sum += shape_values[i * n_q_points + q] *
+                           values[c * n_q_points + q];
+                  if (do_gradients)
+                    for (unsigned int d = 0; d < dim; ++d)
+                      sum += shape_gradients[d * stride + i * n_q_points + q] *
+                             gradients[(c * dim + d) * n_q_points + q];
+                }
+              dofs_ref[c * n_dofs + i] = sum;
+            }
+
+        internal::FEEvaluationImplDense<dim, Number>::integrate(
+          n_components,
+          n_dofs,
+          n_q_points,
+          shape_values.data(),
+          shape_gradients.data(),
+          stride,
+          dofs_test.data(),
+          values.data(),
+          gradients.data(),
+          do_values,
+          do_gradients,
+          add);
+
+        deallog << "integrate values " << do_values << " gradients "
+                << do_gradients << " add " << add << ": "
+                << (max_difference(dofs_test, dofs_ref) < 1e-12 ? "yes" : "no")
+                << std::endl;
+      }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  // cell kernels of triangles and tetrahedra
+  test<2>(1, 3, 3, 0);
+  test<2>(2, 6, 7, 0);
+  test<3>(1, 10, 14, 0);
+  test<3>(3, 4, 4, 0);
+  // face kernels, where the gradient matrices are padded to the largest
+  // number of quadrature points on any face
+  test<2>(1, 6, 3, 6);
+  test<3>(1, 18, 9, 18);
+  test<3>(2, 5, 6, 15);
+}
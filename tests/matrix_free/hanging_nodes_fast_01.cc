@@ -0,0 +1,273 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that resolving the hanging-node constraints on the fly in
+// FEEvaluation gives the same results for a Laplace operator, for
+// read_dof_values_plain() and for MatrixFreeTools::compute_diagonal() as
+// the general path based on the constraint pool, on meshes with constrained
+// faces and (in 3D) constrained edges
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+laplace_cell(FEEvaluation<dim, fe_degree> &phi)
+{
+  phi.evaluate(EvaluationFlags::gradients);
+  for (unsigned int q = 0; q < phi.n_q_points; ++q)
+    phi.submit_gradient(phi.get_gradient(q), q);
+  phi.integrate(EvaluationFlags::gradients);
+}
+
+
+
+template <int dim, int fe_degree>
+void
+vmult(const MatrixFree<dim, double> &                   matrix_free,
+      LinearAlgebra::distributed::Vector<double> &      dst,
+      const LinearAlgebra::distributed::Vector<double> &src,
+      LinearAlgebra::distributed::Vector<double> *      dst_copy = nullptr)
+{
+  // if a second destination vector is given, sum the same local values into
+  // it after the first one, which checks that distribute_local_to_global()
+  // leaves the values held by FEEvaluation unchanged
+  if (dst_copy != nullptr)
+    *dst_copy = 0;
+
+  matrix_free.template cell_loop<LinearAlgebra::distributed::Vector<double>,
+                                 LinearAlgebra::distributed::Vector<double>>(
+    [dst_copy](const MatrixFree<dim, double> &                   data,
+               LinearAlgebra::distributed::Vector<double> &      dst,
+               const LinearAlgebra::distributed::Vector<double> &src,
+               const std::pair<unsigned int, unsigned int> &     cell_range) {
+      FEEvaluation<dim, fe_degree> phi(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(src);
+          laplace_cell(phi);
+          phi.distribute_local_to_global(dst);
+          if (dst_copy != nullptr)
+            phi.distribute_local_to_global(*dst_copy);
+        }
+    },
+    dst,
+    src,
+    true);
+
+  if (dst_copy != nullptr)
+    dst_copy->compress(VectorOperation::add);
+}
+
+
+
+template <int dim, int fe_degree>
+double
+plain_value_sum(const MatrixFree<dim, double> &                   matrix_free,
+                const LinearAlgebra::distributed::Vector<double> &src)
+{
+  // sum of the plain values of all cells, weighted by the local index, in
+  // order to detect permutations of the degrees of freedom
+  FEEvaluation<dim, fe_degree> phi(matrix_free);
+  double                       sum = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values_plain(src);
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+          sum += (i + 1) * phi.begin_dof_values()[i][v];
+    }
+  return sum;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria, -1, 1);
+  tria.refine_global(1);
+
+  // refine all but one of the cells around the z axis (in the lower half
+  // in 3D), which gives constrained faces and, in 3D, cells next to the
+  // origin whose only constraint is on the edge along the z axis
+  for (const auto &cell : tria.active_cell_iterators())
+    if (!(cell->center()[0] > 0 && cell->center()[1] > 0) &&
+        (dim == 2 || cell->center()[dim - 1] < 0))
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  // refine the cells at the origin further
+  for (unsigned int r = 1; r < n_refinements; ++r)
+    {
+      const double h = std::pow(0.5, r + 1);
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center().norm() < 1.01 * h * std::sqrt(dim))
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  VectorTools::interpolate_boundary_values(dof_handler,
+                                           0,
+                                           Functions::ZeroFunction<dim>(),
+                                           constraints);
+  constraints.close();
+
+  MappingQ1<dim> mapping;
+
+  MatrixFree<dim, double> matrix_free_fast, matrix_free_general;
+  {
+    typename MatrixFree<dim, double>::AdditionalData additional_data;
+    additional_data.tasks_parallel_scheme =
+      MatrixFree<dim, double>::AdditionalData::none;
+    additional_data.mapping_update_flags = update_gradients | update_JxW_values;
+
+    additional_data.use_fast_hanging_node_algorithm = true;
+    matrix_free_fast.reinit(mapping,
+                            dof_handler,
+                            constraints,
+                            QGauss<1>(fe_degree + 1),
+                            additional_data);
+
+    additional_data.use_fast_hanging_node_algorithm = false;
+    matrix_free_general.reinit(mapping,
+                               dof_handler,
+                               constraints,
+                               QGauss<1>(fe_degree + 1),
+                               additional_data);
+  }
+
+  deallog << "Testing " << dim << "D, FE_Q<" << dim << ">(" << fe_degree
+          << "), uses fast path: "
+          << (matrix_free_fast.get_dof_info(0)
+                  .hanging_node_constraint_masks.empty() ?
+                "no" :
+                "yes")
+          << ", " << (matrix_free_general.get_dof_info(0)
+                          .hanging_node_constraint_masks.empty() ?
+                        "no" :
+                        "yes")
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> src, dst_fast, dst_general;
+  matrix_free_fast.initialize_dof_vector(src);
+  matrix_free_fast.initialize_dof_vector(dst_fast);
+  matrix_free_general.initialize_dof_vector(dst_general);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = std::sin(1. + 1.7 * i);
+  constraints.set_zero(src);
+
+  LinearAlgebra::distributed::Vector<double> dst_copy;
+  matrix_free_fast.initialize_dof_vector(dst_copy);
+
+  vmult<dim, fe_degree>(matrix_free_fast, dst_fast, src, &dst_copy);
+  vmult<dim, fe_degree>(matrix_free_general, dst_general, src);
+  dst_copy -= dst_fast;
+  deallog << "Repeated distribution agrees: "
+          << (dst_copy.linfty_norm() < 1e-12 * dst_general.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+  dst_fast -= dst_general;
+  deallog << "Operator evaluation agrees: "
+          << (dst_fast.linfty_norm() < 1e-12 * dst_general.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  const double plain_fast = plain_value_sum<dim, fe_degree>(matrix_free_fast,
+                                                            src);
+  const double plain_general =
+    plain_value_sum<dim, fe_degree>(matrix_free_general, src);
+  deallog << "Plain values agree: "
+          << (std::abs(plain_fast - plain_general) <
+                  1e-12 * std::abs(plain_general) ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> diagonal_fast, diagonal_general;
+  MatrixFreeTools::compute_diagonal<dim,
+                                    fe_degree,
+                                    fe_degree + 1,
+                                    1,
+                                    double,
+                                    VectorizedArray<double>>(
+    matrix_free_fast, diagonal_fast, &laplace_cell<dim, fe_degree>);
+  MatrixFreeTools::compute_diagonal<dim,
+                                    fe_degree,
+                                    fe_degree + 1,
+                                    1,
+                                    double,
+                                    VectorizedArray<double>>(
+    matrix_free_general, diagonal_general, &laplace_cell<dim, fe_degree>);
+  diagonal_fast -= diagonal_general;
+  deallog << "Diagonal agrees: "
+          << (diagonal_fast.linfty_norm() <
+                  1e-12 * diagonal_general.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 1>(1);
+  test<2, 2>(2);
+  test<2, 3>(3);
+  test<3, 1>(1);
+  test<3, 2>(2);
+}
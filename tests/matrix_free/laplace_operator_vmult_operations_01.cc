@@ -0,0 +1,194 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check MatrixFreeOperators::Base::vmult() with operations before and after
+// the product: the result must be the same as the one of the ordinary
+// vmult(), including the constrained entries, and each locally owned entry
+// must be passed to the operation before the product and then to the one
+// after the product exactly once. Then check that SolverCG, which fuses its
+// vector updates into this product, gives the same solution as with an
+// operator that only provides the ordinary vmult()
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// hides the vmult() function with operations before and after the product
+template <typename OperatorType>
+class UnfusedOperator : public Subscriptor
+{
+public:
+  UnfusedOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+private:
+  const OperatorType &op;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test(const typename MatrixFree<dim>::AdditionalData::TasksParallelScheme
+       scheme)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  DoFTools::make_zero_boundary_constraints(dof, constraints);
+  constraints.close();
+
+  std::shared_ptr<MatrixFree<dim>> matrix_free(new MatrixFree<dim>());
+  typename MatrixFree<dim>::AdditionalData data;
+  data.tasks_parallel_scheme = scheme;
+  data.tasks_block_size      = 3;
+  matrix_free->reinit(dof, constraints, QGauss<1>(fe_degree + 1), data);
+
+  MatrixFreeOperators::LaplaceOperator<dim, fe_degree> laplace;
+  laplace.initialize(matrix_free);
+  laplace.compute_diagonal();
+
+  VectorType src, dst, src_fused, dst_fused;
+  matrix_free->initialize_dof_vector(src);
+  matrix_free->initialize_dof_vector(dst);
+  matrix_free->initialize_dof_vector(src_fused);
+  matrix_free->initialize_dof_vector(dst_fused);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    {
+      src.local_element(i)       = random_value<double>();
+      dst_fused.local_element(i) = 1.;
+    }
+
+  laplace.vmult(dst, src);
+
+  // the operation before the product sets the input vector and zeroes the
+  // output vector
+  const unsigned int        n_owned = src.locally_owned_size();
+  std::vector<unsigned int> n_before(n_owned), n_after(n_owned);
+  bool                      correct_order = true;
+  laplace.vmult(
+    dst_fused,
+    src_fused,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          src_fused.local_element(i) = src.local_element(i);
+          dst_fused.local_element(i) = 0.;
+          ++n_before[i];
+        }
+    },
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          correct_order &= (n_before[i] == 1 && n_after[i] == 0);
+          ++n_after[i];
+        }
+    });
+
+  bool all_once = correct_order;
+  for (unsigned int i = 0; i < n_owned; ++i)
+    all_once &= (n_before[i] == 1 && n_after[i] == 1);
+  deallog << "Each entry visited once in the correct order: "
+          << (all_once ? "yes" : "no") << std::endl;
+
+  dst_fused -= dst;
+  deallog << "Same result as vmult: "
+          << (dst_fused.linfty_norm() < 1e-12 * dst.linfty_norm() ? "yes" :
+                                                                    "no")
+          << std::endl;
+
+  VectorType rhs, solution, solution_fused;
+  matrix_free->initialize_dof_vector(rhs);
+  matrix_free->initialize_dof_vector(solution);
+  matrix_free->initialize_dof_vector(solution_fused);
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    if (!constraints.is_constrained(i))
+      rhs.local_element(i) = 1.;
+
+  SolverControl        control(500, 1e-12);
+  SolverCG<VectorType> solver(control);
+  solver.solve(UnfusedOperator<decltype(laplace)>(laplace),
+               solution,
+               rhs,
+               *laplace.get_matrix_diagonal_inverse());
+  const unsigned int n_iterations = control.last_step();
+  solver.solve(laplace,
+               solution_fused,
+               rhs,
+               *laplace.get_matrix_diagonal_inverse());
+
+  deallog << "Same number of CG iterations: "
+          << (control.last_step() == n_iterations ? "yes" : "no") << std::endl;
+  solution_fused -= solution;
+  deallog << "Same CG solution: "
+          << (solution_fused.linfty_norm() < 1e-10 * solution.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("none");
+  test<2, 2>(MatrixFree<2>::AdditionalData::none);
+  test<3, 1>(MatrixFree<3>::AdditionalData::none);
+  deallog.pop();
+  deallog.push("partition_partition");
+  test<2, 2>(MatrixFree<2>::AdditionalData::partition_partition);
+  test<3, 1>(MatrixFree<3>::AdditionalData::partition_partition);
+  deallog.pop();
+}
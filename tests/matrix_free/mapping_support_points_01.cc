@@ -0,0 +1,197 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that storing only the support points of the mapping for curved cells
+// in MappingInfo and computing the Jacobians on the fly in FEEvaluation
+// gives the same results for the integration over the domain and a
+// Laplace operator as the standard storage of the Jacobians, with a smaller
+// amount of data
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int fe_degree>
+void
+vmult(const MatrixFree<dim, double> &                   matrix_free,
+      LinearAlgebra::distributed::Vector<double> &      dst,
+      const LinearAlgebra::distributed::Vector<double> &src)
+{
+  matrix_free.template cell_loop<LinearAlgebra::distributed::Vector<double>,
+                                 LinearAlgebra::distributed::Vector<double>>(
+    [](const MatrixFree<dim, double> &                   data,
+       LinearAlgebra::distributed::Vector<double> &      dst,
+       const LinearAlgebra::distributed::Vector<double> &src,
+       const std::pair<unsigned int, unsigned int> &     cell_range) {
+      FEEvaluation<dim, fe_degree> phi(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(src);
+          phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            {
+              phi.submit_value(phi.get_value(q), q);
+              phi.submit_gradient(phi.get_gradient(q), q);
+            }
+          phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+          phi.distribute_local_to_global(dst);
+        }
+    },
+    dst,
+    src,
+    true);
+}
+
+
+
+template <int dim, int fe_degree>
+double
+compute_volume(const MatrixFree<dim, double> &matrix_free)
+{
+  FEEvaluation<dim, fe_degree> phi(matrix_free);
+  double                       volume = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      phi.reinit(cell);
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_cell_batch(cell);
+           ++v)
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          volume += phi.JxW(q)[v];
+    }
+  return volume;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test(const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., 2 * dim);
+  tria.refine_global(4 - dim);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  MappingQGeneric<dim> mapping(mapping_degree);
+
+  MatrixFree<dim, double> matrix_free_stored, matrix_free_support_points;
+  {
+    typename MatrixFree<dim, double>::AdditionalData additional_data;
+    additional_data.tasks_parallel_scheme =
+      MatrixFree<dim, double>::AdditionalData::none;
+    additional_data.mapping_update_flags =
+      update_values | update_gradients | update_JxW_values;
+
+    additional_data.store_mapping_support_points = false;
+    matrix_free_stored.reinit(mapping,
+                              dof_handler,
+                              constraints,
+                              QGauss<1>(fe_degree + 1),
+                              additional_data);
+
+    additional_data.store_mapping_support_points = true;
+    matrix_free_support_points.reinit(mapping,
+                                      dof_handler,
+                                      constraints,
+                                      QGauss<1>(fe_degree + 1),
+                                      additional_data);
+  }
+
+  const auto &data_stored = matrix_free_stored.get_mapping_info().cell_data[0];
+  const auto &data_support_points =
+    matrix_free_support_points.get_mapping_info().cell_data[0];
+  deallog << "Testing " << dim << "D, FE_Q<" << dim << ">(" << fe_degree
+          << "), MappingQ(" << mapping_degree << ")" << std::endl;
+  deallog << "Stores support points: "
+          << (data_support_points.mapping_support_points.empty() ? "no" :
+                                                                   "yes")
+          << ", " << (data_stored.mapping_support_points.empty() ? "no" : "yes")
+          << std::endl;
+  deallog << "Less geometry data: "
+          << (data_support_points.memory_consumption() <
+                  data_stored.memory_consumption() ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  const double volume_stored = compute_volume<dim, fe_degree>(
+    matrix_free_stored);
+  const double volume_support_points =
+    compute_volume<dim, fe_degree>(matrix_free_support_points);
+  deallog << "Volume agrees: "
+          << (std::abs(volume_stored - volume_support_points) <
+                  1e-12 * volume_stored ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  LinearAlgebra::distributed::Vector<double> src, dst_stored,
+    dst_support_points;
+  matrix_free_stored.initialize_dof_vector(src);
+  matrix_free_stored.initialize_dof_vector(dst_stored);
+  matrix_free_support_points.initialize_dof_vector(dst_support_points);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = std::sin(1. + 1.7 * i);
+
+  vmult<dim, fe_degree>(matrix_free_stored, dst_stored, src);
+  vmult<dim, fe_degree>(matrix_free_support_points, dst_support_points, src);
+  dst_support_points -= dst_stored;
+  deallog << "Operator evaluation agrees: "
+          << (dst_support_points.linfty_norm() <
+                  1e-12 * dst_stored.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 2>(2);
+  test<2, 4>(4);
+  test<3, 2>(3);
+  test<3, 3>(2);
+}
@@ -57,7 +57,8 @@ template <int dim, int fe_degree, typename number, int n_q_points_1d>
 void
 do_test(const DoFHandler<dim> &          dof,
         const AffineConstraints<double> &constraints,
-        const unsigned int               parallel_option = 0)
+        const unsigned int               parallel_option    = 0,
+        const bool                       fast_hanging_nodes = false)
 {
   deallog << "Testing " << dof.get_fe().get_name() << std::endl;
   if (parallel_option > 0)
@@ -84,7 +85,8 @@ do_test(const DoFHandler<dim> &          dof,
         data.tasks_parallel_scheme =
           MatrixFree<dim, number>::AdditionalData::partition_partition;
       }
-    data.tasks_block_size = 7;
+    data.tasks_block_size                = 7;
+    data.use_fast_hanging_node_algorithm = fast_hanging_nodes;
 
     mf_data.reinit(mapping, dof, constraints, quad, data);
   }
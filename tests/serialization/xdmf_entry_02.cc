@@ -0,0 +1,79 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check serialization for XDMFEntry with HDF5 groups, and that archives
+// written before the groups were added can still be read
+
+#include <deal.II/base/data_out_base.h>
+
+#include "serialization.h"
+
+void
+test()
+{
+  XDMFEntry entry1("mesh.h5", "solution.h5", 0.5, 128, 16, 2, 2);
+  entry1.set_hdf5_groups("/mesh_0", "/step_3");
+  entry1.add_attribute("u", 1);
+
+  // an entry that references groups is replaced by the one read below
+  XDMFEntry entry2("other.h5", "other.h5", 1., 4, 1, 2, 2);
+  entry2.set_hdf5_groups("/mesh_1", "/step_1");
+
+  // save data to archive
+  std::ostringstream oss;
+  {
+    boost::archive::text_oarchive oa(oss, boost::archive::no_header);
+    oa << entry1;
+  }
+
+  {
+    std::istringstream            iss(oss.str());
+    boost::archive::text_iarchive ia(iss, boost::archive::no_header);
+    ia >> entry2;
+  }
+
+  deallog << "XDMFEntry after de-serialization: " << std::endl
+          << std::endl
+          << entry2.get_xdmf_content(0, ReferenceCells::Quadrilateral)
+          << std::endl;
+
+  // an archive of version 0 of the class, which did not store the groups
+  const std::string old_archive =
+    "0 0 1 11 solution.h5 7 mesh.h5 5.00000000000000000e-01 128 16 2 2 "
+    "0 0 0 0";
+  {
+    std::istringstream            iss(old_archive);
+    boost::archive::text_iarchive ia(iss, boost::archive::no_header);
+    ia >> entry2;
+  }
+
+  deallog << "XDMFEntry read from version 0: " << std::endl
+          << std::endl
+          << entry2.get_xdmf_content(0, ReferenceCells::Quadrilateral)
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  test();
+
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the separate symbolic and numerical factorization of
+// SparseDirectUMFPACK: analyze() followed by several calls to
+// numeric_factorize() for matrices with the same sparsity pattern, and
+// factorize() for matrices with the same and with a different pattern
+
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+void
+check_solution(const SparseDirectUMFPACK & solver,
+               const SparseMatrix<double> &A,
+               const std::string &         name)
+{
+  Vector<double> b(A.m()), x(A.m()), r(A.m());
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = 1. + (i % 5);
+
+  solver.vmult(x, b);
+  A.vmult(r, x);
+  r -= b;
+  deallog << name << ": residual ok: "
+          << (r.l2_norm() < 1e-10 * b.l2_norm() ? "yes" : "no") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 33;
+  const unsigned int dim  = (size - 1) * (size - 1);
+  FDMatrix           testproblem(size, size);
+
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  // a sequence of matrices with the same sparsity pattern, as in Newton's
+  // method
+  SparseMatrix<double> A(structure), B(structure);
+  testproblem.five_point(A);
+  testproblem.five_point(B, true);
+  for (unsigned int i = 0; i < dim; ++i)
+    B.diag_element(i) += 1.;
+
+  SparseDirectUMFPACK solver;
+  solver.analyze(A);
+  solver.numeric_factorize(A);
+  check_solution(solver, A, "analyze and numeric_factorize A");
+  solver.numeric_factorize(B);
+  check_solution(solver, B, "numeric_factorize B");
+  solver.numeric_factorize(A);
+  check_solution(solver, A, "numeric_factorize A");
+
+  solver.factorize(B);
+  check_solution(solver, B, "factorize B");
+  solver.factorize(A);
+  check_solution(solver, A, "factorize A");
+
+  // a matrix with a different sparsity pattern
+  SparsityPattern structure_9(dim, dim, 9);
+  testproblem.nine_point_structure(structure_9);
+  structure_9.compress();
+  SparseMatrix<double> C(structure_9);
+  testproblem.nine_point(C);
+
+  try
+    {
+      solver.numeric_factorize(C);
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "numeric_factorize with a different pattern: exception"
+              << std::endl;
+    }
+
+  solver.factorize(C);
+  check_solution(solver, C, "factorize C");
+  solver.numeric_factorize(C);
+  check_solution(solver, C, "numeric_factorize C");
+}